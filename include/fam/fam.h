@@ -190,7 +190,7 @@ typedef struct {
     /** OpenFAM model to be used; default is memory_server, Other option is
      * shared_memory */
     char *openFamModel;
-    /** FAM context model - Default, Region*/
+    /** FAM context model - Default, Region, Thread */
     char *famContextModel;
     /** Number of consumer threads for shared memory model **/
     char *numConsumer;
@@ -206,6 +206,45 @@ typedef struct {
     uint64_t local_buf_size;
 
 } Fam_Options;
+
+/**
+ * Operations supported by the batched atomics API. Logical operations are
+ * only supported for unsigned types.
+ */
+typedef enum {
+    FAM_ATOMIC_SET = 0,
+    FAM_ATOMIC_ADD,
+    FAM_ATOMIC_SUBTRACT,
+    FAM_ATOMIC_MIN,
+    FAM_ATOMIC_MAX,
+    FAM_ATOMIC_AND,
+    FAM_ATOMIC_OR,
+    FAM_ATOMIC_XOR
+} Fam_Atomic_Op;
+
+/**
+ * Type of the value operated upon by a batched atomic.
+ */
+typedef enum {
+    FAM_ATOMIC_INT32 = 0,
+    FAM_ATOMIC_INT64,
+    FAM_ATOMIC_UINT32,
+    FAM_ATOMIC_UINT64,
+    FAM_ATOMIC_FLOAT,
+    FAM_ATOMIC_DOUBLE
+} Fam_Atomic_Type;
+
+/**
+ * Value of a batched atomic, interpreted as per Fam_Atomic_Type.
+ */
+typedef union {
+    int32_t int32Value;
+    int64_t int64Value;
+    uint32_t uint32Value;
+    uint64_t uint64Value;
+    float floatValue;
+    double doubleValue;
+} Fam_Atomic_Value;
 #ifdef __cplusplus
 }
 #endif
@@ -248,6 +287,8 @@ typedef long long int128_t;
  * not rely on the presence of any field within this data structure.
  * Applications should treat descriptors as opaque read-only data structures.
  */
+struct Fam_Layout;
+
 class Fam_Descriptor {
   public:
     // Constructor
@@ -295,6 +336,8 @@ class Fam_Descriptor {
     void set_gid(uint32_t gid_);
     void set_permissionLevel(Fam_Permission_Level permissionLevel);
     Fam_Permission_Level get_permissionLevel();
+    // get the placement of the item over its memory servers
+    const Fam_Layout *get_layout();
 
   private:
     class FamDescriptorImpl_;
@@ -352,6 +395,37 @@ class Fam_Region_Descriptor {
     FamRegionDescriptorImpl_ *frdimpl_;
 };
 
+/*
+ * Fam_Batch_Entry describes one transfer of a batched get or put. The
+ * entries of a batch may refer to different data items.
+ */
+typedef struct {
+    /* Descriptor of the data item in FAM */
+    Fam_Descriptor *descriptor;
+    /* Byte offset within the data item */
+    uint64_t offset;
+    /* Pointer to local memory */
+    void *local;
+    /* Number of bytes to be transferred */
+    uint64_t nbytes;
+} Fam_Batch_Entry;
+
+/*
+ * Fam_Atomic_Batch_Entry describes one atomic of a batched atomics call.
+ */
+typedef struct {
+    /* Descriptor of the data item in FAM */
+    Fam_Descriptor *descriptor;
+    /* Byte offset within the data item of the value to be updated */
+    uint64_t offset;
+    /* Operation to be performed */
+    Fam_Atomic_Op op;
+    /* Type of the value */
+    Fam_Atomic_Type type;
+    /* Value to be combined with the existing value in FAM */
+    Fam_Atomic_Value value;
+} Fam_Atomic_Batch_Entry;
+
 /**
  * Structure defining FAM options. This structure holds system wide information
  * required to initialize the OpenFAM library and the associated program using
@@ -361,6 +435,20 @@ class Fam_Region_Descriptor {
 
 class fam_context;
 
+/*
+ * Fam_Request is an opaque handle of a nonblocking get, put, gather or
+ * scatter. It is returned by the nonblocking calls that take a request
+ * argument, and must be completed with fam_test(), fam_wait(),
+ * fam_wait_any() or fam_wait_all(), which also release it.
+ */
+class Fam_Request;
+
+/*
+ * Fam_Stream is an opaque handle of a sequential read of a data item,
+ * returned by fam_stream_open() and released by fam_stream_close().
+ */
+class Fam_Stream;
+
 class fam {
   public:
     // INITIALIZE group
@@ -586,6 +674,24 @@ class fam {
     void fam_get_nonblocking(void *local, Fam_Descriptor *descriptor,
                              uint64_t offset, uint64_t nbytes);
 
+    /**
+     * Initiate a copy of data from FAM to node local memory and return a
+     * request that can be used to wait for this copy alone.
+     * @param local - pointer to local memory region where data needs to be
+     * copied. Must be of appropriate size
+     * @param descriptor - valid descriptor to area in FAM.
+     * @param offset - byte offset within the space defined by the descriptor
+     * from where memory should be copied
+     * @param nbytes - number of bytes to be copied from global to local memory
+     * @param request - returns the request of the copy
+     * @return - none
+     * @see #fam_test
+     * @see #fam_wait
+     */
+    void fam_get_nonblocking(void *local, Fam_Descriptor *descriptor,
+                             uint64_t offset, uint64_t nbytes,
+                             Fam_Request **request);
+
     /**
      * Copy data from local memory to FAM, blocking until the copy is complete.
      * @param local - pointer to local memory. Must point to valid data in local
@@ -613,6 +719,47 @@ class fam {
     void fam_put_nonblocking(void *local, Fam_Descriptor *descriptor,
                              uint64_t offset, uint64_t nbytes);
 
+    /**
+     * Initiate a copy of data from local memory to FAM and return a request
+     * that can be used to wait for this copy alone.
+     * @param local - pointer to local memory. Must point to valid data in local
+     * memory
+     * @param descriptor - valid descriptor in FAM
+     * @param offset - byte offset within the region defined by the descriptor
+     * to where data should be copied
+     * @param nbytes - number of bytes to be copied from local to FAM
+     * @param request - returns the request of the copy
+     * @return - none
+     * @see #fam_test
+     * @see #fam_wait
+     */
+    void fam_put_nonblocking(void *local, Fam_Descriptor *descriptor,
+                             uint64_t offset, uint64_t nbytes,
+                             Fam_Request **request);
+
+    /**
+     * Copy data from FAM to local memory for a batch of transfers, blocking
+     * until all of them are complete. The transfers are grouped per memory
+     * server and issued together, and the caller waits for a single
+     * completion for the whole batch.
+     * @param entries - array of transfers, each giving the descriptor, offset,
+     * local buffer and number of bytes
+     * @param nEntries - number of entries in the array
+     * @return - none
+     */
+    void fam_get_batch(Fam_Batch_Entry *entries, uint64_t nEntries);
+
+    /**
+     * Copy data from local memory to FAM for a batch of transfers, blocking
+     * until all of them are complete.
+     * @param entries - array of transfers, each giving the descriptor, offset,
+     * local buffer and number of bytes
+     * @param nEntries - number of entries in the array
+     * @return - none
+     * @see #fam_get_batch
+     */
+    void fam_put_batch(Fam_Batch_Entry *entries, uint64_t nEntries);
+
     // LOAD/STORE sub-group
 
     /**
@@ -642,7 +789,8 @@ class fam {
      * Gathers disjoint elements within a data item in FAM to a contiguous array
      * in local memory. Currently constrained to gather data from a single FAM
      * descriptor, but can be extended if data needs to be gathered from
-     * multiple data items.
+     * multiple data items. With sg_offload enabled in the PE configuration
+     * (off by default), many small elements are packed by the memory server.
      * @param local - pointer to local memory array. Must be large enough to
      * contain returned data
      * @param descriptor - valid descriptor containing FAM reference
@@ -663,7 +811,8 @@ class fam {
      * Gathers disjoint elements within a data item in FAM to a contiguous array
      * in local memory. Currently constrained to gather data from a single FAM
      * descriptor, but can be extended if data needs to be gathered from
-     * multiple data items.
+     * multiple data items. With sg_offload enabled in the PE configuration
+     * (off by default), many small elements are packed by the memory server.
      * @param local - pointer to local memory array. Must be large enough to
      * contain returned data
      * @param descriptor - valid descriptor containing FAM reference
@@ -698,6 +847,18 @@ class fam {
                                 uint64_t nElements, uint64_t firstElement,
                                 uint64_t stride, uint64_t elementSize);
 
+    /**
+     * Initiate a strided gather from FAM to local memory and return a request
+     * that can be used to wait for this gather alone.
+     * @param request - returns the request of the gather
+     * @see #fam_gather_nonblocking for the other parameters
+     * @see #fam_wait
+     */
+    void fam_gather_nonblocking(void *local, Fam_Descriptor *descriptor,
+                                uint64_t nElements, uint64_t firstElement,
+                                uint64_t stride, uint64_t elementSize,
+                                Fam_Request **request);
+
     /**
      * Gather data from FAM to local memory, blocking while copy is complete
      * Gathers disjoint elements within a data item in FAM to a contiguous array
@@ -717,12 +878,25 @@ class fam {
                                 uint64_t nElements, uint64_t *elementIndex,
                                 uint64_t elementSize);
 
+    /**
+     * Initiate an indexed gather from FAM to local memory and return a
+     * request that can be used to wait for this gather alone.
+     * @param request - returns the request of the gather
+     * @see #fam_gather_nonblocking for the other parameters
+     * @see #fam_wait
+     */
+    void fam_gather_nonblocking(void *local, Fam_Descriptor *descriptor,
+                                uint64_t nElements, uint64_t *elementIndex,
+                                uint64_t elementSize, Fam_Request **request);
+
     /**
      * Scatter data from local memory to FAM.
      * Scatters data from a contiguous array in local memory to disjoint
      * elements of a data item in FAM. Currently constrained to scatter data to
      * a single FAM descriptor, but can be extended if data needs to be
-     * scattered to multiple data items.
+     * scattered to multiple data items. With sg_offload enabled in the PE
+     * configuration (off by default), many small elements are unpacked by
+     * the memory server.
      * @param local - pointer to local memory region containing elements
      * @param descriptor - valid descriptor containing FAM reference
      * @param nElements - number of elements to be scattered from local memory
@@ -742,7 +916,9 @@ class fam {
      * Scatters data from a contiguous array in local memory to disjoint
      * elements of a data item in FAM. Currently constrained to scatter data to
      * a single FAM descriptor, but can be extended if data needs to be
-     * scattered to multiple data items.
+     * scattered to multiple data items. With sg_offload enabled in the PE
+     * configuration (off by default), many small elements are unpacked by
+     * the memory server.
      * @param local - pointer to local memory region containing data elements
      * @param descriptor - valid descriptor containing FAM reference
      * @param nElements - number of elements to be scattered from local memory
@@ -775,6 +951,18 @@ class fam {
                                  uint64_t nElements, uint64_t firstElement,
                                  uint64_t stride, uint64_t elementSize);
 
+    /**
+     * Initiate a strided scatter from local memory to FAM and return a
+     * request that can be used to wait for this scatter alone.
+     * @param request - returns the request of the scatter
+     * @see #fam_scatter_nonblocking for the other parameters
+     * @see #fam_wait
+     */
+    void fam_scatter_nonblocking(void *local, Fam_Descriptor *descriptor,
+                                 uint64_t nElements, uint64_t firstElement,
+                                 uint64_t stride, uint64_t elementSize,
+                                 Fam_Request **request);
+
     /**
      * Initiate a scatter data from local memory to FAM.
      * Scatters data from a contiguous array in local memory to disjoint
@@ -793,6 +981,56 @@ class fam {
                                  uint64_t nElements, uint64_t *elementIndex,
                                  uint64_t elementSize);
 
+    /**
+     * Initiate an indexed scatter from local memory to FAM and return a
+     * request that can be used to wait for this scatter alone.
+     * @param request - returns the request of the scatter
+     * @see #fam_scatter_nonblocking for the other parameters
+     * @see #fam_wait
+     */
+    void fam_scatter_nonblocking(void *local, Fam_Descriptor *descriptor,
+                                 uint64_t nElements, uint64_t *elementIndex,
+                                 uint64_t elementSize, Fam_Request **request);
+
+    /**
+     * fam_test - check whether a nonblocking request has completed, without
+     * waiting for it. A completed request is released and must not be used
+     * again.
+     * @param request - request returned by a nonblocking call
+     * @return - true if the request has completed
+     */
+    bool fam_test(Fam_Request *request);
+
+    /**
+     * fam_wait - block until a nonblocking request has completed, and release
+     * the request. The request is released even if its IO failed.
+     * @param request - request returned by a nonblocking call
+     * @return - none
+     */
+    void fam_wait(Fam_Request *request);
+
+    /**
+     * fam_wait_any - block until any one of an array of nonblocking requests
+     * has completed. The completed request is released and its entry set to
+     * NULL. NULL entries are skipped, so the same array can be passed again
+     * until all requests have completed.
+     * @param requests - array of requests returned by nonblocking calls
+     * @param count - number of entries in the array
+     * @return - index of the completed request, or count if all entries are
+     * NULL
+     */
+    uint64_t fam_wait_any(Fam_Request **requests, uint64_t count);
+
+    /**
+     * fam_wait_all - block until all of an array of nonblocking requests have
+     * completed. Each request is released and its entry set to NULL. NULL
+     * entries are skipped.
+     * @param requests - array of requests returned by nonblocking calls
+     * @param count - number of entries in the array
+     * @return - none
+     */
+    void fam_wait_all(Fam_Request **requests, uint64_t count);
+
     // COPY Subgroup
 
     /**
@@ -1020,6 +1258,18 @@ class fam {
     void fam_xor(Fam_Descriptor *descriptor, uint64_t offset, uint32_t value);
     void fam_xor(Fam_Descriptor *descriptor, uint64_t offset, uint64_t value);
 
+    /**
+     * atomic batch - issue a batch of non-fetching atomics. The atomics are
+     * routed to the memory servers holding their offsets and posted together,
+     * so the whole batch costs a single lock acquisition. As with the other
+     * non-fetching atomics, completion is only guaranteed after fam_quiet().
+     * Atomics within a batch are not ordered with respect to each other.
+     * @param entries - array of {descriptor, offset, op, type, value} entries
+     * @param nEntries - number of entries in the array
+     * @return - none
+     */
+    void fam_atomic_batch(Fam_Atomic_Batch_Entry *entries, uint64_t nEntries);
+
     // FETCHING Routines - perform the operation, and return the old value in
     // FAM
 
@@ -1226,6 +1476,18 @@ class fam {
     uint64_t fam_fetch_xor(Fam_Descriptor *descriptor, uint64_t offset,
                            uint64_t value);
 
+    /**
+     * fetch atomic batch - issue a batch of fetching atomics and wait for all
+     * of them to complete. FAM_ATOMIC_SET behaves as fam_swap.
+     * @param entries - array of {descriptor, offset, op, type, value} entries
+     * @param nEntries - number of entries in the array
+     * @param results - array of nEntries values, where the old value from
+     * FAM of each entry is returned
+     * @return - none
+     */
+    void fam_atomic_fetch_batch(Fam_Atomic_Batch_Entry *entries,
+                                uint64_t nEntries, Fam_Atomic_Value *results);
+
     // MEMORY ORDERING Routines - provide ordering of FAM operations issued by a
     // PE
 
@@ -1247,6 +1509,69 @@ class fam {
      * @return - none
      */
     void fam_quiet(void);
+
+    /**
+     * fam_invalidate - drop the data of a range of a data item cached by this
+     * PE, so that the next reads of the range fetch it from FAM. With the
+     * read cache enabled (read_cache in fam_pe_config.yaml), writes issued
+     * by this PE keep the cache coherent, while writes of other PEs are seen
+     * only after the range is invalidated.
+     * @param descriptor - valid descriptor to data item in FAM
+     * @param offset - byte offset within the data item of the range
+     * @param nbytes - number of bytes in the range
+     * @return - none
+     */
+    void fam_invalidate(Fam_Descriptor *descriptor, uint64_t offset,
+                        uint64_t nbytes);
+
+    /**
+     * fam_prefetch - start reading a range of a data item in the background,
+     * so that a later fam_get_blocking of the range completes as a local
+     * copy. The data is kept in the read cache (read_cache in
+     * fam_pe_config.yaml), and fam_prefetch has no effect when it is
+     * disabled. A prefetch is a hint: at most half of the cache is filled,
+     * and pages already cached are not read again.
+     * @param descriptor - valid descriptor to data item in FAM
+     * @param offset - byte offset within the data item of the range
+     * @param nbytes - number of bytes in the range
+     * @return - none
+     */
+    void fam_prefetch(Fam_Descriptor *descriptor, uint64_t offset,
+                      uint64_t nbytes);
+
+    /**
+     * fam_stream_open - start a sequential read of a range of a data item,
+     * in chunks of chunkSize bytes of which up to depth are read ahead.
+     * The chunks are returned in order by fam_stream_next().
+     * @param descriptor - valid descriptor to data item in FAM
+     * @param offset - byte offset within the data item of the range
+     * @param nbytes - number of bytes in the range
+     * @param chunkSize - size in bytes of a chunk
+     * @param depth - number of chunks read ahead
+     * @return - the stream, to be released with fam_stream_close()
+     */
+    Fam_Stream *fam_stream_open(Fam_Descriptor *descriptor, uint64_t offset,
+                                uint64_t nbytes, uint64_t chunkSize,
+                                uint64_t depth);
+
+    /**
+     * fam_stream_next - wait for the next chunk of a stream. The returned
+     * memory stays valid until the next call on the stream.
+     * @param stream - stream returned by fam_stream_open()
+     * @param nbytes - returns the number of bytes in the chunk, 0 at the
+     * end of the stream
+     * @return - pointer to the chunk, NULL at the end of the stream
+     */
+    const void *fam_stream_next(Fam_Stream *stream, uint64_t *nbytes);
+
+    /**
+     * fam_stream_close - release a stream, after waiting for the chunks
+     * still being read.
+     * @param stream - stream returned by fam_stream_open()
+     * @return - none
+     */
+    void fam_stream_close(Fam_Stream *stream);
+
     fam_context *fam_context_open();
     void fam_context_close(fam_context *);
 
@@ -1318,6 +1643,9 @@ using Fam_Permission_Level=openfam::Fam_Permission_Level;
 using Fam_Region_Attributes=openfam::Fam_Region_Attributes;
 using Fam_Stat=openfam::Fam_Stat;
 using Fam_Backup_Options=openfam::Fam_Backup_Options;
+using Fam_Atomic_Op=openfam::Fam_Atomic_Op;
+using Fam_Atomic_Type=openfam::Fam_Atomic_Type;
+using Fam_Atomic_Value=openfam::Fam_Atomic_Value;
 #endif /* end of C/C11 Headers */
 
 #endif /* end of FAM_H_ */
@@ -60,6 +60,8 @@ typedef void c_fam;
 typedef void c_fam_region_desc;
 typedef void c_fam_desc;
 typedef void c_fam_context;
+typedef void c_fam_request;
+typedef void c_fam_stream;
 
 typedef Fam_Options c_fam_options;
 
@@ -75,6 +77,29 @@ typedef Fam_Stat c_fam_stat;
 
 typedef Fam_Backup_Options c_fam_backup_options;
 
+/* One transfer of a batched get or put */
+typedef struct {
+    c_fam_desc *desc;
+    uint64_t offset;
+    void *local_addr;
+    uint64_t size;
+} c_fam_batch_entry;
+
+typedef Fam_Atomic_Op c_fam_atomic_op;
+
+typedef Fam_Atomic_Type c_fam_atomic_type;
+
+typedef Fam_Atomic_Value c_fam_atomic_value;
+
+/* One atomic of a batched atomics call */
+typedef struct {
+    c_fam_desc *desc;
+    uint64_t offset;
+    c_fam_atomic_op op;
+    c_fam_atomic_type type;
+    c_fam_atomic_value value;
+} c_fam_atomic_batch_entry;
+
 /* This method is used to create a FAM instance 
  * and returns a pointer to the FAM instance.
  * @return - pointer to FAM instance
@@ -320,6 +345,92 @@ int  c_fam_put_nonblocking(c_fam* fam_obj, void* local_addr, c_fam_desc* desc, u
  */
 int  c_fam_get_nonblocking(c_fam* fam_obj, void* local_addr, c_fam_desc* desc, uint64_t offset, size_t size);
 
+/**
+ * Initiate a copy of data from local memory to FAM and return a request that
+ * can be used to wait for this copy alone.
+ * @param fam_obj - FAM instance
+ * @param local_addr - pointer to local memory
+ * @param desc - valid descriptor in FAM
+ * @param offset - byte offset within the data item
+ * @param size - number of bytes to be copied from local to FAM
+ * @param request - returns the request, to be completed with c_fam_test(),
+ * c_fam_wait(), c_fam_wait_any() or c_fam_wait_all()
+ * @return - 0 on success and -1 on failure
+ */
+int  c_fam_put_nonblocking_request(c_fam* fam_obj, void* local_addr, c_fam_desc* desc, uint64_t offset, size_t size, c_fam_request** request);
+
+/**
+ * Initiate a copy of data from FAM to local memory and return a request that
+ * can be used to wait for this copy alone.
+ * @param fam_obj - FAM instance
+ * @param local_addr - pointer to local memory region
+ * @param desc - valid descriptor in FAM
+ * @param offset - byte offset within the data item
+ * @param size - number of bytes to be copied from FAM to local memory
+ * @param request - returns the request
+ * @return - 0 on success and -1 on failure
+ */
+int  c_fam_get_nonblocking_request(c_fam* fam_obj, void* local_addr, c_fam_desc* desc, uint64_t offset, size_t size, c_fam_request** request);
+
+/**
+ * Check whether a request has completed, without waiting. A completed
+ * request is released.
+ * @param fam_obj - FAM instance
+ * @param request - request returned by a nonblocking call
+ * @return - 1 if the request has completed, 0 if it is pending and -1 on
+ * failure
+ */
+int  c_fam_test(c_fam* fam_obj, c_fam_request* request);
+
+/**
+ * Wait until a request has completed, and release it.
+ * @param fam_obj - FAM instance
+ * @param request - request returned by a nonblocking call
+ * @return - 0 on success and -1 on failure
+ */
+int  c_fam_wait(c_fam* fam_obj, c_fam_request* request);
+
+/**
+ * Wait until any one of an array of requests has completed. The completed
+ * request is released and its entry set to NULL; NULL entries are skipped.
+ * @param fam_obj - FAM instance
+ * @param requests - array of requests
+ * @param count - number of entries in the array
+ * @return - index of the completed request, count if all entries are NULL,
+ * and -1 on failure
+ */
+int64_t c_fam_wait_any(c_fam* fam_obj, c_fam_request** requests, uint64_t count);
+
+/**
+ * Wait until all of an array of requests have completed. Each request is
+ * released and its entry set to NULL; NULL entries are skipped.
+ * @param fam_obj - FAM instance
+ * @param requests - array of requests
+ * @param count - number of entries in the array
+ * @return - 0 on success and -1 on failure
+ */
+int  c_fam_wait_all(c_fam* fam_obj, c_fam_request** requests, uint64_t count);
+
+/**
+ * Copy a batch of regions from FAM to node local memory, blocking until all
+ * copies are complete.
+ * @param fam_obj - FAM instance
+ * @param entries - array of {descriptor, offset, local, nbytes} entries
+ * @param n_entries - number of entries in the array
+ * @return - 0 on success and -1 on failure
+ */
+int  c_fam_get_batch(c_fam* fam_obj, c_fam_batch_entry* entries, uint64_t n_entries);
+
+/**
+ * Copy a batch of regions from node local memory to FAM, blocking until all
+ * copies are complete.
+ * @param fam_obj - FAM instance
+ * @param entries - array of {descriptor, offset, local, nbytes} entries
+ * @param n_entries - number of entries in the array
+ * @return - 0 on success and -1 on failure
+ */
+int  c_fam_put_batch(c_fam* fam_obj, c_fam_batch_entry* entries, uint64_t n_entries);
+
 /**
  * Copy data from local memory to FAM, blocking until the copy is complete.
  * @param fam_obj - FAM instance
@@ -532,6 +643,62 @@ int  c_fam_quiet(c_fam* fam_obj);
  */
 int  c_fam_fence(c_fam* fam_obj);
 
+/**
+ * fam_invalidate - drop the data of a range of a data item cached by this
+ * PE, so that the next reads of the range fetch it from FAM.
+ * @param fam_obj - FAM instance
+ * @param desc - valid descriptor to data item in FAM
+ * @param offset - byte offset within the data item of the range
+ * @param size - number of bytes in the range
+ * @return - 0 on success and -1 on failure
+ */
+int  c_fam_invalidate(c_fam* fam_obj, c_fam_desc* desc, uint64_t offset, uint64_t size);
+
+/**
+ * fam_prefetch - start reading a range of a data item into the read cache in
+ * the background, so that a later blocking get of the range is served
+ * locally. Has no effect unless the read cache is enabled.
+ * @param fam_obj - FAM instance
+ * @param desc - valid descriptor to data item in FAM
+ * @param offset - byte offset within the data item of the range
+ * @param size - number of bytes in the range
+ * @return - 0 on success and -1 on failure
+ */
+int  c_fam_prefetch(c_fam* fam_obj, c_fam_desc* desc, uint64_t offset, uint64_t size);
+
+/**
+ * Start a sequential read of a range of a data item, in chunks of chunk_size
+ * bytes of which up to depth are read ahead.
+ * @param fam_obj - FAM instance
+ * @param desc - valid descriptor to data item in FAM
+ * @param offset - byte offset within the data item of the range
+ * @param size - number of bytes in the range
+ * @param chunk_size - size in bytes of a chunk
+ * @param depth - number of chunks read ahead
+ * @param stream - returns the stream, to be released with c_fam_stream_close()
+ * @return - 0 on success and -1 on failure
+ */
+int  c_fam_stream_open(c_fam* fam_obj, c_fam_desc* desc, uint64_t offset, uint64_t size, uint64_t chunk_size, uint64_t depth, c_fam_stream** stream);
+
+/**
+ * Wait for the next chunk of a stream, valid until the next call on the
+ * stream.
+ * @param fam_obj - FAM instance
+ * @param stream - stream returned by c_fam_stream_open()
+ * @param chunk - returns a pointer to the chunk, NULL at the end of the stream
+ * @param size - returns the number of bytes in the chunk, 0 at the end
+ * @return - 0 on success and -1 on failure
+ */
+int  c_fam_stream_next(c_fam* fam_obj, c_fam_stream* stream, const void** chunk, uint64_t* size);
+
+/**
+ * Release a stream, after waiting for the chunks still being read.
+ * @param fam_obj - FAM instance
+ * @param stream - stream returned by c_fam_stream_open()
+ * @return - 0 on success and -1 on failure
+ */
+int  c_fam_stream_close(c_fam* fam_obj, c_fam_stream* stream);
+
 /*
  * c_fam_delete - delete the fam instance
  * @param fam_obj - FAM instance
@@ -955,6 +1122,28 @@ int c_fam_fetch_or_uint64(c_fam* fam_obj, c_fam_desc* desc, uint64_t offset, uin
 int c_fam_fetch_xor_uint32(c_fam* fam_obj, c_fam_desc* desc, uint64_t offset, uint32_t value, uint32_t* ret_val);
 int c_fam_fetch_xor_uint64(c_fam* fam_obj, c_fam_desc* desc, uint64_t offset, uint64_t value, uint64_t* ret_val);
 
+/**
+ * atomic batch - issue a batch of non-fetching atomics. Completion is
+ * guaranteed only after c_fam_quiet().
+ * @param fam_obj - FAM instance
+ * @param entries - array of {desc, offset, op, type, value} entries
+ * @param n_entries - number of entries in the array
+ * @return - 0 on success and -1 on failure
+ */
+int c_fam_atomic_batch(c_fam* fam_obj, c_fam_atomic_batch_entry* entries, uint64_t n_entries);
+
+/**
+ * fetch atomic batch - issue a batch of fetching atomics and wait for all of
+ * them to complete.
+ * @param fam_obj - FAM instance
+ * @param entries - array of {desc, offset, op, type, value} entries
+ * @param n_entries - number of entries in the array
+ * @param results - array of n_entries values where the old values are
+ * returned
+ * @return - 0 on success and -1 on failure
+ */
+int c_fam_atomic_fetch_batch(c_fam* fam_obj, c_fam_atomic_batch_entry* entries, uint64_t n_entries, c_fam_atomic_value* results);
+
 #ifdef __cplusplus
 } //end of extern "C" 
 #endif
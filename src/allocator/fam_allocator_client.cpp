@@ -691,6 +691,38 @@ void Fam_Allocator_Client::wait_for_copy(void *waitObj) {
     return famCIS->wait_for_copy(waitObj);
 }
 
+void Fam_Allocator_Client::gather_packed(
+    Fam_Descriptor *descriptor, uint64_t nElements, uint64_t firstElement,
+    uint64_t stride, const uint64_t *elementIndex, uint64_t elementSize,
+    uint64_t key, uint64_t clientBaseAddr, const char *nodeAddr,
+    uint32_t nodeAddrSize) {
+    Fam_Global_Descriptor globalDescriptor =
+        descriptor->get_global_descriptor();
+    uint64_t regionId = globalDescriptor.regionId & REGIONID_MASK;
+    uint64_t offset = globalDescriptor.offset;
+    uint64_t memserverId = descriptor->get_first_memserver_id();
+
+    famCIS->gather_packed(regionId, offset, nElements, firstElement, stride,
+                          elementIndex, elementSize, key, clientBaseAddr,
+                          nodeAddr, nodeAddrSize, memserverId, uid, gid);
+}
+
+void Fam_Allocator_Client::scatter_packed(
+    Fam_Descriptor *descriptor, uint64_t nElements, uint64_t firstElement,
+    uint64_t stride, const uint64_t *elementIndex, uint64_t elementSize,
+    uint64_t key, uint64_t clientBaseAddr, const char *nodeAddr,
+    uint32_t nodeAddrSize) {
+    Fam_Global_Descriptor globalDescriptor =
+        descriptor->get_global_descriptor();
+    uint64_t regionId = globalDescriptor.regionId & REGIONID_MASK;
+    uint64_t offset = globalDescriptor.offset;
+    uint64_t memserverId = descriptor->get_first_memserver_id();
+
+    famCIS->scatter_packed(regionId, offset, nElements, firstElement, stride,
+                          elementIndex, elementSize, key, clientBaseAddr,
+                          nodeAddr, nodeAddrSize, memserverId, uid, gid);
+}
+
 void *Fam_Allocator_Client::backup(Fam_Descriptor *src,
                                    const char *BackupName) {
     Fam_Global_Descriptor globalDescriptor = src->get_global_descriptor();
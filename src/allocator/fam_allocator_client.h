@@ -82,6 +82,16 @@ class Fam_Allocator_Client {
                uint64_t destOffset, uint64_t nbytes);
 
     void wait_for_copy(void *waitObj);
+    void gather_packed(Fam_Descriptor *descriptor, uint64_t nElements,
+                       uint64_t firstElement, uint64_t stride,
+                       const uint64_t *elementIndex, uint64_t elementSize,
+                       uint64_t key, uint64_t clientBaseAddr,
+                       const char *nodeAddr, uint32_t nodeAddrSize);
+    void scatter_packed(Fam_Descriptor *descriptor, uint64_t nElements,
+                        uint64_t firstElement, uint64_t stride,
+                        const uint64_t *elementIndex, uint64_t elementSize,
+                        uint64_t key, uint64_t clientBaseAddr,
+                        const char *nodeAddr, uint32_t nodeAddrSize);
     void *backup(Fam_Descriptor *descriptor, const char *BackupName);
     void *restore(Fam_Descriptor *dest, const char *BackupName);
     void wait_for_backup(void *waitObj);
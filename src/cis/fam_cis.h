@@ -436,6 +436,46 @@ class Fam_CIS {
         uint64_t srcBaseAddr, const char *nodeAddr, uint32_t nodeAddrSize,
         uint64_t memoryServerId, uint32_t uid, uint32_t gid) = 0;
 
+    /**
+     * Gather elements of a data item on its memory server into a packed
+     * buffer and write it to the client buffer registered with key, using a
+     * single RDMA.
+     * @param regionId - region Id of the data item
+     * @param offset - offset of the data item in the region
+     * @param nElements - number of elements
+     * @param firstElement - first element of a strided gather
+     * @param stride - stride of a strided gather in elements
+     * @param elementIndex - element indexes, or NULL for a strided gather
+     * @param elementSize - size of each element in bytes
+     * @param key - key of the client buffer
+     * @param clientBaseAddr - RMA address of the client buffer
+     * @param nodeAddr - fabric address of the client endpoint
+     * @param nodeAddrSize - size of nodeAddr
+     * @param memoryServerId - memory server holding the data item
+     * @param uid - uid of user
+     * @param gid - gid of user
+     */
+    virtual void gather_packed(uint64_t regionId, uint64_t offset,
+                               uint64_t nElements, uint64_t firstElement,
+                               uint64_t stride, const uint64_t *elementIndex,
+                               uint64_t elementSize, uint64_t key,
+                               uint64_t clientBaseAddr, const char *nodeAddr,
+                               uint32_t nodeAddrSize, uint64_t memoryServerId,
+                               uint32_t uid, uint32_t gid) = 0;
+
+    /**
+     * Read a packed buffer from the client with a single RDMA and scatter
+     * its elements into a data item on its memory server.
+     * Parameters are the same as for gather_packed().
+     */
+    virtual void scatter_packed(uint64_t regionId, uint64_t offset,
+                                uint64_t nElements, uint64_t firstElement,
+                                uint64_t stride, const uint64_t *elementIndex,
+                                uint64_t elementSize, uint64_t key,
+                                uint64_t clientBaseAddr, const char *nodeAddr,
+                                uint32_t nodeAddrSize, uint64_t memoryServerId,
+                                uint32_t uid, uint32_t gid) = 0;
+
     virtual void
     open_region_with_registration(uint64_t regionId, uint32_t uid, uint32_t gid,
                                   std::vector<uint64_t> *memserverIds,
@@ -1137,6 +1137,64 @@ int Fam_CIS_Client::gather_indexed_atomic(
     return 0;
 }
 
+void Fam_CIS_Client::gather_packed(
+    uint64_t regionId, uint64_t offset, uint64_t nElements,
+    uint64_t firstElement, uint64_t stride, const uint64_t *elementIndex,
+    uint64_t elementSize, uint64_t key, uint64_t clientBaseAddr,
+    const char *nodeAddr, uint32_t nodeAddrSize, uint64_t memoryServerId,
+    uint32_t uid, uint32_t gid) {
+    Fam_SG_Packed_Request req;
+    Fam_Dataitem_Response res;
+    ::grpc::ClientContext ctx;
+    req.set_regionid(regionId & REGIONID_MASK);
+    req.set_offset(offset);
+    req.set_nelements(nElements);
+    req.set_firstelement(firstElement);
+    req.set_stride(stride);
+    if (elementIndex)
+        req.set_elementindex(elementIndex, nElements * sizeof(uint64_t));
+    req.set_elementsize(elementSize);
+    req.set_key(key);
+    req.set_clientbaseaddr(clientBaseAddr);
+    req.set_nodeaddr(nodeAddr, nodeAddrSize);
+    req.set_nodeaddrsize(nodeAddrSize);
+    req.set_memserver_id(memoryServerId);
+    req.set_uid(uid);
+    req.set_gid(gid);
+    ::grpc::Status status = stub->gather_packed(&ctx, req, &res);
+
+    STATUS_CHECK(CIS_Exception)
+}
+
+void Fam_CIS_Client::scatter_packed(
+    uint64_t regionId, uint64_t offset, uint64_t nElements,
+    uint64_t firstElement, uint64_t stride, const uint64_t *elementIndex,
+    uint64_t elementSize, uint64_t key, uint64_t clientBaseAddr,
+    const char *nodeAddr, uint32_t nodeAddrSize, uint64_t memoryServerId,
+    uint32_t uid, uint32_t gid) {
+    Fam_SG_Packed_Request req;
+    Fam_Dataitem_Response res;
+    ::grpc::ClientContext ctx;
+    req.set_regionid(regionId & REGIONID_MASK);
+    req.set_offset(offset);
+    req.set_nelements(nElements);
+    req.set_firstelement(firstElement);
+    req.set_stride(stride);
+    if (elementIndex)
+        req.set_elementindex(elementIndex, nElements * sizeof(uint64_t));
+    req.set_elementsize(elementSize);
+    req.set_key(key);
+    req.set_clientbaseaddr(clientBaseAddr);
+    req.set_nodeaddr(nodeAddr, nodeAddrSize);
+    req.set_nodeaddrsize(nodeAddrSize);
+    req.set_memserver_id(memoryServerId);
+    req.set_uid(uid);
+    req.set_gid(gid);
+    ::grpc::Status status = stub->scatter_packed(&ctx, req, &res);
+
+    STATUS_CHECK(CIS_Exception)
+}
+
 void Fam_CIS_Client::open_region_with_registration(
     uint64_t regionId, uint32_t uid, uint32_t gid,
     std::vector<uint64_t> *memserverIds,
@@ -191,6 +191,20 @@ class Fam_CIS_Client : public Fam_CIS {
                               uint32_t nodeAddrSize, uint64_t memoryServerId,
                               uint32_t uid, uint32_t gid);
 
+    void gather_packed(uint64_t regionId, uint64_t offset, uint64_t nElements,
+                       uint64_t firstElement, uint64_t stride,
+                       const uint64_t *elementIndex, uint64_t elementSize,
+                       uint64_t key, uint64_t clientBaseAddr,
+                       const char *nodeAddr, uint32_t nodeAddrSize,
+                       uint64_t memoryServerId, uint32_t uid, uint32_t gid);
+
+    void scatter_packed(uint64_t regionId, uint64_t offset, uint64_t nElements,
+                        uint64_t firstElement, uint64_t stride,
+                        const uint64_t *elementIndex, uint64_t elementSize,
+                        uint64_t key, uint64_t clientBaseAddr,
+                        const char *nodeAddr, uint32_t nodeAddrSize,
+                        uint64_t memoryServerId, uint32_t uid, uint32_t gid);
+
     void open_region_with_registration(uint64_t regionId, uint32_t uid,
                                        uint32_t gid,
                                        std::vector<uint64_t> *memserverIds,
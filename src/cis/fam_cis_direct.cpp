@@ -1848,26 +1848,30 @@ void *Fam_CIS_Direct::copy(uint64_t srcRegionId, uint64_t srcOffset,
         tag->copyDone.store(false, boost::memory_order_seq_cst);
         tag->memoryServiceMap = get_memory_service_map();
         tag->srcRegionId = srcRegionId;
-        memcpy(tag->srcOffsets, srcDataitem.offsets,
-               srcDataitem.used_memsrv_cnt * sizeof(uint64_t));
+        tag->srcOffsets.assign(srcDataitem.offsets,
+                               srcDataitem.offsets +
+                                   srcDataitem.used_memsrv_cnt);
         tag->srcCopyStart = srcCopyStart;
         tag->destCopyStart = destCopyStart;
-        memcpy(tag->srcBaseAddrList, srcBaseAddrList,
-               srcDataitem.used_memsrv_cnt * sizeof(uint64_t));
+        tag->srcBaseAddrList.assign(srcBaseAddrList,
+                                    srcBaseAddrList +
+                                        srcDataitem.used_memsrv_cnt);
         tag->destRegionId = destRegionId;
-        memcpy(tag->destOffsets, destDataitem.offsets,
-               destDataitem.used_memsrv_cnt * sizeof(uint64_t));
+        tag->destOffsets.assign(destDataitem.offsets,
+                                destDataitem.offsets +
+                                    destDataitem.used_memsrv_cnt);
         tag->size = size;
-        memcpy(tag->srcKeys, srcKeys,
-               srcDataitem.used_memsrv_cnt * sizeof(uint64_t));
+        tag->srcKeys.assign(srcKeys, srcKeys + srcDataitem.used_memsrv_cnt);
         tag->srcInterleaveSize = srcDataitem.interleaveSize;
         tag->destInterleaveSize = destDataitem.interleaveSize;
         tag->srcUsedMemsrvCnt = srcDataitem.used_memsrv_cnt;
         tag->destUsedMemsrvCnt = destDataitem.used_memsrv_cnt;
-        memcpy(tag->srcMemserverIds, srcDataitem.memoryServerIds,
-               srcDataitem.used_memsrv_cnt * sizeof(uint64_t));
-        memcpy(tag->destMemserverIds, destDataitem.memoryServerIds,
-               destDataitem.used_memsrv_cnt * sizeof(uint64_t));
+        tag->srcMemserverIds.assign(srcDataitem.memoryServerIds,
+                                    srcDataitem.memoryServerIds +
+                                        srcDataitem.used_memsrv_cnt);
+        tag->destMemserverIds.assign(destDataitem.memoryServerIds,
+                                     destDataitem.memoryServerIds +
+                                         destDataitem.used_memsrv_cnt);
         Fam_Ops_Info opsInfo = { COPY, NULL, NULL, 0, 0, 0, 0, 0, tag };
         asyncQHandler->initiate_operation(opsInfo);
         waitObj->tag = tag;
@@ -2006,10 +2010,12 @@ void *Fam_CIS_Direct::backup(uint64_t srcRegionId, uint64_t srcOffset,
         tag->backupDone.store(false, boost::memory_order_seq_cst);
         tag->memoryServiceMap = get_memory_service_map();
         tag->srcRegionId = srcRegionId;
-        memcpy(tag->srcOffsets, srcDataitem.offsets,
-               srcDataitem.used_memsrv_cnt * sizeof(uint64_t));
-        memcpy(tag->srcMemserverIds, srcDataitem.memoryServerIds,
-               srcDataitem.used_memsrv_cnt * sizeof(uint64_t));
+        tag->srcOffsets.assign(srcDataitem.offsets,
+                               srcDataitem.offsets +
+                                   srcDataitem.used_memsrv_cnt);
+        tag->srcMemserverIds.assign(srcDataitem.memoryServerIds,
+                                    srcDataitem.memoryServerIds +
+                                        srcDataitem.used_memsrv_cnt);
         tag->usedMemserverCnt = srcDataitem.used_memsrv_cnt;
         tag->srcInterleaveSize = srcDataitem.interleaveSize;
         tag->srcItemSize = srcDataitem.size;
@@ -2130,10 +2136,12 @@ void *Fam_CIS_Direct::restore(uint64_t destRegionId, uint64_t destOffset,
         tag->restoreDone.store(false, boost::memory_order_seq_cst);
         tag->memoryServiceMap = get_memory_service_map();
         tag->destRegionId = destRegionId;
-        memcpy(tag->destOffsets, destDataitem.offsets,
-               destDataitem.used_memsrv_cnt * sizeof(uint64_t));
-        memcpy(tag->destMemserverIds, destDataitem.memoryServerIds,
-               destDataitem.used_memsrv_cnt * sizeof(uint64_t));
+        tag->destOffsets.assign(destDataitem.offsets,
+                                destDataitem.offsets +
+                                    destDataitem.used_memsrv_cnt);
+        tag->destMemserverIds.assign(destDataitem.memoryServerIds,
+                                     destDataitem.memoryServerIds +
+                                         destDataitem.used_memsrv_cnt);
         tag->usedMemserverCnt = destDataitem.used_memsrv_cnt;
         tag->destInterleaveSize = destDataitem.interleaveSize;
         tag->destItemSize = destDataitem.size;
@@ -2657,6 +2665,112 @@ int Fam_CIS_Direct::gather_indexed_atomic(
     return 0;
 }
 
+// Check that all elements of a packed gather/scatter lie within a data item
+// of itemSize bytes
+static bool packed_elements_in_range(uint64_t nElements, uint64_t firstElement,
+                                     uint64_t stride,
+                                     const uint64_t *elementIndex,
+                                     uint64_t elementSize, uint64_t itemSize) {
+    if (nElements == 0)
+        return true;
+    if (elementSize == 0 || elementSize > itemSize)
+        return false;
+    uint64_t maxElements = itemSize / elementSize;
+    if (elementIndex == NULL) {
+        if (firstElement >= maxElements)
+            return false;
+        return (stride == 0 ||
+                (nElements - 1) <= (maxElements - 1 - firstElement) / stride);
+    }
+    for (uint64_t i = 0; i < nElements; i++) {
+        if (elementIndex[i] >= maxElements)
+            return false;
+    }
+    return true;
+}
+
+void Fam_CIS_Direct::gather_packed(
+    uint64_t regionId, uint64_t offset, uint64_t nElements,
+    uint64_t firstElement, uint64_t stride, const uint64_t *elementIndex,
+    uint64_t elementSize, uint64_t key, uint64_t clientBaseAddr,
+    const char *nodeAddr, uint32_t nodeAddrSize, uint64_t memoryServerId,
+    uint32_t uid, uint32_t gid) {
+
+    CIS_DIRECT_PROFILE_START_OPS()
+    ostringstream message;
+    uint64_t metadataServiceId = 0;
+    Fam_Memory_Service *memoryService = get_memory_service(memoryServerId);
+    Fam_Metadata_Service *metadataService =
+        get_metadata_service(metadataServiceId);
+    message << "Error While accessing dataitem : ";
+    uint64_t dataitemId = get_dataitem_id(offset, memoryServerId);
+    Fam_DataItem_Metadata dataitem;
+    try {
+        metadataService->metadata_find_dataitem_and_check_permissions(
+            META_REGION_ITEM_READ, dataitemId, regionId, uid, gid, dataitem);
+    }
+    catch (Fam_Exception &e) {
+        if (e.fam_error() == NO_PERMISSION) {
+            message << "Not permitted to access the region";
+            THROW_ERRNO_MSG(CIS_Exception, NO_PERMISSION,
+                            message.str().c_str());
+        }
+        throw e;
+    }
+
+    if (!packed_elements_in_range(nElements, firstElement, stride,
+                                  elementIndex, elementSize, dataitem.size)) {
+        message << "Element index is beyond dataitem boundary";
+        THROW_ERRNO_MSG(CIS_Exception, OUT_OF_RANGE, message.str().c_str());
+    }
+
+    memoryService->gather_packed(regionId, offset, nElements, firstElement,
+                                  stride, elementIndex, elementSize, key,
+                                  clientBaseAddr, nodeAddr, nodeAddrSize);
+    CIS_DIRECT_PROFILE_END_OPS(cis_gather_packed);
+}
+
+void Fam_CIS_Direct::scatter_packed(
+    uint64_t regionId, uint64_t offset, uint64_t nElements,
+    uint64_t firstElement, uint64_t stride, const uint64_t *elementIndex,
+    uint64_t elementSize, uint64_t key, uint64_t clientBaseAddr,
+    const char *nodeAddr, uint32_t nodeAddrSize, uint64_t memoryServerId,
+    uint32_t uid, uint32_t gid) {
+
+    CIS_DIRECT_PROFILE_START_OPS()
+    ostringstream message;
+    uint64_t metadataServiceId = 0;
+    Fam_Memory_Service *memoryService = get_memory_service(memoryServerId);
+    Fam_Metadata_Service *metadataService =
+        get_metadata_service(metadataServiceId);
+    message << "Error While accessing dataitem : ";
+    uint64_t dataitemId = get_dataitem_id(offset, memoryServerId);
+    Fam_DataItem_Metadata dataitem;
+    try {
+        metadataService->metadata_find_dataitem_and_check_permissions(
+            META_REGION_ITEM_WRITE, dataitemId, regionId, uid, gid, dataitem);
+    }
+    catch (Fam_Exception &e) {
+        if (e.fam_error() == NO_PERMISSION) {
+            message << "Not permitted to access the region";
+            THROW_ERRNO_MSG(CIS_Exception, NO_PERMISSION,
+                            message.str().c_str());
+        }
+        throw e;
+    }
+
+    if (!packed_elements_in_range(nElements, firstElement, stride,
+                                  elementIndex, elementSize, dataitem.size)) {
+        message << "Element index is beyond dataitem boundary";
+        THROW_ERRNO_MSG(CIS_Exception, OUT_OF_RANGE, message.str().c_str());
+    }
+
+    memoryService->scatter_packed(regionId, offset, nElements, firstElement,
+                                  stride, elementIndex, elementSize, key,
+                                  clientBaseAddr, nodeAddr, nodeAddrSize);
+    CIS_DIRECT_PROFILE_END_OPS(cis_scatter_packed);
+}
+
 inline uint64_t Fam_CIS_Direct::align_to_address(uint64_t size, int multiple) {
     assert(multiple && ((multiple & (multiple - 1)) == 0));
     return (size + multiple - 1) & -multiple;
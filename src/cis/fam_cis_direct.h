@@ -206,6 +206,20 @@ class Fam_CIS_Direct : public Fam_CIS {
                               uint32_t nodeAddrSize, uint64_t memoryServerId,
                               uint32_t uid, uint32_t gid);
 
+    void gather_packed(uint64_t regionId, uint64_t offset, uint64_t nElements,
+                       uint64_t firstElement, uint64_t stride,
+                       const uint64_t *elementIndex, uint64_t elementSize,
+                       uint64_t key, uint64_t clientBaseAddr,
+                       const char *nodeAddr, uint32_t nodeAddrSize,
+                       uint64_t memoryServerId, uint32_t uid, uint32_t gid);
+
+    void scatter_packed(uint64_t regionId, uint64_t offset, uint64_t nElements,
+                        uint64_t firstElement, uint64_t stride,
+                        const uint64_t *elementIndex, uint64_t elementSize,
+                        uint64_t key, uint64_t clientBaseAddr,
+                        const char *nodeAddr, uint32_t nodeAddrSize,
+                        uint64_t memoryServerId, uint32_t uid, uint32_t gid);
+
     memoryServerMap *get_memory_service_map() { return memoryServers; }
 
     void open_region_with_registration(uint64_t regionId, uint32_t uid,
@@ -911,6 +911,70 @@ Fam_CIS_Server::put_atomic(::grpc::ServerContext *context,
     return ::grpc::Status::OK;
 }
 
+::grpc::Status
+Fam_CIS_Server::gather_packed(::grpc::ServerContext *context,
+                              const ::Fam_SG_Packed_Request *request,
+                              ::Fam_Dataitem_Response *response) {
+    CIS_SERVER_PROFILE_START_OPS()
+    const uint64_t *elementIndex = NULL;
+    if (!request->elementindex().empty())
+        elementIndex = (const uint64_t *)request->elementindex().data();
+    try {
+        if (!packed_index_matches(request->elementindex(),
+                                  request->nelements()))
+            THROW_ERRNO_MSG(CIS_Exception, FAM_ERR_INVALID,
+                            "Element index does not match nElements");
+        famCIS->gather_packed(
+            request->regionid(), request->offset(), request->nelements(),
+            request->firstelement(), request->stride(), elementIndex,
+            request->elementsize(), request->key(), request->clientbaseaddr(),
+            request->nodeaddr().c_str(), request->nodeaddrsize(),
+            request->memserver_id(), request->uid(), request->gid());
+    }
+    catch (Fam_Exception &e) {
+        response->set_errorcode(e.fam_error());
+        response->set_errormsg(e.fam_error_msg());
+        return ::grpc::Status::OK;
+    }
+
+    CIS_SERVER_PROFILE_END_OPS(gather_packed);
+
+    // Return status OK
+    return ::grpc::Status::OK;
+}
+
+::grpc::Status
+Fam_CIS_Server::scatter_packed(::grpc::ServerContext *context,
+                              const ::Fam_SG_Packed_Request *request,
+                              ::Fam_Dataitem_Response *response) {
+    CIS_SERVER_PROFILE_START_OPS()
+    const uint64_t *elementIndex = NULL;
+    if (!request->elementindex().empty())
+        elementIndex = (const uint64_t *)request->elementindex().data();
+    try {
+        if (!packed_index_matches(request->elementindex(),
+                                  request->nelements()))
+            THROW_ERRNO_MSG(CIS_Exception, FAM_ERR_INVALID,
+                            "Element index does not match nElements");
+        famCIS->scatter_packed(
+            request->regionid(), request->offset(), request->nelements(),
+            request->firstelement(), request->stride(), elementIndex,
+            request->elementsize(), request->key(), request->clientbaseaddr(),
+            request->nodeaddr().c_str(), request->nodeaddrsize(),
+            request->memserver_id(), request->uid(), request->gid());
+    }
+    catch (Fam_Exception &e) {
+        response->set_errorcode(e.fam_error());
+        response->set_errormsg(e.fam_error_msg());
+        return ::grpc::Status::OK;
+    }
+
+    CIS_SERVER_PROFILE_END_OPS(scatter_packed);
+
+    // Return status OK
+    return ::grpc::Status::OK;
+}
+
 ::grpc::Status Fam_CIS_Server::open_region_with_registration(
     ::grpc::ServerContext *context, const ::Fam_Region_Request *request,
     ::Fam_Region_Response *response) {
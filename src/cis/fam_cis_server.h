@@ -222,6 +222,14 @@ class Fam_CIS_Server : public Fam_CIS_Rpc::Service {
                           const ::Fam_Atomic_SG_Indexed_Request *request,
                           ::Fam_Atomic_Response *response) override;
 
+    ::grpc::Status gather_packed(::grpc::ServerContext *context,
+                                 const ::Fam_SG_Packed_Request *request,
+                                 ::Fam_Dataitem_Response *response) override;
+
+    ::grpc::Status scatter_packed(::grpc::ServerContext *context,
+                                  const ::Fam_SG_Packed_Request *request,
+                                  ::Fam_Dataitem_Response *response) override;
+
     ::grpc::Status
     open_region_with_registration(::grpc::ServerContext *context,
                                   const ::Fam_Region_Request *request,
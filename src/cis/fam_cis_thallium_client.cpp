@@ -160,6 +160,8 @@ void Fam_CIS_Thallium_Client::connect(const char *name, uint64_t port) {
     rp_gather_strided_atomic = myEngine.define("gather_strided_atomic");
     rp_scatter_indexed_atomic = myEngine.define("scatter_indexed_atomic");
     rp_gather_indexed_atomic = myEngine.define("gather_indexed_atomic");
+    rp_gather_packed = myEngine.define("gather_packed");
+    rp_scatter_packed = myEngine.define("scatter_packed");
     rp_get_region_memory = myEngine.define("get_region_memory");
     rp_open_region_with_registration =
         myEngine.define("open_region_with_registration");
@@ -940,6 +942,64 @@ int Fam_CIS_Thallium_Client::gather_indexed_atomic(
     return 0;
 }
 
+void Fam_CIS_Thallium_Client::gather_packed(
+    uint64_t regionId, uint64_t offset, uint64_t nElements,
+    uint64_t firstElement, uint64_t stride, const uint64_t *elementIndex,
+    uint64_t elementSize, uint64_t key, uint64_t clientBaseAddr,
+    const char *nodeAddr, uint32_t nodeAddrSize, uint64_t memoryServerId,
+    uint32_t uid, uint32_t gid) {
+    Fam_CIS_Thallium_Request cisRequest;
+    cisRequest.set_regionid(regionId & REGIONID_MASK);
+    cisRequest.set_offset(offset);
+    cisRequest.set_nelements(nElements);
+    cisRequest.set_firstelement(firstElement);
+    cisRequest.set_stride(stride);
+    if (elementIndex)
+        cisRequest.set_elementindex((const char *)elementIndex,
+                                    (int)(nElements * sizeof(uint64_t)));
+    cisRequest.set_elementsize(elementSize);
+    cisRequest.set_key(key);
+    cisRequest.set_srcbaseaddr(clientBaseAddr);
+    cisRequest.set_nodeaddr(nodeAddr, (int)nodeAddrSize);
+    cisRequest.set_nodeaddrsize(nodeAddrSize);
+    cisRequest.set_memserver_id(memoryServerId);
+    cisRequest.set_uid(uid);
+    cisRequest.set_gid(gid);
+    Fam_CIS_Thallium_Response cisResponse =
+        rp_gather_packed.on(ph)(cisRequest);
+
+    RPC_STATUS_CHECK(CIS_Exception, cisResponse)
+}
+
+void Fam_CIS_Thallium_Client::scatter_packed(
+    uint64_t regionId, uint64_t offset, uint64_t nElements,
+    uint64_t firstElement, uint64_t stride, const uint64_t *elementIndex,
+    uint64_t elementSize, uint64_t key, uint64_t clientBaseAddr,
+    const char *nodeAddr, uint32_t nodeAddrSize, uint64_t memoryServerId,
+    uint32_t uid, uint32_t gid) {
+    Fam_CIS_Thallium_Request cisRequest;
+    cisRequest.set_regionid(regionId & REGIONID_MASK);
+    cisRequest.set_offset(offset);
+    cisRequest.set_nelements(nElements);
+    cisRequest.set_firstelement(firstElement);
+    cisRequest.set_stride(stride);
+    if (elementIndex)
+        cisRequest.set_elementindex((const char *)elementIndex,
+                                    (int)(nElements * sizeof(uint64_t)));
+    cisRequest.set_elementsize(elementSize);
+    cisRequest.set_key(key);
+    cisRequest.set_srcbaseaddr(clientBaseAddr);
+    cisRequest.set_nodeaddr(nodeAddr, (int)nodeAddrSize);
+    cisRequest.set_nodeaddrsize(nodeAddrSize);
+    cisRequest.set_memserver_id(memoryServerId);
+    cisRequest.set_uid(uid);
+    cisRequest.set_gid(gid);
+    Fam_CIS_Thallium_Response cisResponse =
+        rp_scatter_packed.on(ph)(cisRequest);
+
+    RPC_STATUS_CHECK(CIS_Exception, cisResponse)
+}
+
 void Fam_CIS_Thallium_Client::get_region_memory(
     uint64_t regionId, uint32_t uid, uint32_t gid,
     Fam_Region_Memory_Map *regionMemoryMap) {
@@ -184,6 +184,20 @@ class Fam_CIS_Thallium_Client : public Fam_CIS {
                               uint32_t nodeAddrSize, uint64_t memoryServerId,
                               uint32_t uid, uint32_t gid);
 
+    void gather_packed(uint64_t regionId, uint64_t offset, uint64_t nElements,
+                       uint64_t firstElement, uint64_t stride,
+                       const uint64_t *elementIndex, uint64_t elementSize,
+                       uint64_t key, uint64_t clientBaseAddr,
+                       const char *nodeAddr, uint32_t nodeAddrSize,
+                       uint64_t memoryServerId, uint32_t uid, uint32_t gid);
+
+    void scatter_packed(uint64_t regionId, uint64_t offset, uint64_t nElements,
+                        uint64_t firstElement, uint64_t stride,
+                        const uint64_t *elementIndex, uint64_t elementSize,
+                        uint64_t key, uint64_t clientBaseAddr,
+                        const char *nodeAddr, uint32_t nodeAddrSize,
+                        uint64_t memoryServerId, uint32_t uid, uint32_t gid);
+
     void get_region_memory(uint64_t regionId, uint32_t uid, uint32_t gid,
                            Fam_Region_Memory_Map *regionMemoryMap);
 
@@ -216,7 +230,8 @@ class Fam_CIS_Thallium_Client : public Fam_CIS {
         rp_get_backup_info, rp_list_backup, rp_delete_backup,
         rp_get_memserverinfo_size, rp_get_memserverinfo, rp_get_atomic,
         rp_put_atomic, rp_scatter_strided_atomic, rp_gather_strided_atomic,
-        rp_scatter_indexed_atomic, rp_gather_indexed_atomic,
+        rp_scatter_indexed_atomic, rp_gather_indexed_atomic, rp_gather_packed,
+        rp_scatter_packed,
         rp_get_region_memory, rp_open_region_with_registration,
         rp_open_region_without_registration, rp_close_region;
     tl::endpoint server;
@@ -157,6 +157,9 @@ void Fam_CIS_Thallium_Server::run() {
            &Fam_CIS_Thallium_Server::scatter_indexed_atomic, *myPool);
     define("gather_indexed_atomic",
            &Fam_CIS_Thallium_Server::gather_indexed_atomic, *myPool);
+    define("gather_packed", &Fam_CIS_Thallium_Server::gather_packed, *myPool);
+    define("scatter_packed", &Fam_CIS_Thallium_Server::scatter_packed,
+           *myPool);
     define("get_region_memory", &Fam_CIS_Thallium_Server::get_region_memory,
            *myPool);
     define("open_region_with_registration",
@@ -875,6 +878,64 @@ void Fam_CIS_Thallium_Server::gather_indexed_atomic(
     HANDLE_ERROR(req.respond(cisResponse));
 }
 
+void Fam_CIS_Thallium_Server::gather_packed(
+    const tl::request &req, Fam_CIS_Thallium_Request cisRequest) {
+    Fam_CIS_Thallium_Response cisResponse;
+    CIS_THALLIUM_SERVER_PROFILE_START_OPS()
+    std::string elementIndex = cisRequest.get_elementindex();
+    try {
+        if (!packed_index_matches(elementIndex, cisRequest.get_nelements()))
+            THROW_ERRNO_MSG(CIS_Exception, FAM_ERR_INVALID,
+                            "Element index does not match nElements");
+        direct_CIS->gather_packed(
+            cisRequest.get_regionid(), cisRequest.get_offset(),
+            cisRequest.get_nelements(), cisRequest.get_firstelement(),
+            cisRequest.get_stride(),
+            elementIndex.empty() ? NULL
+                                 : (const uint64_t *)elementIndex.data(),
+            cisRequest.get_elementsize(), cisRequest.get_key(),
+            cisRequest.get_srcbaseaddr(), cisRequest.get_nodeaddr().c_str(),
+            cisRequest.get_nodeaddrsize(), cisRequest.get_memserver_id(),
+            cisRequest.get_uid(), cisRequest.get_gid());
+        cisResponse.set_status(ok);
+    } catch (Fam_Exception &e) {
+        cisResponse.set_errorcode(e.fam_error());
+        cisResponse.set_errormsg(e.fam_error_msg());
+        cisResponse.set_status(error);
+    }
+    CIS_THALLIUM_SERVER_PROFILE_END_OPS(thallium_cis_server_gather_packed);
+    HANDLE_ERROR(req.respond(cisResponse));
+}
+
+void Fam_CIS_Thallium_Server::scatter_packed(
+    const tl::request &req, Fam_CIS_Thallium_Request cisRequest) {
+    Fam_CIS_Thallium_Response cisResponse;
+    CIS_THALLIUM_SERVER_PROFILE_START_OPS()
+    std::string elementIndex = cisRequest.get_elementindex();
+    try {
+        if (!packed_index_matches(elementIndex, cisRequest.get_nelements()))
+            THROW_ERRNO_MSG(CIS_Exception, FAM_ERR_INVALID,
+                            "Element index does not match nElements");
+        direct_CIS->scatter_packed(
+            cisRequest.get_regionid(), cisRequest.get_offset(),
+            cisRequest.get_nelements(), cisRequest.get_firstelement(),
+            cisRequest.get_stride(),
+            elementIndex.empty() ? NULL
+                                 : (const uint64_t *)elementIndex.data(),
+            cisRequest.get_elementsize(), cisRequest.get_key(),
+            cisRequest.get_srcbaseaddr(), cisRequest.get_nodeaddr().c_str(),
+            cisRequest.get_nodeaddrsize(), cisRequest.get_memserver_id(),
+            cisRequest.get_uid(), cisRequest.get_gid());
+        cisResponse.set_status(ok);
+    } catch (Fam_Exception &e) {
+        cisResponse.set_errorcode(e.fam_error());
+        cisResponse.set_errormsg(e.fam_error_msg());
+        cisResponse.set_status(error);
+    }
+    CIS_THALLIUM_SERVER_PROFILE_END_OPS(thallium_cis_server_scatter_packed);
+    HANDLE_ERROR(req.respond(cisResponse));
+}
+
 void Fam_CIS_Thallium_Server::get_region_memory(
     const tl::request &req, Fam_CIS_Thallium_Request cisRequest) {
     Fam_CIS_Thallium_Response cisResponse;
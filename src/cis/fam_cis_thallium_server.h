@@ -167,6 +167,12 @@ class Fam_CIS_Thallium_Server : public tl::provider<Fam_CIS_Thallium_Server> {
     void gather_indexed_atomic(const tl::request &req,
                                Fam_CIS_Thallium_Request cisRequest);
 
+    void gather_packed(const tl::request &req,
+                       Fam_CIS_Thallium_Request cisRequest);
+
+    void scatter_packed(const tl::request &req,
+                        Fam_CIS_Thallium_Request cisRequest);
+
     void get_region_memory(const tl::request &req,
                            Fam_CIS_Thallium_Request cisRequest);
 
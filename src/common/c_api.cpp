@@ -33,6 +33,7 @@
 #include <iostream>
 #include <thread>
 #include <atomic>
+#include <vector>
 #include <string.h>
 #include <unistd.h>
 #include <sys/stat.h>
@@ -352,6 +353,118 @@ int c_fam_get_nonblocking(c_fam* fam_obj, void* addr, c_fam_desc* fd,
     return 0;
 }
 
+int c_fam_put_nonblocking_request(c_fam* fam_obj, void* addr, c_fam_desc* fd,
+                                  uint64_t offset, size_t size,
+                                  c_fam_request** request) {
+    fam* fam_inst = (fam*) fam_obj;
+    try {
+        fam_inst->fam_put_nonblocking(addr, (Fd*)fd, offset, size,
+                                      (openfam::Fam_Request**)request);
+    } catch (Fam_Exception &e) {
+        CAPTURE_EXCEPTION(e);
+        return -1;
+    }
+    return 0;
+}
+
+int c_fam_get_nonblocking_request(c_fam* fam_obj, void* addr, c_fam_desc* fd,
+                                  uint64_t offset, size_t size,
+                                  c_fam_request** request) {
+    fam* fam_inst = (fam*) fam_obj;
+    try {
+        fam_inst->fam_get_nonblocking(addr, (Fd*)fd, offset, size,
+                                      (openfam::Fam_Request**)request);
+    } catch (Fam_Exception &e) {
+        CAPTURE_EXCEPTION(e);
+        return -1;
+    }
+    return 0;
+}
+
+int c_fam_test(c_fam* fam_obj, c_fam_request* request) {
+    fam* fam_inst = (fam*) fam_obj;
+    try {
+        return fam_inst->fam_test((openfam::Fam_Request*)request) ? 1 : 0;
+    } catch (Fam_Exception &e) {
+        CAPTURE_EXCEPTION(e);
+        return -1;
+    }
+}
+
+int c_fam_wait(c_fam* fam_obj, c_fam_request* request) {
+    fam* fam_inst = (fam*) fam_obj;
+    try {
+        fam_inst->fam_wait((openfam::Fam_Request*)request);
+    } catch (Fam_Exception &e) {
+        CAPTURE_EXCEPTION(e);
+        return -1;
+    }
+    return 0;
+}
+
+int64_t c_fam_wait_any(c_fam* fam_obj, c_fam_request** requests,
+                       uint64_t count) {
+    fam* fam_inst = (fam*) fam_obj;
+    try {
+        return (int64_t)fam_inst->fam_wait_any(
+            (openfam::Fam_Request**)requests, count);
+    } catch (Fam_Exception &e) {
+        CAPTURE_EXCEPTION(e);
+        return -1;
+    }
+}
+
+int c_fam_wait_all(c_fam* fam_obj, c_fam_request** requests, uint64_t count) {
+    fam* fam_inst = (fam*) fam_obj;
+    try {
+        fam_inst->fam_wait_all((openfam::Fam_Request**)requests, count);
+    } catch (Fam_Exception &e) {
+        CAPTURE_EXCEPTION(e);
+        return -1;
+    }
+    return 0;
+}
+
+int c_fam_get_batch(c_fam* fam_obj, c_fam_batch_entry* entries,
+                                  uint64_t n_entries) {
+    fam* fam_inst = (fam*) fam_obj;
+    try {
+        std::vector<Fam_Batch_Entry> batch(entries ? n_entries : 0);
+        for (uint64_t i = 0; i < batch.size(); i++) {
+            batch[i].descriptor = (Fd*)entries[i].desc;
+            batch[i].offset = entries[i].offset;
+            batch[i].local = entries[i].local_addr;
+            batch[i].nbytes = entries[i].size;
+        }
+        fam_inst->fam_get_batch(batch.empty() ? NULL : batch.data(),
+                                n_entries);
+    } catch (Fam_Exception &e) {
+        CAPTURE_EXCEPTION(e);
+        return -1;
+    }
+    return 0;
+}
+
+int c_fam_put_batch(c_fam* fam_obj, c_fam_batch_entry* entries,
+                                  uint64_t n_entries) {
+    fam* fam_inst = (fam*) fam_obj;
+    try {
+        std::vector<Fam_Batch_Entry> batch(entries ? n_entries : 0);
+        for (uint64_t i = 0; i < batch.size(); i++) {
+            batch[i].descriptor = (Fd*)entries[i].desc;
+            batch[i].offset = entries[i].offset;
+            batch[i].local = entries[i].local_addr;
+            batch[i].nbytes = entries[i].size;
+        }
+        fam_inst->fam_put_batch(batch.empty() ? NULL : batch.data(),
+                                n_entries);
+    } catch (Fam_Exception &e) {
+        CAPTURE_EXCEPTION(e);
+        return -1;
+    }
+    return 0;
+}
+
 int c_fam_put_blocking(c_fam* fam_obj, void* addr, c_fam_desc* fd,
                                      uint64_t offset, size_t size) {
     fam* fam_inst = (fam*) fam_obj;
@@ -502,6 +615,65 @@ int c_fam_fence(c_fam* fam_obj) {
     return 0;
 }
 
+int c_fam_invalidate(c_fam* fam_obj, c_fam_desc* desc, uint64_t offset, uint64_t size) {
+    fam* fam_inst = (fam*) fam_obj;
+    try {
+        fam_inst->fam_invalidate((Fd*)desc, offset, size);
+    } catch (Fam_Exception &e) {
+        CAPTURE_EXCEPTION(e);
+        return -1;
+    }
+    return 0;
+}
+
+int c_fam_prefetch(c_fam* fam_obj, c_fam_desc* desc, uint64_t offset, uint64_t size) {
+    fam* fam_inst = (fam*) fam_obj;
+    try {
+        fam_inst->fam_prefetch((Fd*)desc, offset, size);
+    } catch (Fam_Exception &e) {
+        CAPTURE_EXCEPTION(e);
+        return -1;
+    }
+    return 0;
+}
+
+int c_fam_stream_open(c_fam* fam_obj, c_fam_desc* desc, uint64_t offset,
+                      uint64_t size, uint64_t chunk_size, uint64_t depth,
+                      c_fam_stream** stream) {
+    fam* fam_inst = (fam*) fam_obj;
+    try {
+        *stream = (c_fam_stream*)fam_inst->fam_stream_open(
+            (Fd*)desc, offset, size, chunk_size, depth);
+    } catch (Fam_Exception &e) {
+        CAPTURE_EXCEPTION(e);
+        return -1;
+    }
+    return 0;
+}
+
+int c_fam_stream_next(c_fam* fam_obj, c_fam_stream* stream,
+                      const void** chunk, uint64_t* size) {
+    fam* fam_inst = (fam*) fam_obj;
+    try {
+        *chunk = fam_inst->fam_stream_next((openfam::Fam_Stream*)stream, size);
+    } catch (Fam_Exception &e) {
+        CAPTURE_EXCEPTION(e);
+        return -1;
+    }
+    return 0;
+}
+
+int c_fam_stream_close(c_fam* fam_obj, c_fam_stream* stream) {
+    fam* fam_inst = (fam*) fam_obj;
+    try {
+        fam_inst->fam_stream_close((openfam::Fam_Stream*)stream);
+    } catch (Fam_Exception &e) {
+        CAPTURE_EXCEPTION(e);
+        return -1;
+    }
+    return 0;
+}
+
 int c_fam_abort(c_fam* fam_obj, int status) {
     fam* fam_inst = (fam*)fam_obj;
     try {
@@ -1621,3 +1793,44 @@ int c_fam_fetch_xor_uint64(c_fam* fam_obj, c_fam_desc* fd, uint64_t offset, uint
     return 0;
 }
 
+static void c_fam_to_atomic_batch(c_fam_atomic_batch_entry* entries,
+        std::vector<Fam_Atomic_Batch_Entry> &batch) {
+    for (uint64_t i = 0; i < batch.size(); i++) {
+        batch[i].descriptor = (Fd*)entries[i].desc;
+        batch[i].offset = entries[i].offset;
+        batch[i].op = entries[i].op;
+        batch[i].type = entries[i].type;
+        batch[i].value = entries[i].value;
+    }
+}
+
+int c_fam_atomic_batch(c_fam* fam_obj, c_fam_atomic_batch_entry* entries,
+        uint64_t n_entries) {
+    fam* fam_inst = (fam*)fam_obj;
+    try {
+        std::vector<Fam_Atomic_Batch_Entry> batch(entries ? n_entries : 0);
+        c_fam_to_atomic_batch(entries, batch);
+        fam_inst->fam_atomic_batch(batch.empty() ? NULL : batch.data(),
+                                   n_entries);
+    } catch (Fam_Exception &e) {
+        CAPTURE_EXCEPTION(e);
+        return -1;
+    }
+    return 0;
+}
+
+int c_fam_atomic_fetch_batch(c_fam* fam_obj, c_fam_atomic_batch_entry* entries,
+        uint64_t n_entries, c_fam_atomic_value* results) {
+    fam* fam_inst = (fam*)fam_obj;
+    try {
+        std::vector<Fam_Atomic_Batch_Entry> batch(entries ? n_entries : 0);
+        c_fam_to_atomic_batch(entries, batch);
+        fam_inst->fam_atomic_fetch_batch(batch.empty() ? NULL : batch.data(),
+                                         n_entries, results);
+    } catch (Fam_Exception &e) {
+        CAPTURE_EXCEPTION(e);
+        return -1;
+    }
+    return 0;
+}
+
@@ -0,0 +1,180 @@
+/*
+ * fam_addr_table.h
+ * Copyright (c) 2024 Hewlett Packard Enterprise Development, LP. All
+ * rights reserved. Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See https://spdx.org/licenses/BSD-3-Clause
+ *
+ */
+#ifndef FAM_ADDR_TABLE_H
+#define FAM_ADDR_TABLE_H
+
+#include <algorithm>
+#include <pthread.h>
+#include <sstream>
+#include <stdint.h>
+#include <vector>
+
+#include <rdma/fabric.h>
+#include <rdma/fi_domain.h>
+
+#include "common/fam_internal_exception.h"
+#include "common/fam_libfabric.h"
+#include "fam/fam_exception.h"
+
+namespace openfam {
+
+/*
+ * Fam_Addr_Table - fabric addresses of the memory servers, indexed by memory
+ * server id. The raw address of a server is recorded with set_addr() and only
+ * inserted in the address vector on the first lookup of the server, so that
+ * the AV of a PE holds the servers it actually talks to. The table grows to
+ * the largest id recorded; the slots of inserted servers are read without a
+ * lock, the lock only serializes insertion and growth.
+ */
+class Fam_Addr_Table {
+  public:
+    Fam_Addr_Table() : av(NULL), slots(NULL) {
+        (void)pthread_mutex_init(&lock, NULL);
+    }
+
+    ~Fam_Addr_Table() {
+        for (auto old : retired)
+            free_slots(old);
+        free_slots(slots);
+        (void)pthread_mutex_destroy(&lock);
+    }
+
+    // Address vector the servers are inserted into
+    void set_av(struct fid_av *fiAv) { av = fiAv; }
+
+    /*
+     * Record the raw address of server nodeId. addr must stay valid as long
+     * as the table is used.
+     */
+    void set_addr(uint64_t nodeId, const char *addr) {
+        (void)pthread_mutex_lock(&lock);
+        if (nodeId >= rawAddrs.size())
+            rawAddrs.resize(nodeId + 1, NULL);
+        rawAddrs[nodeId] = addr;
+        if (slots == NULL || nodeId >= slots->size)
+            grow(nodeId + 1);
+        (void)pthread_mutex_unlock(&lock);
+    }
+
+    // Fabric address of server nodeId, inserted in the AV on first use
+    fi_addr_t operator[](uint64_t nodeId) {
+        Fam_Addr_Slots *cur = __atomic_load_n(&slots, __ATOMIC_ACQUIRE);
+        if (cur != NULL && nodeId < cur->size) {
+            fi_addr_t fiAddr =
+                __atomic_load_n(&cur->fiAddrs[nodeId], __ATOMIC_ACQUIRE);
+            if (fiAddr != FI_ADDR_UNSPEC)
+                return fiAddr;
+        }
+        return insert(nodeId);
+    }
+
+    // Call fn(fiAddr) for each server inserted in the AV so far
+    template <typename Fn> void for_each_inserted(Fn fn) {
+        Fam_Addr_Slots *cur = __atomic_load_n(&slots, __ATOMIC_ACQUIRE);
+        if (cur == NULL)
+            return;
+        for (uint64_t i = 0; i < cur->size; i++) {
+            fi_addr_t fiAddr =
+                __atomic_load_n(&cur->fiAddrs[i], __ATOMIC_ACQUIRE);
+            if (fiAddr != FI_ADDR_UNSPEC)
+                fn(fiAddr);
+        }
+    }
+
+  private:
+    struct Fam_Addr_Slots {
+        uint64_t size;
+        fi_addr_t *fiAddrs;
+    };
+
+    static void free_slots(Fam_Addr_Slots *old) {
+        if (old == NULL)
+            return;
+        delete[] old->fiAddrs;
+        delete old;
+    }
+
+    // Replace the slots by a larger copy; readers may still hold the old
+    // ones, which are kept until the table is destroyed. Called with lock.
+    void grow(uint64_t minSize) {
+        uint64_t size = (slots == NULL) ? 0 : slots->size;
+        uint64_t newSize = std::max(minSize, size * 2);
+        Fam_Addr_Slots *bigger = new Fam_Addr_Slots();
+        bigger->size = newSize;
+        bigger->fiAddrs = new fi_addr_t[newSize];
+        for (uint64_t i = 0; i < size; i++)
+            bigger->fiAddrs[i] = slots->fiAddrs[i];
+        for (uint64_t i = size; i < newSize; i++)
+            bigger->fiAddrs[i] = FI_ADDR_UNSPEC;
+        if (slots != NULL)
+            retired.push_back(slots);
+        __atomic_store_n(&slots, bigger, __ATOMIC_RELEASE);
+    }
+
+    fi_addr_t insert(uint64_t nodeId) {
+        std::ostringstream message;
+        (void)pthread_mutex_lock(&lock);
+        // Another thread may have inserted the server meanwhile
+        if (slots != NULL && nodeId < slots->size &&
+            slots->fiAddrs[nodeId] != FI_ADDR_UNSPEC) {
+            fi_addr_t fiAddr = slots->fiAddrs[nodeId];
+            (void)pthread_mutex_unlock(&lock);
+            return fiAddr;
+        }
+        if (nodeId >= rawAddrs.size() || rawAddrs[nodeId] == NULL) {
+            (void)pthread_mutex_unlock(&lock);
+            message << "Fam libfabric: no address for memory server " << nodeId;
+            THROW_ERR_MSG(Fam_Datapath_Exception, message.str().c_str());
+        }
+        std::vector<fi_addr_t> tmpAddrV;
+        int ret = fabric_insert_av(rawAddrs[nodeId], av, &tmpAddrV);
+        if (ret < 0) {
+            (void)pthread_mutex_unlock(&lock);
+            message << "Fam libfabric fabric_insert_av failed: "
+                    << fabric_strerror(ret);
+            THROW_ERR_MSG(Fam_Datapath_Exception, message.str().c_str());
+        }
+        __atomic_store_n(&slots->fiAddrs[nodeId], tmpAddrV[0],
+                         __ATOMIC_RELEASE);
+        (void)pthread_mutex_unlock(&lock);
+        return tmpAddrV[0];
+    }
+
+    struct fid_av *av;
+    Fam_Addr_Slots *slots;
+    std::vector<Fam_Addr_Slots *> retired;
+    // Raw address of each server, protected by lock
+    std::vector<const char *> rawAddrs;
+    pthread_mutex_t lock;
+};
+
+} // namespace openfam
+#endif
@@ -408,11 +408,12 @@ class Fam_Async_QHandler::FamAsyncQHandlerImpl_ {
                     (index == (int)destStartServerIdx) ? destDisplacement : 0;
                 std::future<void> result(std::async(
                     std::launch::async, &openfam::Fam_Memory_Service::copy,
-                    memoryService, tag->srcRegionId, tag->srcOffsets,
+                    memoryService, tag->srcRegionId, tag->srcOffsets.data(),
                     tag->srcUsedMemsrvCnt, tag->srcCopyStart, srcCopyEnd,
-                    tag->srcKeys, tag->srcBaseAddrList, tag->destRegionId,
+                    tag->srcKeys.data(), tag->srcBaseAddrList.data(),
+                    tag->destRegionId,
                     tag->destOffsets[index] + destFamPtr + additionalOffset,
-                    tag->destUsedMemsrvCnt, tag->srcMemserverIds,
+                    tag->destUsedMemsrvCnt, tag->srcMemserverIds.data(),
                     tag->srcInterleaveSize, tag->destInterleaveSize,
                     tag->size));
                 resultList.push_back(result.share());
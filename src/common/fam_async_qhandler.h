@@ -35,6 +35,7 @@
 #include <nvmm/fam.h>
 
 #include <boost/atomic.hpp>
+#include <vector>
 
 #include "common/fam_context.h"
 #include "common/fam_internal.h"
@@ -78,15 +79,15 @@ typedef struct {
     memoryServerMap *memoryServiceMap;
     uint64_t srcRegionId;
     uint64_t destRegionId;
-    uint64_t srcOffsets[MAX_MEMORY_SERVERS_CNT];
-    uint64_t destOffsets[MAX_MEMORY_SERVERS_CNT];
+    std::vector<uint64_t> srcOffsets;
+    std::vector<uint64_t> destOffsets;
     uint64_t size;
-    uint64_t srcKeys[MAX_MEMORY_SERVERS_CNT];
+    std::vector<uint64_t> srcKeys;
     uint64_t srcCopyStart;
     uint64_t destCopyStart;
-    uint64_t srcBaseAddrList[MAX_MEMORY_SERVERS_CNT];
-    uint64_t srcMemserverIds[MAX_MEMORY_SERVERS_CNT];
-    uint64_t destMemserverIds[MAX_MEMORY_SERVERS_CNT];
+    std::vector<uint64_t> srcBaseAddrList;
+    std::vector<uint64_t> srcMemserverIds;
+    std::vector<uint64_t> destMemserverIds;
     uint64_t srcInterleaveSize;
     uint64_t destInterleaveSize;
     uint64_t srcUsedMemsrvCnt;
@@ -98,8 +99,8 @@ typedef struct {
     boost::atomic<bool> backupDone;
     memoryServerMap *memoryServiceMap;
     uint64_t srcRegionId;
-    uint64_t srcOffsets[MAX_MEMORY_SERVERS_CNT];
-    uint64_t srcMemserverIds[MAX_MEMORY_SERVERS_CNT];
+    std::vector<uint64_t> srcOffsets;
+    std::vector<uint64_t> srcMemserverIds;
     uint64_t usedMemserverCnt;
     uint64_t srcInterleaveSize;
     uint64_t srcItemSize;
@@ -118,8 +119,8 @@ typedef struct {
     boost::atomic<bool> restoreDone;
     memoryServerMap *memoryServiceMap;
     uint64_t destRegionId;
-    uint64_t destOffsets[MAX_MEMORY_SERVERS_CNT];
-    uint64_t destMemserverIds[MAX_MEMORY_SERVERS_CNT];
+    std::vector<uint64_t> destOffsets;
+    std::vector<uint64_t> destMemserverIds;
     uint64_t usedMemserverCnt;
     uint64_t destInterleaveSize;
     uint64_t destItemSize;
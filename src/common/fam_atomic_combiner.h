@@ -0,0 +1,221 @@
+/*
+ * fam_atomic_combiner.h
+ * Copyright (c) 2024 Hewlett Packard Enterprise Development, LP. All
+ * rights reserved. Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See https://spdx.org/licenses/BSD-3-Clause
+ *
+ */
+#ifndef FAM_ATOMIC_COMBINER_H
+#define FAM_ATOMIC_COMBINER_H
+
+#include <algorithm>
+#include <chrono>
+#include <pthread.h>
+#include <stdint.h>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "fam/fam.h"
+
+namespace openfam {
+
+/*
+ * Fam_Atomic_Combiner - table of pending non-fetching atomics of one thread.
+ * Updates to the same (descriptor, offset) with the same operation and type
+ * are merged into a single pending atomic, which is issued when the table is
+ * drained. The table asks to be drained once it holds maxEntries atomics or
+ * its oldest atomic is older than flushUsec microseconds (0 disables the
+ * time limit).
+ *
+ * The table is owned by one thread, but is locked so that the owner of the
+ * combiners can drain it on behalf of a thread that has gone away.
+ */
+class Fam_Atomic_Combiner {
+  public:
+    Fam_Atomic_Combiner(uint64_t maxEntries, uint64_t flushUsec)
+        : maxEntries(maxEntries), flushUsec(flushUsec) {
+        (void)pthread_mutex_init(&lock, NULL);
+    }
+
+    ~Fam_Atomic_Combiner() { (void)pthread_mutex_destroy(&lock); }
+
+    void acquire_lock() { pthread_mutex_lock(&lock); }
+
+    void release_lock() { pthread_mutex_unlock(&lock); }
+
+    /*
+     * Merge an atomic into the table. Must be called with the lock held.
+     * @return - false if an atomic with a different operation or type is
+     * pending at the same location, in which case the table must be drained
+     * before the atomic can be added.
+     */
+    bool combine(Fam_Descriptor *descriptor, uint64_t offset,
+                 Fam_Atomic_Op op, Fam_Atomic_Type type,
+                 Fam_Atomic_Value value) {
+        Combiner_Key key(descriptor, offset);
+        auto it = index.find(key);
+        if (it == index.end()) {
+            if (pending.empty())
+                oldest = std::chrono::steady_clock::now();
+            Fam_Atomic_Batch_Entry entry;
+            entry.descriptor = descriptor;
+            entry.offset = offset;
+            entry.op = op;
+            entry.type = type;
+            entry.value = value;
+            index[key] = pending.size();
+            pending.push_back(entry);
+            return true;
+        }
+        Fam_Atomic_Batch_Entry *entry = &pending[it->second];
+        if (entry->op != op || entry->type != type)
+            return false;
+        merge(entry, value);
+        numCombined++;
+        return true;
+    }
+
+    /*
+     * Check if the table has reached its size or age limit. Must be called
+     * with the lock held.
+     */
+    bool needs_flush() {
+        if (pending.size() >= maxEntries)
+            return true;
+        if (flushUsec == 0 || pending.empty())
+            return false;
+        return (std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - oldest)
+                    .count() >= (int64_t)flushUsec);
+    }
+
+    bool empty() { return pending.empty(); }
+
+    /*
+     * Move all the pending atomics to out and empty the table. Must be called
+     * with the lock held.
+     */
+    void drain(std::vector<Fam_Atomic_Batch_Entry> &out) {
+        out.swap(pending);
+        pending.clear();
+        index.clear();
+    }
+
+    /*
+     * Move the pending atomics of descriptor to out, keeping the others.
+     * Must be called with the lock held.
+     */
+    void drain(Fam_Descriptor *descriptor,
+               std::vector<Fam_Atomic_Batch_Entry> &out) {
+        std::vector<Fam_Atomic_Batch_Entry> kept;
+        index.clear();
+        for (auto &entry : pending) {
+            if (entry.descriptor == descriptor) {
+                out.push_back(entry);
+            } else {
+                index[Combiner_Key(entry.descriptor, entry.offset)] =
+                    kept.size();
+                kept.push_back(entry);
+            }
+        }
+        pending.swap(kept);
+    }
+
+    // Number of atomics absorbed into an already pending atomic
+    uint64_t get_num_combined() { return numCombined; }
+
+  private:
+    typedef std::pair<Fam_Descriptor *, uint64_t> Combiner_Key;
+
+    struct Combiner_Key_Hash {
+        size_t operator()(const Combiner_Key &key) const {
+            return std::hash<uint64_t>()((uint64_t)key.first ^
+                                         (key.second * 0x9e3779b97f4a7c15ULL));
+        }
+    };
+
+    void merge(Fam_Atomic_Batch_Entry *entry, Fam_Atomic_Value value) {
+        Fam_Atomic_Value *v = &entry->value;
+        switch (entry->type) {
+        case FAM_ATOMIC_INT32:
+            v->int32Value = merge_value(entry->op, v->int32Value,
+                                        value.int32Value);
+            break;
+        case FAM_ATOMIC_INT64:
+            v->int64Value = merge_value(entry->op, v->int64Value,
+                                        value.int64Value);
+            break;
+        case FAM_ATOMIC_UINT32:
+            v->uint32Value = merge_bits(entry->op, v->uint32Value,
+                                        value.uint32Value);
+            break;
+        case FAM_ATOMIC_UINT64:
+            v->uint64Value = merge_bits(entry->op, v->uint64Value,
+                                        value.uint64Value);
+            break;
+        case FAM_ATOMIC_FLOAT:
+            v->floatValue = merge_value(entry->op, v->floatValue,
+                                        value.floatValue);
+            break;
+        case FAM_ATOMIC_DOUBLE:
+            v->doubleValue = merge_value(entry->op, v->doubleValue,
+                                         value.doubleValue);
+            break;
+        }
+    }
+
+    // Merge two operands of an arithmetic atomic
+    template <typename T> static T merge_value(Fam_Atomic_Op op, T a, T b) {
+        if (op == FAM_ATOMIC_MIN)
+            return std::min(a, b);
+        if (op == FAM_ATOMIC_MAX)
+            return std::max(a, b);
+        return (T)(a + b);
+    }
+
+    // Merge two operands of an atomic on an unsigned type
+    template <typename T> static T merge_bits(Fam_Atomic_Op op, T a, T b) {
+        if (op == FAM_ATOMIC_AND)
+            return (T)(a & b);
+        if (op == FAM_ATOMIC_OR)
+            return (T)(a | b);
+        if (op == FAM_ATOMIC_XOR)
+            return (T)(a ^ b);
+        return merge_value(op, a, b);
+    }
+
+    uint64_t maxEntries;
+    uint64_t flushUsec;
+    uint64_t numCombined = 0;
+    pthread_mutex_t lock;
+    std::chrono::steady_clock::time_point oldest;
+    std::vector<Fam_Atomic_Batch_Entry> pending;
+    std::unordered_map<Combiner_Key, size_t, Combiner_Key_Hash> index;
+};
+
+} // namespace openfam
+#endif
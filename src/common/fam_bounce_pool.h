@@ -0,0 +1,141 @@
+/*
+ * fam_bounce_pool.h
+ * Copyright (c) 2024 Hewlett Packard Enterprise Development, LP. All
+ * rights reserved. Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See https://spdx.org/licenses/BSD-3-Clause
+ *
+ */
+#ifndef FAM_BOUNCE_POOL_H
+#define FAM_BOUNCE_POOL_H
+
+#include <new>
+#include <stdint.h>
+#include <stdlib.h>
+#include <vector>
+
+#include "common/fam_free_list.h"
+
+namespace openfam {
+
+/*
+ * Buffer of a Fam_Bounce_Pool. Objects handed out by a free list once its
+ * slab is exhausted are heap allocated with buf NULL, which marks the
+ * class as exhausted.
+ */
+struct Fam_Bounce_Buffer {
+    char *buf;
+    uint32_t sizeClass;
+};
+
+/*
+ * Fam_Bounce_Pool - bounce buffers in size classes growing by a factor of
+ * four from FAM_BOUNCE_MIN_SIZE, carved from a single page aligned block
+ * that the owner registers once. Every buffer starts on a cache line.
+ */
+class Fam_Bounce_Pool {
+  public:
+    static const size_t FAM_BOUNCE_MIN_SIZE = 64;
+
+    Fam_Bounce_Pool(size_t maxSize, uint32_t count) : inUse(0) {
+        size_t size = FAM_BOUNCE_MIN_SIZE;
+        do {
+            classSizes.push_back(size);
+            size *= 4;
+        } while (classSizes.back() < maxSize);
+
+        len = 0;
+        for (auto classSize : classSizes)
+            len += classSize * count;
+        if (posix_memalign((void **)&base, 4096, len) != 0)
+            throw std::bad_alloc();
+
+        char *buf = base;
+        for (uint32_t c = 0; c < (uint32_t)classSizes.size(); c++) {
+            Fam_Free_List<Fam_Bounce_Buffer> *list =
+                new Fam_Free_List<Fam_Bounce_Buffer>(count);
+            // Hand every slab object out once to attach its buffer
+            std::vector<Fam_Bounce_Buffer *> all;
+            for (uint32_t i = 0; i < count; i++) {
+                Fam_Bounce_Buffer *bb = list->alloc();
+                bb->buf = buf;
+                bb->sizeClass = c;
+                buf += classSizes[c];
+                all.push_back(bb);
+            }
+            for (auto bb : all)
+                list->free(bb);
+            freeLists.push_back(list);
+        }
+    }
+
+    ~Fam_Bounce_Pool() {
+        for (auto list : freeLists)
+            delete list;
+        free(base);
+    }
+
+    char *get_base() { return base; }
+
+    size_t get_len() { return len; }
+
+    size_t get_max_size() { return classSizes.back(); }
+
+    /*
+     * Get a buffer of at least nbytes from the smallest class that fits and
+     * is not exhausted; NULL if there is none.
+     */
+    Fam_Bounce_Buffer *alloc(size_t nbytes) {
+        for (uint32_t c = 0; c < (uint32_t)classSizes.size(); c++) {
+            if (classSizes[c] < nbytes)
+                continue;
+            Fam_Bounce_Buffer *bb = freeLists[c]->alloc();
+            if (bb->buf != NULL) {
+                __sync_fetch_and_add(&inUse, (uint64_t)1);
+                return bb;
+            }
+            freeLists[c]->free(bb);
+        }
+        return NULL;
+    }
+
+    void free_buffer(Fam_Bounce_Buffer *bb) {
+        __sync_fetch_and_sub(&inUse, (uint64_t)1);
+        freeLists[bb->sizeClass]->free(bb);
+    }
+
+    // Number of buffers currently handed out
+    uint64_t get_in_use() { return inUse; }
+
+  private:
+    std::vector<size_t> classSizes;
+    std::vector<Fam_Free_List<Fam_Bounce_Buffer> *> freeLists;
+    char *base;
+    size_t len;
+    uint64_t inUse;
+};
+
+} // namespace openfam
+#endif
@@ -48,6 +48,14 @@ Fam_Context::Fam_Context(Fam_Thread_Model famTM)
     : numTxOps(0), numRxOps(0), isNVMM(true) {
     numLastRxFailCnt = 0;
     numLastTxFailCnt = 0;
+    set_poll_mode(FAM_POLL_BUSY, FAM_DEFAULT_POLL_SPIN_COUNT,
+                  FAM_DEFAULT_POLL_MAX_SLEEP_USEC);
+    cqWaitObj = false;
+    maxMsgSize = SIZE_MAX;
+    fiCtxList =
+        new Fam_Free_List<struct fam_fi_context>(FAM_FI_CONTEXT_POOL_SIZE);
+    errEntryList =
+        new Fam_Free_List<struct fi_cq_err_entry>(FAM_ERR_ENTRY_POOL_SIZE);
     // Initialize ctxRWLock
     famThreadModel = famTM;
     if (famThreadModel == FAM_THREAD_MULTIPLE)
@@ -55,12 +63,22 @@ Fam_Context::Fam_Context(Fam_Thread_Model famTM)
 }
 
 Fam_Context::Fam_Context(struct fi_info *fi, struct fid_domain *domain,
-                         Fam_Thread_Model famTM) {
+                         Fam_Thread_Model famTM, struct fid_stx *stx,
+                         struct fid_ep *srx) {
     std::ostringstream message;
     numTxOps = numRxOps = 0;
     isNVMM = false;
     numLastRxFailCnt = 0;
     numLastTxFailCnt = 0;
+    set_poll_mode(FAM_POLL_BUSY, FAM_DEFAULT_POLL_SPIN_COUNT,
+                  FAM_DEFAULT_POLL_MAX_SLEEP_USEC);
+    cqWaitObj = false;
+    maxMsgSize = (fi->ep_attr->max_msg_size > 0 ? fi->ep_attr->max_msg_size
+                                                 : SIZE_MAX);
+    fiCtxList =
+        new Fam_Free_List<struct fam_fi_context>(FAM_FI_CONTEXT_POOL_SIZE);
+    errEntryList =
+        new Fam_Free_List<struct fi_cq_err_entry>(FAM_ERR_ENTRY_POOL_SIZE);
 
     fi->caps = FI_RMA | FI_WRITE | FI_READ | FI_ATOMIC | FI_REMOTE_WRITE |
                FI_REMOTE_READ;
@@ -74,17 +92,53 @@ Fam_Context::Fam_Context(struct fi_info *fi, struct fid_domain *domain,
     if (famThreadModel == FAM_THREAD_MULTIPLE)
         pthread_rwlock_init(&ctxRWLock, NULL);
 
-    int ret = fi_endpoint(domain, fi, &ep, NULL);
+    // fi is shared by all the endpoints of the domain, which other threads
+    // may be opening: an endpoint using shared contexts is opened from a
+    // private copy
+    struct fi_info *epFi = fi;
+    if (stx != NULL || srx != NULL) {
+        epFi = fi_dupinfo(fi);
+        if (epFi == NULL) {
+            message << "Fam libfabric fi_dupinfo failed";
+            THROW_ERR_MSG(Fam_Datapath_Exception, message.str().c_str());
+        }
+        if (stx != NULL)
+            epFi->ep_attr->tx_ctx_cnt = FI_SHARED_CONTEXT;
+        if (srx != NULL)
+            epFi->ep_attr->rx_ctx_cnt = FI_SHARED_CONTEXT;
+    }
+    int ret = fi_endpoint(domain, epFi, &ep, NULL);
+    if (epFi != fi)
+        fi_freeinfo(epFi);
     if (ret < 0) {
         message << "Fam libfabric fi_endpoint failed: " << fabric_strerror(ret);
         THROW_ERR_MSG(Fam_Datapath_Exception, message.str().c_str());
     }
 
+    if (stx != NULL) {
+        ret = fi_ep_bind(ep, &stx->fid, 0);
+        if (ret < 0) {
+            message << "Fam libfabric fi_ep_bind failed: "
+                    << fabric_strerror(ret);
+            THROW_ERR_MSG(Fam_Datapath_Exception, message.str().c_str());
+        }
+    }
+
+    if (srx != NULL) {
+        ret = fi_ep_bind(ep, &srx->fid, 0);
+        if (ret < 0) {
+            message << "Fam libfabric fi_ep_bind failed: "
+                    << fabric_strerror(ret);
+            THROW_ERR_MSG(Fam_Datapath_Exception, message.str().c_str());
+        }
+    }
+
     struct fi_cq_attr cq_attr;
     memset(&cq_attr, 0, sizeof(cq_attr));
     cq_attr.format = FI_CQ_FORMAT_DATA;
     if((strncmp(fi->fabric_attr->prov_name, "cxi", 3) != 0)) {
     	cq_attr.wait_obj = FI_WAIT_UNSPEC;
+        cqWaitObj = true;
     }
     cq_attr.wait_cond = FI_CQ_COND_NONE;
 
@@ -147,12 +201,18 @@ Fam_Context::~Fam_Context() {
         free(mr_descs);
         if (mr != NULL)
             fi_close(&mr->fid);
+        free(bounceDescs);
+        if (bounceMr != NULL)
+            fi_close(&bounceMr->fid);
+        delete bouncePool;
         fi_close(&ep->fid);
         fi_close(&txcq->fid);
         fi_close(&rxcq->fid);
         fi_close(&txCntr->fid);
         fi_close(&rxCntr->fid);
     }
+    delete fiCtxList;
+    delete errEntryList;
     pthread_rwlock_destroy(&ctxRWLock);
 }
 
@@ -201,4 +261,44 @@ void Fam_Context::register_heap(void *base, size_t len,
         mr_descs[i] = fi_mr_desc(mr);
 }
 
+void Fam_Context::unregister_heap() {
+    free(mr_descs);
+    mr_descs = NULL;
+    if (mr != NULL)
+        fi_close(&mr->fid);
+    mr = NULL;
+    local_buf_base = NULL;
+    local_buf_size = 0;
+}
+
+void Fam_Context::init_bounce_pool(struct fid_domain *domain,
+                                   size_t iov_limit, size_t maxSize,
+                                   uint32_t count) {
+    std::ostringstream message;
+    int ret;
+
+    if (bouncePool != NULL) {
+        message << "Fam_Context init_bounce_pool() called more than once";
+        THROW_ERR_MSG(Fam_Datapath_Exception, message.str().c_str());
+    }
+    Fam_Bounce_Pool *pool = new Fam_Bounce_Pool(maxSize, count);
+    ret = fi_mr_reg(domain, pool->get_base(), pool->get_len(),
+                    FI_READ | FI_WRITE, 0, fabric_alloc_mr_key(), 0,
+                    &bounceMr, 0);
+    if (ret < 0) {
+        delete pool;
+        bounceMr = NULL;
+        message << "Fam libfabric fi_mr_reg failed: " << fabric_strerror(ret);
+        THROW_ERR_MSG(Fam_Datapath_Exception, message.str().c_str());
+    }
+    bounceDescs = (void **)calloc(iov_limit, sizeof(*bounceDescs));
+    if (!bounceDescs) {
+        message << "Fam_Context init_bounce_pool() failed to allocate memory";
+        THROW_ERR_MSG(Fam_Datapath_Exception, message.str().c_str());
+    }
+    for (size_t i = 0; i < iov_limit; i++)
+        bounceDescs[i] = fi_mr_desc(bounceMr);
+    bouncePool = pool;
+}
+
 } // namespace openfam
@@ -39,21 +39,36 @@
 #include <rdma/fabric.h>
 #include <rdma/fi_domain.h>
 #include <rdma/fi_endpoint.h>
+#include <rdma/fi_eq.h>
 
+#include "common/fam_bounce_pool.h"
+#include "common/fam_free_list.h"
 #include "common/fam_internal.h"
 #include "common/fam_internal_exception.h"
+#include "common/fam_mr_cache.h"
 #include "common/fam_options.h"
 
 using namespace std;
 
 namespace openfam {
 
+struct fam_fi_context {
+    struct fi_context2;
+    void *fam_internal[8];
+};
+
 class Fam_Context {
   public:
     Fam_Context(Fam_Thread_Model famTM);
 
+    /*
+     * When stx or srx is given, the endpoint transmits or receives through
+     * that shared context of the domain instead of its own; its completion
+     * queues and counters stay private to this Fam_Context.
+     */
     Fam_Context(struct fi_info *fi, struct fid_domain *domain,
-                Fam_Thread_Model famTM);
+                Fam_Thread_Model famTM, struct fid_stx *stx = NULL,
+                struct fid_ep *srx = NULL);
 
     ~Fam_Context();
 
@@ -119,16 +134,101 @@ class Fam_Context {
     void inc_num_rx_fail_cnt(uint64_t cnt) {
         __sync_fetch_and_add(&numLastRxFailCnt, cnt);
     }
+    /*
+     * Get a zeroed fam_fi_context from the per-context free list and set its
+     * expected completion count to reqCnt.
+     */
+    struct fam_fi_context *alloc_fi_context(uint64_t reqCnt) {
+        struct fam_fi_context *ctx = fiCtxList->alloc();
+        memset(ctx, 0, sizeof(struct fam_fi_context));
+        ctx->fam_internal[2] = (void *)reqCnt;
+        return ctx;
+    }
+
+    /*
+     * Return a fam_fi_context, and the error entry attached to it if any, to
+     * the per-context free lists.
+     */
+    void free_fi_context(struct fi_context *fiCtx) {
+        if (fiCtx == NULL)
+            return;
+        struct fam_fi_context *ctx = (struct fam_fi_context *)fiCtx;
+        if (ctx->fam_internal[3] != NULL)
+            free_err_entry((struct fi_cq_err_entry *)ctx->fam_internal[3]);
+        fiCtxList->free(ctx);
+    }
+
+    struct fi_cq_err_entry *alloc_err_entry() {
+        return errEntryList->alloc();
+    }
+
+    void free_err_entry(struct fi_cq_err_entry *errEntry) {
+        errEntryList->free(errEntry);
+    }
+
+    uint64_t get_num_fi_context_heap_allocs() {
+        return fiCtxList->get_num_heap_allocs() +
+               errEntryList->get_num_heap_allocs();
+    }
+
+    /*
+     * Set how completion waits on this context poll once they have spun
+     * spinCount times without finding a completion.
+     */
+    void set_poll_mode(Fam_Poll_Mode mode, uint64_t spinCount,
+                       uint64_t maxSleepUsec) {
+        pollMode = mode;
+        pollSpinCount = spinCount;
+        pollMaxSleepUsec = maxSleepUsec;
+    }
+
+    Fam_Poll_Mode get_poll_mode() { return pollMode; }
+
+    uint64_t get_poll_spin_count() { return pollSpinCount; }
+
+    uint64_t get_poll_max_sleep_usec() { return pollMaxSleepUsec; }
+
+    // false if the CQs were opened without a wait object
+    bool has_cq_wait_obj() { return cqWaitObj; }
+
+    // largest message the endpoint accepts
+    size_t get_max_msg_size() { return maxMsgSize; }
+
     void register_heap(void *base, size_t len, struct fid_domain *domain,
                        size_t iov_limit);
+
+    /*
+     * Drop the registration of register_heap(), so that the context can be
+     * handed to a new owner
+     */
+    void unregister_heap();
+
+    /*
+     * Create and register the pool of bounce buffers used by small
+     * transfers from unregistered memory.
+     */
+    void init_bounce_pool(struct fid_domain *domain, size_t iov_limit,
+                          size_t maxSize, uint32_t count);
+
+    Fam_Bounce_Pool *get_bounce_pool() { return bouncePool; }
+
     void **get_mr_descs(const void *local_addr, size_t local_size) {
         if (local_buf_size != 0 &&
             (char *)local_addr >= (char *)local_buf_base &&
             (char *)local_addr + local_size <=
                 (char *)local_buf_base + local_buf_size)
             return mr_descs;
-        else
-            return 0;
+        if (bouncePool != NULL &&
+            (char *)local_addr >= bouncePool->get_base() &&
+            (char *)local_addr + local_size <=
+                bouncePool->get_base() + bouncePool->get_len())
+            return bounceDescs;
+        // Registration held from the MR cache by the transfer being issued
+        Fam_Mr_Cache_Entry *pinned = Fam_Mr_Cache::get_thread_pin();
+        if (pinned != NULL && (uintptr_t)local_addr >= pinned->start &&
+            (uintptr_t)local_addr + local_size <= pinned->end)
+            return pinned->descs;
+        return 0;
     }
 
   private:
@@ -141,6 +241,9 @@ class Fam_Context {
     void *local_buf_base = NULL;
     size_t local_buf_size = 0;
     struct fid_mr *mr = NULL;
+    Fam_Bounce_Pool *bouncePool = NULL;
+    void **bounceDescs = NULL;
+    struct fid_mr *bounceMr = NULL;
 
     uint64_t numTxOps;
     uint64_t numRxOps;
@@ -149,6 +252,13 @@ class Fam_Context {
     uint64_t numLastRxFailCnt;
     Fam_Thread_Model famThreadModel;
     pthread_rwlock_t ctxRWLock;
+    Fam_Free_List<struct fam_fi_context> *fiCtxList;
+    Fam_Free_List<struct fi_cq_err_entry> *errEntryList;
+    Fam_Poll_Mode pollMode;
+    uint64_t pollSpinCount;
+    uint64_t pollMaxSleepUsec;
+    bool cqWaitObj;
+    size_t maxMsgSize;
 };
 
 } // namespace openfam
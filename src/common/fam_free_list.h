@@ -0,0 +1,123 @@
+/*
+ * fam_free_list.h
+ * Copyright (c) 2024 Hewlett Packard Enterprise Development, LP. All
+ * rights reserved. Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See https://spdx.org/licenses/BSD-3-Clause
+ *
+ */
+#ifndef FAM_FREE_LIST_H
+#define FAM_FREE_LIST_H
+
+#include <stdint.h>
+#include <stdlib.h>
+
+namespace openfam {
+
+/*
+ * Fam_Free_List - fixed size slab of objects of type T handed out through a
+ * lock-free free list (Treiber stack). The head of the list packs the index
+ * of the first free slot in the lower 32 bits and a modification tag in the
+ * upper 32 bits, so that a pop racing with a pop/push of the same slot
+ * fails its compare-and-swap instead of corrupting the list (ABA).
+ * When the slab is exhausted, objects are allocated from the heap and are
+ * returned to the heap on free.
+ */
+template <typename T> class Fam_Free_List {
+  public:
+    Fam_Free_List(uint32_t count) : slabCnt(count), numHeapAllocs(0) {
+        slab = new T[slabCnt];
+        next = new uint32_t[slabCnt];
+        for (uint32_t i = 0; i < slabCnt; i++)
+            next[i] = i + 1;
+        head = (slabCnt > 0 ? 0 : FREE_LIST_EMPTY);
+        if (slabCnt > 0)
+            next[slabCnt - 1] = FREE_LIST_EMPTY;
+    }
+
+    ~Fam_Free_List() {
+        delete[] slab;
+        delete[] next;
+    }
+
+    /*
+     * Get an object from the free list. Contents of the object are not
+     * initialized.
+     */
+    T *alloc() {
+        uint64_t oldHead, newHead;
+        uint32_t idx;
+        do {
+            oldHead = __atomic_load_n(&head, __ATOMIC_ACQUIRE);
+            idx = (uint32_t)oldHead;
+            if (idx == FREE_LIST_EMPTY) {
+                __sync_fetch_and_add(&numHeapAllocs, (uint64_t)1);
+                return new T();
+            }
+            newHead = next_tag(oldHead) |
+                      __atomic_load_n(&next[idx], __ATOMIC_RELAXED);
+        } while (!__sync_bool_compare_and_swap(&head, oldHead, newHead));
+        return &slab[idx];
+    }
+
+    /*
+     * Return an object obtained from alloc() to the free list.
+     */
+    void free(T *obj) {
+        if (obj < slab || obj >= slab + slabCnt) {
+            delete obj;
+            return;
+        }
+        uint32_t idx = (uint32_t)(obj - slab);
+        uint64_t oldHead, newHead;
+        do {
+            oldHead = __atomic_load_n(&head, __ATOMIC_ACQUIRE);
+            __atomic_store_n(&next[idx], (uint32_t)oldHead, __ATOMIC_RELAXED);
+            newHead = next_tag(oldHead) | idx;
+        } while (!__sync_bool_compare_and_swap(&head, oldHead, newHead));
+    }
+
+    /*
+     * Number of objects which had to be allocated from the heap because the
+     * slab was exhausted.
+     */
+    uint64_t get_num_heap_allocs() { return numHeapAllocs; }
+
+  private:
+    static const uint32_t FREE_LIST_EMPTY = UINT32_MAX;
+
+    static uint64_t next_tag(uint64_t oldHead) {
+        return ((oldHead >> 32) + 1) << 32;
+    }
+
+    T *slab;
+    uint32_t *next;
+    uint32_t slabCnt;
+    uint64_t head;
+    uint64_t numHeapAllocs;
+};
+
+} // namespace openfam
+#endif
@@ -164,6 +164,105 @@ namespace openfam {
 #define FAM_DEFAULT_CTX_ID (uint64_t(0))
 #define FAM_CTX_ID_UNINITIALIZED ((uint64_t)-1)
 
+/*
+ * Default number of chunks of a blocking get/put kept outstanding on the
+ * fabric before waiting for the oldest one to complete. 0 means unlimited.
+ */
+#define FAM_DEFAULT_IO_PIPELINE_DEPTH 16
+
+/*
+ * Default striping of large blocking gets and puts: number of endpoints a
+ * transfer is spread over (1 disables striping), and smallest transfer that
+ * is striped.
+ */
+#define FAM_DEFAULT_IO_STRIPE_COUNT 1
+#define FAM_DEFAULT_IO_STRIPE_MIN_SIZE (4ULL << 20)
+
+/*
+ * Default limits of the per-thread table used to combine non-fetching
+ * atomics: number of pending atomics, and age in microseconds of the oldest
+ * one, that trigger a flush.
+ */
+#define FAM_DEFAULT_ATOMIC_COMBINE_MAX_ENTRIES 1024
+#define FAM_DEFAULT_ATOMIC_COMBINE_FLUSH_USEC 1000
+
+/*
+ * Number of fam_fi_context objects and completion error entries preallocated
+ * in the free lists of each Fam_Context.
+ */
+#define FAM_FI_CONTEXT_POOL_SIZE 256
+#define FAM_ERR_ENTRY_POOL_SIZE 16
+
+/*
+ * Defaults of the completion polling of a Fam_Context: number of empty polls
+ * spent spinning before the poll mode takes effect, number of sched_yield
+ * polls of the backoff mode before it starts sleeping, and the longest
+ * backoff sleep in microseconds.
+ */
+#define FAM_DEFAULT_POLL_SPIN_COUNT 4096
+#define FAM_POLL_YIELD_COUNT 64
+#define FAM_DEFAULT_POLL_MAX_SLEEP_USEC 1000
+
+/*
+ * Defaults of the memory server packing of blocking gathers and scatters:
+ * fewest elements and largest element size of a call that is offloaded.
+ * Below these, per-element RDMA from the client is cheaper than the extra
+ * RPC and registration.
+ */
+#define FAM_DEFAULT_SG_OFFLOAD_MIN_ELEMENTS 1024
+#define FAM_DEFAULT_SG_OFFLOAD_MAX_ELEMENT_SIZE 64
+
+/*
+ * Largest element index, in bytes, sent with an offloaded gather or scatter.
+ * Kept below the 4 MB default message limit of gRPC, leaving room for the
+ * rest of the request; larger index lists use the client path.
+ */
+#define FAM_SG_OFFLOAD_MAX_INDEX_SIZE (3 * 1024 * 1024)
+
+/*
+ * Defaults of the registration cache of user buffers: most registrations
+ * and bytes kept registered, and the smallest blocking get/put whose buffer
+ * is registered; smaller transfers are cheaper to copy than to register.
+ */
+#define FAM_DEFAULT_MR_CACHE_MAX_ENTRIES 256
+#define FAM_DEFAULT_MR_CACHE_MAX_BYTES (1ULL << 30)
+#define FAM_DEFAULT_MR_CACHE_MIN_SIZE 65536
+
+/*
+ * Defaults of the bounce buffers of a Fam_Context: largest transfer copied
+ * through them and number of buffers in each size class.
+ */
+#define FAM_DEFAULT_BOUNCE_MAX_SIZE 4096
+#define FAM_DEFAULT_BOUNCE_COUNT 64
+
+/*
+ * Default number of idle contexts kept for fam_context_open; none, so that
+ * PEs which never open contexts do not pay for their endpoints.
+ */
+#define FAM_DEFAULT_CONTEXT_POOL_SIZE 0
+
+/*
+ * Default time a PE waits for the first PE of its node to publish the memory
+ * server information before fetching it from the CIS itself.
+ */
+#define FAM_DEFAULT_NODE_BOOTSTRAP_TIMEOUT_MSEC 10000
+
+/*
+ * Defaults of the client read cache: bytes of memory for cached pages and
+ * size of a page.
+ */
+#define FAM_DEFAULT_READ_CACHE_SIZE (64ULL << 20)
+#define FAM_DEFAULT_READ_CACHE_PAGE_SIZE 4096
+
+/*
+ * Defaults of write combining: size of the per-thread buffers that collect
+ * adjacent nonblocking puts, largest put that is combined, and number of
+ * buffers a thread may use between two fam_quiet calls.
+ */
+#define FAM_DEFAULT_WRITE_COMBINE_BUFFER_SIZE 16384
+#define FAM_DEFAULT_WRITE_COMBINE_MAX_PUT 1024
+#define FAM_DEFAULT_WRITE_COMBINE_BUFFERS 16
+
 /*
  * Maximum entries in the garbage queue used for resource relinquishment
  */
@@ -287,6 +386,16 @@ typedef enum {
     FAM_INIT_ONLY = 2 << 1
 } Fam_Resource_Flag;
 
+/*
+ * What a thread waiting for fabric completions does once its spin budget is
+ * exhausted
+ */
+typedef enum {
+    FAM_POLL_BUSY = 0,  // keep polling
+    FAM_POLL_BACKOFF,   // sched_yield, then sleep with exponential backoff
+    FAM_POLL_BLOCKING   // block on the wait object of the CQ or counter
+} Fam_Poll_Mode;
+
 using Server_Map = std::map<uint64_t, std::pair<std::string, uint64_t>>;
 
 /*
@@ -411,6 +520,16 @@ inline void decode_offset(uint64_t offset, int *extentIdx, uint64_t *startPos) {
     *startPos = (uint64_t)GlobalPtr(offset).GetOffset();
 }
 
+// Check that a packed gather/scatter index list received in a request holds
+// exactly nElements entries; an empty list selects the strided form
+inline bool packed_index_matches(const std::string &elementIndex,
+                                 uint64_t nElements) {
+    if (elementIndex.empty())
+        return true;
+    return (elementIndex.size() % sizeof(uint64_t) == 0 &&
+            elementIndex.size() / sizeof(uint64_t) == nElements);
+}
+
 inline string protocol_map(string provider) {
     std::map<std::string, int> providertypes;
     string protocol;
@@ -0,0 +1,131 @@
+/*
+ * fam_layout.h
+ * Copyright (c) 2024 Hewlett Packard Enterprise Development, LP. All
+ * rights reserved. Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See https://spdx.org/licenses/BSD-3-Clause
+ *
+ */
+#ifndef FAM_LAYOUT_H
+#define FAM_LAYOUT_H
+
+#include <algorithm>
+#include <stdint.h>
+
+namespace openfam {
+
+/*
+ * Placement of a data item over its memory servers, built once from the
+ * descriptor fields when the item is opened. Interleave blocks go round robin
+ * over the used memory servers; when the interleave size (and the number of
+ * servers) is a power of two, positions are found with shifts and masks.
+ * Fits in one cache line so that the datapath touches a single line of
+ * descriptor state.
+ */
+struct alignas(64) Fam_Layout {
+    // Arrays of the descriptor, one entry per used memory server
+    const uint64_t *memServerIds;
+    const uint64_t *keys;
+    const uint64_t *baseAddrs;
+    uint64_t usedMemsrvCnt;
+    uint64_t interleaveSize;
+    uint64_t interleaveMask;
+    uint32_t interleaveShift;
+    uint32_t memsrvShift;
+    bool interleavePow2;
+    bool memsrvPow2;
+
+    void build(const uint64_t *ids, const uint64_t *itemKeys,
+               const uint64_t *bases, uint64_t cnt, uint64_t interleave) {
+        memServerIds = ids;
+        keys = itemKeys;
+        baseAddrs = bases;
+        usedMemsrvCnt = cnt;
+        interleaveSize = interleave;
+        interleavePow2 = is_pow2(interleave);
+        interleaveShift = interleavePow2 ? log2(interleave) : 0;
+        interleaveMask = interleavePow2 ? interleave - 1 : 0;
+        memsrvPow2 = is_pow2(cnt);
+        memsrvShift = memsrvPow2 ? log2(cnt) : 0;
+    }
+
+    // Whether the item is split in interleave blocks over several servers
+    bool is_interleaved() const {
+        return (usedMemsrvCnt > 1 && interleaveSize > 0);
+    }
+
+    /*
+     * Call fn(serverIndex, remoteOffset, localOffset, len) for each part of
+     * [offset, offset + nbytes) held by one interleave block, in order.
+     * remoteOffset is relative to baseAddrs[serverIndex] and localOffset to
+     * the start of the range. An item on a single server is one part.
+     */
+    template <typename Fn>
+    void for_each_segment(uint64_t offset, uint64_t nbytes, Fn fn) const {
+        if (!is_interleaved())
+            fn(0, offset, 0, nbytes);
+        else if (interleavePow2 && memsrvPow2)
+            walk<true, true>(offset, nbytes, fn);
+        else if (interleavePow2)
+            walk<true, false>(offset, nbytes, fn);
+        else
+            walk<false, false>(offset, nbytes, fn);
+    }
+
+  private:
+    static bool is_pow2(uint64_t n) { return n != 0 && (n & (n - 1)) == 0; }
+
+    static uint32_t log2(uint64_t n) { return (uint32_t)__builtin_ctzll(n); }
+
+    // Only the start of the range is located; the walk itself is additions
+    template <bool InterleavePow2, bool MemsrvPow2, typename Fn>
+    void walk(uint64_t offset, uint64_t nbytes, Fn fn) const {
+        uint64_t block = InterleavePow2 ? offset >> interleaveShift
+                                        : offset / interleaveSize;
+        uint64_t displacement = InterleavePow2
+                                    ? offset & interleaveMask
+                                    : offset - block * interleaveSize;
+        uint64_t row =
+            MemsrvPow2 ? block >> memsrvShift : block / usedMemsrvCnt;
+        uint64_t serverIndex = block - row * usedMemsrvCnt;
+        uint64_t rowOffset = InterleavePow2 ? row << interleaveShift
+                                            : row * interleaveSize;
+        uint64_t done = 0;
+        while (done < nbytes) {
+            uint64_t len =
+                std::min(interleaveSize - displacement, nbytes - done);
+            fn(serverIndex, rowOffset + displacement, done, len);
+            done += len;
+            displacement = 0;
+            if (++serverIndex == usedMemsrvCnt) {
+                serverIndex = 0;
+                rowOffset += interleaveSize;
+            }
+        }
+    }
+};
+
+} // namespace openfam
+#endif
@@ -43,8 +43,10 @@
 #include <iomanip>
 #include <limits.h>
 #include <list>
+#include <sched.h>
 #include <sstream>
 #include <unistd.h>
+#include <vector>
 
 #ifdef __has_include
 #if __has_include(<rdma/fi_cxi_ext.h>)
@@ -61,8 +63,12 @@ using namespace std;
 #define MAX_PENDING_IO 8192
 #define FABRIC_TIMEOUT 10     // 10 milliseconds
 #define TOTAL_TIMEOUT 3600000 // 1 hour
-#define TIMEOUT_WAIT_RETRY (TOTAL_TIMEOUT / FABRIC_TIMEOUT)
-#define TIMEOUT_RETRY INT_MAX
+// Busy polling checks the total timeout once every this many empty polls
+#define TIMEOUT_CHECK_POLLS 65536
+// Scatter/gather lists of up to this many entries are built on the stack
+#define IOV_STACK_COUNT 64
+// Longest list whose buffers are kept by a thread between calls
+#define IOV_SCRATCH_MAX_COUNT 65536
 uint64_t one = 1;
 uint64_t zero = 0;
 
@@ -79,9 +85,13 @@ struct LibFabric_Counter_St {
     LibFabric_Time end;
     LibFabric_Time total;
 };
+// LIBFABRIC_GAUGE entries sample a quantity instead of timing a call: the
+// total is the sum of the samples and the average their mean
 typedef enum LibFabric_Counter_Enum {
 #undef LIBFABRIC_COUNTER
+#undef LIBFABRIC_GAUGE
 #define LIBFABRIC_COUNTER(name) prof_##name,
+#define LIBFABRIC_GAUGE(name) prof_##name,
 #include "libfabric_counters.tbl"
     libfabric_counter_max
 } Libfabric_Counter_Enum_T;
@@ -127,6 +137,9 @@ void libfabric_total_api_time(int apiIdx) {}
     libfabric_add_to_total_profile(prof_##apiIdx, total);                      \
     }
 
+#define LIBFABRIC_PROFILE_SAMPLE(apiIdx, value)                                \
+    libfabric_add_to_total_profile(prof_##apiIdx, value);
+
 void libfabric_profile_init() {
     memset(profileLibfabricData, 0, sizeof(profileLibfabricData));
 }
@@ -215,6 +228,18 @@ void libfabric_dump_profile_data(void) {
         DUMP_DATA_AVG(apiIdx);                                                 \
         cout << endl;                                                          \
     }
+#undef LIBFABRIC_GAUGE
+#undef __LIBFABRIC_GAUGE
+#define LIBFABRIC_GAUGE(name) __LIBFABRIC_GAUGE(name, prof_##name)
+#define __LIBFABRIC_GAUGE(name, apiIdx)                                        \
+    if (profileLibfabricData[apiIdx].count) {                                  \
+        cout << std::left << setfill(' ') << setw(ITEM_WIDTH) << #name;        \
+        DUMP_DATA_COUNT(apiIdx);                                               \
+        cout << std::left << setfill(' ') << setw(ITEM_WIDTH) << "-";          \
+        DUMP_DATA_TIME(apiIdx);                                                \
+        DUMP_DATA_AVG(apiIdx);                                                 \
+        cout << endl;                                                          \
+    }
 #include "libfabric_counters.tbl"
     cout << endl;
 }
@@ -234,6 +259,8 @@ void libfabric_dump_profile_summary(void) {
 #define LIBFABRIC_COUNTER(name) __LIBFABRIC_COUNTER(prof_##name)
 #define __LIBFABRIC_COUNTER(apiIdx)                                            \
     { libfabric_ops_time += profileLibfabricData[apiIdx].total; }
+#undef LIBFABRIC_GAUGE
+#define LIBFABRIC_GAUGE(name)
 #include "libfabric_counters.tbl"
 
     LIBFABRIC_SUMMARY_ENTRY("Total time", libfabric_ops_time);
@@ -243,6 +270,7 @@ void libfabric_dump_profile_summary(void) {
 
 #define LIBFABRIC_PROFILE_START_OPS()
 #define LIBFABRIC_PROFILE_END_OPS(apiIdx)
+#define LIBFABRIC_PROFILE_SAMPLE(apiIdx, value)
 #define LIBFABRIC_PROFILE_START_TIME()
 #define LIBFABRIC_PROFILE_INIT()
 #define LIBFABRIC_PROFILE_END()
@@ -273,18 +301,23 @@ void libfabric_dump_profile_summary(void) {
  * @param fabric - fi_fabric will be initialized
  * @param eq - fi_eq will be initialized
  * @param domain - fi_domain will be initialized
+ * @param rail_addr - local address of the interface of an additional rail,
+ * or the device name with the cxi provider; NULL for the primary interface
  * @return - {true(0), false(1), errNo(<0)}
  */
 int fabric_initialize(const char *name, const char *service, bool source,
                       char *provider, char *if_device, struct fi_info **fi,
                       struct fid_fabric **fabric, struct fid_eq **eq,
-                      struct fid_domain **domain, Fam_Thread_Model famTM) {
+                      struct fid_domain **domain, Fam_Thread_Model famTM,
+                      const char *rail_addr) {
     struct fi_info *hints;
 
     LIBFABRIC_PROFILE_INIT();
     LIBFABRIC_PROFILE_START_TIME();
 
-    if (if_device != NULL && (strcmp(if_device, "") != 0)) {
+    bool rail = (rail_addr != NULL && strcmp(rail_addr, "") != 0);
+    // A rail names its interface itself, if_device selects the primary one
+    if (!rail && if_device != NULL && (strcmp(if_device, "") != 0)) {
         if ((strncmp(provider, "verbs", 5) == 0)) {
             setenv("FI_VERBS_IFACE", if_device, 0);
         }
@@ -346,6 +379,10 @@ int fabric_initialize(const char *name, const char *service, bool source,
 
     hints->domain_attr->resource_mgmt = FI_RM_ENABLED;
 
+    // cxi interfaces are selected by device name rather than by address
+    if (rail && (strncmp(provider, "cxi", 3) == 0))
+        hints->domain_attr->name = strdup(rail_addr);
+
     int ret = 0;
 
     uint64_t flags = 0;
@@ -356,7 +393,11 @@ int fabric_initialize(const char *name, const char *service, bool source,
     }
 
     // Initialize fi with name and service(port)
-    if ((strcmp(provider, "sockets") == 0) && (source)) {
+    if (rail && (strncmp(provider, "cxi", 3) != 0)) {
+        // Bind the rail to the interface owning its address
+        FI_CALL(ret, fi_getinfo, fi_version(), rail_addr,
+                (source ? service : NULL), flags | FI_SOURCE, hints, fi);
+    } else if ((strcmp(provider, "sockets") == 0) && (source)) {
         FI_CALL(ret, fi_getinfo, fi_version(), name, service, flags, hints, fi);
     } else {
         FI_CALL(ret, fi_getinfo, fi_version(), NULL, NULL, flags, hints, fi);
@@ -490,6 +531,88 @@ int fabric_insert_av(const char *addr, struct fid_av *av,
     return 0;
 }
 
+/*
+ * Remove an address inserted with fabric_insert_av from address vector.
+ * @param fiAddr - fi_addr_t of the address
+ * @param av - struct fid_av
+ * @return - {true(0), errNo(<0)}
+ */
+int fabric_remove_av(fi_addr_t fiAddr, struct fid_av *av) {
+    int ret;
+    FI_CALL(ret, fi_av_remove, av, &fiAddr, 1, 0);
+    return ret;
+}
+
+/*
+ * Build the address published by a memory server with additional rails: its
+ * primary address, followed by the address of each rail and a
+ * Fam_Rail_Addr_Trailer. Clients that do not know about rails only read the
+ * primary address. All rail addresses must have the same length.
+ * @param addr - primary address
+ * @param addrLen - length of the primary address
+ * @param railAddrs - address and length of each rail
+ * @param packedLen - set to the length of the returned buffer
+ * @return - buffer allocated with malloc, or NULL if the rail addresses have
+ * different lengths
+ */
+void *fabric_pack_rail_addrs(const void *addr, size_t addrLen,
+                             std::vector<std::pair<void *, size_t>> &railAddrs,
+                             size_t *packedLen) {
+    size_t railAddrLen = railAddrs.empty() ? 0 : railAddrs[0].second;
+    for (auto &railAddr : railAddrs) {
+        if (railAddr.second != railAddrLen)
+            return NULL;
+    }
+    Fam_Rail_Addr_Trailer trailer;
+    trailer.magic = FAM_RAIL_ADDR_MAGIC;
+    trailer.nRails = (uint32_t)railAddrs.size();
+    trailer.addrLen = railAddrLen;
+    *packedLen = addrLen + railAddrs.size() * railAddrLen + sizeof(trailer);
+    char *packed = (char *)malloc(*packedLen);
+    if (packed == NULL)
+        return NULL;
+    memcpy(packed, addr, addrLen);
+    size_t pos = addrLen;
+    for (auto &railAddr : railAddrs) {
+        memcpy(packed + pos, railAddr.first, railAddrLen);
+        pos += railAddrLen;
+    }
+    memcpy(packed + pos, &trailer, sizeof(trailer));
+    return packed;
+}
+
+/*
+ * Get the rail addresses appended to an address published by a memory
+ * server by fabric_pack_rail_addrs.
+ * @param addr - published address
+ * @param addrLen - length of the published address
+ * @return - pointers into addr to the address of each rail; empty if the
+ * memory server has no additional rails
+ */
+std::vector<const char *> fabric_unpack_rail_addrs(const void *addr,
+                                                   size_t addrLen) {
+    std::vector<const char *> railAddrs;
+    Fam_Rail_Addr_Trailer trailer;
+    if (addrLen <= sizeof(trailer))
+        return railAddrs;
+    memcpy(&trailer, (const char *)addr + addrLen - sizeof(trailer),
+           sizeof(trailer));
+    if (trailer.magic != FAM_RAIL_ADDR_MAGIC || trailer.nRails == 0)
+        return railAddrs;
+    // The primary address must remain in front of the rail addresses
+    uint64_t railsLen = trailer.nRails * trailer.addrLen;
+    if (trailer.addrLen == 0 || railsLen / trailer.nRails != trailer.addrLen ||
+        railsLen >= addrLen - sizeof(trailer))
+        return railAddrs;
+    const char *railAddr =
+        (const char *)addr + addrLen - sizeof(trailer) - railsLen;
+    for (uint32_t i = 0; i < trailer.nRails; i++) {
+        railAddrs.push_back(railAddr);
+        railAddr += trailer.addrLen;
+    }
+    return railAddrs;
+}
+
 /*
  * Enable and Bind endpoint
  * @param fi - struct fi_info
@@ -548,6 +671,45 @@ int fabric_getname(struct fid_ep *ep, void *addr, size_t *addrSize) {
     return (fi_getname(&ep->fid, addr, addrSize));
 }
 
+/*
+ * Get a key for a memory region registered by this process. Keys must not
+ * collide when the provider uses the requested key (FI_MR_SCALABLE).
+ * @return - key unique in the process
+ */
+uint64_t fabric_alloc_mr_key() {
+    static std::atomic<uint64_t> nextMrKey(1);
+    return nextMrKey.fetch_add(1);
+}
+
+/*
+ * Get a bounce buffer of the context for a transfer from or to local
+ * memory which is not registered.
+ * @param famCtx - Pointer to Fam_Context
+ * @param local - pointer to the local memory
+ * @param nbytes - size of the transfer
+ * @return - bounce buffer, or NULL if the context has no bounce pool, the
+ * memory is registered, the transfer is too large or the pool is exhausted
+ */
+Fam_Bounce_Buffer *fabric_alloc_bounce_buffer(Fam_Context *famCtx,
+                                              const void *local,
+                                              size_t nbytes) {
+    Fam_Bounce_Pool *pool = famCtx->get_bounce_pool();
+    if (pool == NULL || nbytes > pool->get_max_size() ||
+        famCtx->get_mr_descs(local, nbytes) != NULL)
+        return NULL;
+    Fam_Bounce_Buffer *bb = pool->alloc(nbytes);
+    if (bb == NULL) {
+        LIBFABRIC_PROFILE_SAMPLE(bounce_pool_exhausted, nbytes)
+        return NULL;
+    }
+    LIBFABRIC_PROFILE_SAMPLE(bounce_pool_in_use, pool->get_in_use())
+    return bb;
+}
+
+void fabric_free_bounce_buffer(Fam_Context *famCtx, Fam_Bounce_Buffer *bb) {
+    famCtx->get_bounce_pool()->free_buffer(bb);
+}
+
 /*
  * Register memory region
  * @param addr - local pointer of the memory region
@@ -638,110 +800,243 @@ int fabric_retry(Fam_Context *famCtx, ssize_t ret, uint32_t *retry_cnt) {
     return 0;
 }
 
-// ioType: Send (0), Recv (1)
-int fabric_completion_wait(Fam_Context *famCtx, fi_context *fiCtx, int ioType) {
+/*
+ * Called each time a poll of a completion wait finds nothing to complete.
+ * Spins for the spin count of famCtx, then yields and sleeps, or tells the
+ * caller to block, according to the poll mode of famCtx.
+ * @param famCtx - Fam_Context being waited on
+ * @param state - state of the wait, zeroed before the first poll
+ * @param canBlock - true if the caller has a wait object to block on
+ * @return - true if the caller should block on its wait object for at most
+ * FABRIC_TIMEOUT milliseconds before polling again
+ */
+static bool fabric_poll_idle(Fam_Context *famCtx, struct fam_poll_state *state,
+                             bool canBlock) {
+    Fam_Poll_Mode mode = famCtx->get_poll_mode();
+    uint64_t spinCount = famCtx->get_poll_spin_count();
+    uint64_t polls = ++state->polls;
+
+    if (polls == 1)
+        state->start = steady_clock::now();
+    if (polls <= spinCount)
+        return false;
+
+    if (mode != FAM_POLL_BUSY || (polls % TIMEOUT_CHECK_POLLS) == 0) {
+        if (duration_cast<milliseconds>(steady_clock::now() - state->start)
+                .count() > TOTAL_TIMEOUT)
+            THROW_ERR_MSG(Fam_Timeout_Exception,
+                          "Fabric completion wait timeout exceeded");
+    }
 
-    LIBFABRIC_PROFILE_START_OPS()
-    ssize_t ret = 0;
-    struct fi_cq_data_entry entry;
-    int timeout_retry_cnt = 0;
-    int timeout_wait_retry_cnt = 0;
-    struct fid_cq *cq = NULL;
-    struct fam_fi_context *ctx = (struct fam_fi_context *)fiCtx;
+    if (mode == FAM_POLL_BUSY)
+        return false;
+
+    if (mode == FAM_POLL_BLOCKING && canBlock)
+        return true;
 
+    if (polls <= spinCount + FAM_POLL_YIELD_COUNT) {
+        sched_yield();
+        return false;
+    }
+
+    if (state->sleepUsec == 0)
+        state->sleepUsec = 1;
+    usleep((useconds_t)state->sleepUsec);
+    state->sleepUsec =
+        std::min(state->sleepUsec * 2, famCtx->get_poll_max_sleep_usec());
+    return false;
+}
+
+/*
+ * Called each time a pass over several outstanding requests finds none of
+ * them complete; backs off according to the poll mode of famCtx.
+ * @param famCtx - Fam_Context whose poll mode applies
+ * @param state - state of the wait, zeroed before the first pass
+ */
+void fabric_completion_idle(Fam_Context *famCtx, struct fam_poll_state *state) {
+    (void)fabric_poll_idle(famCtx, state, false);
+}
+
+static struct fid_cq *fabric_completion_cq(Fam_Context *famCtx, int ioType) {
     if (ioType == 0)
-        cq = famCtx->get_txcq();
+        return famCtx->get_txcq();
     else if (ioType == 1)
-        cq = famCtx->get_rxcq();
-    uint64_t success, failure, reqcnt;
-    do {
-        success = (uint64_t)ctx->fam_internal[0];
-        failure = (uint64_t)ctx->fam_internal[1];
-        reqcnt = (uint64_t)ctx->fam_internal[2];
-        if (success == reqcnt) {
-            return 0;
-        }
-        if (failure > 0) {
-            struct fi_cq_err_entry *errptr =
-                (struct fi_cq_err_entry *)ctx->fam_internal[3];
-            const char *errmsg = fi_cq_strerror(cq, errptr->prov_errno,
-                                                errptr->err_data, NULL, 0);
-            int err = errptr->err;
-            free(ctx->fam_internal[3]);
-
-            THROW_ERRNO_MSG(Fam_Datapath_Exception, get_fam_error(err), errmsg);
-        }
+        return famCtx->get_rxcq();
+    return NULL;
+}
+
+/*
+ * Check the counters of a context posted with FI_COMPLETION.
+ * Returns true once all of its requests have completed and throws if any
+ * of them failed.
+ */
+static bool fabric_completion_done(Fam_Context *famCtx, struct fid_cq *cq,
+                                   struct fam_fi_context *ctx) {
+    uint64_t success = (uint64_t)ctx->fam_internal[0];
+    uint64_t failure = (uint64_t)ctx->fam_internal[1];
+    uint64_t reqcnt = (uint64_t)ctx->fam_internal[2];
+    if (success == reqcnt) {
+        return true;
+    }
+    if (failure > 0) {
+        struct fi_cq_err_entry *errptr =
+            (struct fi_cq_err_entry *)ctx->fam_internal[3];
+        const char *errmsg =
+            fi_cq_strerror(cq, errptr->prov_errno, errptr->err_data, NULL, 0);
+        int err = errptr->err;
+        famCtx->free_err_entry(errptr);
+        ctx->fam_internal[3] = NULL;
+
+        THROW_ERRNO_MSG(Fam_Datapath_Exception, get_fam_error(err), errmsg);
+    }
+    return false;
+}
 
-        memset(&entry, 0, sizeof(entry));
+/*
+ * Reap one entry from the CQ and credit it to the context it belongs to.
+ * Errors for other contexts are parked in that context so that their own
+ * waiter reports them; an error for ctx is thrown right away.
+ * Returns the result of the CQ read (-FI_EAGAIN/-FI_ETIMEDOUT when empty).
+ */
+static ssize_t fabric_completion_reap(Fam_Context *famCtx, struct fid_cq *cq,
+                                      struct fam_fi_context *ctx, bool block) {
+    ssize_t ret = 0;
+    struct fi_cq_data_entry entry;
+
+    memset(&entry, 0, sizeof(entry));
+    if (block) {
+        FI_CALL(ret, fi_cq_sread, cq, &entry, 1, NULL, FABRIC_TIMEOUT);
+    } else {
         FI_CALL(ret, fi_cq_read, cq, &entry, 1);
-        if (ret > 0) {
-            if ((fi_context *)entry.op_context != (void *)NULL) {
+    }
+    if (ret > 0) {
+        if ((fi_context *)entry.op_context != (void *)NULL) {
+            __sync_fetch_and_add(
+                ((uint64_t *)&((fam_fi_context *)entry.op_context)
+                     ->fam_internal[0]),
+                one);
+        }
+        return ret;
+    }
+
+    if (ret == -FI_ETIMEDOUT || ret == -FI_EAGAIN) {
+        return ret;
+    }
+    if (ret < 0) {
+        struct fi_cq_err_entry err;
+        FI_CALL(ret, fi_cq_readerr, cq, &err, 0);
+        if (ret == 1) {
+            if (err.op_context == (void *)ctx) {
+                const char *errmsg =
+                    fi_cq_strerror(cq, err.prov_errno, err.err_data, NULL, 0);
                 __sync_fetch_and_add(
-                    ((uint64_t *)&((fam_fi_context *)entry.op_context)
-                         ->fam_internal[0]),
+                    (uint64_t *)&((fam_fi_context *)err.op_context)
+                        ->fam_internal[1],
                     one);
-            }
-        }
 
-        if (ret == -FI_ETIMEDOUT || ret == -FI_EAGAIN) {
-            if (timeout_retry_cnt < TIMEOUT_RETRY) {
-                timeout_retry_cnt++;
-                continue;
-            } else if (timeout_wait_retry_cnt < TIMEOUT_WAIT_RETRY) {
-                timeout_wait_retry_cnt++;
-                usleep(FABRIC_TIMEOUT * 1000);
-                continue;
+                THROW_ERRNO_MSG(Fam_Datapath_Exception, get_fam_error(err.err),
+                                errmsg);
             } else {
-                THROW_ERR_MSG(
-                    Fam_Timeout_Exception,
-                    "fi_cq_read timeout retry count exceeded INT_MAX");
-            }
-        }
-        if (ret < 0) {
-            struct fi_cq_err_entry err;
-            FI_CALL(ret, fi_cq_readerr, cq, &err, 0);
-            if (ret == 1) {
-                if (err.op_context == (void *)ctx) {
-                    const char *errmsg = fi_cq_strerror(cq, err.prov_errno,
-                                                        err.err_data, NULL, 0);
+                if ((fi_context *)err.op_context != NULL) {
                     __sync_fetch_and_add(
                         (uint64_t *)&((fam_fi_context *)err.op_context)
                             ->fam_internal[1],
                         one);
-
-                    THROW_ERRNO_MSG(Fam_Datapath_Exception,
-                                    get_fam_error(err.err), errmsg);
-                } else {
-                    if ((fi_context *)err.op_context != NULL) {
-                        __sync_fetch_and_add(
-                            (uint64_t *)&((fam_fi_context *)err.op_context)
-                                ->fam_internal[1],
-                            one);
-                        struct fi_cq_err_entry *errptr =
-                            (struct fi_cq_err_entry *)malloc(
-                                sizeof(struct fi_cq_err_entry));
-                        memcpy((struct fi_cq_err_entry *)errptr, &err,
-                               sizeof(struct fi_cq_err_entry));
-                        if ((__sync_val_compare_and_swap(
-                                &(((fam_fi_context *)err.op_context)
-                                      ->fam_internal[3]),
-                                NULL, errptr)) != NULL) {
-                            free(errptr);
-                        }
+                    struct fi_cq_err_entry *errptr = famCtx->alloc_err_entry();
+                    memcpy((struct fi_cq_err_entry *)errptr, &err,
+                           sizeof(struct fi_cq_err_entry));
+                    if ((__sync_val_compare_and_swap(
+                            &(((fam_fi_context *)err.op_context)
+                                  ->fam_internal[3]),
+                            NULL, errptr)) != NULL) {
+                        famCtx->free_err_entry(errptr);
                     }
                 }
-
-            } else if (ret && ret != -FI_EAGAIN) {
-                THROW_ERR_MSG(Fam_Datapath_Exception,
-                              "Reading from fabric CQ failed");
             }
+        } else if (ret && ret != -FI_EAGAIN) {
+            THROW_ERR_MSG(Fam_Datapath_Exception,
+                          "Reading from fabric CQ failed");
         }
-    } while (success < reqcnt);
+    }
+    return 0;
+}
+
+// ioType: Send (0), Recv (1)
+int fabric_completion_wait(Fam_Context *famCtx, fi_context *fiCtx, int ioType) {
+
+    LIBFABRIC_PROFILE_START_OPS()
+    ssize_t ret = 0;
+    struct fam_poll_state pollState = {};
+    bool block = false;
+    struct fid_cq *cq = fabric_completion_cq(famCtx, ioType);
+    struct fam_fi_context *ctx = (struct fam_fi_context *)fiCtx;
+
+    while (!fabric_completion_done(famCtx, cq, ctx)) {
+        ret = fabric_completion_reap(famCtx, cq, ctx, block);
+        if (ret == -FI_ETIMEDOUT || ret == -FI_EAGAIN) {
+            block = fabric_poll_idle(famCtx, &pollState,
+                                     famCtx->has_cq_wait_obj());
+        }
+    }
 
     LIBFABRIC_PROFILE_END_OPS(fabric_completion_wait)
     return 0;
 }
 
+// ioType: Send (0), Recv (1)
+int fabric_completion_test(Fam_Context *famCtx, fi_context *fiCtx,
+                           int ioType) {
+    ssize_t ret = 0;
+    struct fid_cq *cq = fabric_completion_cq(famCtx, ioType);
+    struct fam_fi_context *ctx = (struct fam_fi_context *)fiCtx;
+
+    // Drain whatever is already in the CQ, but never wait for more
+    while (!fabric_completion_done(famCtx, cq, ctx)) {
+        ret = fabric_completion_reap(famCtx, cq, ctx, false);
+        if (ret == -FI_ETIMEDOUT || ret == -FI_EAGAIN)
+            return 0;
+    }
+    return 1;
+}
+
+/*
+ * Wait until every request of a context has completed, successfully or not,
+ * without reporting errors, so that the context can be freed after a post
+ * or a wait of the IO it tracks has failed.
+ * ioType: Send (0), Recv (1)
+ * @return - false if requests are still outstanding once the completion
+ * timeout has passed; the provider may still write to the context, which
+ * must then not be freed
+ */
+bool fabric_completion_drain(Fam_Context *famCtx, fi_context *fiCtx,
+                             int ioType) {
+    ssize_t ret = 0;
+    struct fam_poll_state pollState = {};
+    bool block = false;
+    struct fid_cq *cq = fabric_completion_cq(famCtx, ioType);
+    struct fam_fi_context *ctx = (struct fam_fi_context *)fiCtx;
+    uint64_t reqcnt = (uint64_t)ctx->fam_internal[2];
+
+    try {
+        while ((uint64_t)ctx->fam_internal[0] + (uint64_t)ctx->fam_internal[1] <
+               reqcnt) {
+            try {
+                ret = fabric_completion_reap(famCtx, cq, ctx, block);
+            } catch (Fam_Datapath_Exception &e) {
+                // Failures of ctx are counted by the reap
+                ret = -FI_EAGAIN;
+            }
+            if (ret == -FI_ETIMEDOUT || ret == -FI_EAGAIN) {
+                block = fabric_poll_idle(famCtx, &pollState,
+                                         famCtx->has_cq_wait_obj());
+            }
+        }
+    } catch (Fam_Timeout_Exception &e) {
+        return false;
+    }
+    return true;
+}
+
 /*
  * fabric write message blocking
  * @param key - key of the memory region
@@ -760,9 +1055,7 @@ int fabric_write(uint64_t key, const void *local, size_t nbytes,
 
     struct fi_rma_iov rma_iov = {.addr = offset, .len = nbytes, .key = key};
 
-    struct fam_fi_context *ctx = new struct fam_fi_context();
-    memset(ctx, 0, sizeof(struct fam_fi_context));
-    ctx->fam_internal[2] = (void *)1;
+    struct fam_fi_context *ctx = famCtx->alloc_fi_context(1);
 
     struct fi_msg_rma msg = {.msg_iov = &iov,
                              .desc = famCtx->get_mr_descs(local, nbytes),
@@ -798,7 +1091,7 @@ int fabric_write(uint64_t key, const void *local, size_t nbytes,
 
     // Release Fam_Context read lock
     famCtx->release_lock();
-    delete ctx;
+    famCtx->free_fi_context((struct fi_context *)ctx);
 
     return (int)ret;
 }
@@ -821,9 +1114,7 @@ int fabric_read(uint64_t key, const void *local, size_t nbytes, uint64_t offset,
 
     struct fi_rma_iov rma_iov = {.addr = offset, .len = nbytes, .key = key};
 
-    struct fam_fi_context *ctx = new struct fam_fi_context();
-    memset(ctx, 0, sizeof(struct fam_fi_context));
-    ctx->fam_internal[2] = (void *)1;
+    struct fam_fi_context *ctx = famCtx->alloc_fi_context(1);
 
     struct fi_msg_rma msg = {.msg_iov = &iov,
                              .desc = famCtx->get_mr_descs(local, nbytes),
@@ -857,10 +1148,88 @@ int fabric_read(uint64_t key, const void *local, size_t nbytes, uint64_t offset,
     }
     // Release Fam_Context read lock
     famCtx->release_lock();
-    delete ctx;
+    famCtx->free_fi_context((struct fi_context *)ctx);
     return (int)ret;
 }
 
+/*
+ * Iov_List - iov and rma_iov arrays of one scatter/gather. Short lists are
+ * built on the stack and longer ones in buffers kept per thread, so building
+ * a list does not allocate once a thread has seen its longest list. Lists
+ * longer than IOV_SCRATCH_MAX_COUNT get buffers of their own, so that one
+ * huge gather does not pin memory for the life of the thread.
+ */
+class Iov_List {
+  public:
+    Iov_List(uint64_t count) {
+        if (count <= IOV_STACK_COUNT) {
+            iov = stackIov;
+            rma_iov = stackRmaIov;
+            return;
+        }
+        std::vector<struct iovec> *iovBuf = &scratchIov;
+        std::vector<struct fi_rma_iov> *rmaIovBuf = &scratchRmaIov;
+        if (count > IOV_SCRATCH_MAX_COUNT) {
+            iovBuf = &ownIov;
+            rmaIovBuf = &ownRmaIov;
+        }
+        if (iovBuf->size() < count) {
+            iovBuf->resize(count);
+            rmaIovBuf->resize(count);
+        }
+        iov = iovBuf->data();
+        rma_iov = rmaIovBuf->data();
+    }
+
+    struct iovec *iov;
+    struct fi_rma_iov *rma_iov;
+
+  private:
+    struct iovec stackIov[IOV_STACK_COUNT];
+    struct fi_rma_iov stackRmaIov[IOV_STACK_COUNT];
+    std::vector<struct iovec> ownIov;
+    std::vector<struct fi_rma_iov> ownRmaIov;
+    static thread_local std::vector<struct iovec> scratchIov;
+    static thread_local std::vector<struct fi_rma_iov> scratchRmaIov;
+};
+
+thread_local std::vector<struct iovec> Iov_List::scratchIov;
+thread_local std::vector<struct fi_rma_iov> Iov_List::scratchRmaIov;
+
+/*
+ * Fill the lists of a scatter/gather of count elements of nbytes each, which
+ * are packed in local memory and placed at element index(i) in FAM. As the
+ * local side is contiguous, an element that directly follows the previous
+ * one in FAM extends the previous entry instead of taking one of its own, up
+ * to maxLen bytes per entry.
+ * @return - number of entries filled
+ */
+template <typename Index_Fn>
+static uint64_t fabric_fill_iov(Iov_List &list, const void *local,
+                                size_t nbytes, uint64_t count, Index_Fn index,
+                                uint64_t key, uint64_t base, size_t maxLen) {
+    struct iovec *iov = list.iov;
+    struct fi_rma_iov *rma_iov = list.rma_iov;
+    uint64_t n = 0;
+
+    for (uint64_t i = 0; i < count; i++) {
+        uint64_t addr = base + index(i) * nbytes;
+        if (n > 0 && rma_iov[n - 1].addr + rma_iov[n - 1].len == addr &&
+            rma_iov[n - 1].len + nbytes <= maxLen) {
+            iov[n - 1].iov_len += nbytes;
+            rma_iov[n - 1].len += nbytes;
+            continue;
+        }
+        iov[n].iov_base = (void *)((uint64_t)local + (i * nbytes));
+        iov[n].iov_len = nbytes;
+        rma_iov[n].addr = addr;
+        rma_iov[n].len = nbytes;
+        rma_iov[n].key = key;
+        n++;
+    }
+    return n;
+}
+
 /*
  * fabric read or write with multiple messages
  * @param count - number of IO count
@@ -879,7 +1248,7 @@ struct fi_context *fabric_read_write_multi_msg(
     uint64_t count, size_t iov_limit, fi_addr_t fiAddr, Fam_Context *famCtx,
     struct iovec *iov, struct fi_rma_iov *rma_iov, bool write, bool block) {
     ssize_t ret = 0;
-    struct fam_fi_context *ctx = (block ? new struct fam_fi_context() : NULL);
+    struct fam_fi_context *ctx = NULL;
     LIBFABRIC_PROFILE_START_OPS()
     int64_t iteration = count / iov_limit;
     if (count % iov_limit > 0)
@@ -890,20 +1259,26 @@ struct fi_context *fabric_read_write_multi_msg(
     flags = (block ? FI_COMPLETION : 0);
     flags |= ((block && write) ? FI_DELIVERY_COMPLETE : 0);
 
-    if (block) {
-        memset(ctx, 0, sizeof(struct fam_fi_context));
-        ctx->fam_internal[2] = (void *)iteration;
-    }
+    if (block)
+        ctx = famCtx->alloc_fi_context((uint64_t)iteration);
 
     // Take Fam_Context read lock
     famCtx->acquire_RDLock();
 
     for (int64_t j = 0; j < iteration; j++) {
         size_t len_count = std::min<size_t>(iov_limit, count_remain);
+        // Local range covered by the entries of this message
+        uint64_t localStart = UINT64_MAX;
+        uint64_t localEnd = 0;
+        for (size_t k = j * iov_limit; k < j * iov_limit + len_count; k++) {
+            localStart = std::min(localStart, (uint64_t)iov[k].iov_base);
+            localEnd = std::max(localEnd,
+                                (uint64_t)iov[k].iov_base + iov[k].iov_len);
+        }
         struct fi_msg_rma msg = {
             .msg_iov = &iov[j * iov_limit],
-            .desc = famCtx->get_mr_descs(iov[j * iov_limit].iov_base,
-                                         (iov[j * iov_limit].iov_len)*(len_count)),
+            .desc = famCtx->get_mr_descs((void *)localStart,
+                                         localEnd - localStart),
             .iov_count = std::min<size_t>(iov_limit, count_remain),
             .addr = fiAddr,
             .rma_iov = &rma_iov[j * iov_limit],
@@ -926,6 +1301,14 @@ struct fi_context *fabric_read_write_multi_msg(
             else
                 famCtx->inc_num_rx_ops();
         } catch (...) {
+            // Only the messages posted so far complete on ctx; wait for
+            // them before it goes back to the free list
+            if (ctx != NULL) {
+                ctx->fam_internal[2] = (void *)j;
+                if (fabric_completion_drain(famCtx, (struct fi_context *)ctx,
+                                            0))
+                    famCtx->free_fi_context((struct fi_context *)ctx);
+            }
             // Release Fam_Context read lock
             famCtx->release_lock();
             throw;
@@ -952,21 +1335,17 @@ struct fi_context *
 fabric_write(std::vector<std::pair<iovec, fi_rma_iov>> ioInfo, fi_addr_t fiAddr,
              Fam_Context *famCtx, size_t iov_limit, uint64_t base, bool block) {
 
-    struct iovec *iov = new iovec[ioInfo.size()];
-    struct fi_rma_iov *rma_iov = new fi_rma_iov[ioInfo.size()];
+    Iov_List list(ioInfo.size());
 
     LIBFABRIC_PROFILE_START_OPS()
     for (int i = 0; i < (int)ioInfo.size(); i++) {
-        iov[i] = ioInfo[i].first;
-        rma_iov[i] = ioInfo[i].second;
+        list.iov[i] = ioInfo[i].first;
+        list.rma_iov[i] = ioInfo[i].second;
     }
     LIBFABRIC_PROFILE_END_OPS(IO_vector_array_creation)
-    struct fi_context *fiCtx;
-    fiCtx = fabric_read_write_multi_msg(ioInfo.size(), iov_limit, fiAddr,
-                                        famCtx, iov, rma_iov, 1, block);
-    delete [] iov;
-    delete [] rma_iov;
-    return fiCtx;
+    return fabric_read_write_multi_msg(ioInfo.size(), iov_limit, fiAddr,
+                                       famCtx, list.iov, list.rma_iov, 1,
+                                       block);
 }
 
 /*
@@ -983,20 +1362,104 @@ struct fi_context *fabric_read(std::vector<std::pair<iovec, fi_rma_iov>> ioInfo,
                                fi_addr_t fiAddr, Fam_Context *famCtx,
                                size_t iov_limit, uint64_t base, bool block) {
 
-    struct iovec *iov = new iovec[ioInfo.size()];
-    struct fi_rma_iov *rma_iov = new fi_rma_iov[ioInfo.size()];
+    Iov_List list(ioInfo.size());
 
     for (int i = 0; i < (int)ioInfo.size(); i++) {
-        iov[i] = ioInfo[i].first;
-        rma_iov[i] = ioInfo[i].second;
+        list.iov[i] = ioInfo[i].first;
+        list.rma_iov[i] = ioInfo[i].second;
     }
 
-    struct fi_context *fiCtx;
-    fiCtx = fabric_read_write_multi_msg(ioInfo.size(), iov_limit, fiAddr,
-                                        famCtx, iov, rma_iov, 0, block);
-    delete [] iov;
-    delete [] rma_iov;
-    return fiCtx;
+    return fabric_read_write_multi_msg(ioInfo.size(), iov_limit, fiAddr,
+                                       famCtx, list.iov, list.rma_iov, 0,
+                                       block);
+}
+
+/*
+ *  fabric read or write of a batch of IOs to one memory server. IOs are
+ *  posted iov_limit at a time with FI_MORE set on all but the last message,
+ *  so that the provider can defer ringing the doorbell until the whole batch
+ *  is queued. All the messages share fiCtx, whose request count must be set
+ *  by the caller to the total number of messages it waits for.
+ *  @param ioInfo - vector of IOs
+ *  @param fiAddr - fi_addr_t address
+ *  @param famCtx - Pointer to Fam_Context
+ *  @param iov_limit - iov limit
+ *  @param fiCtx - fi_context shared by all the messages of the batch
+ *  @param write - indicates if the oprtaion is write or read. set true for
+ *  write.
+ *  @param more - set if more IOs will be posted after this batch, in which
+ *  case FI_MORE is set on the last message as well
+ *  @return - number of messages posted
+ */
+uint64_t
+fabric_read_write_batch(std::vector<std::pair<iovec, fi_rma_iov>> &ioInfo,
+                        fi_addr_t fiAddr, Fam_Context *famCtx, size_t iov_limit,
+                        struct fi_context *fiCtx, bool write, bool more) {
+    ssize_t ret = 0;
+    uint64_t count = ioInfo.size();
+    uint64_t nMsgs = 0;
+    uint64_t flags = FI_COMPLETION;
+    flags |= (write ? FI_DELIVERY_COMPLETE : 0);
+    std::vector<struct iovec> iov(iov_limit);
+    std::vector<struct fi_rma_iov> rma_iov(iov_limit);
+
+    // Take Fam_Context read lock
+    famCtx->acquire_RDLock();
+
+    for (uint64_t i = 0; i < count; i += iov_limit) {
+        size_t len_count = std::min<size_t>(iov_limit, count - i);
+        // Local buffers of a batch need not be contiguous, so the registered
+        // descriptors are used only if every buffer of the message is within
+        // the registered heap.
+        bool registered = true;
+        for (size_t j = 0; j < len_count; j++) {
+            iov[j] = ioInfo[i + j].first;
+            rma_iov[j] = ioInfo[i + j].second;
+            if (famCtx->get_mr_descs(iov[j].iov_base, iov[j].iov_len) == 0)
+                registered = false;
+        }
+        struct fi_msg_rma msg = {
+            .msg_iov = iov.data(),
+            .desc = (registered ? famCtx->get_mr_descs(iov[0].iov_base,
+                                                       iov[0].iov_len)
+                                : NULL),
+            .iov_count = len_count,
+            .addr = fiAddr,
+            .rma_iov = rma_iov.data(),
+            .rma_iov_count = len_count,
+            .context = fiCtx,
+            .data = 0};
+
+        uint64_t msgFlags = flags;
+        if (more || (i + len_count < count))
+            msgFlags |= FI_MORE;
+
+        uint32_t retry_cnt = 0;
+        try {
+            do {
+                if (write) {
+                    FI_CALL(ret, fi_writemsg, famCtx->get_ep(), &msg,
+                            msgFlags);
+                } else {
+                    FI_CALL(ret, fi_readmsg, famCtx->get_ep(), &msg, msgFlags);
+                }
+            } while (fabric_retry(famCtx, ret, &retry_cnt));
+
+            if (write)
+                famCtx->inc_num_tx_ops();
+            else
+                famCtx->inc_num_rx_ops();
+        } catch (...) {
+            // Release Fam_Context read lock
+            famCtx->release_lock();
+            throw;
+        }
+        nMsgs++;
+    }
+
+    // Release Fam_Context read lock
+    famCtx->release_lock();
+    return nMsgs;
 }
 
 /*
@@ -1029,9 +1492,7 @@ struct fi_context *fabric_write(uint64_t key, const void *local, size_t nbytes,
     uint64_t flags = (block ? FI_COMPLETION | FI_DELIVERY_COMPLETE : 0);
 
     if (block) {
-        ctx = new struct fam_fi_context();
-        memset(ctx, 0, sizeof(struct fam_fi_context));
-        ctx->fam_internal[2] = (void *)1;
+        ctx = famCtx->alloc_fi_context(1);
     }
 
     struct fi_msg_rma msg = {.msg_iov = &iov,
@@ -1062,6 +1523,8 @@ struct fi_context *fabric_write(uint64_t key, const void *local, size_t nbytes,
             famCtx->inc_num_tx_fail_cnt(incr);
         // Release Fam_Context read lock
         famCtx->release_lock();
+        // The write was never posted
+        famCtx->free_fi_context((struct fi_context *)ctx);
         throw;
     }
 
@@ -1102,9 +1565,7 @@ struct fi_context *fabric_read(uint64_t key, const void *local, size_t nbytes,
     uint64_t flags = (block ? FI_COMPLETION : 0);
 
     if (block) {
-        ctx = new struct fam_fi_context();
-        memset(ctx, 0, sizeof(struct fam_fi_context));
-        ctx->fam_internal[2] = (void *)1;
+        ctx = famCtx->alloc_fi_context(1);
     }
 
     struct fi_msg_rma msg = {.msg_iov = &iov,
@@ -1136,6 +1597,8 @@ struct fi_context *fabric_read(uint64_t key, const void *local, size_t nbytes,
         }
         // Release Fam_Context read lock
         famCtx->release_lock();
+        // The read was never posted
+        famCtx->free_fi_context((struct fi_context *)ctx);
         throw;
     }
     // Release Fam_Context read lock
@@ -1165,24 +1628,14 @@ struct fi_context *fabric_scatter_stride(uint64_t key, const void *local,
                                          size_t iov_limit, uint64_t base,
                                          bool block) {
 
-    struct iovec *iov = new iovec[count];
-    struct fi_rma_iov *rma_iov = new fi_rma_iov[count];
-
-    for (uint64_t i = 0; i < count; i++) {
-        iov[i].iov_base = (void *)((uint64_t)local + (i * nbytes));
-        iov[i].iov_len = nbytes;
-
-        rma_iov[i].addr = base + first * nbytes + (i * stride) * nbytes;
-        rma_iov[i].len = nbytes;
-        rma_iov[i].key = key;
-    }
-
-    struct fi_context *ctx = fabric_read_write_multi_msg(
-        count, iov_limit, fiAddr, famCtx, iov, rma_iov, 1, block);
-    delete [] iov;
-    delete [] rma_iov;
+    Iov_List list(count);
+    uint64_t nEntries = fabric_fill_iov(
+        list, local, nbytes, count,
+        [first, stride](uint64_t i) { return first + i * stride; }, key, base,
+        famCtx->get_max_msg_size());
 
-    return ctx;
+    return fabric_read_write_multi_msg(nEntries, iov_limit, fiAddr, famCtx,
+                                       list.iov, list.rma_iov, 1, block);
 }
 
 /*
@@ -1210,25 +1663,14 @@ struct fi_context *fabric_gather_stride(uint64_t key, const void *local,
                                         size_t iov_limit, uint64_t base,
                                         bool block) {
 
-    struct iovec *iov = new iovec[count];
-    struct fi_rma_iov *rma_iov = new fi_rma_iov[count];
+    Iov_List list(count);
+    uint64_t nEntries = fabric_fill_iov(
+        list, local, nbytes, count,
+        [first, stride](uint64_t i) { return first + i * stride; }, key, base,
+        famCtx->get_max_msg_size());
 
-    for (uint64_t i = 0; i < count; i++) {
-        iov[i].iov_base = (void *)((uint64_t)local + (i * nbytes));
-        iov[i].iov_len = nbytes;
-
-        rma_iov[i].addr = base + first * nbytes + (i * stride) * nbytes;
-        rma_iov[i].len = nbytes;
-        rma_iov[i].key = key;
-    }
-
-    struct fi_context *ctx = fabric_read_write_multi_msg(
-        count, iov_limit, fiAddr, famCtx, iov, rma_iov, 0, block);
-
-    delete [] iov;
-    delete [] rma_iov;
-
-    return ctx;
+    return fabric_read_write_multi_msg(nEntries, iov_limit, fiAddr, famCtx,
+                                       list.iov, list.rma_iov, 0, block);
 }
 
 /*
@@ -1251,24 +1693,14 @@ struct fi_context *fabric_scatter_index(uint64_t key, const void *local,
                                         Fam_Context *famCtx, size_t iov_limit,
                                         uint64_t base, bool block) {
 
-    struct iovec *iov = new iovec[count];
-    struct fi_rma_iov *rma_iov = new fi_rma_iov[count];
+    // Runs of consecutive indexes are posted as one entry each
+    Iov_List list(count);
+    uint64_t nEntries = fabric_fill_iov(
+        list, local, nbytes, count, [index](uint64_t i) { return index[i]; },
+        key, base, famCtx->get_max_msg_size());
 
-    for (uint64_t i = 0; i < count; i++) {
-        iov[i].iov_base = (void *)((uint64_t)local + (i * nbytes));
-        iov[i].iov_len = nbytes;
-        rma_iov[i].addr = base + index[i] * nbytes;
-        rma_iov[i].len = nbytes;
-        rma_iov[i].key = key;
-    }
-
-    struct fi_context *ctx = fabric_read_write_multi_msg(
-        count, iov_limit, fiAddr, famCtx, iov, rma_iov, 1, block);
-
-    delete [] iov;
-    delete [] rma_iov;
-
-    return ctx;
+    return fabric_read_write_multi_msg(nEntries, iov_limit, fiAddr, famCtx,
+                                       list.iov, list.rma_iov, 1, block);
 }
 
 /*
@@ -1291,25 +1723,14 @@ struct fi_context *fabric_gather_index(uint64_t key, const void *local,
                                        Fam_Context *famCtx, size_t iov_limit,
                                        uint64_t base, bool block) {
 
-    struct iovec *iov = new iovec[count];
-    struct fi_rma_iov *rma_iov = new fi_rma_iov[count];
-
-    for (uint64_t i = 0; i < count; i++) {
-        iov[i].iov_base = (void *)((uint64_t)local + (i * nbytes));
-        iov[i].iov_len = nbytes;
-
-        rma_iov[i].addr = base + index[i] * nbytes;
-        rma_iov[i].len = nbytes;
-        rma_iov[i].key = key;
-    }
+    // Runs of consecutive indexes are posted as one entry each
+    Iov_List list(count);
+    uint64_t nEntries = fabric_fill_iov(
+        list, local, nbytes, count, [index](uint64_t i) { return index[i]; },
+        key, base, famCtx->get_max_msg_size());
 
-    struct fi_context *ctx = fabric_read_write_multi_msg(
-        count, iov_limit, fiAddr, famCtx, iov, rma_iov, 0, block);
-
-    delete [] iov;
-    delete [] rma_iov;
-
-    return ctx;
+    return fabric_read_write_multi_msg(nEntries, iov_limit, fiAddr, famCtx,
+                                       list.iov, list.rma_iov, 0, block);
 }
 
 /*
@@ -1321,7 +1742,7 @@ struct fi_context *fabric_gather_index(uint64_t key, const void *local,
  */
 void fabric_fence(fi_addr_t fiAddr, Fam_Context *famCtx) {
 
-    char *local = strdup("FENCE MSG");
+    static char local[] = "FENCE MSG";
     uint64_t nbytes = 10;
     uint64_t offset = 0;
     uint64_t key = FAM_FENCE_KEY;
@@ -1331,7 +1752,7 @@ void fabric_fence(fi_addr_t fiAddr, Fam_Context *famCtx) {
 
     struct fi_rma_iov rma_iov = {.addr = offset, .len = nbytes, .key = key};
 
-    struct fi_context *ctx = new struct fi_context();
+    struct fi_context *ctx = (struct fi_context *)famCtx->alloc_fi_context(1);
 
     struct fi_msg_rma msg = {.msg_iov = &iov,
                              .desc = famCtx->get_mr_descs(local, nbytes),
@@ -1360,7 +1781,7 @@ void fabric_fence(fi_addr_t fiAddr, Fam_Context *famCtx) {
 
     // Release Fam_Context Write lock
     famCtx->release_lock();
-    delete ctx;
+    famCtx->free_fi_context(ctx);
 
     return;
 }
@@ -1372,7 +1793,7 @@ void fabric_fence(fi_addr_t fiAddr, Fam_Context *famCtx) {
  */
 void fabric_put_quiet(Fam_Context *famCtx) {
 
-    int timeout_retry_cnt = 0;
+    struct fam_poll_state pollState = {};
 
     uint64_t txsuccess = 0;
     uint64_t txfail = 0;
@@ -1380,7 +1801,6 @@ void fabric_put_quiet(Fam_Context *famCtx) {
     struct fi_cq_data_entry entry;
     ssize_t ret = 0;
     uint64_t txLastFailCnt = famCtx->get_num_tx_fail_cnt();
-    int timeout_wait_retry_cnt = 0;
 
     txcnt = famCtx->get_num_tx_ops();
     do {
@@ -1408,14 +1828,11 @@ void fabric_put_quiet(Fam_Context *famCtx) {
                      ((ret == -FI_EAGAIN) || (ret == -FI_ETIMEDOUT)));
         }
 
-        if (timeout_retry_cnt < TIMEOUT_RETRY) {
-            timeout_retry_cnt++;
-        } else if (timeout_wait_retry_cnt < TIMEOUT_WAIT_RETRY) {
-            timeout_wait_retry_cnt++;
-            usleep(FABRIC_TIMEOUT * 1000);
-        } else {
-            THROW_ERR_MSG(Fam_Timeout_Exception,
-                          "Timeout retry count exceeded INT_MAX");
+        if ((txsuccess + txfail) < txcnt &&
+            fabric_poll_idle(famCtx, &pollState, true)) {
+            // Returns early with an error if a failure is counted
+            FI_CALL_NO_RETURN(fi_cntr_wait, famCtx->get_txCntr(),
+                              txcnt - txfail, FABRIC_TIMEOUT);
         }
     } while ((txsuccess + txfail) < txcnt);
 
@@ -1424,7 +1841,7 @@ void fabric_put_quiet(Fam_Context *famCtx) {
 
 void fabric_get_quiet(Fam_Context *famCtx) {
 
-    int timeout_retry_cnt = 0;
+    struct fam_poll_state pollState = {};
 
     uint64_t rxsuccess = 0;
     uint64_t rxfail = 0;
@@ -1432,7 +1849,6 @@ void fabric_get_quiet(Fam_Context *famCtx) {
     struct fi_cq_data_entry entry;
     ssize_t ret = 0;
     uint64_t rxLastFailCnt = famCtx->get_num_rx_fail_cnt();
-    int timeout_wait_retry_cnt = 0;
     rxcnt = famCtx->get_num_rx_ops();
     do {
 
@@ -1461,14 +1877,11 @@ void fabric_get_quiet(Fam_Context *famCtx) {
                      ((ret == -FI_EAGAIN) || (ret == -FI_ETIMEDOUT)));
         }
 
-        if (timeout_retry_cnt < TIMEOUT_RETRY) {
-            timeout_retry_cnt++;
-        } else if (timeout_wait_retry_cnt < TIMEOUT_WAIT_RETRY) {
-            timeout_wait_retry_cnt++;
-            usleep(FABRIC_TIMEOUT * 1000);
-        } else {
-            THROW_ERR_MSG(Fam_Timeout_Exception,
-                          "Timeout retry count exceeded INT_MAX");
+        if ((rxsuccess + rxfail) < rxcnt &&
+            fabric_poll_idle(famCtx, &pollState, true)) {
+            // Returns early with an error if a failure is counted
+            FI_CALL_NO_RETURN(fi_cntr_wait, famCtx->get_rxCntr(),
+                              rxcnt - rxfail, FABRIC_TIMEOUT);
         }
     } while ((rxsuccess + rxfail) < rxcnt);
 
@@ -1603,9 +2016,7 @@ void fabric_fetch_atomic(uint64_t key, void *value, void *result,
 
     struct fi_ioc result_iov = {.addr = result, .count = 1};
 
-    struct fam_fi_context *ctx = new struct fam_fi_context();
-    memset(ctx, 0, sizeof(struct fam_fi_context));
-    ctx->fam_internal[2] = (void *)1;
+    struct fam_fi_context *ctx = famCtx->alloc_fi_context(1);
 
     struct fi_msg_atomic msg = {
         .msg_iov = &iov,
@@ -1644,7 +2055,87 @@ void fabric_fetch_atomic(uint64_t key, void *value, void *result,
     // Release Fam_Context read lock
     famCtx->release_lock();
 
-    delete ctx;
+    famCtx->free_fi_context((struct fi_context *)ctx);
+
+    return;
+}
+
+/*
+ * Post a batch of atomics under a single acquisition of the context lock.
+ * FI_MORE is set on all but the last atomic so that the provider can defer
+ * ringing the doorbell until the whole batch is queued.
+ * @param ioList - atomics to be posted
+ * @param famCtx - Pointer to Fam_Context
+ * @param fetch - set to fetch the old values into the result of each atomic
+ * and wait for the whole batch to complete. Non-fetching atomics are
+ * injected and complete as part of fam_quiet.
+ */
+void fabric_atomic_batch(std::vector<struct fam_atomic_io> &ioList,
+                         Fam_Context *famCtx, bool fetch) {
+    ssize_t ret;
+    uint64_t count = ioList.size();
+    uint64_t incr = 0;
+    struct fam_fi_context *ctx = NULL;
+
+    if (count == 0)
+        return;
+
+    if (fetch)
+        ctx = famCtx->alloc_fi_context(count);
+
+    // Take Fam_Context read lock
+    famCtx->acquire_RDLock();
+
+    try {
+        for (uint64_t i = 0; i < count; i++) {
+            struct fam_atomic_io *io = &ioList[i];
+            struct fi_ioc iov = {.addr = io->value, .count = 1};
+            struct fi_rma_ioc rma_iov = {
+                .addr = io->offset, .count = 1, .key = io->key};
+            struct fi_msg_atomic msg = {
+                .msg_iov = &iov,
+                .desc = famCtx->get_mr_descs(io->value, sizeof(uint64_t)),
+                .iov_count = 1,
+                .addr = io->fiAddr,
+                .rma_iov = &rma_iov,
+                .rma_iov_count = 1,
+                .datatype = io->datatype,
+                .op = io->op,
+                .context = (struct fi_context *)ctx,
+                .data = 0};
+            uint64_t flags = (i + 1 < count) ? FI_MORE : 0;
+            uint32_t retry_cnt = 0;
+
+            if (fetch) {
+                struct fi_ioc result_iov = {.addr = io->result, .count = 1};
+                do {
+                    FI_CALL(ret, fi_fetch_atomicmsg, famCtx->get_ep(), &msg,
+                            &result_iov, 0, 1, flags | FI_COMPLETION);
+                } while (fabric_retry(famCtx, ret, &retry_cnt));
+                famCtx->inc_num_rx_ops();
+                incr++;
+            } else {
+                do {
+                    FI_CALL(ret, fi_atomicmsg, famCtx->get_ep(), &msg,
+                            flags | FI_INJECT);
+                } while (fabric_retry(famCtx, ret, &retry_cnt));
+                famCtx->inc_num_tx_ops();
+            }
+        }
+        if (fetch)
+            ret = fabric_completion_wait(famCtx, (struct fi_context *)ctx, 0);
+    } catch (...) {
+        famCtx->inc_num_rx_fail_cnt(incr);
+        // Release Fam_Context read lock
+        famCtx->release_lock();
+        throw;
+    }
+
+    // Release Fam_Context read lock
+    famCtx->release_lock();
+
+    if (fetch)
+        famCtx->free_fi_context((struct fi_context *)ctx);
 
     return;
 }
@@ -1661,9 +2152,7 @@ void fabric_compare_atomic(uint64_t key, void *compare, void *result,
 
     struct fi_ioc compare_iov = {.addr = compare, .count = 1};
 
-    struct fam_fi_context *ctx = new struct fam_fi_context();
-    memset(ctx, 0, sizeof(struct fam_fi_context));
-    ctx->fam_internal[2] = (void *)1;
+    struct fam_fi_context *ctx = famCtx->alloc_fi_context(1);
 
     struct fi_msg_atomic msg = {
         .msg_iov = &iov,
@@ -1703,10 +2192,49 @@ void fabric_compare_atomic(uint64_t key, void *compare, void *result,
     // Release Fam_Context read lock
     famCtx->release_lock();
 
-    delete ctx;
+    famCtx->free_fi_context((struct fi_context *)ctx);
 
     return;
 }
+
+bool fabric_int128_atomics_valid(struct fid_ep *ep) {
+#ifdef FAM_FI_INT128_ATOMICS
+    size_t count = 0;
+    if (fi_compare_atomicvalid(ep, FI_INT128, FI_CSWAP, &count) != 0 ||
+        count < 1)
+        return false;
+    count = 0;
+    if (fi_fetch_atomicvalid(ep, FI_INT128, FI_ATOMIC_READ, &count) != 0 ||
+        count < 1)
+        return false;
+    count = 0;
+    if (fi_atomicvalid(ep, FI_INT128, FI_ATOMIC_WRITE, &count) != 0 ||
+        count < 1)
+        return false;
+    return true;
+#else
+    return false;
+#endif
+}
+
+void fabric_atomic128(uint64_t key, void *value, void *result, void *compare,
+                      uint64_t offset, enum fi_op op, fi_addr_t fiAddr,
+                      Fam_Context *famCtx) {
+#ifdef FAM_FI_INT128_ATOMICS
+    if (op == FI_CSWAP)
+        fabric_compare_atomic(key, compare, result, value, offset, op,
+                              FI_INT128, fiAddr, famCtx);
+    else if (op == FI_ATOMIC_READ)
+        fabric_fetch_atomic(key, value, result, offset, op, FI_INT128, fiAddr,
+                            famCtx);
+    else
+        fabric_atomic(key, value, offset, op, FI_INT128, fiAddr, famCtx);
+#else
+    THROW_ERR_MSG(Fam_Datapath_Exception,
+                  "128-bit atomics not supported by this libfabric version");
+#endif
+}
+
 /* Fabric error string
  * @param fabErr - errno returned by libfabric fall
  * @return string
@@ -1747,9 +2275,7 @@ void fabric_send_response(void *retStatus, fi_addr_t fiAddr,
                           Fam_Context *famCtx, size_t nbytes) {
     struct iovec iov = {.iov_base = (void *)retStatus, .iov_len = nbytes};
 
-    struct fam_fi_context *ctx = new struct fam_fi_context();
-    memset(ctx, 0, sizeof(struct fam_fi_context));
-    ctx->fam_internal[2] = (void *)1;
+    struct fam_fi_context *ctx = famCtx->alloc_fi_context(1);
 
     struct fi_msg msg = {.msg_iov = &iov,
                          .desc = 0,
@@ -1781,7 +2307,7 @@ void fabric_send_response(void *retStatus, fi_addr_t fiAddr,
     }
 
     famCtx->release_lock();
-    delete ctx;
+    famCtx->free_fi_context((struct fi_context *)ctx);
 }
 /*
  * fabric post response buff
@@ -1795,9 +2321,7 @@ fi_context *fabric_post_response_buff(void *retStatus, fi_addr_t fiAddr,
                                       Fam_Context *famCtx, size_t nbytes) {
     struct iovec iov = {.iov_base = retStatus, .iov_len = nbytes};
 
-    struct fam_fi_context *ctx = new struct fam_fi_context();
-    memset(ctx, 0, sizeof(struct fam_fi_context));
-    ctx->fam_internal[2] = (void *)1;
+    struct fam_fi_context *ctx = famCtx->alloc_fi_context(1);
     struct fi_msg msg = {.msg_iov = &iov,
                          .desc = 0,
                          .iov_count = 1,
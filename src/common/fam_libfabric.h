@@ -32,6 +32,7 @@
 #define FAM_LIBFABRIC_H
 
 #include <arpa/inet.h>
+#include <chrono>
 #include <iostream>
 #include <map>
 #include <pthread.h>
@@ -58,17 +59,31 @@
 #include "common/fam_options.h"
 #include "fam/fam_exception.h"
 
+// 128-bit integer atomic datatypes were added in libfabric 1.18
+#if FI_VERSION_GE(FI_VERSION(FI_MAJOR_VERSION, FI_MINOR_VERSION),             \
+                  FI_VERSION(1, 18))
+#define FAM_FI_INT128_ATOMICS
+#endif
+
 namespace openfam {
 
-struct fam_fi_context {
-    struct fi_context2;
-    void *fam_internal[8];
+/*
+ * Trailer of the address published by a memory server with additional rails,
+ * which follows the nRails rail addresses of addrLen bytes each
+ */
+#define FAM_RAIL_ADDR_MAGIC 0x4c494152U
+
+struct Fam_Rail_Addr_Trailer {
+    uint32_t magic;
+    uint32_t nRails;
+    uint64_t addrLen;
 };
 
 int fabric_initialize(const char *name, const char *service, bool source,
                       char *provider, char *if_device, struct fi_info **fi,
                       struct fid_fabric **fabric, struct fid_eq **eq,
-                      struct fid_domain **domain, Fam_Thread_Model famTM);
+                      struct fid_domain **domain, Fam_Thread_Model famTM,
+                      const char *rail_addr = NULL);
 
 void fabric_reset_profile(void);
 
@@ -82,6 +97,15 @@ int fabric_initialize_av(struct fi_info *fi, struct fid_domain *domain,
 int fabric_insert_av(const char *addr, struct fid_av *av,
                      std::vector<fi_addr_t> *fiAddrs);
 
+int fabric_remove_av(fi_addr_t fiAddr, struct fid_av *av);
+
+void *fabric_pack_rail_addrs(const void *addr, size_t addrLen,
+                             std::vector<std::pair<void *, size_t>> &railAddrs,
+                             size_t *packedLen);
+
+std::vector<const char *> fabric_unpack_rail_addrs(const void *addr,
+                                                   size_t addrLen);
+
 int fabric_enable_bind_ep(struct fi_info *fi, struct fid_av *av,
                           struct fid_eq *eq, struct fid_ep *ep);
 
@@ -91,6 +115,14 @@ int fabric_register_mr(void *addr, size_t size, uint64_t *key,
 
 int fabric_deregister_mr(fid_mr *&mr);
 
+uint64_t fabric_alloc_mr_key();
+
+Fam_Bounce_Buffer *fabric_alloc_bounce_buffer(Fam_Context *famCtx,
+                                              const void *local,
+                                              size_t nbytes);
+
+void fabric_free_bounce_buffer(Fam_Context *famCtx, Fam_Bounce_Buffer *bb);
+
 int fabric_write(uint64_t key, const void *local, size_t nbytes,
                  uint64_t offset, fi_addr_t fiAddr, Fam_Context *famCtx);
 
@@ -105,6 +137,11 @@ struct fi_context *fabric_read(std::vector<std::pair<iovec, fi_rma_iov>> ioInfo,
                                fi_addr_t fiAddr, Fam_Context *famCtx,
                                size_t iov_limit, uint64_t base, bool block);
 
+uint64_t
+fabric_read_write_batch(std::vector<std::pair<iovec, fi_rma_iov>> &ioInfo,
+                        fi_addr_t fiAddr, Fam_Context *famCtx, size_t iov_limit,
+                        struct fi_context *fiCtx, bool write, bool more);
+
 struct fi_context *fabric_scatter_stride(uint64_t key, const void *local,
                                          size_t nbytes, uint64_t first,
                                          uint64_t count, uint64_t stride,
@@ -141,6 +178,15 @@ fi_context *fabric_read(uint64_t key, const void *local, size_t nbytes,
 
 void fabric_fence(fi_addr_t fiAddr, Fam_Context *context);
 
+/*
+ * State of one completion wait, advanced by fabric_poll_idle
+ */
+struct fam_poll_state {
+    uint64_t polls;
+    uint64_t sleepUsec;
+    std::chrono::steady_clock::time_point start;
+};
+
 void fabric_quiet(Fam_Context *context);
 
 uint64_t fabric_progress(Fam_Context *context);
@@ -149,6 +195,12 @@ int fabric_retry(Fam_Context *context, int ret, uint64_t *retry_cnt);
 
 int fabric_completion_wait(Fam_Context *famCtx, fi_context *ctx, int ioType);
 
+int fabric_completion_test(Fam_Context *famCtx, fi_context *ctx, int ioType);
+
+bool fabric_completion_drain(Fam_Context *famCtx, fi_context *ctx, int ioType);
+
+void fabric_completion_idle(Fam_Context *famCtx, struct fam_poll_state *state);
+
 void fabric_atomic(uint64_t key, void *value, uint64_t offset, enum fi_op op,
                    enum fi_datatype datatype, fi_addr_t fiAddr,
                    Fam_Context *famCtx);
@@ -163,6 +215,37 @@ void fabric_compare_atomic(uint64_t key, void *value, void *result,
                            enum fi_datatype datatype, fi_addr_t fiAddr,
                            Fam_Context *famCtx);
 
+/*
+ * Check whether the provider executes 128-bit integer compare-swap, atomic
+ * read and atomic write on the target side.
+ */
+bool fabric_int128_atomics_valid(struct fid_ep *ep);
+
+/*
+ * 128-bit integer atomic executed by the provider. op is one of FI_CSWAP,
+ * FI_ATOMIC_READ or FI_ATOMIC_WRITE; result and compare are not used by the
+ * operations which do not need them.
+ */
+void fabric_atomic128(uint64_t key, void *value, void *result, void *compare,
+                      uint64_t offset, enum fi_op op, fi_addr_t fiAddr,
+                      Fam_Context *famCtx);
+
+/*
+ * One atomic of a batch posted by fabric_atomic_batch
+ */
+struct fam_atomic_io {
+    uint64_t key;
+    uint64_t offset;
+    void *value;
+    void *result;
+    enum fi_op op;
+    enum fi_datatype datatype;
+    fi_addr_t fiAddr;
+};
+
+void fabric_atomic_batch(std::vector<struct fam_atomic_io> &ioList,
+                         Fam_Context *famCtx, bool fetch);
+
 const char *fabric_strerror(int fabErr);
 
 int fabric_getname_len(struct fid_ep *ep, size_t *addrSize);
@@ -0,0 +1,239 @@
+/*
+ * fam_mr_cache.cpp
+ * Copyright (c) 2024 Hewlett Packard Enterprise Development, LP. All
+ * rights reserved. Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See https://spdx.org/licenses/BSD-3-Clause
+ *
+ */
+
+#include <algorithm>
+#include <dlfcn.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <vector>
+
+#include "common/fam_libfabric.h"
+#include "common/fam_mr_cache.h"
+
+namespace openfam {
+
+// Set while the calling thread is inside a cache, so that a munmap issued
+// by the provider from fi_mr_reg or fi_close does not re-enter it
+static thread_local bool inMrCache = false;
+
+// Caches of the process, looked up by munmap. Never freed, munmap may be
+// called after static destructors have run.
+static std::vector<Fam_Mr_Cache *> *mrCaches = NULL;
+static pthread_mutex_t mrCachesLock = PTHREAD_MUTEX_INITIALIZER;
+static int numMrCaches = 0;
+
+namespace {
+class Mr_Cache_Guard {
+  public:
+    Mr_Cache_Guard(pthread_mutex_t *mutex) : lock(mutex) {
+        inMrCache = true;
+        pthread_mutex_lock(lock);
+    }
+    ~Mr_Cache_Guard() {
+        pthread_mutex_unlock(lock);
+        inMrCache = false;
+    }
+
+  private:
+    pthread_mutex_t *lock;
+};
+} // namespace
+
+Fam_Mr_Cache::Fam_Mr_Cache(struct fid_domain *domain, char *provider,
+                           size_t iovLimit, uint64_t maxEntries,
+                           uint64_t maxBytes, uint64_t minSize)
+    : domain(domain), provider(provider),
+      bindEp(strncmp(provider, "cxi", 3) == 0), iovLimit(iovLimit),
+      maxEntries(maxEntries), maxBytes(maxBytes), minSize(minSize),
+      cachedBytes(0), hitCnt(0), missCnt(0), evictCnt(0) {
+    caching = install_unmap_hook();
+    pthread_mutex_init(&cacheLock, NULL);
+    pthread_mutex_lock(&mrCachesLock);
+    if (mrCaches == NULL)
+        mrCaches = new std::vector<Fam_Mr_Cache *>();
+    mrCaches->push_back(this);
+    __atomic_store_n(&numMrCaches, (int)mrCaches->size(), __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&mrCachesLock);
+}
+
+Fam_Mr_Cache::~Fam_Mr_Cache() {
+    pthread_mutex_lock(&mrCachesLock);
+    mrCaches->erase(std::remove(mrCaches->begin(), mrCaches->end(), this),
+                    mrCaches->end());
+    __atomic_store_n(&numMrCaches, (int)mrCaches->size(), __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&mrCachesLock);
+
+    inMrCache = true;
+    for (auto entry : lru)
+        close_entry(entry);
+    inMrCache = false;
+    pthread_mutex_destroy(&cacheLock);
+}
+
+Fam_Mr_Cache_Entry *Fam_Mr_Cache::acquire(struct fid_ep *ep, const void *addr,
+                                          size_t len) {
+    static uintptr_t pageSize = (uintptr_t)sysconf(_SC_PAGESIZE);
+    uintptr_t start = (uintptr_t)addr & ~(pageSize - 1);
+    uintptr_t end = ((uintptr_t)addr + len + pageSize - 1) & ~(pageSize - 1);
+    Mr_Cache_Guard guard(&cacheLock);
+
+    // The only entry which can cover start is the first one ending after it
+    auto it = entries.upper_bound(start);
+    if (it != entries.end() && it->second->start <= start &&
+        it->second->end >= end && (!bindEp || it->second->ep == ep)) {
+        Fam_Mr_Cache_Entry *entry = it->second;
+        entry->refCnt++;
+        lru.splice(lru.begin(), lru, entry->lruPos);
+        hitCnt++;
+        return entry;
+    }
+    missCnt++;
+
+    // Overlapping entries not in use are merged into the new registration,
+    // one in use leaves the new registration out of the cache
+    bool cacheable = caching;
+    for (auto ov = it; ov != entries.end() && ov->second->start < end; ++ov) {
+        if (ov->second->refCnt > 0)
+            cacheable = false;
+    }
+    if (cacheable) {
+        while (it != entries.end() && it->second->start < end) {
+            Fam_Mr_Cache_Entry *old = it->second;
+            ++it;
+            start = std::min(start, old->start);
+            end = std::max(end, old->end);
+            remove_entry(old);
+            close_entry(old);
+        }
+    }
+
+    Fam_Mr_Cache_Entry *entry = new Fam_Mr_Cache_Entry();
+    entry->start = start;
+    entry->end = end;
+    entry->mr = NULL;
+    entry->ep = bindEp ? ep : NULL;
+    entry->refCnt = 1;
+    entry->cached = false;
+    // Binds and enables the registration where the provider requires it
+    uint64_t key = fabric_alloc_mr_key();
+    int ret = fabric_register_mr((void *)start, end - start, &key, domain, ep,
+                                 provider, true, entry->mr);
+    if (ret < 0) {
+        delete entry;
+        return NULL;
+    }
+    entry->descs = (void **)malloc(iovLimit * sizeof(void *));
+    for (size_t i = 0; i < iovLimit; i++)
+        entry->descs[i] = fi_mr_desc(entry->mr);
+
+    if (cacheable) {
+        entry->cached = true;
+        entries.insert({end, entry});
+        lru.push_front(entry);
+        entry->lruPos = lru.begin();
+        cachedBytes += end - start;
+        evict();
+    }
+    return entry;
+}
+
+void Fam_Mr_Cache::release(Fam_Mr_Cache_Entry *entry) {
+    Mr_Cache_Guard guard(&cacheLock);
+    if (--entry->refCnt == 0 && !entry->cached)
+        close_entry(entry);
+}
+
+void Fam_Mr_Cache::invalidate(const void *addr, size_t len) {
+    uintptr_t start = (uintptr_t)addr;
+    uintptr_t end = start + len;
+    Mr_Cache_Guard guard(&cacheLock);
+    auto it = entries.upper_bound(start);
+    while (it != entries.end() && it->second->start < end) {
+        Fam_Mr_Cache_Entry *entry = it->second;
+        ++it;
+        remove_entry(entry);
+        if (entry->refCnt == 0)
+            close_entry(entry);
+    }
+}
+
+void Fam_Mr_Cache::invalidate_all(const void *addr, size_t len) {
+    if (inMrCache || __atomic_load_n(&numMrCaches, __ATOMIC_ACQUIRE) == 0)
+        return;
+    pthread_mutex_lock(&mrCachesLock);
+    for (auto cache : *mrCaches)
+        cache->invalidate(addr, len);
+    pthread_mutex_unlock(&mrCachesLock);
+}
+
+bool Fam_Mr_Cache::install_unmap_hook() {
+    typedef void (*Set_Hook_Fn)(void (*)(const void *, size_t));
+    Set_Hook_Fn setHook =
+        (Set_Hook_Fn)dlsym(RTLD_DEFAULT, "openfam_set_unmap_hook");
+    if (setHook == NULL)
+        return false;
+    setHook(invalidate_all);
+    return true;
+}
+
+void Fam_Mr_Cache::remove_entry(Fam_Mr_Cache_Entry *entry) {
+    entries.erase(entry->end);
+    lru.erase(entry->lruPos);
+    cachedBytes -= entry->end - entry->start;
+    entry->cached = false;
+}
+
+void Fam_Mr_Cache::close_entry(Fam_Mr_Cache_Entry *entry) {
+    fi_close(&entry->mr->fid);
+    free(entry->descs);
+    delete entry;
+}
+
+// Drop the least recently used entries not in use until the cache is back
+// within its limits
+void Fam_Mr_Cache::evict() {
+    auto it = lru.end();
+    while (it != lru.begin() &&
+           (lru.size() > maxEntries || cachedBytes > maxBytes)) {
+        --it;
+        Fam_Mr_Cache_Entry *entry = *it;
+        if (entry->refCnt > 0)
+            continue;
+        // Keep an iterator to the older neighbour, which survives the erase
+        ++it;
+        remove_entry(entry);
+        close_entry(entry);
+        evictCnt++;
+    }
+}
+
+} // namespace openfam
@@ -0,0 +1,187 @@
+/*
+ * fam_mr_cache.h
+ * Copyright (c) 2024 Hewlett Packard Enterprise Development, LP. All
+ * rights reserved. Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See https://spdx.org/licenses/BSD-3-Clause
+ *
+ */
+#ifndef FAM_MR_CACHE_H
+#define FAM_MR_CACHE_H
+
+#include <list>
+#include <map>
+#include <pthread.h>
+#include <stdint.h>
+
+#include <rdma/fabric.h>
+#include <rdma/fi_domain.h>
+
+namespace openfam {
+
+/*
+ * Registration of a page aligned range of local memory. An entry that is
+ * no longer cached (evicted, invalidated or never inserted) is closed when
+ * its last user releases it.
+ */
+struct Fam_Mr_Cache_Entry {
+    uintptr_t start;
+    uintptr_t end;
+    struct fid_mr *mr;
+    // Endpoint the registration is bound to, if the provider needs one
+    struct fid_ep *ep;
+    void **descs;
+    uint64_t refCnt;
+    bool cached;
+    std::list<Fam_Mr_Cache_Entry *>::iterator lruPos;
+};
+
+/*
+ * Fam_Mr_Cache - registrations of user buffers in a fabric domain, reused
+ * by later transfers to the same memory. Entries do not overlap and are
+ * kept in a map ordered by their end address, so the entry covering an
+ * address is found with a single upper_bound. Entries not in use are
+ * evicted in LRU order once maxEntries or maxBytes is exceeded, and
+ * entries of a range are dropped when it is unmapped with munmap.
+ *
+ * munmap is only seen when libopenfam_mrhook is linked into the application
+ * or preloaded. Without it registrations are not kept once released, as
+ * the memory they cover could be unmapped and mapped again unnoticed.
+ */
+class Fam_Mr_Cache {
+  public:
+    Fam_Mr_Cache(struct fid_domain *domain, char *provider, size_t iovLimit,
+                 uint64_t maxEntries, uint64_t maxBytes, uint64_t minSize);
+
+    ~Fam_Mr_Cache();
+
+    /*
+     * Get a registration covering [addr, addr + len), usable by transfers
+     * on ep, and hold it until release(). Returns NULL if the range can not
+     * be registered. With providers that bind registrations to an endpoint
+     * (cxi), an entry of another endpoint is replaced.
+     */
+    Fam_Mr_Cache_Entry *acquire(struct fid_ep *ep, const void *addr,
+                                size_t len);
+
+    void release(Fam_Mr_Cache_Entry *entry);
+
+    /*
+     * Drop the entries overlapping [addr, addr + len); entries in use are
+     * closed when they are released.
+     */
+    void invalidate(const void *addr, size_t len);
+
+    // Invalidate the range in every cache of the process
+    static void invalidate_all(const void *addr, size_t len);
+
+    uint64_t get_min_size() { return minSize; }
+
+    // false if released registrations are closed, see the class comment
+    bool is_caching() { return caching; }
+
+    uint64_t get_hit_count() { return hitCnt; }
+
+    uint64_t get_miss_count() { return missCnt; }
+
+    uint64_t get_evict_count() { return evictCnt; }
+
+    /*
+     * Entry held by the calling thread for the blocking transfer it is
+     * issuing, consulted by Fam_Context::get_mr_descs.
+     */
+    static Fam_Mr_Cache_Entry *get_thread_pin() { return thread_pin(); }
+
+    static void set_thread_pin(Fam_Mr_Cache_Entry *entry) {
+        thread_pin() = entry;
+    }
+
+  private:
+    // Inline, so that Fam_Context users need not link the cache
+    static Fam_Mr_Cache_Entry *&thread_pin() {
+        static thread_local Fam_Mr_Cache_Entry *pin = NULL;
+        return pin;
+    }
+
+    // Have libopenfam_mrhook report munmap calls, if it is loaded
+    static bool install_unmap_hook();
+
+    void remove_entry(Fam_Mr_Cache_Entry *entry);
+
+    void close_entry(Fam_Mr_Cache_Entry *entry);
+
+    void evict();
+
+    struct fid_domain *domain;
+    char *provider;
+    bool bindEp;
+    size_t iovLimit;
+    uint64_t maxEntries;
+    uint64_t maxBytes;
+    uint64_t minSize;
+    bool caching;
+    uint64_t cachedBytes;
+    std::map<uintptr_t, Fam_Mr_Cache_Entry *> entries;
+    // Most recently used entry first
+    std::list<Fam_Mr_Cache_Entry *> lru;
+    pthread_mutex_t cacheLock;
+    uint64_t hitCnt;
+    uint64_t missCnt;
+    uint64_t evictCnt;
+};
+
+/*
+ * Holds a cache entry for the scope of a blocking transfer and makes it
+ * visible to get_mr_descs on the calling thread.
+ */
+class Fam_Mr_Cache_Pin {
+  public:
+    Fam_Mr_Cache_Pin(Fam_Mr_Cache *cache, struct fid_ep *ep, const void *addr,
+                     size_t len)
+        : mrCache(cache), entry(NULL), prevEntry(NULL) {
+        if (mrCache == NULL || len < mrCache->get_min_size())
+            return;
+        entry = mrCache->acquire(ep, addr, len);
+        if (entry == NULL)
+            return;
+        prevEntry = Fam_Mr_Cache::get_thread_pin();
+        Fam_Mr_Cache::set_thread_pin(entry);
+    }
+
+    ~Fam_Mr_Cache_Pin() {
+        if (entry == NULL)
+            return;
+        Fam_Mr_Cache::set_thread_pin(prevEntry);
+        mrCache->release(entry);
+    }
+
+  private:
+    Fam_Mr_Cache *mrCache;
+    Fam_Mr_Cache_Entry *entry;
+    Fam_Mr_Cache_Entry *prevEntry;
+};
+
+} // namespace openfam
+#endif
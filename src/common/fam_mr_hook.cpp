@@ -0,0 +1,61 @@
+/*
+ * fam_mr_hook.cpp
+ * Copyright (c) 2024 Hewlett Packard Enterprise Development, LP. All
+ * rights reserved. Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See https://spdx.org/licenses/BSD-3-Clause
+ *
+ */
+
+/*
+ * libopenfam_mrhook - munmap wrapper for applications that enable mr_cache.
+ * Linked into the application, or preloaded, it reports the ranges being
+ * unmapped to the registration caches of libopenfam, which install their
+ * callback with openfam_set_unmap_hook. It is a library of its own so that
+ * processes which do not ask for it keep the munmap of libc.
+ */
+
+#include <stddef.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+extern "C" {
+
+typedef void (*openfam_unmap_hook_fn)(const void *addr, size_t len);
+
+static openfam_unmap_hook_fn unmapHook = NULL;
+
+void openfam_set_unmap_hook(openfam_unmap_hook_fn hook) {
+    __atomic_store_n(&unmapHook, hook, __ATOMIC_RELEASE);
+}
+
+int munmap(void *addr, size_t len) {
+    openfam_unmap_hook_fn hook = __atomic_load_n(&unmapHook, __ATOMIC_ACQUIRE);
+    if (hook != NULL)
+        hook(addr, len);
+    // The system call itself, no symbol lookup that could allocate or unmap
+    return (int)syscall(SYS_munmap, addr, len);
+}
+}
@@ -0,0 +1,226 @@
+/*
+ * fam_node_bootstrap.h
+ * Copyright (c) 2024 Hewlett Packard Enterprise Development, LP. All
+ * rights reserved. Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See https://spdx.org/licenses/BSD-3-Clause
+ *
+ */
+#ifndef FAM_NODE_BOOTSTRAP_H
+#define FAM_NODE_BOOTSTRAP_H
+
+#include <chrono>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace openfam {
+
+#define FAM_NODE_BOOTSTRAP_MAGIC 0x4f4f4253414d4146ULL
+
+/*
+ * Header of the shared memory segment, followed by infoSize bytes of
+ * memory server information
+ */
+struct Fam_Node_Bootstrap_Header {
+    uint64_t magic;
+    uint32_t state;
+    uint32_t reserved;
+    uint64_t numMemoryNodes;
+    uint64_t infoSize;
+};
+
+typedef enum {
+    FAM_BOOTSTRAP_FILLING = 0,
+    FAM_BOOTSTRAP_READY,
+    FAM_BOOTSTRAP_FAILED
+} Fam_Node_Bootstrap_State;
+
+/*
+ * Fam_Node_Bootstrap - memory server information fetched from the CIS by a
+ * single PE of each node and shared with the other PEs of the node through a
+ * POSIX shared memory segment named after the job. The PE which creates the
+ * segment is the leader of the node; the others map it and wait until the
+ * leader publishes the information. A PE which waits longer than the timeout,
+ * or whose leader failed, fetches the information itself. The leader removes
+ * the segment when it is destroyed.
+ */
+class Fam_Node_Bootstrap {
+  public:
+    Fam_Node_Bootstrap(const char *jobId, uint64_t timeoutMsec)
+        : leader(false), timeout(timeoutMsec) {
+        name = "/openfam_bootstrap_" + std::to_string(getuid()) + "_";
+        // Segment names can not hold '/' past the first character
+        for (const char *c = jobId; *c != '\0' && name.size() < NAME_MAX;
+             c++)
+            name += (*c == '/') ? '_' : *c;
+    }
+
+    ~Fam_Node_Bootstrap() {
+        if (leader)
+            (void)shm_unlink(name.c_str());
+    }
+
+    bool is_leader() { return leader; }
+
+    /*
+     * Get the number of memory servers and their information, which is
+     * returned in a buffer allocated with calloc and owned by the caller.
+     * fetch(numMemoryNodes, info, infoSize) gets them from the CIS.
+     */
+    template <typename Fetch>
+    void get_memserverinfo(uint64_t *numMemoryNodes, void **info,
+                           size_t *infoSize, Fetch fetch) {
+        // A leader which failed removes the segment, and the next PE to
+        // create it takes over
+        for (int attempt = 0; attempt < 2; attempt++) {
+            int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+            if (fd >= 0) {
+                leader = true;
+                lead(fd, numMemoryNodes, info, infoSize, fetch);
+                return;
+            }
+            if (errno != EEXIST)
+                break;
+            fd = shm_open(name.c_str(), O_RDONLY, 0);
+            if (fd < 0) {
+                if (errno == ENOENT)
+                    continue;
+                break;
+            }
+            if (follow(fd, numMemoryNodes, info, infoSize))
+                return;
+            break;
+        }
+        fetch(numMemoryNodes, info, infoSize);
+    }
+
+  private:
+    template <typename Fetch>
+    void lead(int fd, uint64_t *numMemoryNodes, void **info, size_t *infoSize,
+              Fetch fetch) {
+        Fam_Node_Bootstrap_Header *hdr;
+        try {
+            fetch(numMemoryNodes, info, infoSize);
+        } catch (...) {
+            // Release the PEs waiting on the segment before reporting
+            hdr = map_header(fd, sizeof(Fam_Node_Bootstrap_Header));
+            if (hdr != NULL) {
+                __atomic_store_n(&hdr->state, (uint32_t)FAM_BOOTSTRAP_FAILED,
+                                 __ATOMIC_RELEASE);
+                munmap(hdr, sizeof(Fam_Node_Bootstrap_Header));
+            }
+            (void)shm_unlink(name.c_str());
+            leader = false;
+            throw;
+        }
+        size_t segSize = sizeof(Fam_Node_Bootstrap_Header) + *infoSize;
+        hdr = map_header(fd, segSize);
+        if (hdr == NULL) {
+            // The waiting PEs time out and fetch the information themselves
+            (void)shm_unlink(name.c_str());
+            leader = false;
+            return;
+        }
+        hdr->magic = FAM_NODE_BOOTSTRAP_MAGIC;
+        hdr->numMemoryNodes = *numMemoryNodes;
+        hdr->infoSize = *infoSize;
+        if (*infoSize)
+            memcpy(hdr + 1, *info, *infoSize);
+        __atomic_store_n(&hdr->state, (uint32_t)FAM_BOOTSTRAP_READY,
+                         __ATOMIC_RELEASE);
+        munmap(hdr, segSize);
+    }
+
+    // Size the segment of the leader and map it; closes fd
+    Fam_Node_Bootstrap_Header *map_header(int fd, size_t segSize) {
+        void *seg = MAP_FAILED;
+        if (ftruncate(fd, (off_t)segSize) == 0)
+            seg = mmap(NULL, segSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd,
+                       0);
+        close(fd);
+        return (seg == MAP_FAILED) ? NULL : (Fam_Node_Bootstrap_Header *)seg;
+    }
+
+    bool timed_out(std::chrono::steady_clock::time_point start) {
+        return std::chrono::steady_clock::now() - start >
+               std::chrono::milliseconds(timeout);
+    }
+
+    // Wait for the leader to publish the segment and copy it; closes fd
+    bool follow(int fd, uint64_t *numMemoryNodes, void **info,
+                size_t *infoSize) {
+        auto start = std::chrono::steady_clock::now();
+        struct stat st;
+        // The leader sizes the segment once, to its final size
+        while (fstat(fd, &st) == 0 &&
+               (size_t)st.st_size < sizeof(Fam_Node_Bootstrap_Header)) {
+            if (timed_out(start)) {
+                close(fd);
+                return false;
+            }
+            usleep(100);
+        }
+        size_t segSize = (size_t)st.st_size;
+        void *seg = mmap(NULL, segSize, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if (seg == MAP_FAILED)
+            return false;
+        Fam_Node_Bootstrap_Header *hdr = (Fam_Node_Bootstrap_Header *)seg;
+        uint32_t state;
+        while ((state = __atomic_load_n(&hdr->state, __ATOMIC_ACQUIRE)) ==
+               FAM_BOOTSTRAP_FILLING) {
+            if (timed_out(start))
+                break;
+            usleep(100);
+        }
+        bool valid = (state == FAM_BOOTSTRAP_READY &&
+                      hdr->magic == FAM_NODE_BOOTSTRAP_MAGIC &&
+                      sizeof(Fam_Node_Bootstrap_Header) + hdr->infoSize <=
+                          segSize);
+        if (valid) {
+            *numMemoryNodes = hdr->numMemoryNodes;
+            *infoSize = hdr->infoSize;
+            *info = calloc(1, hdr->infoSize);
+            memcpy(*info, hdr + 1, hdr->infoSize);
+        }
+        munmap(seg, segSize);
+        return valid;
+    }
+
+    std::string name;
+    bool leader;
+    uint64_t timeout;
+};
+
+} // namespace openfam
+#endif
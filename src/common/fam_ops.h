@@ -37,6 +37,7 @@
 #include "common/fam_internal.h"
 #include "common/fam_internal_exception.h"
 #include "common/fam_options.h"
+#include "common/fam_request.h"
 
 #include <iostream>
 #include <sstream>
@@ -112,7 +113,8 @@ class Fam_Ops {
      * @param nbytes - number of bytes to be copied from global to local memory
      */
     virtual void get_nonblocking(void *local, Fam_Descriptor *descriptor,
-                                 uint64_t offset, uint64_t nbytes) = 0;
+                                 uint64_t offset, uint64_t nbytes,
+                                 Fam_Request *request = NULL) = 0;
 
     /**
      * Copy data from local memory to FAM, blocking until the copy is complete.
@@ -139,7 +141,28 @@ class Fam_Ops {
      * @param nbytes - number of bytes to be copied from local to FAM
      */
     virtual void put_nonblocking(void *local, Fam_Descriptor *descriptor,
-                                 uint64_t offset, uint64_t nbytes) = 0;
+                                 uint64_t offset, uint64_t nbytes,
+                                 Fam_Request *request = NULL) = 0;
+
+    /**
+     * Copy data from FAM to local memory for a batch of transfers, blocking
+     * until all of them are complete.
+     * @param entries - array of transfers
+     * @param nEntries - number of entries in the array
+     * @return - 0 for successful completion, 1 for unsuccessful, and a negative
+     * number in case of exceptions
+     */
+    virtual int get_batch(Fam_Batch_Entry *entries, uint64_t nEntries) = 0;
+
+    /**
+     * Copy data from local memory to FAM for a batch of transfers, blocking
+     * until all of them are complete.
+     * @param entries - array of transfers
+     * @param nEntries - number of entries in the array
+     * @return - 0 for successful completion, 1 for unsuccessful, and a negative
+     * number in case of exceptions
+     */
+    virtual int put_batch(Fam_Batch_Entry *entries, uint64_t nEntries) = 0;
 
     // GATHER/SCATTER subgroup
 
@@ -203,7 +226,8 @@ class Fam_Ops {
      */
     virtual void gather_nonblocking(void *local, Fam_Descriptor *descriptor,
                                     uint64_t nElements, uint64_t firstElement,
-                                    uint64_t stride, uint64_t elementSize) = 0;
+                                    uint64_t stride, uint64_t elementSize,
+                                    Fam_Request *request = NULL) = 0;
 
     /**
      * Gather data from FAM to local memory, blocking while copy is complete
@@ -221,7 +245,8 @@ class Fam_Ops {
      */
     virtual void gather_nonblocking(void *local, Fam_Descriptor *descriptor,
                                     uint64_t nElements, uint64_t *elementIndex,
-                                    uint64_t elementSize) = 0;
+                                    uint64_t elementSize,
+                                    Fam_Request *request = NULL) = 0;
 
     /**
      * Scatter data from local memory to FAM.
@@ -282,7 +307,8 @@ class Fam_Ops {
      */
     virtual void scatter_nonblocking(void *local, Fam_Descriptor *descriptor,
                                      uint64_t nElements, uint64_t firstElement,
-                                     uint64_t stride, uint64_t elementSize) = 0;
+                                     uint64_t stride, uint64_t elementSize,
+                                     Fam_Request *request = NULL) = 0;
 
     /**
      * Initiate a scatter data from local memory to FAM.
@@ -301,7 +327,43 @@ class Fam_Ops {
      */
     virtual void scatter_nonblocking(void *local, Fam_Descriptor *descriptor,
                                      uint64_t nElements, uint64_t *elementIndex,
-                                     uint64_t elementSize) = 0;
+                                     uint64_t elementSize,
+                                     Fam_Request *request = NULL) = 0;
+
+    /**
+     * Check whether all IOs of a request issued by one of the nonblocking
+     * calls above have completed, without waiting for them.
+     * @param request - request to be checked
+     * @return - true if the request is complete
+     */
+    virtual bool test_request(Fam_Request *request) = 0;
+
+    /**
+     * Wait until all IOs of a request have completed.
+     * @param request - request to be waited on
+     */
+    virtual void wait_request(Fam_Request *request) = 0;
+
+    /**
+     * Wait until any one of an array of requests has completed. NULL
+     * entries are skipped.
+     * @param requests - array of requests
+     * @param count - number of entries in the array
+     * @param failed - set to the index of the request that failed when an
+     * exception is thrown
+     * @return - index of the completed request, or count if all entries are
+     * NULL
+     */
+    virtual uint64_t wait_any_request(Fam_Request **requests, uint64_t count,
+                                      uint64_t *failed) = 0;
+
+    /**
+     * Wait for the IOs of a request that failed to be posted or completed,
+     * ignoring their errors, and release their resources so that the
+     * request can be deleted. Never throws.
+     * @param request - request to be drained, may be NULL
+     */
+    virtual void drain_request(Fam_Request *request) = 0;
 
     // COPY Subgroup
 
@@ -698,6 +760,19 @@ class Fam_Ops {
     virtual uint64_t atomic_fetch_xor(Fam_Descriptor *descriptor,
                                       uint64_t offset, uint64_t value) = 0;
 
+    /**
+     * atomic batch - issue a batch of atomics. Entries are assumed to have
+     * been validated by the caller.
+     * @param entries - array of atomics
+     * @param nEntries - number of entries in the array
+     * @param results - array where the old values are returned; NULL for
+     * non-fetching atomics, in which case completion is only guaranteed
+     * after quiet()
+     */
+    virtual void atomic_batch(Fam_Atomic_Batch_Entry *entries,
+                              uint64_t nEntries,
+                              Fam_Atomic_Value *results) = 0;
+
     // MEMORY ORDERING Routines - provide ordering of FAM operations issued by a
     // PE
 
@@ -718,6 +793,28 @@ class Fam_Ops {
      */
     virtual void quiet(Fam_Region_Descriptor *descriptor = NULL) = 0;
 
+    /**
+     * invalidate - drop the data of a data item, or of all data items of a
+     * region, cached by this PE so that later reads fetch it from FAM.
+     * @param descriptor - valid descriptor to data item in FAM
+     * @param offset - byte offset within the data item of the range
+     * @param nbytes - number of bytes in the range
+     */
+    virtual void invalidate(Fam_Descriptor *descriptor, uint64_t offset,
+                            uint64_t nbytes) = 0;
+    virtual void invalidate(Fam_Region_Descriptor *descriptor) = 0;
+
+    /**
+     * prefetch - start reading a range of a data item into memory of this
+     * PE, so that later blocking gets of the range are served locally. The
+     * range may be read only in part; prefetch never fails because of it.
+     * @param descriptor - valid descriptor to data item in FAM
+     * @param offset - byte offset within the data item of the range
+     * @param nbytes - number of bytes in the range
+     */
+    virtual void prefetch(Fam_Descriptor *descriptor, uint64_t offset,
+                          uint64_t nbytes) = 0;
+
     /**
      * progress - returns number of all its pending FAM
      * operations (put, scatter, atomics, copy).
@@ -31,8 +31,13 @@
 #ifndef FAM_OPS_LIBFABRIC_H
 #define FAM_OPS_LIBFABRIC_H
 
+#include <condition_variable>
+#include <exception>
+#include <functional>
 #include <iostream>
 #include <map>
+#include <mutex>
+#include <string>
 #include <string.h>
 #include <sys/uio.h>
 #include <thread>
@@ -48,10 +53,16 @@
 #include <rdma/fi_rma.h>
 
 #include "allocator/fam_allocator_client.h"
+#include "common/fam_addr_table.h"
+#include "common/fam_atomic_combiner.h"
 #include "common/fam_context.h"
 #include "common/fam_internal.h"
+#include "common/fam_mr_cache.h"
+#include "common/fam_node_bootstrap.h"
 #include "common/fam_ops.h"
 #include "common/fam_options.h"
+#include "common/fam_read_cache.h"
+#include "common/fam_write_combiner.h"
 #include "fam/fam.h"
 
 using namespace std;
@@ -59,6 +70,122 @@ using namespace std;
 namespace openfam {
 
 class Fam_Allocator_Client;
+class Fam_Ops_Libfabric;
+
+/*
+ * Fam_Context owned by a thread in the FAM_CONTEXT_THREAD model
+ */
+struct Fam_Thread_Context {
+    Fam_Ops_Libfabric *famOps;
+    Fam_Context *famCtx;
+};
+
+/*
+ * Additional fabric interface of a client, with its own domain and address
+ * vector
+ */
+struct Fam_Rail {
+    struct fi_info *fi;
+    struct fid_fabric *fabric;
+    struct fid_eq *eq;
+    struct fid_domain *domain;
+    struct fid_av *av;
+    // Address of each memory server on this rail, indexed by nodeId
+    Fam_Addr_Table fiAddrs;
+    // Registrations of local buffers in the domain of the rail
+    Fam_Mr_Cache *mrCache;
+};
+
+/*
+ * Helper thread of a stripe, started with the stripe set, which runs the
+ * range of each striped transfer assigned to the stripe
+ */
+class Fam_Stripe_Worker {
+  public:
+    Fam_Stripe_Worker()
+        : job(nullptr), busy(false), stop(false),
+          worker(&Fam_Stripe_Worker::run, this) {}
+
+    ~Fam_Stripe_Worker() {
+        {
+            std::lock_guard<std::mutex> guard(mtx);
+            stop = true;
+        }
+        cond.notify_all();
+        worker.join();
+    }
+
+    // Hand a range to the thread; the previous one must have been waited on
+    void start(std::function<void()> fn) {
+        {
+            std::lock_guard<std::mutex> guard(mtx);
+            job = fn;
+            error = nullptr;
+            busy = true;
+        }
+        cond.notify_all();
+    }
+
+    // Wait for the range handed by start() and rethrow its exception
+    void wait() {
+        std::unique_lock<std::mutex> lk(mtx);
+        cond.wait(lk, [this] { return !busy; });
+        if (error)
+            std::rethrow_exception(error);
+    }
+
+  private:
+    void run() {
+        std::unique_lock<std::mutex> lk(mtx);
+        for (;;) {
+            cond.wait(lk, [this] { return (job != nullptr) || stop; });
+            if (stop)
+                return;
+            std::function<void()> fn = job;
+            std::exception_ptr err;
+            lk.unlock();
+            try {
+                fn();
+            } catch (...) {
+                err = std::current_exception();
+            }
+            lk.lock();
+            error = err;
+            job = nullptr;
+            busy = false;
+            cond.notify_all();
+        }
+    }
+
+    std::mutex mtx;
+    std::condition_variable cond;
+    std::function<void()> job;
+    std::exception_ptr error;
+    bool busy;
+    bool stop;
+    // Started last, once the members above are constructed
+    std::thread worker;
+};
+
+/*
+ * Endpoint of a stripe set, the rail it belongs to, NULL for the primary
+ * interface, and the thread driving it
+ */
+struct Fam_Stripe {
+    Fam_Context *ctx;
+    Fam_Rail *rail;
+    Fam_Stripe_Worker *worker;
+};
+
+/*
+ * Additional endpoints over which large blocking transfers are spread, used
+ * by one transfer at a time
+ */
+struct Fam_Stripe_Set {
+    std::vector<Fam_Stripe> stripes;
+    std::vector<Fam_Rail *> rails;
+    pthread_mutex_t lock;
+};
 
 class Fam_Ops_Libfabric : public Fam_Ops {
   public:
@@ -108,6 +235,8 @@ class Fam_Ops_Libfabric : public Fam_Ops {
                      uint64_t nbytes);
     int get_blocking(void *local, Fam_Descriptor *descriptor, uint64_t offset,
                      uint64_t nbytes);
+    int get_batch(Fam_Batch_Entry *entries, uint64_t nEntries);
+    int put_batch(Fam_Batch_Entry *entries, uint64_t nEntries);
     int gather_blocking(void *local, Fam_Descriptor *descriptor,
                         uint64_t nElements, uint64_t firstElement,
                         uint64_t stride, uint64_t elementSize);
@@ -125,26 +254,39 @@ class Fam_Ops_Libfabric : public Fam_Ops {
                          uint64_t elementSize);
 
     void put_nonblocking(void *local, Fam_Descriptor *descriptor,
-                         uint64_t offset, uint64_t nbytes);
+                         uint64_t offset, uint64_t nbytes,
+                         Fam_Request *request = NULL);
 
     void get_nonblocking(void *local, Fam_Descriptor *descriptor,
-                         uint64_t offset, uint64_t nbytes);
+                         uint64_t offset, uint64_t nbytes,
+                         Fam_Request *request = NULL);
 
     void gather_nonblocking(void *local, Fam_Descriptor *descriptor,
                             uint64_t nElements, uint64_t firstElement,
-                            uint64_t stride, uint64_t elementSize);
+                            uint64_t stride, uint64_t elementSize,
+                            Fam_Request *request = NULL);
 
     void gather_nonblocking(void *local, Fam_Descriptor *descriptor,
                             uint64_t nElements, uint64_t *elementIndex,
-                            uint64_t elementSize);
+                            uint64_t elementSize, Fam_Request *request = NULL);
 
     void scatter_nonblocking(void *local, Fam_Descriptor *descriptor,
                              uint64_t nElements, uint64_t firstElement,
-                             uint64_t stride, uint64_t elementSize);
+                             uint64_t stride, uint64_t elementSize,
+                             Fam_Request *request = NULL);
 
     void scatter_nonblocking(void *local, Fam_Descriptor *descriptor,
                              uint64_t nElements, uint64_t *elementIndex,
-                             uint64_t elementSize);
+                             uint64_t elementSize, Fam_Request *request = NULL);
+
+    bool test_request(Fam_Request *request);
+
+    void wait_request(Fam_Request *request);
+
+    uint64_t wait_any_request(Fam_Request **requests, uint64_t count,
+                              uint64_t *failed);
+
+    void drain_request(Fam_Request *request);
 
     void quiet(Fam_Region_Descriptor *descriptor = NULL);
     void *copy(Fam_Descriptor *src, uint64_t srcOffset, Fam_Descriptor *dest,
@@ -158,6 +300,13 @@ class Fam_Ops_Libfabric : public Fam_Ops {
 
     void fence(Fam_Region_Descriptor *descriptor = NULL);
 
+    void invalidate(Fam_Descriptor *descriptor, uint64_t offset,
+                    uint64_t nbytes);
+    void invalidate(Fam_Region_Descriptor *descriptor);
+
+    void prefetch(Fam_Descriptor *descriptor, uint64_t offset,
+                  uint64_t nbytes);
+
     uint64_t progress();
     void check_progress(Fam_Region_Descriptor *descriptor = NULL);
 
@@ -321,6 +470,9 @@ class Fam_Ops_Libfabric : public Fam_Ops {
                               uint32_t value);
     uint64_t atomic_fetch_xor(Fam_Descriptor *descriptor, uint64_t offset,
                               uint64_t value);
+
+    void atomic_batch(Fam_Atomic_Batch_Entry *entries, uint64_t nEntries,
+                      Fam_Atomic_Value *results);
     void context_open(uint64_t contextId, Fam_Ops *famOpsObj);
     void context_close(uint64_t contextId);
     /**
@@ -334,10 +486,13 @@ class Fam_Ops_Libfabric : public Fam_Ops {
     struct fid_domain *get_domain() {
         return domain;
     };
-    std::vector<fi_addr_t> *get_fiAddrs() { return fiAddrs; };
+    Fam_Addr_Table *get_fiAddrs() { return fiAddrs; };
 
     // Use context_id instead of nodeID
     Fam_Context *get_defaultCtx(uint64_t nodeId) {
+        // Only the default context is ever present, keep it off the map
+        if (nodeId == FAM_DEFAULT_CTX_ID && defCtx != NULL)
+            return defCtx;
         auto obj = defContexts->find(nodeId);
         if (obj == defContexts->end())
             THROW_ERR_MSG(Fam_Datapath_Exception,
@@ -349,27 +504,42 @@ class Fam_Ops_Libfabric : public Fam_Ops {
     // TODO: Lets not use this two varients of get_defautlCtx
     //      To be deleted.
     Fam_Context *get_defaultCtx(Fam_Region_Descriptor *descriptor) {
-        auto obj = defContexts->find(get_context_id());
-        if (obj == defContexts->end())
-            THROW_ERR_MSG(Fam_Datapath_Exception,
-                          "Context for memserver not found");
-        else
-            return obj->second;
+        return get_defaultCtx(get_context_id());
     };
 
     Fam_Context *get_defaultCtx(Fam_Descriptor *descriptor) {
-        auto obj = defContexts->find(get_context_id());
-        if (obj == defContexts->end())
-            THROW_ERR_MSG(Fam_Datapath_Exception,
-                          "Context for memserver not found");
-        else
-            return obj->second;
+        return get_defaultCtx(get_context_id());
     };
 
     uint64_t get_context_id() { return ctxId; };
 
     void set_context_id(uint64_t contextID) { ctxId = contextID; };
-    Fam_Context *get_context() { return ctxObj; };
+    Fam_Context *get_context() {
+        if (threadContexts)
+            return get_thread_context();
+        return ctxObj;
+    };
+
+    /**
+     * Get the context of the calling thread in the FAM_CONTEXT_THREAD model,
+     * opening one with its own endpoint, CQs and counters on first use.
+     * Contexts of exited threads are reused.
+     */
+    Fam_Context *get_thread_context() {
+        Fam_Thread_Context *threadCtx =
+            (Fam_Thread_Context *)pthread_getspecific(threadCtxKey);
+        if (threadCtx != NULL)
+            return threadCtx->famCtx;
+        return open_thread_context();
+    }
+
+    Fam_Context *open_thread_context();
+
+    /**
+     * Quiet the context of an exiting thread and make it available to the
+     * next thread that opens one.
+     */
+    void release_thread_context(Fam_Thread_Context *threadCtx);
     void set_context(Fam_Context *ctx) { ctxObj = ctx; };
 
     pthread_rwlock_t *get_mr_lock() { return &fiMrLock; };
@@ -378,7 +548,14 @@ class Fam_Ops_Libfabric : public Fam_Ops {
 
     pthread_mutex_t *get_ctx_lock() { return &ctxLock; };
 
-    Fam_Context *get_context(Fam_Descriptor *descriptor);
+    /**
+     * Context used for the data path operations on descriptor. The context
+     * model is validated by initialize(), so this is the context of the
+     * calling thread or the default context.
+     */
+    Fam_Context *get_context(Fam_Descriptor *descriptor) {
+        return get_context();
+    }
 
     void quiet_context(Fam_Context *context);
 
@@ -409,8 +586,374 @@ class Fam_Ops_Libfabric : public Fam_Ops {
 
     size_t get_fabric_iov_limit() { return fabric_iov_limit; }
     size_t get_fabric_max_msg_size() { return fabric_max_msg_size; }
+    uint64_t get_io_pipeline_depth() { return ioPipelineDepth; }
+    void set_io_pipeline_depth(uint64_t depth) { ioPipelineDepth = depth; }
+
+    /**
+     * Spread blocking gets and puts of at least minSize bytes over count
+     * endpoints, the context of the caller and count - 1 endpoints opened by
+     * initialize(), each driven by its own thread. A count of 1 disables
+     * striping. Must be called before initialize().
+     */
+    void set_io_striping(uint64_t count, uint64_t minSize) {
+        ioStripeCount = count;
+        ioStripeMinSize = minSize;
+    }
+
+    /**
+     * Open an additional rail on each of the given interfaces, named by a
+     * local address or, with the cxi provider, by device name. Large
+     * blocking gets and puts are striped over the primary interface and the
+     * rails, with io_stripe_count endpoints on each. Must be called before
+     * initialize().
+     */
+    void set_rails(std::vector<std::string> addrs) { railAddrs = addrs; }
+
+    /**
+     * Open the fabric of a memory server rail on the interface owning the
+     * given address instead of the primary interface. Must be called before
+     * initialize().
+     */
+    void set_rail_address(const char *addr) { railAddress = strdup(addr); }
+
+    /**
+     * Allow 128-bit atomics to be executed by the provider when it supports
+     * them. Must be called before initialize(), which probes the provider.
+     */
+    void set_native_int128_atomics(bool enable) {
+        nativeInt128Atomics = enable;
+    }
+    bool is_native_int128_atomics() { return nativeInt128Atomics; }
+
+    /**
+     * Set the completion polling of the contexts opened by this object.
+     * Must be called before initialize().
+     * @param mode - what a completion wait does once its spin budget is
+     * exhausted
+     * @param spinCount - number of empty polls before mode takes effect
+     * @param maxSleepUsec - longest sleep of the backoff mode
+     */
+    void set_completion_poll(Fam_Poll_Mode mode, uint64_t spinCount,
+                             uint64_t maxSleepUsec) {
+        pollMode = mode;
+        pollSpinCount = spinCount;
+        pollMaxSleepUsec = maxSleepUsec;
+    }
+
+    /**
+     * Let the memory server pack and unpack the elements of blocking
+     * gathers and scatters, which then move as a single RDMA. Off unless
+     * enabled with sg_offload. Must be called before initialize(), which
+     * disables it for providers without automatic data progress.
+     * @param enable - allow the offload
+     * @param minElements - fewest elements an offloaded call may have
+     * @param maxElementSize - largest element size an offloaded call may have
+     */
+    void set_sg_offload(bool enable, uint64_t minElements,
+                        uint64_t maxElementSize) {
+        sgOffload = enable;
+        sgOffloadMinElements = minElements;
+        sgOffloadMaxElementSize = maxElementSize;
+    }
+    bool is_sg_offload() { return sgOffload; }
+
+    /**
+     * Cache the registrations of user buffers of blocking gets and puts.
+     * Must be called before initialize(), which opens the cache.
+     * @param maxEntries - most registrations kept in the cache
+     * @param maxBytes - most bytes of memory kept registered
+     * @param minSize - smallest transfer whose buffer is registered
+     */
+    void enable_mr_cache(uint64_t maxEntries, uint64_t maxBytes,
+                         uint64_t minSize) {
+        mrCacheEnabled = true;
+        mrCacheMaxEntries = maxEntries;
+        mrCacheMaxBytes = maxBytes;
+        mrCacheMinSize = minSize;
+    }
+    Fam_Mr_Cache *get_mr_cache() { return mrCache; }
+
+    /**
+     * Give every context opened by this object a pool of registered bounce
+     * buffers for small blocking gets and puts from unregistered memory.
+     * Must be called before initialize().
+     * @param maxSize - largest transfer copied through the pool
+     * @param count - number of buffers of each size class
+     */
+    void enable_bounce_buffers(uint64_t maxSize, uint64_t count) {
+        bounceMaxSize = maxSize;
+        bounceCount = count;
+    }
+
+    /**
+     * Keep size contexts ready for context_open(): initialize() creates them
+     * and context_close() returns closed contexts to the pool while it holds
+     * fewer than size. Must be called before initialize().
+     * @param size - number of idle contexts kept, 0 disables the pool
+     */
+    void set_context_pool_size(uint64_t size) { ctxPoolSize = size; }
+
+    /**
+     * Fetch the memory server information once per node: the first PE of
+     * the job on the node gets it from the CIS and publishes it in shared
+     * memory for the other PEs. Must be called before initialize().
+     * @param jobId - identifier of the job, shared by all its PEs
+     * @param timeoutMsec - time a PE waits for the first PE before fetching
+     * the information itself
+     */
+    void enable_node_bootstrap(const char *jobId, uint64_t timeoutMsec) {
+        delete nodeBootstrap;
+        nodeBootstrap = new Fam_Node_Bootstrap(jobId, timeoutMsec);
+    }
+
+    /**
+     * Have the default, thread and fam_context_open contexts transmit and
+     * receive through one shared transmit and one shared receive context of
+     * the domain, if the provider supports them, rather than through
+     * hardware contexts of their own. Each context keeps its completion
+     * queues and counters. Must be called before initialize().
+     */
+    void enable_shared_contexts() { sharedContexts = true; }
+
+    /**
+     * Serve blocking gets from a cache of data item pages in local memory.
+     * Writes issued by this PE invalidate the pages they overlap; writes of
+     * other PEs are seen only after an invalidate(). Must be called before
+     * initialize(), which allocates the cache.
+     * @param size - bytes of memory used for cached pages
+     * @param pageSize - size of a cached page
+     * @param invalidateOnFence - drop the cached pages of a region on
+     * fence()
+     */
+    void enable_read_cache(uint64_t size, uint64_t pageSize,
+                           bool invalidateOnFence) {
+        readCacheEnabled = true;
+        readCacheSize = size;
+        readCachePageSize = pageSize;
+        readCacheInvalidateOnFence = invalidateOnFence;
+    }
+    Fam_Read_Cache *get_read_cache() { return readCache; }
+
+    /**
+     * Enable combining of non-fetching atomics. Must be called before any
+     * atomic is issued on this object.
+     * @param maxEntries - number of pending atomics per thread that triggers
+     * a flush
+     * @param flushUsec - age in microseconds of the oldest pending atomic
+     * that triggers a flush; 0 for no age limit
+     */
+    void enable_atomic_combining(uint64_t maxEntries, uint64_t flushUsec);
+    bool is_atomic_combining() { return atomicCombining; }
+
+    /**
+     * Buffer a non-fetching atomic in the combining table of the calling
+     * thread.
+     * @return - false if combining is disabled and the atomic must be issued
+     * by the caller
+     */
+    template <typename T>
+    bool combine_atomic(Fam_Descriptor *descriptor, uint64_t offset,
+                        Fam_Atomic_Op op, Fam_Atomic_Type type, T value) {
+        if (!atomicCombining)
+            return false;
+        Fam_Atomic_Value atomicValue;
+        atomicValue.uint64Value = 0;
+        memcpy(&atomicValue, &value, sizeof(T));
+        combine_atomic_value(descriptor, offset, op, type, atomicValue);
+        return true;
+    }
+
+    /**
+     * Issue the combined atomics pending in the table of the calling thread,
+     * or in the tables of all threads if allThreads is set.
+     */
+    void flush_combined_atomics(bool allThreads = false);
+
+    /**
+     * Issue and complete the combined operations of all threads on a data
+     * item, before its descriptor is closed or its space deallocated.
+     */
+    void flush_combined_item(Fam_Descriptor *descriptor);
+
+    /**
+     * Enable combining of small nonblocking puts to adjacent or overlapping
+     * ranges of a data item. Must be called before any put is issued on
+     * this object.
+     * @param bufSize - size of the buffer of a run of puts
+     * @param maxPut - largest put that is combined
+     * @param maxBuffers - most run buffers of a thread, open or in flight
+     */
+    void enable_write_combining(uint64_t bufSize, uint64_t maxPut,
+                                uint64_t maxBuffers);
+    bool is_write_combining() { return writeCombining; }
+
+    /**
+     * Issue the runs of puts open in the combiner of the calling thread, or
+     * in the combiners of all threads if allThreads is set. Runs of all
+     * threads are written with blocking puts, as their buffers may be freed
+     * right after, unless wait is false.
+     */
+    void flush_combined_puts(bool allThreads = false, bool wait = true);
     void register_heap(void *base, size_t len);
 
+    /**
+     * Wait for the completion of a single blocking IO and free its fi_context.
+     * @param famCtx - Fam_Context on which the IO was issued
+     * @param ctx - fi_context of the IO
+     * @param isWrite - true for put IO, false for get IO
+     */
+    void wait_for_io(Fam_Context *famCtx, struct fi_context *ctx,
+                     bool isWrite);
+
+    /**
+     * Wait for the completion of the IOs in fiCtxVector, starting at index
+     * *completed, until no more than maxOutstanding of them are pending.
+     * Completed fi_context objects are freed and *completed is advanced.
+     * @param famCtx - Fam_Context on which the IOs were issued
+     * @param fiCtxVector - fi_context pointers of the issued IOs, in order
+     * @param completed - index of the oldest IO not yet waited for
+     * @param maxOutstanding - number of IOs that may remain pending
+     * @param isWrite - true for put IOs, false for get IOs
+     */
+    void wait_for_io_window(Fam_Context *famCtx,
+                            std::vector<struct fi_context *> &fiCtxVector,
+                            size_t *completed, uint64_t maxOutstanding,
+                            bool isWrite);
+
+    /**
+     * Issue the IOs of a batch of get or put transfers grouped per memory
+     * server and wait for a single completion covering all of them.
+     * @param entries - array of transfers
+     * @param nEntries - number of entries in the array
+     * @param isWrite - true for put, false for get
+     * @return - 0 for successful completion
+     */
+    int batch_io(Fam_Batch_Entry *entries, uint64_t nEntries, bool isWrite);
+
+    // Blocking get and put of a range on the given context of a rail, or of
+    // the primary interface if rail is NULL
+    int read_range(Fam_Context *famCtx, Fam_Rail *rail, void *local,
+                   Fam_Descriptor *descriptor, uint64_t offset,
+                   uint64_t nbytes);
+    int write_range(Fam_Context *famCtx, Fam_Rail *rail, void *local,
+                    Fam_Descriptor *descriptor, uint64_t offset,
+                    uint64_t nbytes);
+
+    bool use_striping(uint64_t nbytes) {
+        return (stripeSet != NULL && nbytes >= ioStripeMinSize);
+    }
+
+    // Open the endpoints of the stripe set and the rails they use
+    void init_stripe_set();
+
+    // Open the fabric, domain and address vector of a rail
+    Fam_Rail *open_rail(const char *railAddr, size_t railIndex);
+
+    void close_rail(Fam_Rail *rail);
+
+    // Add an endpoint on the given rail to the stripe set
+    void add_stripe(Fam_Rail *rail);
+
+    /**
+     * Split a blocking get or put in one contiguous range per endpoint of
+     * the stripe set and the context of the caller, and wait for all of
+     * them.
+     * @return - false if the stripe set is used by another transfer, in
+     * which case nothing was issued
+     */
+    bool stripe_blocking(void *local, Fam_Descriptor *descriptor,
+                         uint64_t offset, uint64_t nbytes, bool isWrite);
+
+    // Blocking get that bypasses the read cache
+    int read_blocking(void *local, Fam_Descriptor *descriptor,
+                      uint64_t offset, uint64_t nbytes);
+
+    // Blocking get through the read cache, one page at a time
+    int cached_get(void *local, Fam_Descriptor *descriptor, uint64_t offset,
+                   uint64_t nbytes);
+
+    // Wait for the reads of a prefetched page and publish it
+    void complete_prefetch(Fam_Read_Cache_Prefetch &prefetch);
+
+    // Complete the prefetches posted on a context, or on all contexts if
+    // famCtx is NULL
+    void complete_prefetches(Fam_Context *famCtx);
+
+    // Invalidate the cached pages written by an IO completing at quiet
+    void defer_invalidate(Fam_Descriptor *descriptor, uint64_t offset,
+                          uint64_t nbytes) {
+        if (readCache != NULL)
+            readCache->defer_invalidate(descriptor->get_global_descriptor(),
+                                        offset, nbytes);
+    }
+
+    void combine_atomic_value(Fam_Descriptor *descriptor, uint64_t offset,
+                              Fam_Atomic_Op op, Fam_Atomic_Type type,
+                              Fam_Atomic_Value value);
+
+    Fam_Atomic_Combiner *get_combiner();
+
+    void flush_combiner(Fam_Atomic_Combiner *combiner);
+
+    // Nonblocking put that bypasses the write combiner
+    void write_nonblocking(void *local, Fam_Descriptor *descriptor,
+                           uint64_t offset, uint64_t nbytes,
+                           Fam_Request *request);
+
+    Fam_Write_Combiner *get_write_combiner();
+
+    /**
+     * Merge a put into the combiner of the calling thread.
+     * @return - false if the put was not merged and must be issued by the
+     * caller; the open run of its data item has then been issued
+     */
+    bool combine_put(void *local, Fam_Descriptor *descriptor,
+                     uint64_t offset, uint64_t nbytes);
+
+    // Issue closed runs of puts, with blocking puts if wait is set
+    void issue_write_runs(std::vector<Fam_Write_Run> &runs, bool wait);
+
+    /**
+     * Get the key, remote address and fabric address of a 128-bit value.
+     * Throws if the value crosses an interleave block boundary.
+     */
+    void get_int128_location(Fam_Descriptor *descriptor, uint64_t offset,
+                             uint64_t *key, uint64_t *famPtr,
+                             fi_addr_t *fiAddr);
+
+    // Apply the settings of this object to a newly created Fam_Context
+    void configure_context(Fam_Context *ctx);
+
+    // Create a configured Fam_Context with its endpoint bound and enabled
+    Fam_Context *create_context();
+
+    /*
+     * Issue the runs of all threads, quiet the shared context and recycle
+     * the buffers of all threads; the combiners stay locked meanwhile so
+     * that no buffer issued after the quiet is recycled.
+     */
+    void quiet_shared_write_combiners();
+
+    // Open the shared contexts of enable_shared_contexts()
+    void open_shared_contexts();
+
+    // Get the number of memory servers and their addresses from the CIS
+    void fetch_memserverinfo(uint64_t *numMemNodes, void **memServerInfoBuffer,
+                             size_t *memServerInfoSize);
+
+    bool use_sg_offload(Fam_Descriptor *descriptor, uint64_t nElements,
+                        uint64_t elementSize, bool indexed);
+
+    /**
+     * Gather or scatter through the memory server: the local buffer is
+     * registered and the server moves the packed elements with one RDMA.
+     * Elements are (firstElement + i * stride) when elementIndex is NULL.
+     */
+    void sg_offload(void *local, Fam_Descriptor *descriptor,
+                    uint64_t nElements, uint64_t firstElement,
+                    uint64_t stride, uint64_t *elementIndex,
+                    uint64_t elementSize, bool isScatter);
+
   protected:
     // Server_Map name;
     char *memoryServerName;
@@ -428,6 +971,79 @@ class Fam_Ops_Libfabric : public Fam_Ops {
     size_t serverAddrNameLen;
     void *serverAddrName;
     size_t fabric_max_msg_size;
+    // Maximum chunks of a blocking get/put in flight, 0 for no limit
+    uint64_t ioPipelineDepth;
+    // Striping of large blocking get/put, shared with the contexts opened
+    // from this object
+    uint64_t ioStripeCount;
+    uint64_t ioStripeMinSize;
+    Fam_Stripe_Set *stripeSet;
+    // Interfaces of the additional rails of a client
+    std::vector<std::string> railAddrs;
+    // Interface of a memory server rail, NULL for the primary interface
+    char *railAddress;
+    // Combining of non-fetching atomics, see Fam_Atomic_Combiner
+    bool atomicCombining;
+    uint64_t atomicCombineMaxEntries;
+    uint64_t atomicCombineFlushUsec;
+    // Combining table of each thread, and the list of all of them
+    pthread_key_t combinerKey;
+    std::vector<Fam_Atomic_Combiner *> *combiners;
+    pthread_mutex_t combinerLock;
+    // Combining of small nonblocking puts, see Fam_Write_Combiner
+    bool writeCombining;
+    uint64_t writeCombineBufSize;
+    uint64_t writeCombineMaxPut;
+    uint64_t writeCombineMaxBuffers;
+    // Write combiner of each thread, and the list of all of them
+    pthread_key_t writeCombinerKey;
+    std::vector<Fam_Write_Combiner *> *writeCombiners;
+    pthread_mutex_t writeCombinerLock;
+    // 128-bit atomics executed by the provider instead of under the memory
+    // server CAS lock
+    bool nativeInt128Atomics;
+    // Completion polling of the contexts, see Fam_Context::set_poll_mode
+    Fam_Poll_Mode pollMode;
+    uint64_t pollSpinCount;
+    uint64_t pollMaxSleepUsec;
+    // Packing of small-element gathers and scatters on the memory server
+    bool sgOffload;
+    uint64_t sgOffloadMinElements;
+    uint64_t sgOffloadMaxElementSize;
+    // Registrations of user buffers, shared with the contexts opened from
+    // this object and closed by finalize()
+    bool mrCacheEnabled;
+    uint64_t mrCacheMaxEntries;
+    uint64_t mrCacheMaxBytes;
+    uint64_t mrCacheMinSize;
+    Fam_Mr_Cache *mrCache;
+    // Bounce buffers of each context, none if bounceCount is 0
+    uint64_t bounceMaxSize;
+    uint64_t bounceCount;
+    // Pages of data items read by blocking gets, shared like mrCache
+    bool readCacheEnabled;
+    uint64_t readCacheSize;
+    uint64_t readCachePageSize;
+    bool readCacheInvalidateOnFence;
+    Fam_Read_Cache *readCache;
+    // FAM_CONTEXT_THREAD: contexts of all threads and those free for reuse,
+    // protected by ctxLock
+    bool threadContexts;
+    pthread_key_t threadCtxKey;
+    std::vector<Fam_Thread_Context *> *threadCtxList;
+    std::vector<Fam_Thread_Context *> *freeThreadCtxList;
+    // Local buffer registered on every thread context
+    void *heapBase;
+    size_t heapLen;
+    // Idle contexts handed out by context_open(), protected by ctxLock
+    uint64_t ctxPoolSize;
+    std::vector<Fam_Context *> *ctxPool;
+    // Shares the memory server information between the PEs of a node
+    Fam_Node_Bootstrap *nodeBootstrap;
+    // Transmit and receive contexts shared by the endpoints of the contexts
+    bool sharedContexts;
+    struct fid_stx *stx;
+    struct fid_ep *srx;
     std::map<uint64_t, std::pair<void *, size_t>> *memServerAddrs;
     std::map<uint64_t, fi_addr_t> *fiMemsrvMap;
     pthread_rwlock_t fiMemsrvAddrLock;
@@ -437,10 +1053,12 @@ class Fam_Ops_Libfabric : public Fam_Ops {
     uint64_t nextCtxId;
     uint64_t ctxId;
 
-    std::vector<fi_addr_t> *fiAddrs;
+    Fam_Addr_Table *fiAddrs;
 
     std::map<uint64_t, Fam_Context *> *contexts;
     std::map<uint64_t, Fam_Context *> *defContexts;
+    // FAM_DEFAULT_CTX_ID entry of defContexts
+    Fam_Context *defCtx;
     Fam_Thread_Model famThreadModel;
     Fam_Context_Model famContextModel;
     Fam_Allocator_Client *famAllocator;
@@ -81,6 +81,8 @@ class Fam_Ops_SHM : public Fam_Ops {
                      uint64_t nbytes);
     int get_blocking(void *local, Fam_Descriptor *descriptor, uint64_t offset,
                      uint64_t nbytes);
+    int get_batch(Fam_Batch_Entry *entries, uint64_t nEntries);
+    int put_batch(Fam_Batch_Entry *entries, uint64_t nEntries);
     int gather_blocking(void *local, Fam_Descriptor *descriptor,
                         uint64_t nElements, uint64_t firstElement,
                         uint64_t stride, uint64_t elementSize);
@@ -97,26 +99,39 @@ class Fam_Ops_SHM : public Fam_Ops {
                          uint64_t nElements, uint64_t *elementIndex,
                          uint64_t elementSize);
     void put_nonblocking(void *local, Fam_Descriptor *descriptor,
-                         uint64_t offset, uint64_t nbytes);
+                         uint64_t offset, uint64_t nbytes,
+                         Fam_Request *request = NULL);
 
     void get_nonblocking(void *local, Fam_Descriptor *descriptor,
-                         uint64_t offset, uint64_t nbytes);
+                         uint64_t offset, uint64_t nbytes,
+                         Fam_Request *request = NULL);
 
     void gather_nonblocking(void *local, Fam_Descriptor *descriptor,
                             uint64_t nElements, uint64_t firstElement,
-                            uint64_t stride, uint64_t elementSize);
+                            uint64_t stride, uint64_t elementSize,
+                            Fam_Request *request = NULL);
 
     void gather_nonblocking(void *local, Fam_Descriptor *descriptor,
                             uint64_t nElements, uint64_t *elementIndex,
-                            uint64_t elementSize);
+                            uint64_t elementSize, Fam_Request *request = NULL);
 
     void scatter_nonblocking(void *local, Fam_Descriptor *descriptor,
                              uint64_t nElements, uint64_t firstElement,
-                             uint64_t stride, uint64_t elementSize);
+                             uint64_t stride, uint64_t elementSize,
+                             Fam_Request *request = NULL);
 
     void scatter_nonblocking(void *local, Fam_Descriptor *descriptor,
                              uint64_t nElements, uint64_t *elementIndex,
-                             uint64_t elementSize);
+                             uint64_t elementSize, Fam_Request *request = NULL);
+
+    bool test_request(Fam_Request *request);
+
+    void wait_request(Fam_Request *request);
+
+    uint64_t wait_any_request(Fam_Request **requests, uint64_t count,
+                              uint64_t *failed);
+
+    void drain_request(Fam_Request *request);
 
     void *copy(Fam_Descriptor *src, uint64_t srcOffset, Fam_Descriptor *dest,
                uint64_t destOffset, uint64_t nbytes);
@@ -130,6 +145,14 @@ class Fam_Ops_SHM : public Fam_Ops {
     void fence(Fam_Region_Descriptor *descriptor = NULL);
 
     void quiet(Fam_Region_Descriptor *descriptor = NULL);
+
+    // Data items are accessed in place, nothing is cached
+    void invalidate(Fam_Descriptor *descriptor, uint64_t offset,
+                    uint64_t nbytes) {}
+    void invalidate(Fam_Region_Descriptor *descriptor) {}
+    void prefetch(Fam_Descriptor *descriptor, uint64_t offset,
+                  uint64_t nbytes) {}
+
     uint64_t progress();
     void check_progress(Fam_Region_Descriptor *descriptor = NULL);
     void atomic_set(Fam_Descriptor *descriptor, uint64_t offset, int32_t value);
@@ -290,6 +313,9 @@ class Fam_Ops_SHM : public Fam_Ops {
                               uint32_t value);
     uint64_t atomic_fetch_xor(Fam_Descriptor *descriptor, uint64_t offset,
                               uint64_t value);
+
+    void atomic_batch(Fam_Atomic_Batch_Entry *entries, uint64_t nEntries,
+                      Fam_Atomic_Value *results);
     union int128store {
         struct {
             uint64_t low;
@@ -90,6 +90,7 @@ typedef enum {
 
 #define FAM_CONTEXT_DEFAULT_STR "FAM_CONTEXT_DEFAULT"
 #define FAM_CONTEXT_REGION_STR "FAM_CONTEXT_REGION"
+#define FAM_CONTEXT_THREAD_STR "FAM_CONTEXT_THREAD"
 
 #define FAM_OPTIONS_SHM_STR "shared_memory"
 #define FAM_OPTIONS_MEMSERV_STR "memory_server"
@@ -113,7 +114,9 @@ typedef enum {
 typedef enum {
     /** For single threaded applicaiton */
     FAM_CONTEXT_DEFAULT = 1,
-    FAM_CONTEXT_REGION
+    FAM_CONTEXT_REGION,
+    /** Each thread issues IOs on its own endpoint */
+    FAM_CONTEXT_THREAD
 } Fam_Context_Model;
 
 #endif
@@ -0,0 +1,461 @@
+/*
+ * fam_read_cache.h
+ * Copyright (c) 2024 Hewlett Packard Enterprise Development, LP. All
+ * rights reserved. Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See https://spdx.org/licenses/BSD-3-Clause
+ *
+ */
+#ifndef FAM_READ_CACHE_H
+#define FAM_READ_CACHE_H
+
+#include <map>
+#include <new>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#include "fam/fam.h"
+
+namespace openfam {
+
+/*
+ * Page of a data item: the global descriptor of the item and the index of
+ * the page within it.
+ */
+struct Fam_Read_Cache_Key {
+    uint64_t regionId;
+    uint64_t itemOffset;
+    uint64_t page;
+
+    bool operator<(const Fam_Read_Cache_Key &other) const {
+        if (regionId != other.regionId)
+            return regionId < other.regionId;
+        if (itemOffset != other.itemOffset)
+            return itemOffset < other.itemOffset;
+        return page < other.page;
+    }
+};
+
+/*
+ * Page being filled by a nonblocking read started by a prefetch, which is
+ * published once the read of its request has completed.
+ */
+struct Fam_Read_Cache_Prefetch {
+    Fam_Read_Cache_Key key;
+    uint64_t frameIdx;
+    uint64_t fillGen;
+    uint64_t len;
+    Fam_Request *request;
+    // Context the reads are posted on, which only its owner may poll
+    const void *owner;
+    // The reads of the request have all been posted
+    bool issued;
+};
+
+/*
+ * Fam_Read_Cache - pages of data items read by blocking gets, kept in a
+ * fixed number of page frames replaced in CLOCK order. A miss is filled
+ * outside of the cache lock: reserve() takes a frame, the caller reads the
+ * page into it and publish() makes it visible, unless an invalidation ran
+ * in between, in which case the page may predate a write and is dropped.
+ *
+ * Writes that complete only at quiet (nonblocking puts and scatters,
+ * non-fetching atomics, copies) are invalidated with defer_invalidate(),
+ * which applies the invalidation again in apply_deferred(), so that a page
+ * read while the write is in flight does not outlive it.
+ *
+ * Prefetched pages hold their frame from reserve_prefetch() until the
+ * prefetch is taken and published by a reader of the page or by quiet, on
+ * the context the prefetch was posted on; other readers treat the page as a
+ * miss. At most half of the frames are used by prefetches.
+ */
+class Fam_Read_Cache {
+  public:
+    static const size_t FAM_READ_CACHE_MAX_DEFERRED = 64;
+
+    Fam_Read_Cache(uint64_t size, uint64_t pageSize)
+        : pageSize(pageSize), hand(0), gen(0), deferredOverflow(false),
+          hitCnt(0), missCnt(0) {
+        nFrames = size / pageSize;
+        if (nFrames == 0)
+            nFrames = 1;
+        if (posix_memalign((void **)&base, 4096, nFrames * pageSize) != 0)
+            throw std::bad_alloc();
+        frames.resize(nFrames);
+        for (auto &frame : frames) {
+            frame.state = FRAME_FREE;
+            frame.ref = false;
+            frame.len = 0;
+        }
+        pthread_mutex_init(&cacheLock, NULL);
+    }
+
+    ~Fam_Read_Cache() {
+        pthread_mutex_destroy(&cacheLock);
+        free(base);
+    }
+
+    uint64_t get_page_size() { return pageSize; }
+
+    // Largest get served through the cache, larger ones would only thrash it
+    uint64_t get_max_read() {
+        return (nFrames >= 8 ? nFrames / 8 : 1) * pageSize;
+    }
+
+    static Fam_Read_Cache_Key make_key(Fam_Global_Descriptor gd,
+                                       uint64_t page) {
+        Fam_Read_Cache_Key key;
+        key.regionId = gd.regionId;
+        key.itemOffset = gd.offset;
+        key.page = page;
+        return key;
+    }
+
+    /*
+     * Copy nbytes at pageOffset of a cached page to local.
+     * @return - false if the page, or that part of it, is not cached
+     */
+    bool read(const Fam_Read_Cache_Key &key, uint64_t pageOffset, void *local,
+              uint64_t nbytes) {
+        pthread_mutex_lock(&cacheLock);
+        auto it = pages.find(key);
+        if (it == pages.end() || pageOffset + nbytes > frames[it->second].len) {
+            missCnt++;
+            pthread_mutex_unlock(&cacheLock);
+            return false;
+        }
+        frames[it->second].ref = true;
+        memcpy(local, base + it->second * pageSize + pageOffset, nbytes);
+        hitCnt++;
+        pthread_mutex_unlock(&cacheLock);
+        return true;
+    }
+
+    /*
+     * Take a frame to be filled with a page, evicting the page it held.
+     * @param frameIdx - returns the frame to be passed to publish/abandon
+     * @param fillGen - returns the invalidation generation of the fill
+     * @return - the frame memory, NULL if all frames are being filled
+     */
+    char *reserve(uint64_t *frameIdx, uint64_t *fillGen) {
+        pthread_mutex_lock(&cacheLock);
+        char *frame = reserve_frame(frameIdx);
+        *fillGen = gen;
+        pthread_mutex_unlock(&cacheLock);
+        return frame;
+    }
+
+    // Largest range of a data item started by one prefetch
+    uint64_t get_max_prefetch() { return (nFrames + 1) / 2 * pageSize; }
+
+    /*
+     * Take a frame to be filled with a page by the reads of request.
+     * issue_prefetch() must follow once the reads are posted, or
+     * cancel_prefetch() if posting them failed.
+     * @return - the frame memory, NULL if the page is cached or already
+     * prefetched, or no frame is available for a prefetch
+     */
+    char *reserve_prefetch(const Fam_Read_Cache_Key &key, uint64_t len,
+                           Fam_Request *request) {
+        char *frame = NULL;
+        pthread_mutex_lock(&cacheLock);
+        if (pages.count(key) == 0 && prefetches.count(key) == 0 &&
+            prefetches.size() < (nFrames + 1) / 2) {
+            Fam_Read_Cache_Prefetch prefetch;
+            frame = reserve_frame(&prefetch.frameIdx);
+            if (frame != NULL) {
+                prefetch.key = key;
+                prefetch.fillGen = gen;
+                prefetch.len = len;
+                prefetch.request = request;
+                prefetch.owner = NULL;
+                prefetch.issued = false;
+                prefetches[key] = prefetch;
+            }
+        }
+        pthread_mutex_unlock(&cacheLock);
+        return frame;
+    }
+
+    // owner is the context the reads of the prefetch were posted on
+    void issue_prefetch(const Fam_Read_Cache_Key &key, const void *owner) {
+        pthread_mutex_lock(&cacheLock);
+        prefetches[key].owner = owner;
+        prefetches[key].issued = true;
+        pthread_mutex_unlock(&cacheLock);
+    }
+
+    void cancel_prefetch(const Fam_Read_Cache_Key &key) {
+        pthread_mutex_lock(&cacheLock);
+        auto it = prefetches.find(key);
+        frames[it->second.frameIdx].state = FRAME_FREE;
+        prefetches.erase(it);
+        pthread_mutex_unlock(&cacheLock);
+    }
+
+    /*
+     * Remove the prefetch of a page, to be completed by the caller, which
+     * waits for its request and then publishes or abandons its frame.
+     * @return - false if the page has no prefetch whose reads are posted on
+     * the owner context
+     */
+    bool take_prefetch(const Fam_Read_Cache_Key &key, const void *owner,
+                       Fam_Read_Cache_Prefetch *prefetch) {
+        bool found = false;
+        pthread_mutex_lock(&cacheLock);
+        auto it = prefetches.find(key);
+        if (it != prefetches.end() && it->second.issued &&
+            it->second.owner == owner) {
+            *prefetch = it->second;
+            prefetches.erase(it);
+            found = true;
+        }
+        pthread_mutex_unlock(&cacheLock);
+        return found;
+    }
+
+    // Remove the prefetches whose reads are posted on the owner context, or
+    // on any context if owner is NULL, see take_prefetch()
+    void take_prefetches(const void *owner,
+                         std::vector<Fam_Read_Cache_Prefetch> &out) {
+        pthread_mutex_lock(&cacheLock);
+        auto it = prefetches.begin();
+        while (it != prefetches.end()) {
+            if (it->second.issued &&
+                (owner == NULL || it->second.owner == owner)) {
+                out.push_back(it->second);
+                it = prefetches.erase(it);
+            } else {
+                it++;
+            }
+        }
+        pthread_mutex_unlock(&cacheLock);
+    }
+
+    // Make a filled frame visible as the first len bytes of a page
+    void publish(const Fam_Read_Cache_Key &key, uint64_t frameIdx,
+                 uint64_t fillGen, uint64_t len) {
+        pthread_mutex_lock(&cacheLock);
+        Frame &frame = frames[frameIdx];
+        // Also drop the fill if another thread cached the page meanwhile
+        if (fillGen != gen || pages.count(key) > 0) {
+            frame.state = FRAME_FREE;
+        } else {
+            frame.state = FRAME_VALID;
+            frame.key = key;
+            frame.len = len;
+            frame.ref = true;
+            pages[key] = frameIdx;
+        }
+        pthread_mutex_unlock(&cacheLock);
+    }
+
+    // Return a reserved frame whose fill failed
+    void abandon(uint64_t frameIdx) {
+        pthread_mutex_lock(&cacheLock);
+        frames[frameIdx].state = FRAME_FREE;
+        pthread_mutex_unlock(&cacheLock);
+    }
+
+    // Drop the cached pages overlapping nbytes at offset of a data item
+    void invalidate(Fam_Global_Descriptor gd, uint64_t offset,
+                    uint64_t nbytes) {
+        pthread_mutex_lock(&cacheLock);
+        invalidate_range(gd.regionId, gd.offset, offset, nbytes);
+        pthread_mutex_unlock(&cacheLock);
+    }
+
+    // Drop the cached pages of all data items of a region
+    void invalidate_region(uint64_t regionId) {
+        pthread_mutex_lock(&cacheLock);
+        gen++;
+        Fam_Read_Cache_Key first = {regionId, 0, 0};
+        auto it = pages.lower_bound(first);
+        while (it != pages.end() && it->first.regionId == regionId) {
+            frames[it->second].state = FRAME_FREE;
+            it = pages.erase(it);
+        }
+        pthread_mutex_unlock(&cacheLock);
+    }
+
+    void invalidate_all() {
+        pthread_mutex_lock(&cacheLock);
+        clear();
+        pthread_mutex_unlock(&cacheLock);
+    }
+
+    /*
+     * Invalidate a range written by an IO that completes at quiet, now and
+     * again in apply_deferred().
+     */
+    void defer_invalidate(Fam_Global_Descriptor gd, uint64_t offset,
+                          uint64_t nbytes) {
+        pthread_mutex_lock(&cacheLock);
+        invalidate_range(gd.regionId, gd.offset, offset, nbytes);
+        if (deferred.size() < FAM_READ_CACHE_MAX_DEFERRED) {
+            Deferred_Range range = {gd.regionId, gd.offset, offset, nbytes};
+            deferred.push_back(range);
+        } else {
+            // Too many to track, drop the whole cache instead
+            deferredOverflow = true;
+        }
+        pthread_mutex_unlock(&cacheLock);
+    }
+
+    // Invalidate again the ranges recorded since the last call
+    void apply_deferred() {
+        pthread_mutex_lock(&cacheLock);
+        if (deferredOverflow) {
+            clear();
+        } else {
+            for (auto &range : deferred)
+                invalidate_range(range.regionId, range.itemOffset,
+                                 range.offset, range.nbytes);
+        }
+        deferred.clear();
+        deferredOverflow = false;
+        pthread_mutex_unlock(&cacheLock);
+    }
+
+    uint64_t get_hit_count() { return hitCnt; }
+
+    uint64_t get_miss_count() { return missCnt; }
+
+  private:
+    enum Frame_State { FRAME_FREE, FRAME_FILLING, FRAME_VALID };
+
+    struct Frame {
+        Fam_Read_Cache_Key key;
+        Frame_State state;
+        // Referenced since the CLOCK hand last passed
+        bool ref;
+        // Valid bytes, less than pageSize for the last page of an item
+        uint64_t len;
+    };
+
+    struct Deferred_Range {
+        uint64_t regionId;
+        uint64_t itemOffset;
+        uint64_t offset;
+        uint64_t nbytes;
+    };
+
+    // Must be called with the cache lock held
+    char *reserve_frame(uint64_t *frameIdx) {
+        for (uint64_t i = 0; i < 2 * nFrames; i++) {
+            uint64_t idx = hand;
+            hand = (hand + 1) % nFrames;
+            Frame &frame = frames[idx];
+            if (frame.state == FRAME_FILLING)
+                continue;
+            if (frame.state == FRAME_VALID) {
+                // Second chance for pages read since the hand last passed
+                if (frame.ref) {
+                    frame.ref = false;
+                    continue;
+                }
+                pages.erase(frame.key);
+            }
+            frame.state = FRAME_FILLING;
+            *frameIdx = idx;
+            return base + idx * pageSize;
+        }
+        return NULL;
+    }
+
+    void invalidate_range(uint64_t regionId, uint64_t itemOffset,
+                          uint64_t offset, uint64_t nbytes) {
+        gen++;
+        if (nbytes == 0)
+            return;
+        Fam_Read_Cache_Key first = {regionId, itemOffset, offset / pageSize};
+        uint64_t lastPage = (offset + nbytes - 1) / pageSize;
+        auto it = pages.lower_bound(first);
+        while (it != pages.end() && it->first.regionId == regionId &&
+               it->first.itemOffset == itemOffset &&
+               it->first.page <= lastPage) {
+            frames[it->second].state = FRAME_FREE;
+            it = pages.erase(it);
+        }
+    }
+
+    void clear() {
+        gen++;
+        for (auto &page : pages)
+            frames[page.second].state = FRAME_FREE;
+        pages.clear();
+    }
+
+    uint64_t pageSize;
+    uint64_t nFrames;
+    char *base;
+    std::vector<Frame> frames;
+    std::map<Fam_Read_Cache_Key, uint64_t> pages;
+    std::map<Fam_Read_Cache_Key, Fam_Read_Cache_Prefetch> prefetches;
+    // CLOCK hand, the next frame considered for replacement
+    uint64_t hand;
+    // Incremented by every invalidation
+    uint64_t gen;
+    std::vector<Deferred_Range> deferred;
+    bool deferredOverflow;
+    pthread_mutex_t cacheLock;
+    uint64_t hitCnt;
+    uint64_t missCnt;
+};
+
+/*
+ * Invalidates the range of a blocking write when the write starts and
+ * again when it ends, so that no page filled while it was in progress
+ * stays cached.
+ */
+class Fam_Read_Cache_Write_Scope {
+  public:
+    Fam_Read_Cache_Write_Scope(Fam_Read_Cache *cache,
+                               Fam_Descriptor *descriptor, uint64_t offset,
+                               uint64_t nbytes)
+        : readCache(cache), offset(offset), nbytes(nbytes) {
+        if (readCache == NULL)
+            return;
+        gd = descriptor->get_global_descriptor();
+        readCache->invalidate(gd, offset, nbytes);
+    }
+
+    ~Fam_Read_Cache_Write_Scope() {
+        if (readCache != NULL)
+            readCache->invalidate(gd, offset, nbytes);
+    }
+
+  private:
+    Fam_Read_Cache *readCache;
+    Fam_Global_Descriptor gd;
+    uint64_t offset;
+    uint64_t nbytes;
+};
+
+} // namespace openfam
+#endif
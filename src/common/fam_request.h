@@ -0,0 +1,80 @@
+/*
+ * fam_request.h
+ * Copyright (c) 2024 Hewlett Packard Enterprise Development, LP. All rights
+ * reserved. Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See https://spdx.org/licenses/BSD-3-Clause
+ *
+ */
+#ifndef FAM_REQUEST_H
+#define FAM_REQUEST_H
+
+#include <stdint.h>
+#include <vector>
+
+struct fi_context;
+
+namespace openfam {
+
+class Fam_Context;
+
+/*
+ * Fam_Request - handle of one nonblocking get, put, scatter or gather.
+ * The IOs of the operation are posted with their own completion context,
+ * which is kept here until the request is tested or waited on. Contexts
+ * of completed IOs are released as they are found to be done, so a request
+ * that is tested repeatedly does not wait for the same IO twice.
+ *
+ * A request is owned by the caller until fam_test() reports it complete
+ * or fam_wait()/fam_wait_any()/fam_wait_all() return it; every request
+ * must be completed through one of them.
+ */
+class Fam_Request {
+  public:
+    Fam_Request(bool isWrite) : famCtx(NULL), isWrite(isWrite), completed(0) {}
+
+    void set_context(Fam_Context *ctx) { famCtx = ctx; }
+
+    Fam_Context *get_context() { return famCtx; }
+
+    bool is_write() { return isWrite; }
+
+    void add_io(struct fi_context *ctx) { ioCtxs.push_back(ctx); }
+
+    std::vector<struct fi_context *> &get_ios() { return ioCtxs; }
+
+    // Number of IOs, from the front of get_ios(), known to be complete
+    size_t *get_completed() { return &completed; }
+
+    bool is_complete() { return completed == ioCtxs.size(); }
+
+  private:
+    Fam_Context *famCtx;
+    bool isWrite;
+    std::vector<struct fi_context *> ioCtxs;
+    size_t completed;
+};
+
+} // namespace openfam
+#endif
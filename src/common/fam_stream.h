@@ -0,0 +1,129 @@
+/*
+ * fam_stream.h
+ * Copyright (c) 2024 Hewlett Packard Enterprise Development, LP. All
+ * rights reserved. Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See https://spdx.org/licenses/BSD-3-Clause
+ *
+ */
+#ifndef FAM_STREAM_H
+#define FAM_STREAM_H
+
+#include <deque>
+#include <new>
+#include <stdint.h>
+#include <stdlib.h>
+#include <vector>
+
+#include "fam/fam.h"
+
+namespace openfam {
+
+// Chunk of a stream whose read has been started
+struct Fam_Stream_Chunk {
+    Fam_Request *request;
+    char *buf;
+    uint64_t nbytes;
+};
+
+/*
+ * Fam_Stream - state of a sequential read of a range of a data item, in
+ * chunks read ahead into a fixed number of buffers. Chunks are returned in
+ * order; the buffer of the chunk last returned is lent to the caller until
+ * the next chunk is requested.
+ */
+class Fam_Stream {
+  public:
+    Fam_Stream(Fam_Descriptor *descriptor, uint64_t offset, uint64_t nbytes,
+               uint64_t chunkSize, uint64_t depth)
+        : descriptor(descriptor), nextOffset(offset), end(offset + nbytes),
+          chunkSize(chunkSize), lent(NULL) {
+        base = (char *)malloc(chunkSize * depth);
+        if (base == NULL)
+            throw std::bad_alloc();
+        for (uint64_t i = 0; i < depth; i++)
+            freeBufs.push_back(base + i * chunkSize);
+    }
+
+    ~Fam_Stream() { free(base); }
+
+    Fam_Descriptor *get_descriptor() { return descriptor; }
+
+    /*
+     * Buffer and range of the next chunk to be read.
+     * @return - false if all chunks have been started or no buffer is free
+     */
+    bool next_chunk(char **buf, uint64_t *offset, uint64_t *nbytes) {
+        if (nextOffset >= end || freeBufs.empty())
+            return false;
+        *buf = freeBufs.back();
+        *offset = nextOffset;
+        *nbytes = (end - nextOffset < chunkSize) ? end - nextOffset : chunkSize;
+        return true;
+    }
+
+    // Record that the read of the chunk from next_chunk() has started
+    void start_chunk(Fam_Request *request) {
+        Fam_Stream_Chunk chunk;
+        chunk.request = request;
+        chunk.buf = freeBufs.back();
+        chunk.nbytes =
+            (end - nextOffset < chunkSize) ? end - nextOffset : chunkSize;
+        freeBufs.pop_back();
+        nextOffset += chunk.nbytes;
+        started.push_back(chunk);
+    }
+
+    bool empty() { return started.empty(); }
+
+    // Oldest started chunk
+    Fam_Stream_Chunk &front() { return started.front(); }
+
+    // Remove the oldest started chunk, and lend its buffer to the caller
+    void pop_front() {
+        lent = started.front().buf;
+        started.pop_front();
+    }
+
+    // Take back the buffer lent to the caller
+    void release_lent() {
+        if (lent != NULL)
+            freeBufs.push_back(lent);
+        lent = NULL;
+    }
+
+  private:
+    Fam_Descriptor *descriptor;
+    uint64_t nextOffset;
+    uint64_t end;
+    uint64_t chunkSize;
+    char *base;
+    char *lent;
+    std::vector<char *> freeBufs;
+    std::deque<Fam_Stream_Chunk> started;
+};
+
+} // namespace openfam
+#endif
@@ -0,0 +1,194 @@
+/*
+ * fam_write_combiner.h
+ * Copyright (c) 2024 Hewlett Packard Enterprise Development, LP. All
+ * rights reserved. Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See https://spdx.org/licenses/BSD-3-Clause
+ *
+ */
+#ifndef FAM_WRITE_COMBINER_H
+#define FAM_WRITE_COMBINER_H
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unordered_map>
+#include <vector>
+
+#include "fam/fam.h"
+
+namespace openfam {
+
+/*
+ * Contiguous bytes written by nonblocking puts to one data item and not
+ * yet issued.
+ */
+struct Fam_Write_Run {
+    Fam_Descriptor *descriptor;
+    uint64_t offset;
+    uint64_t nbytes;
+    char *buf;
+};
+
+/*
+ * Fam_Write_Combiner - runs of small nonblocking puts of one thread, at
+ * most one per data item. A put that starts inside or right at the end of
+ * the run of its item is copied into the run buffer; any other put closes
+ * the run. A closed run is issued as a single nonblocking put from its
+ * buffer, which stays in flight until recycle() is called after a quiet.
+ *
+ * Buffers are allocated on demand up to maxBuffers. Once they are all open
+ * or in flight, open_run() fails and the put is issued on its own.
+ *
+ * Like Fam_Atomic_Combiner, the combiner is owned by one thread but locked,
+ * so that its runs can be issued on behalf of a thread that has gone away.
+ */
+class Fam_Write_Combiner {
+  public:
+    Fam_Write_Combiner(uint64_t bufSize, uint64_t maxBuffers)
+        : bufSize(bufSize), maxBuffers(maxBuffers), numBuffers(0) {
+        (void)pthread_mutex_init(&lock, NULL);
+    }
+
+    ~Fam_Write_Combiner() {
+        for (auto &run : runs)
+            free(run.second.buf);
+        for (auto buf : inFlight)
+            free(buf);
+        for (auto buf : freeBufs)
+            free(buf);
+        (void)pthread_mutex_destroy(&lock);
+    }
+
+    void acquire_lock() { pthread_mutex_lock(&lock); }
+
+    void release_lock() { pthread_mutex_unlock(&lock); }
+
+    uint64_t get_buffer_size() { return bufSize; }
+
+    /*
+     * Copy a put into the open run of its data item. Must be called with
+     * the lock held.
+     * @return - false if the item has no open run, or the put does not
+     * start inside or at the end of it, or does not fit in its buffer
+     */
+    bool extend_run(Fam_Descriptor *descriptor, uint64_t offset,
+                    const void *local, uint64_t nbytes) {
+        auto it = runs.find(descriptor);
+        if (it == runs.end())
+            return false;
+        Fam_Write_Run &run = it->second;
+        if (offset < run.offset || offset > run.offset + run.nbytes ||
+            offset + nbytes - run.offset > bufSize)
+            return false;
+        memcpy(run.buf + (offset - run.offset), local, nbytes);
+        if (offset + nbytes - run.offset > run.nbytes)
+            run.nbytes = offset + nbytes - run.offset;
+        numCombined++;
+        return true;
+    }
+
+    /*
+     * Start the run of a data item with a put. Must be called with the lock
+     * held, and the item must not have an open run.
+     * @return - false if all buffers are in use
+     */
+    bool open_run(Fam_Descriptor *descriptor, uint64_t offset,
+                  const void *local, uint64_t nbytes) {
+        char *buf;
+        if (!freeBufs.empty()) {
+            buf = freeBufs.back();
+            freeBufs.pop_back();
+        } else if (numBuffers < maxBuffers) {
+            buf = (char *)malloc(bufSize);
+            if (buf == NULL)
+                return false;
+            numBuffers++;
+        } else {
+            return false;
+        }
+        Fam_Write_Run run = {descriptor, offset, nbytes, buf};
+        memcpy(buf, local, nbytes);
+        runs[descriptor] = run;
+        return true;
+    }
+
+    // Whether the open run of a data item has filled its buffer
+    bool is_full(Fam_Descriptor *descriptor) {
+        auto it = runs.find(descriptor);
+        return (it != runs.end() && it->second.nbytes == bufSize);
+    }
+
+    /*
+     * Remove the open run of a data item, or of all items if descriptor is
+     * NULL, and move them to out. The buffers of the runs count as in
+     * flight. Must be called with the lock held.
+     */
+    void close_runs(Fam_Descriptor *descriptor,
+                    std::vector<Fam_Write_Run> &out) {
+        if (descriptor != NULL) {
+            auto it = runs.find(descriptor);
+            if (it == runs.end())
+                return;
+            out.push_back(it->second);
+            inFlight.push_back(it->second.buf);
+            runs.erase(it);
+            return;
+        }
+        for (auto &run : runs) {
+            out.push_back(run.second);
+            inFlight.push_back(run.second.buf);
+        }
+        runs.clear();
+    }
+
+    /*
+     * Make the buffers of closed runs available again, once their puts are
+     * known to be complete. Must be called with the lock held.
+     */
+    void recycle() {
+        freeBufs.insert(freeBufs.end(), inFlight.begin(), inFlight.end());
+        inFlight.clear();
+    }
+
+    bool empty() { return runs.empty(); }
+
+    // Number of puts merged into an already open run
+    uint64_t get_num_combined() { return numCombined; }
+
+  private:
+    uint64_t bufSize;
+    uint64_t maxBuffers;
+    uint64_t numBuffers;
+    uint64_t numCombined = 0;
+    pthread_mutex_t lock;
+    std::unordered_map<Fam_Descriptor *, Fam_Write_Run> runs;
+    std::vector<char *> inFlight;
+    std::vector<char *> freeBufs;
+};
+
+} // namespace openfam
+#endif
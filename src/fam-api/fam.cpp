@@ -43,6 +43,7 @@
 #include "common/fam_ops_libfabric.h"
 #include "common/fam_ops_shm.h"
 #include "common/fam_options.h"
+#include "common/fam_stream.h"
 #include "fam/fam.h"
 #include "fam/fam_exception.h"
 #include "pmi/fam_runtime.h"
@@ -212,13 +213,19 @@ class fam::Impl_ {
                           uint64_t offset, uint64_t nbytes);
 
     void fam_get_nonblocking(void *local, Fam_Descriptor *descriptor,
-                             uint64_t offset, uint64_t nbytes);
+                             uint64_t offset, uint64_t nbytes,
+                             Fam_Request **request = NULL);
 
     void fam_put_blocking(void *local, Fam_Descriptor *descriptor,
                           uint64_t offset, uint64_t nbytes);
 
     void fam_put_nonblocking(void *local, Fam_Descriptor *descriptor,
-                             uint64_t offset, uint64_t nbytes);
+                             uint64_t offset, uint64_t nbytes,
+                             Fam_Request **request = NULL);
+
+    void fam_get_batch(Fam_Batch_Entry *entries, uint64_t nEntries);
+
+    void fam_put_batch(Fam_Batch_Entry *entries, uint64_t nEntries);
 
     void *fam_map(Fam_Descriptor *descriptor);
 
@@ -234,11 +241,13 @@ class fam::Impl_ {
 
     void fam_gather_nonblocking(void *local, Fam_Descriptor *descriptor,
                                 uint64_t nElements, uint64_t firstElement,
-                                uint64_t stride, uint64_t elementSize);
+                                uint64_t stride, uint64_t elementSize,
+                                Fam_Request **request = NULL);
 
     void fam_gather_nonblocking(void *local, Fam_Descriptor *descriptor,
                                 uint64_t nElements, uint64_t *elementIndex,
-                                uint64_t elementSize);
+                                uint64_t elementSize,
+                                Fam_Request **request = NULL);
 
     void fam_scatter_blocking(void *local, Fam_Descriptor *descriptor,
                               uint64_t nElements, uint64_t firstElement,
@@ -250,11 +259,21 @@ class fam::Impl_ {
 
     void fam_scatter_nonblocking(void *local, Fam_Descriptor *descriptor,
                                  uint64_t nElements, uint64_t firstElement,
-                                 uint64_t stride, uint64_t elementSize);
+                                 uint64_t stride, uint64_t elementSize,
+                                 Fam_Request **request = NULL);
 
     void fam_scatter_nonblocking(void *local, Fam_Descriptor *descriptor,
                                  uint64_t nElements, uint64_t *elementIndex,
-                                 uint64_t elementSize);
+                                 uint64_t elementSize,
+                                 Fam_Request **request = NULL);
+
+    bool fam_test(Fam_Request *request);
+
+    void fam_wait(Fam_Request *request);
+
+    uint64_t fam_wait_any(Fam_Request **requests, uint64_t count);
+
+    void fam_wait_all(Fam_Request **requests, uint64_t count);
 
     void *fam_copy(Fam_Descriptor *src, uint64_t srcOffset,
                    Fam_Descriptor *dest, uint64_t destOffset, uint64_t nbytes);
@@ -422,17 +441,44 @@ class fam::Impl_ {
     uint64_t fam_fetch_xor(Fam_Descriptor *descriptor, uint64_t offset,
                            uint64_t value);
 
+    void fam_atomic_batch(Fam_Atomic_Batch_Entry *entries, uint64_t nEntries);
+
+    void fam_atomic_fetch_batch(Fam_Atomic_Batch_Entry *entries,
+                                uint64_t nEntries, Fam_Atomic_Value *results);
+
     void fam_fence(Fam_Region_Descriptor *descriptor = NULL);
     void fam_quiet(Fam_Region_Descriptor *descriptor = NULL);
 
+    void fam_invalidate(Fam_Descriptor *descriptor, uint64_t offset,
+                        uint64_t nbytes);
+
+    void fam_prefetch(Fam_Descriptor *descriptor, uint64_t offset,
+                      uint64_t nbytes);
+
+    Fam_Stream *fam_stream_open(Fam_Descriptor *descriptor, uint64_t offset,
+                                uint64_t nbytes, uint64_t chunkSize,
+                                uint64_t depth);
+
+    const void *fam_stream_next(Fam_Stream *stream, uint64_t *nbytes);
+
+    void fam_stream_close(Fam_Stream *stream);
+
     uint64_t fam_progress();
 
     int validate_fam_options(Fam_Options *options,
                              configFileParams config_file_fam_options);
     void clean_fam_options();
     int validate_item(Fam_Descriptor *descriptor);
+    void stream_start_chunks(Fam_Stream *stream);
+    void stream_release(Fam_Stream *stream);
+    int validate_batch(Fam_Batch_Entry *entries, uint64_t nEntries);
+    int validate_atomic_batch(Fam_Atomic_Batch_Entry *entries,
+                              uint64_t nEntries);
     int contains_nonutf(const char *name);
     configFileParams get_info_from_config_file(std::string filename);
+    uint64_t get_config_uint64(configFileParams &options, const char *key,
+                               uint64_t defaultValue);
+    void flush_combined_item(Fam_Descriptor *descriptor);
 #ifdef FAM_PROFILE
     void fam_reset_profile();
 #endif
@@ -772,8 +818,13 @@ void fam::Impl_::fam_initialize(const char *grpName, Fam_Options *options) {
     if (strcmp(famOptions.openFamModel, FAM_OPTIONS_SHM_STR) == 0) {
         // initialize shared memory client
         famAllocator = new Fam_Allocator_Client(true, enableResourceRelease);
-        famOps = new Fam_Ops_SHM(famThreadModel, famContextModel, famAllocator,
-                                 atoi(famOptions.numConsumer));
+        // Shared memory has no endpoints, FAM_CONTEXT_THREAD behaves as the
+        // default context model
+        famOps = new Fam_Ops_SHM(famThreadModel,
+                                 famContextModel == FAM_CONTEXT_THREAD
+                                     ? FAM_CONTEXT_DEFAULT
+                                     : famContextModel,
+                                 famAllocator, atoi(famOptions.numConsumer));
         ret = famOps->initialize();
     } else {
         if (strcmp(famOptions.cisInterfaceType, FAM_OPTIONS_RPC_STR) == 0) {
@@ -788,6 +839,120 @@ void fam::Impl_::fam_initialize(const char *grpName, Fam_Options *options) {
         famOps = new Fam_Ops_Libfabric(false, famOptions.libfabricProvider,
                                        famOptions.if_device, famThreadModel,
                                        famAllocator, famContextModel);
+        Fam_Ops_Libfabric *famOpsLibfabric = (Fam_Ops_Libfabric *)famOps;
+        famOpsLibfabric->set_io_pipeline_depth(
+            get_config_uint64(file_options, "io_pipeline_depth",
+                              FAM_DEFAULT_IO_PIPELINE_DEPTH));
+        uint64_t stripeCount = get_config_uint64(
+            file_options, "io_stripe_count", FAM_DEFAULT_IO_STRIPE_COUNT);
+        if (stripeCount == 0) {
+            message << "Invalid value for io_stripe_count: 0";
+            THROW_ERR_MSG(Fam_InvalidOption_Exception, message.str().c_str());
+        }
+        famOpsLibfabric->set_io_striping(
+            stripeCount,
+            get_config_uint64(file_options, "io_stripe_min_size",
+                              FAM_DEFAULT_IO_STRIPE_MIN_SIZE));
+        if (file_options.count("rail_addresses") > 0) {
+            std::vector<std::string> railAddrs;
+            std::istringstream railList(file_options["rail_addresses"]);
+            std::string railAddr;
+            while (std::getline(railList, railAddr, ','))
+                railAddrs.push_back(railAddr);
+            famOpsLibfabric->set_rails(railAddrs);
+        }
+        if (file_options.count("atomic_combining") > 0 &&
+            strcmp(file_options["atomic_combining"].c_str(), "enable") == 0) {
+            famOpsLibfabric->enable_atomic_combining(
+                get_config_uint64(file_options, "atomic_combine_max_entries",
+                                  FAM_DEFAULT_ATOMIC_COMBINE_MAX_ENTRIES),
+                get_config_uint64(file_options, "atomic_combine_flush_usec",
+                                  FAM_DEFAULT_ATOMIC_COMBINE_FLUSH_USEC));
+        }
+        famOpsLibfabric->set_native_int128_atomics(
+            strcmp(file_options["native_int128_atomics"].c_str(), "disable") !=
+            0);
+        Fam_Poll_Mode pollMode = FAM_POLL_BUSY;
+        if (strcmp(file_options["completion_poll_mode"].c_str(), "backoff") ==
+            0) {
+            pollMode = FAM_POLL_BACKOFF;
+        } else if (strcmp(file_options["completion_poll_mode"].c_str(),
+                          "blocking") == 0) {
+            pollMode = FAM_POLL_BLOCKING;
+        } else if (strcmp(file_options["completion_poll_mode"].c_str(),
+                          "busy") != 0) {
+            message << "Invalid value for completion_poll_mode: "
+                    << file_options["completion_poll_mode"];
+            THROW_ERR_MSG(Fam_InvalidOption_Exception, message.str().c_str());
+        }
+        famOpsLibfabric->set_completion_poll(
+            pollMode,
+            get_config_uint64(file_options, "completion_poll_spin_count",
+                              FAM_DEFAULT_POLL_SPIN_COUNT),
+            get_config_uint64(file_options, "completion_poll_max_sleep_usec",
+                              FAM_DEFAULT_POLL_MAX_SLEEP_USEC));
+        famOpsLibfabric->set_sg_offload(
+            strcmp(file_options["sg_offload"].c_str(), "enable") == 0,
+            get_config_uint64(file_options, "sg_offload_min_elements",
+                              FAM_DEFAULT_SG_OFFLOAD_MIN_ELEMENTS),
+            get_config_uint64(file_options, "sg_offload_max_element_size",
+                              FAM_DEFAULT_SG_OFFLOAD_MAX_ELEMENT_SIZE));
+        if (file_options.count("mr_cache") > 0 &&
+            strcmp(file_options["mr_cache"].c_str(), "enable") == 0) {
+            famOpsLibfabric->enable_mr_cache(
+                get_config_uint64(file_options, "mr_cache_max_entries",
+                                  FAM_DEFAULT_MR_CACHE_MAX_ENTRIES),
+                get_config_uint64(file_options, "mr_cache_max_bytes",
+                                  FAM_DEFAULT_MR_CACHE_MAX_BYTES),
+                get_config_uint64(file_options, "mr_cache_min_size",
+                                  FAM_DEFAULT_MR_CACHE_MIN_SIZE));
+        }
+        if (strcmp(file_options["bounce_buffers"].c_str(), "disable") != 0) {
+            famOpsLibfabric->enable_bounce_buffers(
+                get_config_uint64(file_options, "bounce_buffer_max_size",
+                                  FAM_DEFAULT_BOUNCE_MAX_SIZE),
+                get_config_uint64(file_options, "bounce_buffer_count",
+                                  FAM_DEFAULT_BOUNCE_COUNT));
+        }
+        famOpsLibfabric->set_context_pool_size(
+            get_config_uint64(file_options, "context_pool_size",
+                              FAM_DEFAULT_CONTEXT_POOL_SIZE));
+        if (strcmp(file_options["shared_contexts"].c_str(), "enable") == 0)
+            famOpsLibfabric->enable_shared_contexts();
+        // PEs started without a runtime can not tell which of them share a
+        // job, and fetch the memory server information themselves
+        if (famRuntime != NULL && famRuntime->job_id()[0] != '\0' &&
+            strcmp(file_options["node_bootstrap"].c_str(), "disable") != 0) {
+            famOpsLibfabric->enable_node_bootstrap(
+                famRuntime->job_id(),
+                get_config_uint64(file_options, "node_bootstrap_timeout_msec",
+                                  FAM_DEFAULT_NODE_BOOTSTRAP_TIMEOUT_MSEC));
+        }
+        if (strcmp(file_options["read_cache"].c_str(), "enable") == 0) {
+            uint64_t pageSize =
+                get_config_uint64(file_options, "read_cache_page_size",
+                                  FAM_DEFAULT_READ_CACHE_PAGE_SIZE);
+            if (pageSize == 0) {
+                message << "Invalid value for read_cache_page_size: 0";
+                THROW_ERR_MSG(Fam_InvalidOption_Exception,
+                              message.str().c_str());
+            }
+            famOpsLibfabric->enable_read_cache(
+                get_config_uint64(file_options, "read_cache_size",
+                                  FAM_DEFAULT_READ_CACHE_SIZE),
+                pageSize,
+                strcmp(file_options["read_cache_invalidate_on_fence"].c_str(),
+                       "enable") == 0);
+        }
+        if (strcmp(file_options["write_combining"].c_str(), "enable") == 0) {
+            famOpsLibfabric->enable_write_combining(
+                get_config_uint64(file_options, "write_combine_buffer_size",
+                                  FAM_DEFAULT_WRITE_COMBINE_BUFFER_SIZE),
+                get_config_uint64(file_options, "write_combine_max_put",
+                                  FAM_DEFAULT_WRITE_COMBINE_MAX_PUT),
+                get_config_uint64(file_options, "write_combine_buffers",
+                                  FAM_DEFAULT_WRITE_COMBINE_BUFFERS));
+        }
         ret = famOps->initialize();
 
         if (ret < 0) {
@@ -950,6 +1115,8 @@ int fam::Impl_::validate_fam_options(Fam_Options *options,
         famContextModel = FAM_CONTEXT_DEFAULT;
     else if (strcmp(famOptions.famContextModel, FAM_CONTEXT_REGION_STR) == 0)
         famContextModel = FAM_CONTEXT_REGION;
+    else if (strcmp(famOptions.famContextModel, FAM_CONTEXT_THREAD_STR) == 0)
+        famContextModel = FAM_CONTEXT_THREAD;
     else {
         message << "Invalid value specified for famContextModel: "
                 << famOptions.famContextModel;
@@ -1016,6 +1183,14 @@ void fam::Impl_::fam_context_close(fam_context *ctx) {
     auto it = std::find(ctxList->begin(), ctxList->end(), ctx);
     if (it != ctxList->end()) {
         uint64_t contextId = ctx->pimpl_->ctxId;
+        // Issue atomics and puts still held in the combining tables and
+        // buffers of the context
+        if (strcmp(famOptions.openFamModel, FAM_OPTIONS_SHM_STR) != 0) {
+            Fam_Ops_Libfabric *ctxOps =
+                (Fam_Ops_Libfabric *)ctx->pimpl_->famOps;
+            ctxOps->flush_combined_atomics(true);
+            ctxOps->flush_combined_puts(true);
+        }
         famOps->context_close(contextId);
         // Delete this list during fam_finalize
         // ctxList->erase(it);
@@ -1155,6 +1330,223 @@ configFileParams fam::Impl_::get_info_from_config_file(std::string filename) {
             // exception. This parameter will be obtained from
             // validate_fam_options function.
         }
+        try {
+            options["io_pipeline_depth"] = (char *)strdup(
+                (info->get_key_value("io_pipeline_depth")).c_str());
+        } catch (Fam_InvalidOption_Exception &e) {
+            // If the parameter io_pipeline_depth is not present, then ignore
+            // the exception. The default pipeline depth is used.
+        }
+        try {
+            options["io_stripe_count"] = (char *)strdup(
+                (info->get_key_value("io_stripe_count")).c_str());
+        } catch (Fam_InvalidOption_Exception &e) {
+            // If the parameter is not present, the default is used.
+        }
+        try {
+            options["io_stripe_min_size"] = (char *)strdup(
+                (info->get_key_value("io_stripe_min_size")).c_str());
+        } catch (Fam_InvalidOption_Exception &e) {
+            // If the parameter is not present, the default is used.
+        }
+        try {
+            std::vector<std::string> rails =
+                info->get_value_list("rail_addresses");
+            std::ostringstream railList;
+            for (size_t i = 0; i < rails.size(); i++)
+                railList << (i > 0 ? "," : "") << rails[i];
+            if (!rails.empty())
+                options["rail_addresses"] =
+                    (char *)strdup(railList.str().c_str());
+        } catch (Fam_InvalidOption_Exception &e) {
+            // If the parameter is not present, no additional rail is used.
+        }
+        try {
+            options["atomic_combining"] = (char *)strdup(
+                (info->get_key_value("atomic_combining")).c_str());
+        } catch (Fam_InvalidOption_Exception &e) {
+            // If parameter is not present, then set the default.
+            options["atomic_combining"] = (char *)strdup("disable");
+        }
+        try {
+            options["atomic_combine_max_entries"] = (char *)strdup(
+                (info->get_key_value("atomic_combine_max_entries")).c_str());
+        } catch (Fam_InvalidOption_Exception &e) {
+            // If the parameter is not present, the default is used.
+        }
+        try {
+            options["atomic_combine_flush_usec"] = (char *)strdup(
+                (info->get_key_value("atomic_combine_flush_usec")).c_str());
+        } catch (Fam_InvalidOption_Exception &e) {
+            // If the parameter is not present, the default is used.
+        }
+        try {
+            options["native_int128_atomics"] = (char *)strdup(
+                (info->get_key_value("native_int128_atomics")).c_str());
+        } catch (Fam_InvalidOption_Exception &e) {
+            // If parameter is not present, then set the default.
+            options["native_int128_atomics"] = (char *)strdup("enable");
+        }
+        try {
+            options["completion_poll_mode"] = (char *)strdup(
+                (info->get_key_value("completion_poll_mode")).c_str());
+        } catch (Fam_InvalidOption_Exception &e) {
+            // If parameter is not present, then set the default.
+            options["completion_poll_mode"] = (char *)strdup("busy");
+        }
+        try {
+            options["completion_poll_spin_count"] = (char *)strdup(
+                (info->get_key_value("completion_poll_spin_count")).c_str());
+        } catch (Fam_InvalidOption_Exception &e) {
+            // If the parameter is not present, the default is used.
+        }
+        try {
+            options["completion_poll_max_sleep_usec"] = (char *)strdup(
+                (info->get_key_value("completion_poll_max_sleep_usec"))
+                    .c_str());
+        } catch (Fam_InvalidOption_Exception &e) {
+            // If the parameter is not present, the default is used.
+        }
+        try {
+            options["sg_offload"] = (char *)strdup(
+                (info->get_key_value("sg_offload")).c_str());
+        } catch (Fam_InvalidOption_Exception &e) {
+            // If parameter is not present, then set the default.
+            options["sg_offload"] = (char *)strdup("disable");
+        }
+        try {
+            options["sg_offload_min_elements"] = (char *)strdup(
+                (info->get_key_value("sg_offload_min_elements")).c_str());
+        } catch (Fam_InvalidOption_Exception &e) {
+            // If the parameter is not present, the default is used.
+        }
+        try {
+            options["sg_offload_max_element_size"] = (char *)strdup(
+                (info->get_key_value("sg_offload_max_element_size")).c_str());
+        } catch (Fam_InvalidOption_Exception &e) {
+            // If the parameter is not present, the default is used.
+        }
+        try {
+            options["mr_cache"] =
+                (char *)strdup((info->get_key_value("mr_cache")).c_str());
+        } catch (Fam_InvalidOption_Exception &e) {
+            // If parameter is not present, then set the default.
+            options["mr_cache"] = (char *)strdup("disable");
+        }
+        try {
+            options["mr_cache_max_entries"] = (char *)strdup(
+                (info->get_key_value("mr_cache_max_entries")).c_str());
+        } catch (Fam_InvalidOption_Exception &e) {
+            // If the parameter is not present, the default is used.
+        }
+        try {
+            options["mr_cache_max_bytes"] = (char *)strdup(
+                (info->get_key_value("mr_cache_max_bytes")).c_str());
+        } catch (Fam_InvalidOption_Exception &e) {
+            // If the parameter is not present, the default is used.
+        }
+        try {
+            options["mr_cache_min_size"] = (char *)strdup(
+                (info->get_key_value("mr_cache_min_size")).c_str());
+        } catch (Fam_InvalidOption_Exception &e) {
+            // If the parameter is not present, the default is used.
+        }
+        try {
+            options["bounce_buffers"] = (char *)strdup(
+                (info->get_key_value("bounce_buffers")).c_str());
+        } catch (Fam_InvalidOption_Exception &e) {
+            // If parameter is not present, then set the default.
+            options["bounce_buffers"] = (char *)strdup("enable");
+        }
+        try {
+            options["bounce_buffer_max_size"] = (char *)strdup(
+                (info->get_key_value("bounce_buffer_max_size")).c_str());
+        } catch (Fam_InvalidOption_Exception &e) {
+            // If the parameter is not present, the default is used.
+        }
+        try {
+            options["bounce_buffer_count"] = (char *)strdup(
+                (info->get_key_value("bounce_buffer_count")).c_str());
+        } catch (Fam_InvalidOption_Exception &e) {
+            // If the parameter is not present, the default is used.
+        }
+        try {
+            options["context_pool_size"] = (char *)strdup(
+                (info->get_key_value("context_pool_size")).c_str());
+        } catch (Fam_InvalidOption_Exception &e) {
+            // If the parameter is not present, the default is used.
+        }
+        try {
+            options["shared_contexts"] = (char *)strdup(
+                (info->get_key_value("shared_contexts")).c_str());
+        } catch (Fam_InvalidOption_Exception &e) {
+            // If the parameter is not present, the default is used.
+        }
+        try {
+            options["node_bootstrap"] =
+                (char *)strdup((info->get_key_value("node_bootstrap")).c_str());
+        } catch (Fam_InvalidOption_Exception &e) {
+            // If the parameter is not present, the default is used.
+        }
+        try {
+            options["node_bootstrap_timeout_msec"] = (char *)strdup(
+                (info->get_key_value("node_bootstrap_timeout_msec")).c_str());
+        } catch (Fam_InvalidOption_Exception &e) {
+            // If the parameter is not present, the default is used.
+        }
+        try {
+            options["read_cache"] =
+                (char *)strdup((info->get_key_value("read_cache")).c_str());
+        } catch (Fam_InvalidOption_Exception &e) {
+            // If parameter is not present, then set the default.
+            options["read_cache"] = (char *)strdup("disable");
+        }
+        try {
+            options["read_cache_size"] = (char *)strdup(
+                (info->get_key_value("read_cache_size")).c_str());
+        } catch (Fam_InvalidOption_Exception &e) {
+            // If the parameter is not present, the default is used.
+        }
+        try {
+            options["read_cache_page_size"] = (char *)strdup(
+                (info->get_key_value("read_cache_page_size")).c_str());
+        } catch (Fam_InvalidOption_Exception &e) {
+            // If the parameter is not present, the default is used.
+        }
+        try {
+            options["read_cache_invalidate_on_fence"] = (char *)strdup(
+                (info->get_key_value("read_cache_invalidate_on_fence"))
+                    .c_str());
+        } catch (Fam_InvalidOption_Exception &e) {
+            // If parameter is not present, then set the default.
+            options["read_cache_invalidate_on_fence"] =
+                (char *)strdup("disable");
+        }
+        try {
+            options["write_combining"] = (char *)strdup(
+                (info->get_key_value("write_combining")).c_str());
+        } catch (Fam_InvalidOption_Exception &e) {
+            // If parameter is not present, then set the default.
+            options["write_combining"] = (char *)strdup("disable");
+        }
+        try {
+            options["write_combine_buffer_size"] = (char *)strdup(
+                (info->get_key_value("write_combine_buffer_size")).c_str());
+        } catch (Fam_InvalidOption_Exception &e) {
+            // If the parameter is not present, the default is used.
+        }
+        try {
+            options["write_combine_max_put"] = (char *)strdup(
+                (info->get_key_value("write_combine_max_put")).c_str());
+        } catch (Fam_InvalidOption_Exception &e) {
+            // If the parameter is not present, the default is used.
+        }
+        try {
+            options["write_combine_buffers"] = (char *)strdup(
+                (info->get_key_value("write_combine_buffers")).c_str());
+        } catch (Fam_InvalidOption_Exception &e) {
+            // If the parameter is not present, the default is used.
+        }
         try {
             options["resource_release"] = (char *)strdup(
                 (info->get_key_value("resource_release")).c_str());
@@ -1166,6 +1558,30 @@ configFileParams fam::Impl_::get_info_from_config_file(std::string filename) {
     return options;
 }
 
+/**
+ * Read an optional unsigned integer parameter of the config file.
+ * @param options - parameters read from the config file
+ * @param key - name of the parameter
+ * @param defaultValue - value used if the parameter is not present
+ * @return - value of the parameter
+ * @throws : Fam_InvalidOption_Exception if the value is not a number.
+ */
+uint64_t fam::Impl_::get_config_uint64(configFileParams &options,
+                                       const char *key,
+                                       uint64_t defaultValue) {
+    std::ostringstream message;
+    if (options.count(key) == 0)
+        return defaultValue;
+    char *end = NULL;
+    const char *valueStr = options[key].c_str();
+    uint64_t value = strtoull(valueStr, &end, 10);
+    if (end == valueStr || *end != '\0') {
+        message << "Invalid value specified for " << key << ": " << valueStr;
+        THROW_ERR_MSG(Fam_InvalidOption_Exception, message.str().c_str());
+    }
+    return value;
+}
+
 /**
  * Finalize the fam library. Once finalized, the process can continue work, but
  * it is disconnected from the OpenFAM library functions.
@@ -1487,6 +1903,8 @@ fam::Impl_::fam_create_region(const char *name, uint64_t size,
 void fam::Impl_::fam_destroy_region(Fam_Region_Descriptor *descriptor) {
     FAM_CNTR_INC_API(fam_destroy_region);
     FAM_PROFILE_START_ALLOCATOR(fam_destroy_region);
+    // Region ids are reused, drop what this PE has cached of the region
+    famOps->invalidate(descriptor);
     famAllocator->destroy_region(descriptor);
     FAM_PROFILE_END_ALLOCATOR(fam_destroy_region);
     return;
@@ -1544,6 +1962,19 @@ Fam_Descriptor *fam::Impl_::fam_allocate(const char *name, uint64_t nbytes,
     return ret;
 }
 
+/*
+ * Issue the operations on a data item still held by the combining tables of
+ * this fam and of its contexts, which refer to the item by its descriptor.
+ */
+void fam::Impl_::flush_combined_item(Fam_Descriptor *descriptor) {
+    if (strcmp(famOptions.openFamModel, FAM_OPTIONS_SHM_STR) == 0)
+        return;
+    ((Fam_Ops_Libfabric *)famOps)->flush_combined_item(descriptor);
+    for (auto ctx : *ctxList)
+        ((Fam_Ops_Libfabric *)ctx->pimpl_->famOps)
+            ->flush_combined_item(descriptor);
+}
+
 /**
  * Deallocate allocated space in memory
  * @param descriptor - descriptor associated with the space.
@@ -1552,6 +1983,9 @@ Fam_Descriptor *fam::Impl_::fam_allocate(const char *name, uint64_t nbytes,
 void fam::Impl_::fam_deallocate(Fam_Descriptor *descriptor) {
     FAM_CNTR_INC_API(fam_deallocate);
     FAM_PROFILE_START_ALLOCATOR(fam_deallocate);
+    flush_combined_item(descriptor);
+    // The space may be handed out again by a later allocation
+    famOps->invalidate(descriptor, 0, UINT64_MAX);
     famAllocator->deallocate(descriptor);
     FAM_PROFILE_END_ALLOCATOR(fam_deallocate);
     return;
@@ -1570,6 +2004,7 @@ void fam::Impl_::fam_close(Fam_Descriptor *descriptor) {
         message << "Descriptor is no longer valid" << endl;
         THROW_ERR_MSG(Fam_InvalidOption_Exception, message.str().c_str());
     }
+    flush_combined_item(descriptor);
     famAllocator->close(descriptor);
     FAM_PROFILE_END_ALLOCATOR(fam_close);
     return;
@@ -1813,7 +2248,8 @@ void fam::Impl_::fam_get_blocking(void *local, Fam_Descriptor *descriptor,
  * @param nbytes - number of bytes to be copied from global to local memory
  */
 void fam::Impl_::fam_get_nonblocking(void *local, Fam_Descriptor *descriptor,
-                                     uint64_t offset, uint64_t nbytes) {
+                                     uint64_t offset, uint64_t nbytes,
+                                     Fam_Request **request) {
 
     FAM_CNTR_INC_API(fam_get_nonblocking);
     FAM_PROFILE_START_ALLOCATOR(fam_get_nonblocking);
@@ -1833,8 +2269,17 @@ void fam::Impl_::fam_get_nonblocking(void *local, Fam_Descriptor *descriptor,
     FAM_PROFILE_END_ALLOCATOR(fam_get_nonblocking);
     FAM_PROFILE_START_OPS(fam_get_nonblocking);
     if (ret == 0) {
-        // Read data from FAM region with this key
-        famOps->get_nonblocking(local, descriptor, offset, nbytes);
+        Fam_Request *req = (request ? new Fam_Request(false) : NULL);
+        try {
+            // Read data from FAM region with this key
+            famOps->get_nonblocking(local, descriptor, offset, nbytes, req);
+        } catch (...) {
+            famOps->drain_request(req);
+            delete req;
+            throw;
+        }
+        if (request)
+            *request = req;
     }
     FAM_PROFILE_END_OPS(fam_get_nonblocking);
     return;
@@ -1896,7 +2341,8 @@ void fam::Impl_::fam_put_blocking(void *local, Fam_Descriptor *descriptor,
  * @param nbytes - number of bytes to be copied from local to FAM
  */
 void fam::Impl_::fam_put_nonblocking(void *local, Fam_Descriptor *descriptor,
-                                     uint64_t offset, uint64_t nbytes) {
+                                     uint64_t offset, uint64_t nbytes,
+                                     Fam_Request **request) {
     FAM_CNTR_INC_API(fam_put_nonblocking);
     FAM_PROFILE_START_ALLOCATOR(fam_put_nonblocking);
     if ((local == NULL) || (descriptor == NULL) || (nbytes == 0)) {
@@ -1917,12 +2363,99 @@ void fam::Impl_::fam_put_nonblocking(void *local, Fam_Descriptor *descriptor,
     FAM_PROFILE_END_ALLOCATOR(fam_put_nonblocking);
     FAM_PROFILE_START_OPS(fam_put_nonblocking);
     if (ret == 0) {
-        famOps->put_nonblocking(local, descriptor, offset, nbytes);
+        Fam_Request *req = (request ? new Fam_Request(true) : NULL);
+        try {
+            famOps->put_nonblocking(local, descriptor, offset, nbytes, req);
+        } catch (...) {
+            famOps->drain_request(req);
+            delete req;
+            throw;
+        }
+        if (request)
+            *request = req;
     }
     FAM_PROFILE_END_OPS(fam_put_nonblocking);
     return;
 }
 
+/**
+ * Validate every entry of a batched get/put request.
+ * @param entries - array of batch entries
+ * @param nEntries - number of entries in the array
+ * @return - 0 if all entries are valid
+ * @throws : Fam_InvalidOption_Exception if incorrect parameters are passed.
+ */
+int fam::Impl_::validate_batch(Fam_Batch_Entry *entries, uint64_t nEntries) {
+    int ret = 0;
+    if ((entries == NULL) || (nEntries == 0)) {
+        THROW_ERR_MSG(Fam_InvalidOption_Exception, "Invalid Options");
+    }
+    for (uint64_t i = 0; i < nEntries; i++) {
+        Fam_Descriptor *descriptor = entries[i].descriptor;
+        if ((entries[i].local == NULL) || (descriptor == NULL) ||
+            (entries[i].nbytes == 0)) {
+            THROW_ERR_MSG(Fam_InvalidOption_Exception, "Invalid Options");
+        }
+        ret = validate_item(descriptor);
+        if (ret != 0)
+            return ret;
+
+#ifdef CHECK_OFFSETS
+        uint64_t disize = descriptor->get_size();
+        uint64_t offset = entries[i].offset;
+        uint64_t io_size = entries[i].nbytes;
+        if ((offset >= disize) || ((offset + io_size) > disize)) {
+            THROW_ERR_MSG(Fam_InvalidOption_Exception, "Access out of bounds");
+        }
+#endif
+    }
+    return ret;
+}
+
+/**
+ * Copy a batch of regions from FAM to node local memory, blocking until all
+ * copies are complete. Entries that map to the same memory server are posted
+ * together and a single completion wait covers the whole batch.
+ * @param entries - array of {descriptor, offset, local, nbytes} entries
+ * @param nEntries - number of entries in the array
+ * @throws : Fam_InvalidOption_Exception if incorrect parameters are passed.
+ * @throws : Fam_Permission_Exception if the given key has incorrect permissions
+ * @throws : Fam_Datapath_Exception if libfabric read fails
+ */
+void fam::Impl_::fam_get_batch(Fam_Batch_Entry *entries, uint64_t nEntries) {
+    FAM_CNTR_INC_API(fam_get_batch);
+    FAM_PROFILE_START_ALLOCATOR(fam_get_batch);
+    int ret = validate_batch(entries, nEntries);
+    FAM_PROFILE_END_ALLOCATOR(fam_get_batch);
+    FAM_PROFILE_START_OPS(fam_get_batch);
+    if (ret == 0) {
+        famOps->get_batch(entries, nEntries);
+    }
+    FAM_PROFILE_END_OPS(fam_get_batch);
+}
+
+/**
+ * Copy a batch of regions from node local memory to FAM, blocking until all
+ * copies are complete. Entries that map to the same memory server are posted
+ * together and a single completion wait covers the whole batch.
+ * @param entries - array of {descriptor, offset, local, nbytes} entries
+ * @param nEntries - number of entries in the array
+ * @throws : Fam_InvalidOption_Exception if incorrect parameters are passed.
+ * @throws : Fam_Permission_Exception if the given key has incorrect permissions
+ * @throws : Fam_Datapath_Exception if libfabric write fails
+ */
+void fam::Impl_::fam_put_batch(Fam_Batch_Entry *entries, uint64_t nEntries) {
+    FAM_CNTR_INC_API(fam_put_batch);
+    FAM_PROFILE_START_ALLOCATOR(fam_put_batch);
+    int ret = validate_batch(entries, nEntries);
+    FAM_PROFILE_END_ALLOCATOR(fam_put_batch);
+    FAM_PROFILE_START_OPS(fam_put_batch);
+    if (ret == 0) {
+        famOps->put_batch(entries, nEntries);
+    }
+    FAM_PROFILE_END_OPS(fam_put_batch);
+}
+
 // LOAD/STORE sub-group
 
 // GATHER/SCATTER subgroup
@@ -2035,7 +2568,8 @@ void fam::Impl_::fam_gather_blocking(void *local, Fam_Descriptor *descriptor,
 void fam::Impl_::fam_gather_nonblocking(void *local, Fam_Descriptor *descriptor,
                                         uint64_t nElements,
                                         uint64_t firstElement, uint64_t stride,
-                                        uint64_t elementSize) {
+                                        uint64_t elementSize,
+                                        Fam_Request **request) {
     FAM_CNTR_INC_API(fam_gather_nonblocking);
     FAM_PROFILE_START_ALLOCATOR(fam_gather_nonblocking);
     if ((local == NULL) || (descriptor == NULL) || (nElements == 0)) {
@@ -2056,8 +2590,17 @@ void fam::Impl_::fam_gather_nonblocking(void *local, Fam_Descriptor *descriptor,
     FAM_PROFILE_END_ALLOCATOR(fam_gather_nonblocking);
     FAM_PROFILE_START_OPS(fam_gather_nonblocking);
     if (ret == 0) {
-        famOps->gather_nonblocking(local, descriptor, nElements, firstElement,
-                                   stride, elementSize);
+        Fam_Request *req = (request ? new Fam_Request(false) : NULL);
+        try {
+            famOps->gather_nonblocking(local, descriptor, nElements,
+                                       firstElement, stride, elementSize, req);
+        } catch (...) {
+            famOps->drain_request(req);
+            delete req;
+            throw;
+        }
+        if (request)
+            *request = req;
     }
     FAM_PROFILE_END_OPS(fam_gather_nonblocking);
     return;
@@ -2080,7 +2623,8 @@ void fam::Impl_::fam_gather_nonblocking(void *local, Fam_Descriptor *descriptor,
 void fam::Impl_::fam_gather_nonblocking(void *local, Fam_Descriptor *descriptor,
                                         uint64_t nElements,
                                         uint64_t *elementIndex,
-                                        uint64_t elementSize) {
+                                        uint64_t elementSize,
+                                        Fam_Request **request) {
     FAM_CNTR_INC_API(fam_gather_nonblocking);
     FAM_PROFILE_START_ALLOCATOR(fam_gather_nonblocking);
     if ((local == NULL) || (descriptor == NULL) || (nElements == 0)) {
@@ -2104,8 +2648,17 @@ void fam::Impl_::fam_gather_nonblocking(void *local, Fam_Descriptor *descriptor,
     FAM_PROFILE_END_ALLOCATOR(fam_gather_nonblocking);
     FAM_PROFILE_START_OPS(fam_gather_nonblocking);
     if (ret == 0) {
-        famOps->gather_nonblocking(local, descriptor, nElements, elementIndex,
-                                   elementSize);
+        Fam_Request *req = (request ? new Fam_Request(false) : NULL);
+        try {
+            famOps->gather_nonblocking(local, descriptor, nElements,
+                                       elementIndex, elementSize, req);
+        } catch (...) {
+            famOps->drain_request(req);
+            delete req;
+            throw;
+        }
+        if (request)
+            *request = req;
     }
     FAM_PROFILE_END_OPS(fam_gather_nonblocking);
     return;
@@ -2227,7 +2780,8 @@ void fam::Impl_::fam_scatter_nonblocking(void *local,
                                          Fam_Descriptor *descriptor,
                                          uint64_t nElements,
                                          uint64_t firstElement, uint64_t stride,
-                                         uint64_t elementSize) {
+                                         uint64_t elementSize,
+                                         Fam_Request **request) {
     FAM_CNTR_INC_API(fam_scatter_nonblocking);
     FAM_PROFILE_START_ALLOCATOR(fam_scatter_nonblocking);
     if ((local == NULL) || (descriptor == NULL) || (nElements == 0)) {
@@ -2246,8 +2800,17 @@ void fam::Impl_::fam_scatter_nonblocking(void *local,
     FAM_PROFILE_END_ALLOCATOR(fam_scatter_nonblocking);
     FAM_PROFILE_START_OPS(fam_scatter_nonblocking);
     if (ret == 0) {
-        famOps->scatter_nonblocking(local, descriptor, nElements, firstElement,
-                                    stride, elementSize);
+        Fam_Request *req = (request ? new Fam_Request(true) : NULL);
+        try {
+            famOps->scatter_nonblocking(local, descriptor, nElements,
+                                        firstElement, stride, elementSize, req);
+        } catch (...) {
+            famOps->drain_request(req);
+            delete req;
+            throw;
+        }
+        if (request)
+            *request = req;
     }
     FAM_PROFILE_END_OPS(fam_scatter_nonblocking);
     return;
@@ -2272,7 +2835,8 @@ void fam::Impl_::fam_scatter_nonblocking(void *local,
                                          Fam_Descriptor *descriptor,
                                          uint64_t nElements,
                                          uint64_t *elementIndex,
-                                         uint64_t elementSize) {
+                                         uint64_t elementSize,
+                                         Fam_Request **request) {
     FAM_CNTR_INC_API(fam_scatter_nonblocking);
     FAM_PROFILE_START_ALLOCATOR(fam_scatter_nonblocking);
     if ((local == NULL) || (descriptor == NULL) || (nElements == 0)) {
@@ -2294,8 +2858,17 @@ void fam::Impl_::fam_scatter_nonblocking(void *local,
     FAM_PROFILE_END_ALLOCATOR(fam_scatter_nonblocking);
     FAM_PROFILE_START_OPS(fam_scatter_nonblocking);
     if (ret == 0) {
-        famOps->scatter_nonblocking(local, descriptor, nElements, elementIndex,
-                                    elementSize);
+        Fam_Request *req = (request ? new Fam_Request(true) : NULL);
+        try {
+            famOps->scatter_nonblocking(local, descriptor, nElements,
+                                        elementIndex, elementSize, req);
+        } catch (...) {
+            famOps->drain_request(req);
+            delete req;
+            throw;
+        }
+        if (request)
+            *request = req;
     }
     FAM_PROFILE_END_OPS(fam_scatter_nonblocking);
     return;
@@ -5361,6 +5934,122 @@ uint64_t fam::Impl_::fam_fetch_xor(Fam_Descriptor *descriptor, uint64_t offset,
     return old;
 }
 
+/**
+ * Validate every entry of a batched atomics request.
+ * @param entries - array of atomic batch entries
+ * @param nEntries - number of entries in the array
+ * @return - 0 if all entries are valid
+ * @throws : Fam_InvalidOption_Exception if incorrect parameters are passed.
+ */
+int fam::Impl_::validate_atomic_batch(Fam_Atomic_Batch_Entry *entries,
+                                      uint64_t nEntries) {
+    int ret = 0;
+    if ((entries == NULL) || (nEntries == 0)) {
+        THROW_ERR_MSG(Fam_InvalidOption_Exception, "Invalid Options");
+    }
+    for (uint64_t i = 0; i < nEntries; i++) {
+        Fam_Descriptor *descriptor = entries[i].descriptor;
+        uint64_t value_size;
+        bool isUnsigned = false;
+        if (descriptor == NULL) {
+            THROW_ERR_MSG(Fam_InvalidOption_Exception, "Invalid Options");
+        }
+        switch (entries[i].type) {
+        case FAM_ATOMIC_INT32:
+        case FAM_ATOMIC_FLOAT:
+            value_size = sizeof(int32_t);
+            break;
+        case FAM_ATOMIC_UINT32:
+            value_size = sizeof(uint32_t);
+            isUnsigned = true;
+            break;
+        case FAM_ATOMIC_INT64:
+        case FAM_ATOMIC_DOUBLE:
+            value_size = sizeof(int64_t);
+            break;
+        case FAM_ATOMIC_UINT64:
+            value_size = sizeof(uint64_t);
+            isUnsigned = true;
+            break;
+        default:
+            THROW_ERR_MSG(Fam_InvalidOption_Exception, "Invalid atomic type");
+        }
+        if ((entries[i].op < FAM_ATOMIC_SET) ||
+            (entries[i].op > FAM_ATOMIC_XOR)) {
+            THROW_ERR_MSG(Fam_InvalidOption_Exception, "Invalid atomic op");
+        }
+        // Logical operations are defined only for unsigned types
+        if ((entries[i].op >= FAM_ATOMIC_AND) && !isUnsigned) {
+            THROW_ERR_MSG(Fam_InvalidOption_Exception,
+                          "Logical atomic op on a signed type");
+        }
+
+        ret = validate_item(descriptor);
+        if (ret != 0)
+            return ret;
+
+#ifdef CHECK_OFFSETS
+        uint64_t disize = descriptor->get_size();
+        uint64_t offset = entries[i].offset;
+        if ((offset >= disize) || ((offset + value_size) > disize)) {
+            THROW_ERR_MSG(Fam_InvalidOption_Exception, "Access out of bounds");
+        }
+        if (!is_aligned(offset, value_size))
+            THROW_ERR_MSG(Fam_InvalidOption_Exception, "Misaligned Offset");
+#else
+        (void)value_size;
+#endif
+    }
+    return ret;
+}
+
+/**
+ * atomic batch - issue a batch of non-fetching atomics with a single lock
+ * acquisition per context. Completion is guaranteed only after fam_quiet().
+ * @param entries - array of {descriptor, offset, op, type, value} entries
+ * @param nEntries - number of entries in the array
+ */
+void fam::Impl_::fam_atomic_batch(Fam_Atomic_Batch_Entry *entries,
+                                  uint64_t nEntries) {
+    FAM_CNTR_INC_API(fam_atomic_batch);
+    FAM_PROFILE_START_ALLOCATOR(fam_atomic_batch);
+    int ret = validate_atomic_batch(entries, nEntries);
+    FAM_PROFILE_END_ALLOCATOR(fam_atomic_batch);
+
+    FAM_PROFILE_START_OPS(fam_atomic_batch);
+    if (ret == 0) {
+        famOps->atomic_batch(entries, nEntries, NULL);
+    }
+    FAM_PROFILE_END_OPS(fam_atomic_batch);
+    return;
+}
+
+/**
+ * fetch atomic batch - issue a batch of fetching atomics and wait for all of
+ * them to complete.
+ * @param entries - array of {descriptor, offset, op, type, value} entries
+ * @param nEntries - number of entries in the array
+ * @param results - array of nEntries values where the old values are returned
+ */
+void fam::Impl_::fam_atomic_fetch_batch(Fam_Atomic_Batch_Entry *entries,
+                                        uint64_t nEntries,
+                                        Fam_Atomic_Value *results) {
+    FAM_CNTR_INC_API(fam_atomic_fetch_batch);
+    FAM_PROFILE_START_ALLOCATOR(fam_atomic_fetch_batch);
+    if (results == NULL) {
+        THROW_ERR_MSG(Fam_InvalidOption_Exception, "Invalid Options");
+    }
+    int ret = validate_atomic_batch(entries, nEntries);
+    FAM_PROFILE_END_ALLOCATOR(fam_atomic_fetch_batch);
+
+    FAM_PROFILE_START_OPS(fam_atomic_fetch_batch);
+    if (ret == 0) {
+        famOps->atomic_batch(entries, nEntries, results);
+    }
+    FAM_PROFILE_END_OPS(fam_atomic_fetch_batch);
+    return;
+}
+
 // MEMORY ORDERING Routines - provide ordering of FAM operations issued by a PE
 
 /**
@@ -5392,16 +6081,307 @@ void fam::Impl_::fam_quiet(Fam_Region_Descriptor *descriptor) {
 }
 
 /**
- * fam_progress - returns number of all its pending FAM
- * operations (put, scatter, atomics, copy).
- * @return - number of pending operations
+ * fam_invalidate - drop the data of a range of a data item cached by this PE,
+ * so that the next reads of the range fetch it from FAM.
+ * @param descriptor - valid descriptor to data item in FAM
+ * @param offset - byte offset within the data item of the range
+ * @param nbytes - number of bytes in the range
  */
+void fam::Impl_::fam_invalidate(Fam_Descriptor *descriptor, uint64_t offset,
+                                uint64_t nbytes) {
+    FAM_CNTR_INC_API(fam_invalidate);
+    FAM_PROFILE_START_OPS(fam_invalidate);
+    if (descriptor == NULL) {
+        THROW_ERR_MSG(Fam_InvalidOption_Exception, "Invalid Options");
+    }
+    famOps->invalidate(descriptor, offset, nbytes);
+    FAM_PROFILE_END_OPS(fam_invalidate);
+    return;
+}
 
-uint64_t fam::Impl_::fam_progress() {
-    uint64_t ret;
-    FAM_CNTR_INC_API(fam_progress);
-    FAM_PROFILE_START_OPS(fam_progress);
-    ret = famOps->progress();
+/**
+ * fam_prefetch - start reading a range of a data item into the read cache,
+ * without waiting for it.
+ * @param descriptor - valid descriptor to data item in FAM
+ * @param offset - byte offset within the data item of the range
+ * @param nbytes - number of bytes in the range
+ */
+void fam::Impl_::fam_prefetch(Fam_Descriptor *descriptor, uint64_t offset,
+                              uint64_t nbytes) {
+    FAM_CNTR_INC_API(fam_prefetch);
+    FAM_PROFILE_START_ALLOCATOR(fam_prefetch);
+    if ((descriptor == NULL) || (nbytes == 0)) {
+        THROW_ERR_MSG(Fam_InvalidOption_Exception, "Invalid Options");
+    }
+    int ret = validate_item(descriptor);
+    FAM_PROFILE_END_ALLOCATOR(fam_prefetch);
+    FAM_PROFILE_START_OPS(fam_prefetch);
+    if (ret == 0)
+        famOps->prefetch(descriptor, offset, nbytes);
+    FAM_PROFILE_END_OPS(fam_prefetch);
+    return;
+}
+
+/**
+ * fam_stream_open - start a sequential read of a range of a data item, in
+ * chunks read ahead with nonblocking gets.
+ * @param descriptor - valid descriptor to data item in FAM
+ * @param offset - byte offset within the data item of the range
+ * @param nbytes - number of bytes in the range
+ * @param chunkSize - size in bytes of a chunk
+ * @param depth - number of chunks read ahead
+ * @return - the stream
+ */
+Fam_Stream *fam::Impl_::fam_stream_open(Fam_Descriptor *descriptor,
+                                        uint64_t offset, uint64_t nbytes,
+                                        uint64_t chunkSize, uint64_t depth) {
+    FAM_CNTR_INC_API(fam_stream_open);
+    FAM_PROFILE_START_ALLOCATOR(fam_stream_open);
+    if ((descriptor == NULL) || (nbytes == 0) || (chunkSize == 0) ||
+        (depth == 0)) {
+        THROW_ERR_MSG(Fam_InvalidOption_Exception, "Invalid Options");
+    }
+    int ret = validate_item(descriptor);
+#ifdef CHECK_OFFSETS
+    uint64_t disize = descriptor->get_size(); // Get size from user decriptor
+    if ((offset >= disize) || ((offset + nbytes) > disize)) {
+        THROW_ERR_MSG(Fam_InvalidOption_Exception, "Access out of bounds");
+    }
+#endif
+    FAM_PROFILE_END_ALLOCATOR(fam_stream_open);
+    FAM_PROFILE_START_OPS(fam_stream_open);
+    Fam_Stream *stream = NULL;
+    if (ret == 0) {
+        try {
+            stream =
+                new Fam_Stream(descriptor, offset, nbytes, chunkSize, depth);
+        } catch (std::bad_alloc &e) {
+            THROW_ERRNO_MSG(Fam_Datapath_Exception, FAM_ERR_RESOURCE,
+                            "Failed to allocate stream buffers");
+        }
+        try {
+            stream_start_chunks(stream);
+        } catch (...) {
+            stream_release(stream);
+            throw;
+        }
+    }
+    FAM_PROFILE_END_OPS(fam_stream_open);
+    return stream;
+}
+
+/**
+ * fam_stream_next - wait for the next chunk of a stream, and start reading
+ * the chunk that takes the place of the previous one.
+ * @param stream - stream returned by fam_stream_open()
+ * @param nbytes - returns the number of bytes in the chunk
+ * @return - pointer to the chunk, NULL at the end of the stream
+ */
+const void *fam::Impl_::fam_stream_next(Fam_Stream *stream, uint64_t *nbytes) {
+    FAM_CNTR_INC_API(fam_stream_next);
+    FAM_PROFILE_START_OPS(fam_stream_next);
+    if ((stream == NULL) || (nbytes == NULL)) {
+        THROW_ERR_MSG(Fam_InvalidOption_Exception, "Invalid Options");
+    }
+    stream->release_lent();
+    stream_start_chunks(stream);
+    if (stream->empty()) {
+        *nbytes = 0;
+        FAM_PROFILE_END_OPS(fam_stream_next);
+        return NULL;
+    }
+    Fam_Stream_Chunk chunk = stream->front();
+    stream->pop_front();
+    try {
+        famOps->wait_request(chunk.request);
+    } catch (...) {
+        famOps->drain_request(chunk.request);
+        delete chunk.request;
+        throw;
+    }
+    delete chunk.request;
+    *nbytes = chunk.nbytes;
+    FAM_PROFILE_END_OPS(fam_stream_next);
+    return chunk.buf;
+}
+
+/**
+ * fam_stream_close - release a stream once the chunks still being read
+ * have completed.
+ * @param stream - stream returned by fam_stream_open()
+ */
+void fam::Impl_::fam_stream_close(Fam_Stream *stream) {
+    FAM_CNTR_INC_API(fam_stream_close);
+    FAM_PROFILE_START_OPS(fam_stream_close);
+    if (stream == NULL) {
+        THROW_ERR_MSG(Fam_InvalidOption_Exception, "Invalid Options");
+    }
+    stream_release(stream);
+    FAM_PROFILE_END_OPS(fam_stream_close);
+    return;
+}
+
+// Start reading chunks of a stream into all of its free buffers
+void fam::Impl_::stream_start_chunks(Fam_Stream *stream) {
+    char *buf;
+    uint64_t offset, nbytes;
+    while (stream->next_chunk(&buf, &offset, &nbytes)) {
+        Fam_Request *req = new Fam_Request(false);
+        try {
+            famOps->get_nonblocking(buf, stream->get_descriptor(), offset,
+                                    nbytes, req);
+        } catch (...) {
+            famOps->drain_request(req);
+            delete req;
+            throw;
+        }
+        stream->start_chunk(req);
+    }
+}
+
+// Wait for the chunks of a stream still being read and delete it
+void fam::Impl_::stream_release(Fam_Stream *stream) {
+    while (!stream->empty()) {
+        Fam_Stream_Chunk chunk = stream->front();
+        stream->pop_front();
+        // The data of unread chunks is dropped, only their completion matters
+        try {
+            famOps->wait_request(chunk.request);
+        } catch (...) {
+            famOps->drain_request(chunk.request);
+        }
+        delete chunk.request;
+    }
+    delete stream;
+}
+
+/**
+ * fam_test - check whether a request returned by a nonblocking get, put,
+ * gather or scatter has completed, without waiting. A completed request is
+ * released.
+ * @param request - request to be checked
+ * @return - true if the request has completed
+ */
+bool fam::Impl_::fam_test(Fam_Request *request) {
+    bool done;
+    FAM_CNTR_INC_API(fam_test);
+    FAM_PROFILE_START_OPS(fam_test);
+    if (request == NULL) {
+        THROW_ERR_MSG(Fam_InvalidOption_Exception, "Invalid Options");
+    }
+    try {
+        done = famOps->test_request(request);
+    } catch (...) {
+        famOps->drain_request(request);
+        delete request;
+        throw;
+    }
+    if (done)
+        delete request;
+    FAM_PROFILE_END_OPS(fam_test);
+    return done;
+}
+
+/**
+ * fam_wait - wait until a request returned by a nonblocking get, put, gather
+ * or scatter has completed, and release it.
+ * @param request - request to be waited on
+ */
+void fam::Impl_::fam_wait(Fam_Request *request) {
+    FAM_CNTR_INC_API(fam_wait);
+    FAM_PROFILE_START_OPS(fam_wait);
+    if (request == NULL) {
+        THROW_ERR_MSG(Fam_InvalidOption_Exception, "Invalid Options");
+    }
+    try {
+        famOps->wait_request(request);
+    } catch (...) {
+        famOps->drain_request(request);
+        delete request;
+        throw;
+    }
+    delete request;
+    FAM_PROFILE_END_OPS(fam_wait);
+    return;
+}
+
+/**
+ * fam_wait_any - wait until any one of an array of requests has completed.
+ * The completed request is released and its entry is set to NULL; NULL
+ * entries are skipped.
+ * @param requests - array of requests
+ * @param count - number of entries in the array
+ * @return - index of the completed request, or count if all entries are NULL
+ */
+uint64_t fam::Impl_::fam_wait_any(Fam_Request **requests, uint64_t count) {
+    FAM_CNTR_INC_API(fam_wait_any);
+    FAM_PROFILE_START_OPS(fam_wait_any);
+    if ((requests == NULL) && (count > 0)) {
+        THROW_ERR_MSG(Fam_InvalidOption_Exception, "Invalid Options");
+    }
+    uint64_t i;
+    uint64_t failed = count;
+    try {
+        i = famOps->wait_any_request(requests, count, &failed);
+    } catch (...) {
+        if (failed < count) {
+            famOps->drain_request(requests[failed]);
+            delete requests[failed];
+            requests[failed] = NULL;
+        }
+        throw;
+    }
+    if (i < count) {
+        delete requests[i];
+        requests[i] = NULL;
+    }
+    FAM_PROFILE_END_OPS(fam_wait_any);
+    return i;
+}
+
+/**
+ * fam_wait_all - wait until all of an array of requests have completed. Each
+ * request is released and its entry set to NULL as it completes; NULL entries
+ * are skipped. If a request fails, the exception is thrown once that request
+ * has been released, and the entries after it are left for the caller.
+ * @param requests - array of requests
+ * @param count - number of entries in the array
+ */
+void fam::Impl_::fam_wait_all(Fam_Request **requests, uint64_t count) {
+    FAM_CNTR_INC_API(fam_wait_all);
+    FAM_PROFILE_START_OPS(fam_wait_all);
+    if ((requests == NULL) && (count > 0)) {
+        THROW_ERR_MSG(Fam_InvalidOption_Exception, "Invalid Options");
+    }
+    for (uint64_t i = 0; i < count; i++) {
+        Fam_Request *request = requests[i];
+        if (request == NULL)
+            continue;
+        requests[i] = NULL;
+        try {
+            famOps->wait_request(request);
+        } catch (...) {
+            famOps->drain_request(request);
+            delete request;
+            throw;
+        }
+        delete request;
+    }
+    FAM_PROFILE_END_OPS(fam_wait_all);
+    return;
+}
+
+/**
+ * fam_progress - returns number of all its pending FAM
+ * operations (put, scatter, atomics, copy).
+ * @return - number of pending operations
+ */
+
+uint64_t fam::Impl_::fam_progress() {
+    uint64_t ret;
+    FAM_CNTR_INC_API(fam_progress);
+    FAM_PROFILE_START_OPS(fam_progress);
+    ret = famOps->progress();
     FAM_PROFILE_END_OPS(fam_progress);
     return ret;
 }
@@ -5740,6 +6720,24 @@ void fam::fam_get_nonblocking(void *local, Fam_Descriptor *descriptor,
     RETURN_WITH_FAM_EXCEPTION
 }
 
+/**
+ * Initiate a copy of data from FAM to node local memory and return a request
+ * for it.
+ * @param request - returns the request, to be completed with fam_test(),
+ * fam_wait(), fam_wait_any() or fam_wait_all()
+ * @throws Fam_InvalidOption_Exception.
+ * @throws Fam_Datapath_Exception.
+ * @throws Fam_Allocator_Exception - exceptionObj->fam_error() may return:
+ *         FAM_ERR_NOPERM, FAM_ERR_NOTFOUND, FAM_ERR_RPC
+ */
+void fam::fam_get_nonblocking(void *local, Fam_Descriptor *descriptor,
+                              uint64_t offset, uint64_t nbytes,
+                              Fam_Request **request) {
+    TRY_CATCH_BEGIN
+    pimpl_->fam_get_nonblocking(local, descriptor, offset, nbytes, request);
+    RETURN_WITH_FAM_EXCEPTION
+}
+
 /**
  * Copy data from local memory to FAM, blocking until the copy is complete.
  * @param local - pointer to local memory. Must point to valid data in local
@@ -5784,6 +6782,58 @@ void fam::fam_put_nonblocking(void *local, Fam_Descriptor *descriptor,
     RETURN_WITH_FAM_EXCEPTION
 }
 
+/**
+ * Initiate a copy of data from local memory to FAM and return a request for
+ * it.
+ * @param request - returns the request, to be completed with fam_test(),
+ * fam_wait(), fam_wait_any() or fam_wait_all()
+ * @throws Fam_InvalidOption_Exception.
+ * @throws Fam_Datapath_Exception.
+ * @throws Fam_Allocator_Exception - exceptionObj->fam_error() may return:
+ *         FAM_ERR_NOPERM, FAM_ERR_NOTFOUND, FAM_ERR_RPC
+ */
+void fam::fam_put_nonblocking(void *local, Fam_Descriptor *descriptor,
+                              uint64_t offset, uint64_t nbytes,
+                              Fam_Request **request) {
+    TRY_CATCH_BEGIN
+    pimpl_->fam_put_nonblocking(local, descriptor, offset, nbytes, request);
+    RETURN_WITH_FAM_EXCEPTION
+}
+
+/**
+ * Copy a batch of regions from FAM to node local memory, blocking until all
+ * copies are complete.
+ * @param entries - array of {descriptor, offset, local, nbytes} entries
+ * @param nEntries - number of entries in the array
+ * @throws Fam_InvalidOption_Exception.
+ * @throws Fam_Datapath_Exception.
+ * @throws Fam_Timeout_Exception.
+ * @throws Fam_Allocator_Exception - exceptionObj->fam_error() may return:
+ *         FAM_ERR_NOPERM, FAM_ERR_NOTFOUND, FAM_ERR_RPC
+ */
+void fam::fam_get_batch(Fam_Batch_Entry *entries, uint64_t nEntries) {
+    TRY_CATCH_BEGIN
+    pimpl_->fam_get_batch(entries, nEntries);
+    RETURN_WITH_FAM_EXCEPTION
+}
+
+/**
+ * Copy a batch of regions from node local memory to FAM, blocking until all
+ * copies are complete.
+ * @param entries - array of {descriptor, offset, local, nbytes} entries
+ * @param nEntries - number of entries in the array
+ * @throws Fam_InvalidOption_Exception.
+ * @throws Fam_Datapath_Exception.
+ * @throws Fam_Timeout_Exception.
+ * @throws Fam_Allocator_Exception - exceptionObj->fam_error() may return:
+ *         FAM_ERR_NOPERM, FAM_ERR_NOTFOUND, FAM_ERR_RPC
+ */
+void fam::fam_put_batch(Fam_Batch_Entry *entries, uint64_t nEntries) {
+    TRY_CATCH_BEGIN
+    pimpl_->fam_put_batch(entries, nEntries);
+    RETURN_WITH_FAM_EXCEPTION
+}
+
 // LOAD/STORE sub-group
 
 /**
@@ -5904,6 +6954,26 @@ void fam::fam_gather_nonblocking(void *local, Fam_Descriptor *descriptor,
     RETURN_WITH_FAM_EXCEPTION
 }
 
+/**
+ * Initiate a strided gather from FAM to local memory and return a request for
+ * it.
+ * @param request - returns the request, to be completed with fam_test(),
+ * fam_wait(), fam_wait_any() or fam_wait_all()
+ * @throws Fam_InvalidOption_Exception.
+ * @throws Fam_Datapath_Exception.
+ * @throws Fam_Allocator_Exception - exceptionObj->fam_error() may return:
+ *         FAM_ERR_NOPERM, FAM_ERR_NOTFOUND, FAM_ERR_RPC
+ */
+void fam::fam_gather_nonblocking(void *local, Fam_Descriptor *descriptor,
+                                 uint64_t nElements, uint64_t firstElement,
+                                 uint64_t stride, uint64_t elementSize,
+                                 Fam_Request **request) {
+    TRY_CATCH_BEGIN
+    pimpl_->fam_gather_nonblocking(local, descriptor, nElements, firstElement,
+                                   stride, elementSize, request);
+    RETURN_WITH_FAM_EXCEPTION
+}
+
 /**
  * Gather data from FAM to local memory, blocking while copy is complete
  * Gathers disjoint elements within a data item in FAM to a contiguous array in
@@ -5931,6 +7001,25 @@ void fam::fam_gather_nonblocking(void *local, Fam_Descriptor *descriptor,
     RETURN_WITH_FAM_EXCEPTION
 }
 
+/**
+ * Initiate an indexed gather from FAM to local memory and return a request
+ * for it.
+ * @param request - returns the request, to be completed with fam_test(),
+ * fam_wait(), fam_wait_any() or fam_wait_all()
+ * @throws Fam_InvalidOption_Exception.
+ * @throws Fam_Datapath_Exception.
+ * @throws Fam_Allocator_Exception - exceptionObj->fam_error() may return:
+ *         FAM_ERR_NOPERM, FAM_ERR_NOTFOUND, FAM_ERR_RPC
+ */
+void fam::fam_gather_nonblocking(void *local, Fam_Descriptor *descriptor,
+                                 uint64_t nElements, uint64_t *elementIndex,
+                                 uint64_t elementSize, Fam_Request **request) {
+    TRY_CATCH_BEGIN
+    pimpl_->fam_gather_nonblocking(local, descriptor, nElements, elementIndex,
+                                   elementSize, request);
+    RETURN_WITH_FAM_EXCEPTION
+}
+
 /**
  * Scatter data from local memory to FAM.
  * Scatters data from a contiguous array in local memory to disjoint elements of
@@ -6021,6 +7110,26 @@ void fam::fam_scatter_nonblocking(void *local, Fam_Descriptor *descriptor,
     RETURN_WITH_FAM_EXCEPTION
 }
 
+/**
+ * Initiate a strided scatter from local memory to FAM and return a request
+ * for it.
+ * @param request - returns the request, to be completed with fam_test(),
+ * fam_wait(), fam_wait_any() or fam_wait_all()
+ * @throws Fam_InvalidOption_Exception.
+ * @throws Fam_Datapath_Exception.
+ * @throws Fam_Allocator_Exception - exceptionObj->fam_error() may return:
+ *         FAM_ERR_NOPERM, FAM_ERR_NOTFOUND, FAM_ERR_RPC
+ */
+void fam::fam_scatter_nonblocking(void *local, Fam_Descriptor *descriptor,
+                                  uint64_t nElements, uint64_t firstElement,
+                                  uint64_t stride, uint64_t elementSize,
+                                  Fam_Request **request) {
+    TRY_CATCH_BEGIN
+    pimpl_->fam_scatter_nonblocking(local, descriptor, nElements, firstElement,
+                                    stride, elementSize, request);
+    RETURN_WITH_FAM_EXCEPTION
+}
+
 /**
  * Initiate a scatter data from local memory to FAM.
  * Scatters data from a contiguous array in local memory to disjoint elements of
@@ -6049,6 +7158,84 @@ void fam::fam_scatter_nonblocking(void *local, Fam_Descriptor *descriptor,
     RETURN_WITH_FAM_EXCEPTION
 }
 
+/**
+ * Initiate an indexed scatter from local memory to FAM and return a request
+ * for it.
+ * @param request - returns the request, to be completed with fam_test(),
+ * fam_wait(), fam_wait_any() or fam_wait_all()
+ * @throws Fam_InvalidOption_Exception.
+ * @throws Fam_Datapath_Exception.
+ * @throws Fam_Allocator_Exception - exceptionObj->fam_error() may return:
+ *         FAM_ERR_NOPERM, FAM_ERR_NOTFOUND, FAM_ERR_RPC
+ */
+void fam::fam_scatter_nonblocking(void *local, Fam_Descriptor *descriptor,
+                                  uint64_t nElements, uint64_t *elementIndex,
+                                  uint64_t elementSize, Fam_Request **request) {
+    TRY_CATCH_BEGIN
+    pimpl_->fam_scatter_nonblocking(local, descriptor, nElements, elementIndex,
+                                    elementSize, request);
+    RETURN_WITH_FAM_EXCEPTION
+}
+
+/**
+ * fam_test - check whether a nonblocking request has completed, without
+ * waiting for it. A completed request is released.
+ * @param request - request returned by a nonblocking call
+ * @return - true if the request has completed
+ * @throws Fam_InvalidOption_Exception.
+ * @throws Fam_Datapath_Exception - if an IO of the request failed; the
+ * request is released.
+ */
+bool fam::fam_test(Fam_Request *request) {
+    TRY_CATCH_BEGIN
+    return pimpl_->fam_test(request);
+    RETURN_WITH_FAM_EXCEPTION
+}
+
+/**
+ * fam_wait - block until a nonblocking request has completed, and release it.
+ * @param request - request returned by a nonblocking call
+ * @throws Fam_InvalidOption_Exception.
+ * @throws Fam_Datapath_Exception - if an IO of the request failed; the
+ * request is released.
+ * @throws Fam_Timeout_Exception.
+ */
+void fam::fam_wait(Fam_Request *request) {
+    TRY_CATCH_BEGIN
+    pimpl_->fam_wait(request);
+    RETURN_WITH_FAM_EXCEPTION
+}
+
+/**
+ * fam_wait_any - block until any one of an array of nonblocking requests has
+ * completed. The completed request is released and its entry set to NULL.
+ * @param requests - array of requests; NULL entries are skipped
+ * @param count - number of entries in the array
+ * @return - index of the completed request, or count if all entries are NULL
+ * @throws Fam_InvalidOption_Exception.
+ * @throws Fam_Datapath_Exception.
+ */
+uint64_t fam::fam_wait_any(Fam_Request **requests, uint64_t count) {
+    TRY_CATCH_BEGIN
+    return pimpl_->fam_wait_any(requests, count);
+    RETURN_WITH_FAM_EXCEPTION
+}
+
+/**
+ * fam_wait_all - block until all of an array of nonblocking requests have
+ * completed. Each request is released and its entry set to NULL.
+ * @param requests - array of requests; NULL entries are skipped
+ * @param count - number of entries in the array
+ * @throws Fam_InvalidOption_Exception.
+ * @throws Fam_Datapath_Exception.
+ * @throws Fam_Timeout_Exception.
+ */
+void fam::fam_wait_all(Fam_Request **requests, uint64_t count) {
+    TRY_CATCH_BEGIN
+    pimpl_->fam_wait_all(requests, count);
+    RETURN_WITH_FAM_EXCEPTION
+}
+
 // COPY Subgroup
 
 /**
@@ -6875,6 +8062,43 @@ uint64_t fam::fam_fetch_xor(Fam_Descriptor *descriptor, uint64_t offset,
     RETURN_WITH_FAM_EXCEPTION
 }
 
+/**
+ * atomic batch - issue a batch of non-fetching atomics. Completion is
+ * guaranteed only after fam_quiet().
+ * @param entries - array of {descriptor, offset, op, type, value} entries
+ * @param nEntries - number of entries in the array
+ * @throws Fam_InvalidOption_Exception.
+ * @throws Fam_Datapath_Exception.
+ * @throws Fam_Allocator_Exception - exceptionObj->fam_error() may return:
+ *         FAM_ERR_NOPERM, FAM_ERR_NOTFOUND, FAM_ERR_RPC
+ */
+void fam::fam_atomic_batch(Fam_Atomic_Batch_Entry *entries,
+                           uint64_t nEntries) {
+    TRY_CATCH_BEGIN
+    pimpl_->fam_atomic_batch(entries, nEntries);
+    RETURN_WITH_FAM_EXCEPTION
+}
+
+/**
+ * fetch atomic batch - issue a batch of fetching atomics and wait for all of
+ * them to complete.
+ * @param entries - array of {descriptor, offset, op, type, value} entries
+ * @param nEntries - number of entries in the array
+ * @param results - array of nEntries values where the old values are returned
+ * @throws Fam_InvalidOption_Exception.
+ * @throws Fam_Datapath_Exception.
+ * @throws Fam_Timeout_Exception.
+ * @throws Fam_Allocator_Exception - exceptionObj->fam_error() may return:
+ *         FAM_ERR_NOPERM, FAM_ERR_NOTFOUND, FAM_ERR_RPC
+ */
+void fam::fam_atomic_fetch_batch(Fam_Atomic_Batch_Entry *entries,
+                                 uint64_t nEntries,
+                                 Fam_Atomic_Value *results) {
+    TRY_CATCH_BEGIN
+    pimpl_->fam_atomic_fetch_batch(entries, nEntries, results);
+    RETURN_WITH_FAM_EXCEPTION
+}
+
 // MEMORY ORDERING Routines - provide ordering of FAM operations issued by a PE
 
 /**
@@ -6905,6 +8129,84 @@ void fam::fam_quiet() {
     RETURN_WITH_FAM_EXCEPTION
 }
 
+/**
+ * fam_invalidate - drop the data of a range of a data item cached by this PE,
+ * so that the next reads of the range fetch it from FAM. Needed only with the
+ * read cache enabled, to see the writes of other PEs.
+ * @param descriptor - valid descriptor to data item in FAM
+ * @param offset - byte offset within the data item of the range
+ * @param nbytes - number of bytes in the range
+ * @throws Fam_InvalidOption_Exception.
+ */
+void fam::fam_invalidate(Fam_Descriptor *descriptor, uint64_t offset,
+                         uint64_t nbytes) {
+    TRY_CATCH_BEGIN
+    pimpl_->fam_invalidate(descriptor, offset, nbytes);
+    RETURN_WITH_FAM_EXCEPTION
+}
+
+/**
+ * fam_prefetch - start reading a range of a data item in the background,
+ * so that a later fam_get_blocking of the range completes as a local copy.
+ * Has no effect unless the read cache is enabled.
+ * @param descriptor - valid descriptor to data item in FAM
+ * @param offset - byte offset within the data item of the range
+ * @param nbytes - number of bytes in the range
+ * @throws Fam_InvalidOption_Exception, Fam_Datapath_Exception.
+ */
+void fam::fam_prefetch(Fam_Descriptor *descriptor, uint64_t offset,
+                       uint64_t nbytes) {
+    TRY_CATCH_BEGIN
+    pimpl_->fam_prefetch(descriptor, offset, nbytes);
+    RETURN_WITH_FAM_EXCEPTION
+}
+
+/**
+ * fam_stream_open - start a sequential read of a range of a data item, in
+ * chunks of chunkSize bytes of which up to depth are read ahead.
+ * @param descriptor - valid descriptor to data item in FAM
+ * @param offset - byte offset within the data item of the range
+ * @param nbytes - number of bytes in the range
+ * @param chunkSize - size in bytes of a chunk
+ * @param depth - number of chunks read ahead
+ * @return - the stream, to be released with fam_stream_close()
+ * @throws Fam_InvalidOption_Exception, Fam_Datapath_Exception.
+ */
+Fam_Stream *fam::fam_stream_open(Fam_Descriptor *descriptor, uint64_t offset,
+                                 uint64_t nbytes, uint64_t chunkSize,
+                                 uint64_t depth) {
+    TRY_CATCH_BEGIN
+    return pimpl_->fam_stream_open(descriptor, offset, nbytes, chunkSize,
+                                   depth);
+    RETURN_WITH_FAM_EXCEPTION
+}
+
+/**
+ * fam_stream_next - wait for the next chunk of a stream, valid until the
+ * next call on the stream.
+ * @param stream - stream returned by fam_stream_open()
+ * @param nbytes - returns the number of bytes in the chunk, 0 at the end
+ * @return - pointer to the chunk, NULL at the end of the stream
+ * @throws Fam_InvalidOption_Exception, Fam_Datapath_Exception.
+ */
+const void *fam::fam_stream_next(Fam_Stream *stream, uint64_t *nbytes) {
+    TRY_CATCH_BEGIN
+    return pimpl_->fam_stream_next(stream, nbytes);
+    RETURN_WITH_FAM_EXCEPTION
+}
+
+/**
+ * fam_stream_close - release a stream, after waiting for the chunks still
+ * being read.
+ * @param stream - stream returned by fam_stream_open()
+ * @throws Fam_InvalidOption_Exception.
+ */
+void fam::fam_stream_close(Fam_Stream *stream) {
+    TRY_CATCH_BEGIN
+    pimpl_->fam_stream_close(stream);
+    RETURN_WITH_FAM_EXCEPTION
+}
+
 /**
  * fam_progress - returns number of all its pending FAM
  * operations (put, scatter, atomics, copy).
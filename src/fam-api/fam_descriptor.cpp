@@ -29,119 +29,135 @@
  *
  */
 #include <iostream>
+#include <map>
+#include <new>
+#include <pthread.h>
 #include <sstream>
+#include <stdlib.h>
 #include <string>
 #include <unistd.h>
+#include <unordered_map>
+#include <vector>
 
 #include "common/fam_internal.h"
+#include "common/fam_layout.h"
 #include "fam/fam.h"
 
 using namespace std;
 using namespace openfam;
+
+/*
+ * Memory server lists of interleaved data items. Items spread over the same
+ * servers share one immutable copy of the list, so that descriptors only keep
+ * a pointer to it.
+ */
+namespace {
+struct Fam_Server_List {
+    std::vector<uint64_t> ids;
+    uint64_t refCount;
+};
+
+pthread_mutex_t serverListLock = PTHREAD_MUTEX_INITIALIZER;
+std::map<std::vector<uint64_t>, Fam_Server_List *> serverLists;
+std::unordered_map<const uint64_t *, Fam_Server_List *> serverListArrays;
+
+const uint64_t *acquire_server_list(const uint64_t *ids, uint64_t cnt) {
+    std::vector<uint64_t> key(ids, ids + cnt);
+    pthread_mutex_lock(&serverListLock);
+    Fam_Server_List *list;
+    auto it = serverLists.find(key);
+    if (it != serverLists.end()) {
+        list = it->second;
+    } else {
+        list = new Fam_Server_List();
+        list->ids = key;
+        list->refCount = 0;
+        serverLists.insert({key, list});
+        serverListArrays.insert({list->ids.data(), list});
+    }
+    list->refCount++;
+    pthread_mutex_unlock(&serverListLock);
+    return list->ids.data();
+}
+
+void release_server_list(const uint64_t *ids) {
+    pthread_mutex_lock(&serverListLock);
+    auto it = serverListArrays.find(ids);
+    if (it != serverListArrays.end() && --it->second->refCount == 0) {
+        Fam_Server_List *list = it->second;
+        serverListArrays.erase(it);
+        serverLists.erase(list->ids);
+        delete list;
+    }
+    pthread_mutex_unlock(&serverListLock);
+}
+
+// FamDescriptorImpl_ starts with a cache-line aligned Fam_Layout, which new
+// does not guarantee in C++14
+void *alloc_impl(size_t size) {
+    void *mem = NULL;
+    if (posix_memalign(&mem, alignof(Fam_Layout), size) != 0)
+        throw std::bad_alloc();
+    return mem;
+}
+} // namespace
+
 /*
- * Internal implementation of Fam_Descriptor
+ * Internal implementation of Fam_Descriptor. The placement of the item is
+ * kept only in its Fam_Layout; an item held by a single memory server keeps
+ * its id, key and base address inline, interleaved items point to allocated
+ * key and base address arrays and to a shared memory server list.
  */
 class Fam_Descriptor::FamDescriptorImpl_ {
   public:
     FamDescriptorImpl_(Fam_Global_Descriptor globalDesc, uint64_t itemSize) {
+        layout.build(NULL, NULL, NULL, 0, 0);
         gDescriptor = globalDesc;
-        // key = FAM_KEY_UNINITIALIZED;
-        keys = NULL;
         context = NULL;
-        base_addr_list = NULL;
         desc_update_status = DESC_UNINITIALIZED;
         size = itemSize;
-        interleaveSize = 0;
         perm = 0;
         name = NULL;
-        memserver_ids = NULL;
-        used_memsrv_cnt = 0;
         uid = 0;
         gid = 0;
         permissionLevel = PERMISSION_LEVEL_DEFAULT;
     }
 
-    FamDescriptorImpl_(Fam_Global_Descriptor globalDesc) {
-        gDescriptor = globalDesc;
-        // key = FAM_KEY_UNINITIALIZED;
-        keys = NULL;
-        context = NULL;
-        base_addr_list = NULL;
-        desc_update_status = DESC_UNINITIALIZED;
-        size = 0;
-        interleaveSize = 0;
-        perm = 0;
-        name = NULL;
-        memserver_ids = NULL;
-        used_memsrv_cnt = 0;
-        uid = 0;
-        gid = 0;
-        permissionLevel = PERMISSION_LEVEL_DEFAULT;
-    }
+    FamDescriptorImpl_(Fam_Global_Descriptor globalDesc)
+        : FamDescriptorImpl_(globalDesc, 0) {}
 
-    FamDescriptorImpl_() {
-        gDescriptor = {FAM_INVALID_REGION, 0};
-        // key = FAM_KEY_UNINITIALIZED;
-        keys = NULL;
-        context = NULL;
-        base_addr_list = NULL;
-        desc_update_status = DESC_UNINITIALIZED;
-        size = 0;
-        interleaveSize = 0;
-        perm = 0;
-        name = NULL;
-        memserver_ids = NULL;
-        used_memsrv_cnt = 0;
-        uid = 0;
-        gid = 0;
-        permissionLevel = PERMISSION_LEVEL_DEFAULT;
-    }
+    FamDescriptorImpl_() : FamDescriptorImpl_({FAM_INVALID_REGION, 0}, 0) {}
 
     ~FamDescriptorImpl_() {
-        gDescriptor = {FAM_INVALID_REGION, 0};
-        context = NULL;
-        base_addr_list = NULL;
-        desc_update_status = DESC_INVALID;
-        size = 0;
-        interleaveSize = 0;
-        perm = 0;
         if (name)
             free(name);
-        if (memserver_ids)
-            free(memserver_ids);
-        if (keys)
-            free(keys);
-        if (base_addr_list)
-            free(base_addr_list);
-        used_memsrv_cnt = 0;
-        uid = 0;
-        gid = 0;
-        permissionLevel = PERMISSION_LEVEL_DEFAULT;
+        free_keys();
+        free_base_address_list();
+        free_memserver_ids();
     }
 
     Fam_Global_Descriptor get_global_descriptor() { return this->gDescriptor; }
 
     void bind_keys(uint64_t *tempKeys, uint64_t cnt) {
-        if (!keys) {
-            keys = (uint64_t *)malloc(cnt * sizeof(uint64_t));
-            memcpy(keys, tempKeys, sizeof(uint64_t) * cnt);
+        if (!layout.keys) {
+            layout.keys = inline_or_copy(tempKeys, cnt, &singleKey);
         }
         //      key = check_permissions_get_key(gDescriptor.regionID,
         //      gDescriptor.offset);
     }
 
-    uint64_t *get_keys() { return keys; }
+    uint64_t *get_keys() { return (uint64_t *)layout.keys; }
 
     void set_context(void *ctx) { context = ctx; }
 
     void *get_context() { return context; }
 
     void set_base_address_list(uint64_t *addressList, uint64_t cnt) {
-        base_addr_list = (uint64_t *)malloc(cnt * sizeof(uint64_t));
-        memcpy(base_addr_list, addressList, sizeof(uint64_t) * cnt);
+        free_base_address_list();
+        layout.baseAddrs = inline_or_copy(addressList, cnt, &singleBase);
     }
 
-    uint64_t *get_base_address_list() { return base_addr_list; }
+    uint64_t *get_base_address_list() { return (uint64_t *)layout.baseAddrs; }
 
     void set_desc_status(int update_status) {
         desc_update_status = update_status;
@@ -149,10 +165,11 @@ class Fam_Descriptor::FamDescriptorImpl_ {
     int get_desc_status() { return desc_update_status; }
 
     void set_interleave_size(uint64_t interleaveSize_) {
-        interleaveSize = interleaveSize_;
+        layout.build(layout.memServerIds, layout.keys, layout.baseAddrs,
+                     layout.usedMemsrvCnt, interleaveSize_);
     }
 
-    uint64_t get_interleave_size() { return interleaveSize; }
+    uint64_t get_interleave_size() { return layout.interleaveSize; }
 
     void set_size(uint64_t itemSize) {
         if (size == 0)
@@ -169,24 +186,31 @@ class Fam_Descriptor::FamDescriptorImpl_ {
     mode_t get_perm() { return perm; }
 
     void set_name(char *itemName) {
-        if (name == NULL) {
-            name = (char *)malloc(RadixTree::MAX_KEY_LEN);
-            memcpy(name, itemName, RadixTree::MAX_KEY_LEN);
-        }
+        if (name == NULL)
+            name = strndup(itemName, RadixTree::MAX_KEY_LEN);
     }
 
     char *get_name() { return name; }
 
-    void set_used_memsrv_cnt(uint64_t cnt) { used_memsrv_cnt = cnt; }
+    void set_used_memsrv_cnt(uint64_t cnt) {
+        layout.build(layout.memServerIds, layout.keys, layout.baseAddrs, cnt,
+                     layout.interleaveSize);
+    }
 
-    uint64_t get_used_memsrv_cnt() { return used_memsrv_cnt; }
+    uint64_t get_used_memsrv_cnt() { return layout.usedMemsrvCnt; }
 
     void set_memserver_ids(uint64_t *ids) {
-        memserver_ids = (uint64_t *)malloc(used_memsrv_cnt * sizeof(uint64_t));
-        memcpy(memserver_ids, ids, used_memsrv_cnt * sizeof(uint64_t));
+        free_memserver_ids();
+        if (layout.usedMemsrvCnt == 1) {
+            singleId = ids[0];
+            layout.memServerIds = &singleId;
+        } else {
+            layout.memServerIds =
+                acquire_server_list(ids, layout.usedMemsrvCnt);
+        }
     }
 
-    uint64_t *get_memserver_ids() { return memserver_ids; }
+    uint64_t *get_memserver_ids() { return (uint64_t *)layout.memServerIds; }
 
     uint64_t get_first_memserver_id() {
         return (gDescriptor.regionId) >> MEMSERVERID_SHIFT;
@@ -206,36 +230,75 @@ class Fam_Descriptor::FamDescriptorImpl_ {
 
     Fam_Permission_Level get_permissionLevel() { return permissionLevel; }
 
+    const Fam_Layout *get_layout() { return &layout; }
+
   private:
+    // Keep a single value inline, or an allocated copy of an array
+    static const uint64_t *inline_or_copy(const uint64_t *values, uint64_t cnt,
+                                          uint64_t *single) {
+        if (cnt == 1) {
+            *single = values[0];
+            return single;
+        }
+        uint64_t *copy = (uint64_t *)malloc(cnt * sizeof(uint64_t));
+        memcpy(copy, values, cnt * sizeof(uint64_t));
+        return copy;
+    }
+
+    void free_keys() {
+        if (layout.keys != &singleKey)
+            free((void *)layout.keys);
+        layout.keys = NULL;
+    }
+
+    void free_base_address_list() {
+        if (layout.baseAddrs != &singleBase)
+            free((void *)layout.baseAddrs);
+        layout.baseAddrs = NULL;
+    }
+
+    void free_memserver_ids() {
+        if (layout.memServerIds != NULL && layout.memServerIds != &singleId)
+            release_server_list(layout.memServerIds);
+        layout.memServerIds = NULL;
+    }
+
+    // Placement of the item, on the first cache line
+    Fam_Layout layout;
     Fam_Global_Descriptor gDescriptor;
-    /* libfabric access key*/
-    uint64_t *keys;
+    uint64_t size;
     void *context;
-    uint64_t *base_addr_list;
+    char *name;
     int desc_update_status;
     mode_t perm;
     uint32_t uid;
     uint32_t gid;
-    char *name;
-    uint64_t interleaveSize;
-    uint64_t size;
-    uint64_t *memserver_ids;
-    uint64_t used_memsrv_cnt;
     Fam_Permission_Level permissionLevel;
+    // Storage of an item held by a single memory server
+    uint64_t singleId;
+    uint64_t singleKey;
+    uint64_t singleBase;
 };
 
 Fam_Descriptor::Fam_Descriptor(Fam_Global_Descriptor gDescriptor,
                                uint64_t itemSize) {
-    fdimpl_ = new FamDescriptorImpl_(gDescriptor, itemSize);
+    fdimpl_ = new (alloc_impl(sizeof(FamDescriptorImpl_)))
+        FamDescriptorImpl_(gDescriptor, itemSize);
 }
 
 Fam_Descriptor::Fam_Descriptor(Fam_Global_Descriptor gDescriptor) {
-    fdimpl_ = new FamDescriptorImpl_(gDescriptor);
+    fdimpl_ = new (alloc_impl(sizeof(FamDescriptorImpl_)))
+        FamDescriptorImpl_(gDescriptor);
 }
 
-Fam_Descriptor::Fam_Descriptor() { fdimpl_ = new FamDescriptorImpl_(); }
+Fam_Descriptor::Fam_Descriptor() {
+    fdimpl_ = new (alloc_impl(sizeof(FamDescriptorImpl_))) FamDescriptorImpl_();
+}
 
-Fam_Descriptor::~Fam_Descriptor() { delete fdimpl_; }
+Fam_Descriptor::~Fam_Descriptor() {
+    fdimpl_->~FamDescriptorImpl_();
+    free(fdimpl_);
+}
 
 Fam_Global_Descriptor Fam_Descriptor::get_global_descriptor() {
     return fdimpl_->get_global_descriptor();
@@ -324,6 +387,8 @@ Fam_Permission_Level Fam_Descriptor::get_permissionLevel() {
     return fdimpl_->get_permissionLevel();
 }
 
+const Fam_Layout *Fam_Descriptor::get_layout() { return fdimpl_->get_layout(); }
+
 /*
  * Internal implementation of Fam_Region_Descriptor
  */
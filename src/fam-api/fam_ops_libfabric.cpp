@@ -39,6 +39,7 @@
 #include <future>
 
 #include "common/fam_internal.h"
+#include "common/fam_layout.h"
 #include "common/fam_libfabric.h"
 #include "common/fam_memserver_profile.h"
 #include "common/fam_ops.h"
@@ -51,6 +52,14 @@ using namespace chrono;
 
 namespace openfam {
 
+/*
+ * pthread key destructor of the FAM_CONTEXT_THREAD contexts
+ */
+static void thread_context_exit(void *arg) {
+    Fam_Thread_Context *threadCtx = (Fam_Thread_Context *)arg;
+    threadCtx->famOps->release_thread_context(threadCtx);
+}
+
 Fam_Ops_Libfabric::~Fam_Ops_Libfabric() {
 
     delete contexts;
@@ -62,6 +71,21 @@ Fam_Ops_Libfabric::~Fam_Ops_Libfabric() {
     free(provider);
     free(serverAddrName);
     free(if_device);
+    free(railAddress);
+    if (combiners != NULL) {
+        for (auto combiner : *combiners)
+            delete combiner;
+        delete combiners;
+        (void)pthread_key_delete(combinerKey);
+        (void)pthread_mutex_destroy(&combinerLock);
+    }
+    if (writeCombiners != NULL) {
+        for (auto combiner : *writeCombiners)
+            delete combiner;
+        delete writeCombiners;
+        (void)pthread_key_delete(writeCombinerKey);
+        (void)pthread_mutex_destroy(&writeCombinerLock);
+    }
 }
 
 Fam_Ops_Libfabric::Fam_Ops_Libfabric(bool source, const char *libfabricProvider,
@@ -79,11 +103,12 @@ Fam_Ops_Libfabric::Fam_Ops_Libfabric(bool source, const char *libfabricProvider,
     famContextModel = famCM;
     famAllocator = famAlloc;
 
-    fiAddrs = new std::vector<fi_addr_t>();
+    fiAddrs = new Fam_Addr_Table();
     memServerAddrs = new std::map<uint64_t, std::pair<void *, size_t>>();
     fiMemsrvMap = new std::map<uint64_t, fi_addr_t>();
     contexts = new std::map<uint64_t, Fam_Context *>();
     defContexts = new std::map<uint64_t, Fam_Context *>();
+    defCtx = NULL;
 
     fi = NULL;
     fabric = NULL;
@@ -94,6 +119,51 @@ Fam_Ops_Libfabric::Fam_Ops_Libfabric(bool source, const char *libfabricProvider,
     serverAddrName = NULL;
     ctxId = FAM_DEFAULT_CTX_ID;
     nextCtxId = ctxId + 1;
+    ioPipelineDepth = FAM_DEFAULT_IO_PIPELINE_DEPTH;
+    ioStripeCount = FAM_DEFAULT_IO_STRIPE_COUNT;
+    ioStripeMinSize = FAM_DEFAULT_IO_STRIPE_MIN_SIZE;
+    stripeSet = NULL;
+    railAddress = NULL;
+    atomicCombining = false;
+    atomicCombineMaxEntries = FAM_DEFAULT_ATOMIC_COMBINE_MAX_ENTRIES;
+    atomicCombineFlushUsec = FAM_DEFAULT_ATOMIC_COMBINE_FLUSH_USEC;
+    combiners = NULL;
+    writeCombining = false;
+    writeCombineBufSize = FAM_DEFAULT_WRITE_COMBINE_BUFFER_SIZE;
+    writeCombineMaxPut = FAM_DEFAULT_WRITE_COMBINE_MAX_PUT;
+    writeCombineMaxBuffers = FAM_DEFAULT_WRITE_COMBINE_BUFFERS;
+    writeCombiners = NULL;
+    nativeInt128Atomics = true;
+    pollMode = FAM_POLL_BUSY;
+    pollSpinCount = FAM_DEFAULT_POLL_SPIN_COUNT;
+    pollMaxSleepUsec = FAM_DEFAULT_POLL_MAX_SLEEP_USEC;
+    sgOffload = false;
+    sgOffloadMinElements = FAM_DEFAULT_SG_OFFLOAD_MIN_ELEMENTS;
+    sgOffloadMaxElementSize = FAM_DEFAULT_SG_OFFLOAD_MAX_ELEMENT_SIZE;
+    mrCacheEnabled = false;
+    mrCacheMaxEntries = FAM_DEFAULT_MR_CACHE_MAX_ENTRIES;
+    mrCacheMaxBytes = FAM_DEFAULT_MR_CACHE_MAX_BYTES;
+    mrCacheMinSize = FAM_DEFAULT_MR_CACHE_MIN_SIZE;
+    mrCache = NULL;
+    bounceMaxSize = FAM_DEFAULT_BOUNCE_MAX_SIZE;
+    bounceCount = 0;
+    readCacheEnabled = false;
+    readCacheSize = FAM_DEFAULT_READ_CACHE_SIZE;
+    readCachePageSize = FAM_DEFAULT_READ_CACHE_PAGE_SIZE;
+    readCacheInvalidateOnFence = false;
+    readCache = NULL;
+    threadContexts = false;
+    threadCtxList = NULL;
+    freeThreadCtxList = NULL;
+    heapBase = NULL;
+    heapLen = 0;
+    ctxPoolSize = 0;
+    ctxPool = NULL;
+    nodeBootstrap = NULL;
+    sharedContexts = false;
+    stx = NULL;
+    srx = NULL;
+    ctxObj = NULL;
 
     numMemoryNodes = 0;
     if (!isSource && famAllocator == NULL) {
@@ -120,11 +190,12 @@ Fam_Ops_Libfabric::Fam_Ops_Libfabric(bool source, const char *libfabricProvider,
     famContextModel = famCM;
     famAllocator = famAlloc;
 
-    fiAddrs = new std::vector<fi_addr_t>();
+    fiAddrs = new Fam_Addr_Table();
     memServerAddrs = new std::map<uint64_t, std::pair<void *, size_t>>();
     fiMemsrvMap = new std::map<uint64_t, fi_addr_t>();
     contexts = new std::map<uint64_t, Fam_Context *>();
     defContexts = new std::map<uint64_t, Fam_Context *>();
+    defCtx = NULL;
 
     fi = NULL;
     fabric = NULL;
@@ -135,6 +206,51 @@ Fam_Ops_Libfabric::Fam_Ops_Libfabric(bool source, const char *libfabricProvider,
     serverAddrName = NULL;
     ctxId = FAM_DEFAULT_CTX_ID;
     nextCtxId = ctxId + 1;
+    ioPipelineDepth = FAM_DEFAULT_IO_PIPELINE_DEPTH;
+    ioStripeCount = FAM_DEFAULT_IO_STRIPE_COUNT;
+    ioStripeMinSize = FAM_DEFAULT_IO_STRIPE_MIN_SIZE;
+    stripeSet = NULL;
+    railAddress = NULL;
+    atomicCombining = false;
+    atomicCombineMaxEntries = FAM_DEFAULT_ATOMIC_COMBINE_MAX_ENTRIES;
+    atomicCombineFlushUsec = FAM_DEFAULT_ATOMIC_COMBINE_FLUSH_USEC;
+    combiners = NULL;
+    writeCombining = false;
+    writeCombineBufSize = FAM_DEFAULT_WRITE_COMBINE_BUFFER_SIZE;
+    writeCombineMaxPut = FAM_DEFAULT_WRITE_COMBINE_MAX_PUT;
+    writeCombineMaxBuffers = FAM_DEFAULT_WRITE_COMBINE_BUFFERS;
+    writeCombiners = NULL;
+    nativeInt128Atomics = true;
+    pollMode = FAM_POLL_BUSY;
+    pollSpinCount = FAM_DEFAULT_POLL_SPIN_COUNT;
+    pollMaxSleepUsec = FAM_DEFAULT_POLL_MAX_SLEEP_USEC;
+    sgOffload = false;
+    sgOffloadMinElements = FAM_DEFAULT_SG_OFFLOAD_MIN_ELEMENTS;
+    sgOffloadMaxElementSize = FAM_DEFAULT_SG_OFFLOAD_MAX_ELEMENT_SIZE;
+    mrCacheEnabled = false;
+    mrCacheMaxEntries = FAM_DEFAULT_MR_CACHE_MAX_ENTRIES;
+    mrCacheMaxBytes = FAM_DEFAULT_MR_CACHE_MAX_BYTES;
+    mrCacheMinSize = FAM_DEFAULT_MR_CACHE_MIN_SIZE;
+    mrCache = NULL;
+    bounceMaxSize = FAM_DEFAULT_BOUNCE_MAX_SIZE;
+    bounceCount = 0;
+    readCacheEnabled = false;
+    readCacheSize = FAM_DEFAULT_READ_CACHE_SIZE;
+    readCachePageSize = FAM_DEFAULT_READ_CACHE_PAGE_SIZE;
+    readCacheInvalidateOnFence = false;
+    readCache = NULL;
+    threadContexts = false;
+    threadCtxList = NULL;
+    freeThreadCtxList = NULL;
+    heapBase = NULL;
+    heapLen = 0;
+    ctxPoolSize = 0;
+    ctxPool = NULL;
+    nodeBootstrap = NULL;
+    sharedContexts = false;
+    stx = NULL;
+    srx = NULL;
+    ctxObj = NULL;
 
     numMemoryNodes = 0;
     if (!isSource && famAllocator == NULL) {
@@ -160,6 +276,7 @@ Fam_Ops_Libfabric::Fam_Ops_Libfabric(Fam_Ops_Libfabric *famOps) {
     fiMemsrvMap = famOps->fiMemsrvMap;
     contexts = famOps->contexts;
     defContexts = famOps->defContexts;
+    defCtx = famOps->defCtx;
     ctxLock = famOps->ctxLock;
 
     fi = famOps->fi;
@@ -175,12 +292,69 @@ Fam_Ops_Libfabric::Fam_Ops_Libfabric(Fam_Ops_Libfabric *famOps) {
     numMemoryNodes = famOps->numMemoryNodes;
     fabric_iov_limit = famOps->fabric_iov_limit;
     fabric_max_msg_size = famOps->fabric_max_msg_size;
+    ioPipelineDepth = famOps->ioPipelineDepth;
+    ioStripeCount = famOps->ioStripeCount;
+    ioStripeMinSize = famOps->ioStripeMinSize;
+    stripeSet = famOps->stripeSet;
+    railAddress = NULL;
+    nativeInt128Atomics = famOps->nativeInt128Atomics;
+    pollMode = famOps->pollMode;
+    pollSpinCount = famOps->pollSpinCount;
+    pollMaxSleepUsec = famOps->pollMaxSleepUsec;
+    sgOffload = famOps->sgOffload;
+    sgOffloadMinElements = famOps->sgOffloadMinElements;
+    sgOffloadMaxElementSize = famOps->sgOffloadMaxElementSize;
+    mrCacheEnabled = famOps->mrCacheEnabled;
+    mrCacheMaxEntries = famOps->mrCacheMaxEntries;
+    mrCacheMaxBytes = famOps->mrCacheMaxBytes;
+    mrCacheMinSize = famOps->mrCacheMinSize;
+    mrCache = famOps->mrCache;
+    bounceMaxSize = famOps->bounceMaxSize;
+    bounceCount = famOps->bounceCount;
+    readCacheEnabled = famOps->readCacheEnabled;
+    readCacheSize = famOps->readCacheSize;
+    readCachePageSize = famOps->readCachePageSize;
+    readCacheInvalidateOnFence = famOps->readCacheInvalidateOnFence;
+    readCache = famOps->readCache;
+    // A context opened with fam_context_open has a single Fam_Context, even
+    // in the FAM_CONTEXT_THREAD model
+    threadContexts = false;
+    threadCtxList = NULL;
+    freeThreadCtxList = NULL;
+    heapBase = NULL;
+    heapLen = 0;
+    ctxPoolSize = famOps->ctxPoolSize;
+    ctxPool = famOps->ctxPool;
+    nodeBootstrap = famOps->nodeBootstrap;
+    sharedContexts = famOps->sharedContexts;
+    stx = famOps->stx;
+    srx = famOps->srx;
+    ctxObj = NULL;
+    // Each context has its own combining tables
+    atomicCombining = false;
+    combiners = NULL;
+    if (famOps->atomicCombining)
+        enable_atomic_combining(famOps->atomicCombineMaxEntries,
+                                famOps->atomicCombineFlushUsec);
+    writeCombining = false;
+    writeCombiners = NULL;
+    if (famOps->writeCombining)
+        enable_write_combining(famOps->writeCombineBufSize,
+                               famOps->writeCombineMaxPut,
+                               famOps->writeCombineMaxBuffers);
 }
 
 int Fam_Ops_Libfabric::initialize() {
     std::ostringstream message;
     int ret = 0;
 
+    // Checked once here so that get_context(descriptor) does not have to
+    if (famContextModel != FAM_CONTEXT_DEFAULT &&
+        famContextModel != FAM_CONTEXT_THREAD) {
+        message << "Fam Invalid Option FAM_CONTEXT_MODEL: " << famContextModel;
+        THROW_ERR_MSG(Fam_InvalidOption_Exception, message.str().c_str());
+    }
+
     // Initialize the mutex lock
     (void)pthread_rwlock_init(&fiMrLock, NULL);
 
@@ -190,14 +364,29 @@ int Fam_Ops_Libfabric::initialize() {
     // Initialize the mutex lock
     (void)pthread_mutex_init(&ctxLock, NULL);
 
+    if (!isSource && famContextModel == FAM_CONTEXT_THREAD) {
+        ret = pthread_key_create(&threadCtxKey, thread_context_exit);
+        if (ret != 0) {
+            message << "Fam libfabric pthread_key_create failed: "
+                    << strerror(ret);
+            THROW_ERR_MSG(Fam_Datapath_Exception, message.str().c_str());
+        }
+        threadCtxList = new std::vector<Fam_Thread_Context *>();
+        freeThreadCtxList = new std::vector<Fam_Thread_Context *>();
+        threadContexts = true;
+    }
+
     if ((ret = fabric_initialize(memoryServerName, service, isSource, provider,
                                  if_device, &fi, &fabric, &eq, &domain,
-                                 famThreadModel)) < 0) {
+                                 famThreadModel, railAddress)) < 0) {
         message << "Fam libfabric fabric_initialize failed: "
                 << fabric_strerror(ret);
         THROW_ERR_MSG(Fam_Datapath_Exception, message.str().c_str());
     }
 
+    if (!isSource && sharedContexts)
+        open_shared_contexts();
+
     // Initialize address vector
     if (fi->ep_attr->type == FI_EP_RDM) {
         if ((ret = fabric_initialize_av(fi, domain, eq, &av)) < 0) {
@@ -238,6 +427,7 @@ int Fam_Ops_Libfabric::initialize() {
 
         // Save this context to defContexts on memoryserver
         defContexts->insert({FAM_DEFAULT_CTX_ID, tmpCtx});
+        defCtx = tmpCtx;
     }
     if (fi->ep_attr->max_msg_size > 0) {
         fabric_max_msg_size = fi->ep_attr->max_msg_size;
@@ -248,9 +438,144 @@ int Fam_Ops_Libfabric::initialize() {
 
     fabric_iov_limit = fi->tx_attr->rma_iov_limit;
 
+    // Fall back to the memory server CAS lock for 128-bit atomics if the
+    // provider can not execute them
+    if (!isSource && nativeInt128Atomics)
+        nativeInt128Atomics = (get_context() != NULL) &&
+                              fabric_int128_atomics_valid(get_context()->get_ep());
+
+    // The RDMA of an offloaded gather or scatter is issued by the memory
+    // server while this side only waits for the RPC, so it would never land
+    // with manual data progress
+    if (!isSource && sgOffload)
+        sgOffload = (fi->domain_attr->data_progress == FI_PROGRESS_AUTO);
+
+    if (!isSource && mrCacheEnabled) {
+        mrCache = new Fam_Mr_Cache(domain, fi->fabric_attr->prov_name,
+                                   fabric_iov_limit, mrCacheMaxEntries,
+                                   mrCacheMaxBytes, mrCacheMinSize);
+        if (!mrCache->is_caching()) {
+            delete mrCache;
+            mrCache = NULL;
+            message << "mr_cache needs libopenfam_mrhook linked into the "
+                       "application or preloaded";
+            THROW_ERR_MSG(Fam_InvalidOption_Exception, message.str().c_str());
+        }
+    }
+
+    if (!isSource && readCacheEnabled)
+        readCache = new Fam_Read_Cache(readCacheSize, readCachePageSize);
+
+    if (!isSource && (ioStripeCount > 1 || !railAddrs.empty()))
+        init_stripe_set();
+
+    if (!isSource && ctxPoolSize > 0) {
+        ctxPool = new std::vector<Fam_Context *>();
+        ctxPool->reserve(ctxPoolSize);
+        for (uint64_t i = 0; i < ctxPoolSize; i++)
+            ctxPool->push_back(create_context());
+    }
+
     return 0;
 }
 
+void Fam_Ops_Libfabric::init_stripe_set() {
+    stripeSet = new Fam_Stripe_Set();
+    (void)pthread_mutex_init(&stripeSet->lock, NULL);
+    // The caller issues the first stripe on its own context
+    for (uint64_t i = 1; i < ioStripeCount; i++)
+        add_stripe(NULL);
+    for (size_t i = 0; i < railAddrs.size(); i++) {
+        Fam_Rail *rail = open_rail(railAddrs[i].c_str(), i);
+        for (uint64_t j = 0; j < ioStripeCount; j++)
+            add_stripe(rail);
+    }
+}
+
+Fam_Rail *Fam_Ops_Libfabric::open_rail(const char *railAddr,
+                                       size_t railIndex) {
+    std::ostringstream message;
+    int ret = 0;
+    Fam_Rail *rail = new Fam_Rail();
+    // Saved first so that finalize() closes a partially opened rail
+    stripeSet->rails.push_back(rail);
+    // The endpoints of a rail are driven by several threads at a time
+    if ((ret = fabric_initialize(NULL, NULL, false, provider, if_device,
+                                 &rail->fi, &rail->fabric, &rail->eq,
+                                 &rail->domain, FAM_THREAD_MULTIPLE,
+                                 railAddr)) < 0) {
+        message << "Fam libfabric fabric_initialize failed for rail "
+                << railAddr << ": " << fabric_strerror(ret);
+        THROW_ERR_MSG(Fam_Datapath_Exception, message.str().c_str());
+    }
+    if ((ret = fabric_initialize_av(rail->fi, rail->domain, rail->eq,
+                                    &rail->av)) < 0) {
+        message << "Fam libfabric fabric_initialize_av failed: "
+                << fabric_strerror(ret);
+        THROW_ERR_MSG(Fam_Datapath_Exception, message.str().c_str());
+    }
+
+    // Reach each memory server on one of its own rails when it has some,
+    // spreading the client rails over them, or on its primary interface.
+    // Servers are inserted in the AV of the rail on first use.
+    rail->fiAddrs.set_av(rail->av);
+    for (auto memServer : *memServerAddrs) {
+        uint64_t nodeId = memServer.first;
+        const char *nodeAddr = (const char *)memServer.second.first;
+        std::vector<const char *> serverRails = fabric_unpack_rail_addrs(
+            memServer.second.first, memServer.second.second);
+        if (!serverRails.empty())
+            nodeAddr = serverRails[railIndex % serverRails.size()];
+        rail->fiAddrs.set_addr(nodeId, nodeAddr);
+    }
+
+    // Stripes register their part of the buffer whatever its size
+    rail->mrCache = new Fam_Mr_Cache(
+        rail->domain, rail->fi->fabric_attr->prov_name,
+        std::max(rail->fi->tx_attr->rma_iov_limit, (size_t)1),
+        mrCacheMaxEntries, mrCacheMaxBytes, 0);
+    return rail;
+}
+
+void Fam_Ops_Libfabric::close_rail(Fam_Rail *rail) {
+    delete rail->mrCache;
+    if (rail->av)
+        fi_close(&rail->av->fid);
+    if (rail->domain)
+        fi_close(&rail->domain->fid);
+    if (rail->eq)
+        fi_close(&rail->eq->fid);
+    if (rail->fabric)
+        fi_close(&rail->fabric->fid);
+    if (rail->fi)
+        fi_freeinfo(rail->fi);
+    delete rail;
+}
+
+void Fam_Ops_Libfabric::add_stripe(Fam_Rail *rail) {
+    std::ostringstream message;
+    struct fi_info *stripeFi = (rail != NULL) ? rail->fi : fi;
+    // The stripe set lock serializes the transfers using the context
+    Fam_Context *ctx =
+        new Fam_Context(stripeFi, (rail != NULL) ? rail->domain : domain,
+                        FAM_THREAD_SERIALIZE);
+    // Stripes are never small enough to use the bounce buffers, which are
+    // registered in the primary domain
+    if (rail != NULL)
+        ctx->set_poll_mode(pollMode, pollSpinCount, pollMaxSleepUsec);
+    else
+        configure_context(ctx);
+    stripeSet->stripes.push_back({ctx, rail, new Fam_Stripe_Worker()});
+    int ret = fabric_enable_bind_ep(stripeFi, (rail != NULL) ? rail->av : av,
+                                    (rail != NULL) ? rail->eq : eq,
+                                    ctx->get_ep());
+    if (ret < 0) {
+        message << "Fam libfabric fabric_enable_bind_ep failed: "
+                << fabric_strerror(ret);
+        THROW_ERR_MSG(Fam_Datapath_Exception, message.str().c_str());
+    }
+}
+
 void Fam_Ops_Libfabric::populate_address_vector(void *memServerInfoBuffer,
                                                 size_t memServerInfoSize,
                                                 uint64_t numMemNodes,
@@ -261,33 +586,23 @@ void Fam_Ops_Libfabric::populate_address_vector(void *memServerInfoBuffer,
     numMemoryNodes = numMemNodes;
     int ret = 0;
     if (!memServerInfoBuffer) {
-        numMemoryNodes = famAllocator->get_num_memory_servers();
-        if (numMemoryNodes == 0) {
-            message << "Libfabric initialize: memory server name not specified";
-            THROW_ERR_MSG(Fam_Datapath_Exception, message.str().c_str());
-        }
-        ret = famAllocator->get_memserverinfo_size(&memServerInfoSize);
-        if (ret < 0) {
-            message << "Fam allocator get_memserverinfo_size failed";
-            THROW_ERRNO_MSG(Fam_Allocator_Exception, FAM_ERR_ALLOCATOR,
-                            message.str().c_str());
-        }
-        if (memServerInfoSize) {
-            memServerInfoBuffer = calloc(1, memServerInfoSize);
-            ret = famAllocator->get_memserverinfo(memServerInfoBuffer);
-
-            if (ret < 0) {
-                message << "Fam Allocator get_memserverinfo failed";
-                THROW_ERRNO_MSG(Fam_Allocator_Exception, FAM_ERR_ALLOCATOR,
-                                message.str().c_str());
-            }
+        if (nodeBootstrap != NULL) {
+            nodeBootstrap->get_memserverinfo(
+                &numMemoryNodes, &memServerInfoBuffer, &memServerInfoSize,
+                [this](uint64_t *num, void **buf, size_t *size) {
+                    fetch_memserverinfo(num, buf, size);
+                });
+        } else {
+            fetch_memserverinfo(&numMemoryNodes, &memServerInfoBuffer,
+                                &memServerInfoSize);
         }
     }
     size_t bufPtr = 0;
     uint64_t nodeId;
     size_t addrSize;
     void *nodeAddr;
-    uint64_t fiAddrsSize = fiAddrs->size();
+    // Servers are inserted in the AV on the first access to them
+    fiAddrs->set_av(av);
 
     while (bufPtr < memServerInfoSize) {
         memcpy(&nodeId, ((char *)memServerInfoBuffer + bufPtr),
@@ -306,28 +621,15 @@ void Fam_Ops_Libfabric::populate_address_vector(void *memServerInfoBuffer,
         if (isSource && (myId == nodeId))
             continue;
         memServerAddrs->insert({nodeId, std::make_pair(nodeAddr, addrSize)});
-
-        std::vector<fi_addr_t> tmpAddrV;
-        ret = fabric_insert_av((char *)nodeAddr, av, &tmpAddrV);
-        if (ret < 0) {
-            message << "Fam libfabric fabric_insert_av failed: "
-                    << fabric_strerror(ret);
-            THROW_ERR_MSG(Fam_Datapath_Exception, message.str().c_str());
-        }
-
-        // Place the fi_addr_t at nodeId index of fiAddrs vector.
-        if (nodeId >= fiAddrsSize) {
-            // Increase the size of fiAddrs vector to accomodate
-            // nodeId larger than the current size.
-            fiAddrs->resize(nodeId + 512, FI_ADDR_UNSPEC);
-            fiAddrsSize = fiAddrs->size();
-        }
-        fiAddrs->at(nodeId) = tmpAddrV[0];
+        fiAddrs->set_addr(nodeId, (const char *)nodeAddr);
     }
     // Initialize defaultCtx
     if (famContextModel == FAM_CONTEXT_DEFAULT) {
-        Fam_Context *defaultCtx = new Fam_Context(fi, domain, famThreadModel);
+        Fam_Context *defaultCtx =
+            new Fam_Context(fi, domain, famThreadModel, stx, srx);
+        configure_context(defaultCtx);
         defContexts->insert({FAM_DEFAULT_CTX_ID, defaultCtx});
+        defCtx = defaultCtx;
         set_context(defaultCtx);
         ret = fabric_enable_bind_ep(fi, av, eq, defaultCtx->get_ep());
         if (ret < 0) {
@@ -338,20 +640,59 @@ void Fam_Ops_Libfabric::populate_address_vector(void *memServerInfoBuffer,
     }
 }
 
-Fam_Context *Fam_Ops_Libfabric::get_context(Fam_Descriptor *descriptor) {
+void Fam_Ops_Libfabric::fetch_memserverinfo(uint64_t *numMemNodes,
+                                            void **memServerInfoBuffer,
+                                            size_t *memServerInfoSize) {
     std::ostringstream message;
-    // Case - FAM_CONTEXT_DEFAULT
-    if (famContextModel == FAM_CONTEXT_DEFAULT) {
-        return get_context();
-    } else {
-        message << "Fam Invalid Option FAM_CONTEXT_MODEL: " << famContextModel;
-        THROW_ERR_MSG(Fam_InvalidOption_Exception, message.str().c_str());
+    int ret;
+    *numMemNodes = famAllocator->get_num_memory_servers();
+    if (*numMemNodes == 0) {
+        message << "Libfabric initialize: memory server name not specified";
+        THROW_ERR_MSG(Fam_Datapath_Exception, message.str().c_str());
+    }
+    ret = famAllocator->get_memserverinfo_size(memServerInfoSize);
+    if (ret < 0) {
+        message << "Fam allocator get_memserverinfo_size failed";
+        THROW_ERRNO_MSG(Fam_Allocator_Exception, FAM_ERR_ALLOCATOR,
+                        message.str().c_str());
+    }
+    if (*memServerInfoSize) {
+        *memServerInfoBuffer = calloc(1, *memServerInfoSize);
+        ret = famAllocator->get_memserverinfo(*memServerInfoBuffer);
+
+        if (ret < 0) {
+            message << "Fam Allocator get_memserverinfo failed";
+            THROW_ERRNO_MSG(Fam_Allocator_Exception, FAM_ERR_ALLOCATOR,
+                            message.str().c_str());
+        }
     }
 }
 
 void Fam_Ops_Libfabric::finalize() {
+    flush_combined_atomics(true);
+    flush_combined_puts(true);
+    // Prefetch reads poll their contexts, which are deleted below; a failed
+    // prefetch has no reader left to report to
+    if (readCache != NULL) {
+        try {
+            complete_prefetches(NULL);
+        } catch (Fam_Exception &e) {
+        }
+    }
     fabric_finalize();
 
+    if (threadContexts) {
+        // The Fam_Context objects are deleted with defContexts below
+        (void)pthread_key_delete(threadCtxKey);
+        for (auto threadCtx : *threadCtxList)
+            delete threadCtx;
+        delete threadCtxList;
+        delete freeThreadCtxList;
+        threadCtxList = NULL;
+        freeThreadCtxList = NULL;
+        threadContexts = false;
+    }
+
     if (contexts != NULL) {
         for (auto fam_ctx : *contexts) {
             delete fam_ctx.second;
@@ -364,6 +705,53 @@ void Fam_Ops_Libfabric::finalize() {
             delete fam_ctx.second;
         }
         defContexts->clear();
+        defCtx = NULL;
+    }
+
+    if (ctxPool != NULL) {
+        for (auto ctx : *ctxPool)
+            delete ctx;
+        delete ctxPool;
+        ctxPool = NULL;
+    }
+
+    // The first PE of the node removes the shared segment
+    if (nodeBootstrap != NULL) {
+        delete nodeBootstrap;
+        nodeBootstrap = NULL;
+    }
+
+    if (mrCache != NULL) {
+        delete mrCache;
+        mrCache = NULL;
+    }
+
+    if (readCache != NULL) {
+        delete readCache;
+        readCache = NULL;
+    }
+
+    if (stripeSet != NULL) {
+        for (auto stripe : stripeSet->stripes) {
+            delete stripe.worker;
+            delete stripe.ctx;
+        }
+        for (auto rail : stripeSet->rails)
+            close_rail(rail);
+        (void)pthread_mutex_destroy(&stripeSet->lock);
+        delete stripeSet;
+        stripeSet = NULL;
+    }
+
+    // Closed once no endpoint is bound to them
+    if (stx != NULL) {
+        fi_close(&stx->fid);
+        stx = NULL;
+    }
+
+    if (srx != NULL) {
+        fi_close(&srx->fid);
+        srx = NULL;
     }
 
     if (fi) {
@@ -394,19 +782,61 @@ void Fam_Ops_Libfabric::finalize() {
 
 int Fam_Ops_Libfabric::put_blocking(void *local, Fam_Descriptor *descriptor,
                                     uint64_t offset, uint64_t nbytes) {
-    uint64_t *memServerIds = descriptor->get_memserver_ids();
-    size_t interleaveSize = descriptor->get_interleave_size();
-    uint64_t *keys = descriptor->get_keys();
-    uint64_t *base_addr_list = descriptor->get_base_address_list();
-    uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
     Fam_Context *famCtx = get_context(descriptor);
-    int ret = 0;
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    // Small transfers from unregistered memory go through a bounce buffer
+    Fam_Bounce_Buffer *bounce = fabric_alloc_bounce_buffer(famCtx, local,
+                                                           nbytes);
+    if (bounce != NULL) {
+        memcpy(bounce->buf, local, nbytes);
+        try {
+            put_blocking(bounce->buf, descriptor, offset, nbytes);
+        } catch (...) {
+            fabric_free_bounce_buffer(famCtx, bounce);
+            throw;
+        }
+        fabric_free_bounce_buffer(famCtx, bounce);
+        return 0;
+    }
+    Fam_Read_Cache_Write_Scope cacheScope(readCache, descriptor, offset,
+                                          nbytes);
+    if (use_striping(nbytes) &&
+        stripe_blocking(local, descriptor, offset, nbytes, true))
+        return 0;
+    return write_range(famCtx, NULL, local, descriptor, offset, nbytes);
+}
+
+int Fam_Ops_Libfabric::write_range(Fam_Context *famCtx, Fam_Rail *rail,
+                                   void *local, Fam_Descriptor *descriptor,
+                                   uint64_t offset, uint64_t nbytes) {
+    const Fam_Layout *layout = descriptor->get_layout();
+    const uint64_t *memServerIds = layout->memServerIds;
+    const uint64_t *keys = layout->keys;
+    const uint64_t *base_addr_list = layout->baseAddrs;
+    uint64_t usedMemsrvCnt = layout->usedMemsrvCnt;
+    // Register the buffer through the MR cache unless it is in the heap
+    // registered with register_heap, or through the cache of the rail; all
+    // IOs complete before the pin ends
+    Fam_Mr_Cache *rangeMrCache =
+        (rail != NULL) ? rail->mrCache
+                       : (famCtx->get_mr_descs(local, nbytes) ? NULL : mrCache);
+    Fam_Mr_Cache_Pin mrPin(rangeMrCache, famCtx->get_ep(), local, nbytes);
+    Fam_Addr_Table *fiAddr = (rail != NULL) ? &rail->fiAddrs : get_fiAddrs();
+    // Vector to store fi_context pointer of each IO
+    std::vector<struct fi_context *> fiCtxVector;
+    // Number of IOs in fiCtxVector which are already completed
+    size_t nCompleted = 0;
     // Check if the dataitem is spread across more than one memory server,
     // if spread across multiple servers calculate the index of first server,
-    // first block and the displacement within the block, else issue a single IO
+    // first block and the displacement within the block, else issue IOs
     // to a memory server where that dataitem is located.
-    if (usedMemsrvCnt == 1) {
+    if (usedMemsrvCnt == 1 && nbytes <= fabric_max_msg_size) {
+        // Single IO, wait for it without tracking it in fiCtxVector
+        fi_context *ctx = fabric_write(
+            keys[0], local, nbytes, (uint64_t)(base_addr_list[0]) + offset,
+            (*fiAddr)[memServerIds[0]], famCtx, true);
+        wait_for_io(famCtx, ctx, true);
+        return 0;
+    } else if (usedMemsrvCnt == 1) {
         uint64_t currentLocal = (uint64_t)local;
         uint64_t currentOffset = offset;
         uint64_t currentNbytes = nbytes;
@@ -418,147 +848,160 @@ int Fam_Ops_Libfabric::put_blocking(void *local, Fam_Descriptor *descriptor,
             } else {
                 pending_nbytes = 0;
             }
+            // Keep at most ioPipelineDepth chunks in flight
+            if (ioPipelineDepth > 0)
+                wait_for_io_window(famCtx, fiCtxVector, &nCompleted,
+                                   ioPipelineDepth - 1, true);
             // Issue an IO
             fi_context *ctx =
                 fabric_write(keys[0], (void *)currentLocal, currentNbytes,
                              (uint64_t)(base_addr_list[0]) + currentOffset,
                              (*fiAddr)[memServerIds[0]], famCtx, true);
-            // wait for IO to complete
-            famCtx->acquire_RDLock();
-            try {
-                ret = fabric_completion_wait(famCtx, ctx, 0);
-                delete ctx;
-            } catch (...) {
-                famCtx->inc_num_tx_fail_cnt(1l);
-                // Release Fam_Context read lock
-                famCtx->release_lock();
-                throw;
-            }
-            famCtx->release_lock();
+            fiCtxVector.push_back(ctx);
             currentNbytes = pending_nbytes;
             if (currentNbytes > 0) {
                 currentOffset = currentOffset + fabric_max_msg_size;
                 currentLocal = currentLocal + fabric_max_msg_size;
             }
         }
-        return ret;
-    }
-
-    // Vector to store fi_context pointer of each IO
-    std::vector<struct fi_context *> fiCtxVector;
-
-    // Current memory server Id index
-    uint64_t currentServerIndex = ((offset / interleaveSize) % usedMemsrvCnt);
-    // Current remote location in FAM
-    uint64_t currentFamPtr =
-        (((offset / interleaveSize) - currentServerIndex) / usedMemsrvCnt) *
-        interleaveSize;
-    // Current Local pointer position
-    uint64_t currentLocalPtr = (uint64_t)local;
-    // Displacement from the starting position of the interleave block
-    uint64_t displacement = offset % interleaveSize;
-
-    uint64_t chunkSize;
-    uint64_t nBytesWritten = 0;
-    /*
-     * If the offset is displaced from a starting position of a block
-     * issue a seperate IO for that chunk of data
-     */
-    uint64_t firstBlockSize = interleaveSize - displacement;
-    if (firstBlockSize < interleaveSize) {
-        // Calculate the chunk of size for each IO
-        if (nbytes < firstBlockSize)
-            chunkSize = nbytes;
-        else
-            chunkSize = firstBlockSize;
-        // Issue an IO
-        fi_context *ctx = fabric_write(
-            keys[currentServerIndex], (void *)currentLocalPtr, chunkSize,
-            (uint64_t)(base_addr_list[currentServerIndex]) + currentFamPtr +
-                displacement,
-            (*fiAddr)[memServerIds[currentServerIndex]],
-            get_context(descriptor), true);
-        // store the fi_context pointer to ensure the completion latter.
-        fiCtxVector.push_back(ctx);
-        // go to next server for next block of data
-        currentServerIndex++;
-        // If last memory server is reached roll back to first server and
-        // incement the interleave block by one
-        if (currentServerIndex == usedMemsrvCnt) {
-            currentServerIndex = 0;
-            // Increment a block everytime cricles through used servers.
-            currentFamPtr += interleaveSize;
-        }
-        // Increment the number of bytes written
-        nBytesWritten += chunkSize;
-        // Increment the local buffer pointer by number of bytes written
-        currentLocalPtr += chunkSize;
-    }
-    // Loop until the requested number of bytes are issued through IO
-    while (nBytesWritten < nbytes) {
-        // Calculate the chunk of size for each IO
-        //(For last IO the chunk size may not be same as inetrleave size)
-        if ((nbytes - nBytesWritten) < interleaveSize)
-            chunkSize = nbytes - nBytesWritten;
-        else
-            chunkSize = interleaveSize;
-        // Issue an IO
+        // wait for all the IOs to complete
+        wait_for_io_window(famCtx, fiCtxVector, &nCompleted, 0, true);
+        return 0;
+    }
+
+    // Issue one IO per interleave block, keeping at most ioPipelineDepth of
+    // them in flight
+    layout->for_each_segment(offset, nbytes, [&](uint64_t serverIndex,
+                                                 uint64_t remoteOffset,
+                                                 uint64_t localOffset,
+                                                 uint64_t len) {
+        if (ioPipelineDepth > 0)
+            wait_for_io_window(famCtx, fiCtxVector, &nCompleted,
+                               ioPipelineDepth - 1, true);
         fi_context *ctx = fabric_write(
-            keys[currentServerIndex], (void *)currentLocalPtr, chunkSize,
-            (uint64_t)(base_addr_list[currentServerIndex]) + currentFamPtr,
-            (*fiAddr)[memServerIds[currentServerIndex]],
-            get_context(descriptor), true);
+            keys[serverIndex], (char *)local + localOffset, len,
+            base_addr_list[serverIndex] + remoteOffset,
+            (*fiAddr)[memServerIds[serverIndex]], famCtx, true);
         // store the fi_context pointer to ensure the completion latter.
         fiCtxVector.push_back(ctx);
-        // go to next server for next block of data
-        currentServerIndex++;
-        // If last memory server is reached roll back to first server and
-        // incement the interleave block by one
-        if (currentServerIndex == usedMemsrvCnt) {
-            currentServerIndex = 0;
-            currentFamPtr += interleaveSize;
+    });
+    // Ensure the completion of all the IOs which are still outstanding
+    wait_for_io_window(famCtx, fiCtxVector, &nCompleted, 0, true);
+    return 0;
+}
+
+int Fam_Ops_Libfabric::get_blocking(void *local, Fam_Descriptor *descriptor,
+                                    uint64_t offset, uint64_t nbytes) {
+    if (readCache != NULL && nbytes <= readCache->get_max_read())
+        return cached_get(local, descriptor, offset, nbytes);
+    return read_blocking(local, descriptor, offset, nbytes);
+}
+
+int Fam_Ops_Libfabric::cached_get(void *local, Fam_Descriptor *descriptor,
+                                  uint64_t offset, uint64_t nbytes) {
+    uint64_t itemSize = descriptor->get_size();
+    // Without the item size the length of its last page is unknown
+    if (itemSize == 0 || offset + nbytes > itemSize)
+        return read_blocking(local, descriptor, offset, nbytes);
+    Fam_Global_Descriptor gd = descriptor->get_global_descriptor();
+    uint64_t pageSize = readCache->get_page_size();
+    Fam_Context *famCtx = get_context(descriptor);
+    char *dest = (char *)local;
+    uint64_t end = offset + nbytes;
+    while (offset < end) {
+        uint64_t page = offset / pageSize;
+        uint64_t pageStart = page * pageSize;
+        uint64_t pageOffset = offset - pageStart;
+        uint64_t len = std::min(end, pageStart + pageSize) - offset;
+        Fam_Read_Cache_Key key = Fam_Read_Cache::make_key(gd, page);
+        Fam_Read_Cache_Prefetch prefetch;
+        bool hit = readCache->read(key, pageOffset, dest, len);
+        // A page being prefetched on this context is waited for instead of
+        // read again; one prefetched on another is a miss, as its context
+        // is polled only by its owner
+        if (!hit && readCache->take_prefetch(key, famCtx, &prefetch)) {
+            complete_prefetch(prefetch);
+            hit = readCache->read(key, pageOffset, dest, len);
         }
-        // Increment the number of bytes written
-        currentLocalPtr += chunkSize;
-        // Increment the local buffer pointer by number of bytes written
-        nBytesWritten += chunkSize;
-    }
-    /*
-     * Iterate over the vector of fi_context to ensure the completion of all IOs
-     */
-    if (!fiCtxVector.empty()) {
-        famCtx->acquire_RDLock();
-        for (auto ctx : fiCtxVector) {
-            try {
-                ret = fabric_completion_wait(famCtx, ctx, 0);
-                delete ctx;
-            } catch (...) {
-                famCtx->inc_num_tx_fail_cnt(1l);
-                // Release Fam_Context read lock
-                famCtx->release_lock();
-                throw;
+        if (!hit) {
+            uint64_t frameIdx, fillGen;
+            char *frame = readCache->reserve(&frameIdx, &fillGen);
+            if (frame == NULL) {
+                // Every frame is being filled, read around the cache
+                read_blocking(dest, descriptor, offset, len);
+            } else {
+                uint64_t fillLen = std::min(pageSize, itemSize - pageStart);
+                try {
+                    read_blocking(frame, descriptor, pageStart, fillLen);
+                } catch (...) {
+                    readCache->abandon(frameIdx);
+                    throw;
+                }
+                memcpy(dest, frame + pageOffset, len);
+                readCache->publish(key, frameIdx, fillGen, fillLen);
             }
         }
-        famCtx->release_lock();
+        dest += len;
+        offset += len;
     }
-    return ret;
+    return 0;
 }
 
-int Fam_Ops_Libfabric::get_blocking(void *local, Fam_Descriptor *descriptor,
-                                    uint64_t offset, uint64_t nbytes) {
-    uint64_t *memServerIds = descriptor->get_memserver_ids();
-    size_t interleaveSize = descriptor->get_interleave_size();
-    uint64_t *keys = descriptor->get_keys();
-    uint64_t *base_addr_list = descriptor->get_base_address_list();
-    uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
+int Fam_Ops_Libfabric::read_blocking(void *local, Fam_Descriptor *descriptor,
+                                     uint64_t offset, uint64_t nbytes) {
     Fam_Context *famCtx = get_context(descriptor);
-    int ret = 0;
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    // Small transfers to unregistered memory go through a bounce buffer
+    Fam_Bounce_Buffer *bounce = fabric_alloc_bounce_buffer(famCtx, local,
+                                                           nbytes);
+    if (bounce != NULL) {
+        try {
+            read_blocking(bounce->buf, descriptor, offset, nbytes);
+        } catch (...) {
+            fabric_free_bounce_buffer(famCtx, bounce);
+            throw;
+        }
+        memcpy(local, bounce->buf, nbytes);
+        fabric_free_bounce_buffer(famCtx, bounce);
+        return 0;
+    }
+    if (use_striping(nbytes) &&
+        stripe_blocking(local, descriptor, offset, nbytes, false))
+        return 0;
+    return read_range(famCtx, NULL, local, descriptor, offset, nbytes);
+}
+
+int Fam_Ops_Libfabric::read_range(Fam_Context *famCtx, Fam_Rail *rail,
+                                  void *local, Fam_Descriptor *descriptor,
+                                  uint64_t offset, uint64_t nbytes) {
+    const Fam_Layout *layout = descriptor->get_layout();
+    const uint64_t *memServerIds = layout->memServerIds;
+    const uint64_t *keys = layout->keys;
+    const uint64_t *base_addr_list = layout->baseAddrs;
+    uint64_t usedMemsrvCnt = layout->usedMemsrvCnt;
+    // Register the buffer through the MR cache unless it is in the heap
+    // registered with register_heap, or through the cache of the rail; all
+    // IOs complete before the pin ends
+    Fam_Mr_Cache *rangeMrCache =
+        (rail != NULL) ? rail->mrCache
+                       : (famCtx->get_mr_descs(local, nbytes) ? NULL : mrCache);
+    Fam_Mr_Cache_Pin mrPin(rangeMrCache, famCtx->get_ep(), local, nbytes);
+    Fam_Addr_Table *fiAddr = (rail != NULL) ? &rail->fiAddrs : get_fiAddrs();
+    // Vector to store fi_context pointer of each IO
+    std::vector<struct fi_context *> fiCtxVector;
+    // Number of IOs in fiCtxVector which are already completed
+    size_t nCompleted = 0;
     // Check if the dataitem is spread across more than one memory server,
     // if spread across multiple servers calculate the index of first server,
     // first block and the displacement within the block using the given offset,
-    // else issue a single IO to a memory server where that dataitem is located.
-    if (usedMemsrvCnt == 1) {
+    // else issue IOs to a memory server where that dataitem is located.
+    if (usedMemsrvCnt == 1 && nbytes <= fabric_max_msg_size) {
+        // Single IO, wait for it without tracking it in fiCtxVector
+        fi_context *ctx = fabric_read(
+            keys[0], local, nbytes, (uint64_t)(base_addr_list[0]) + offset,
+            (*fiAddr)[memServerIds[0]], famCtx, true);
+        wait_for_io(famCtx, ctx, false);
+        return 0;
+    } else if (usedMemsrvCnt == 1) {
         uint64_t currentLocal = (uint64_t)local;
         uint64_t currentOffset = offset;
         uint64_t currentNbytes = nbytes;
@@ -570,136 +1013,336 @@ int Fam_Ops_Libfabric::get_blocking(void *local, Fam_Descriptor *descriptor,
             } else {
                 pending_nbytes = 0;
             }
+            // Keep at most ioPipelineDepth chunks in flight
+            if (ioPipelineDepth > 0)
+                wait_for_io_window(famCtx, fiCtxVector, &nCompleted,
+                                   ioPipelineDepth - 1, false);
             // Issue an IO
             fi_context *ctx =
                 fabric_read(keys[0], (void *)currentLocal, currentNbytes,
                             (uint64_t)(base_addr_list[0]) + currentOffset,
                             (*fiAddr)[memServerIds[0]], famCtx, true);
-
-            // wait for IO to complete
-            famCtx->acquire_RDLock();
-            try {
-                ret = fabric_completion_wait(famCtx, ctx, 0);
-                delete ctx;
-            } catch (...) {
-                famCtx->inc_num_rx_fail_cnt(1l);
-                // Release Fam_Context read lock
-                famCtx->release_lock();
-                throw;
-            }
-            famCtx->release_lock();
+            fiCtxVector.push_back(ctx);
             currentNbytes = pending_nbytes;
             if (currentNbytes > 0) {
                 currentOffset = currentOffset + fabric_max_msg_size;
                 currentLocal = currentLocal + fabric_max_msg_size;
             }
         }
-        return ret;
+        // wait for all the IOs to complete
+        wait_for_io_window(famCtx, fiCtxVector, &nCompleted, 0, false);
+        return 0;
+    }
+
+    // Issue one IO per interleave block, keeping at most ioPipelineDepth of
+    // them in flight
+    layout->for_each_segment(offset, nbytes, [&](uint64_t serverIndex,
+                                                 uint64_t remoteOffset,
+                                                 uint64_t localOffset,
+                                                 uint64_t len) {
+        if (ioPipelineDepth > 0)
+            wait_for_io_window(famCtx, fiCtxVector, &nCompleted,
+                               ioPipelineDepth - 1, false);
+        fi_context *ctx = fabric_read(
+            keys[serverIndex], (char *)local + localOffset, len,
+            base_addr_list[serverIndex] + remoteOffset,
+            (*fiAddr)[memServerIds[serverIndex]], famCtx, true);
+        // store the fi_context pointer to ensure the completion latter.
+        fiCtxVector.push_back(ctx);
+    });
+    // Ensure the completion of all the IOs which are still outstanding
+    wait_for_io_window(famCtx, fiCtxVector, &nCompleted, 0, false);
+    return 0;
+}
+
+bool Fam_Ops_Libfabric::stripe_blocking(void *local, Fam_Descriptor *descriptor,
+                                        uint64_t offset, uint64_t nbytes,
+                                        bool isWrite) {
+    if (pthread_mutex_trylock(&stripeSet->lock) != 0)
+        return false;
+    Fam_Context *famCtx = get_context(descriptor);
+    uint64_t nStripes = stripeSet->stripes.size() + 1;
+    // Stripes end on interleave blocks, or on message boundaries for items
+    // held by a single memory server, so that no IO is split
+    const Fam_Layout *layout = descriptor->get_layout();
+    uint64_t unit = layout->is_interleaved()
+                        ? layout->interleaveSize
+                        : std::min(fabric_max_msg_size, (size_t)1 << 20);
+    std::vector<std::pair<uint64_t, uint64_t>> ranges;
+    uint64_t start = offset;
+    for (uint64_t i = 1; i <= nStripes && start < offset + nbytes; i++) {
+        uint64_t stop = offset + nbytes;
+        if (i < nStripes) {
+            stop = offset + nbytes / nStripes * i;
+            stop = std::min((stop + unit - 1) / unit * unit, offset + nbytes);
+        }
+        if (stop > start)
+            ranges.push_back(std::make_pair(start, stop - start));
+        start = stop;
     }
-    // Vector to store fi_context pointer of each IO
-    std::vector<struct fi_context *> fiCtxVector;
 
-    // Current memory server Id index
-    uint64_t currentServerIndex = ((offset / interleaveSize) % usedMemsrvCnt);
-    // Current remote location in FAM
-    uint64_t currentFamPtr =
-        (((offset / interleaveSize) - currentServerIndex) / usedMemsrvCnt) *
-        interleaveSize;
-    // Current Local pointer position
-    uint64_t currentLocalPtr = (uint64_t)local;
-    // Displacement from the starting position of the interleave block
-    uint64_t displacement = offset % interleaveSize;
-    uint64_t chunkSize;
-    uint64_t nBytesRead = 0;
-    /*
-     * If the offset is displaced from a starting position of a block
-     * issue a seperate IO for that chunk of data
-     */
-    uint64_t firstBlockSize = interleaveSize - displacement;
-    if (firstBlockSize < interleaveSize) {
-        // Calculate the chunk of size for each IO
-        if (nbytes < firstBlockSize)
-            chunkSize = nbytes;
+    // The first range is issued by the caller on its own context, the
+    // others by the helper threads of the stripe set, each on its own
+    // endpoint and waiting for the completions of that endpoint
+    size_t nStarted = 0;
+    std::exception_ptr error;
+    try {
+        for (size_t i = 1; i < ranges.size(); i++) {
+            Fam_Stripe stripe = stripeSet->stripes[i - 1];
+            char *stripeLocal = (char *)local + (ranges[i].first - offset);
+            uint64_t stripeOffset = ranges[i].first;
+            uint64_t stripeBytes = ranges[i].second;
+            stripe.worker->start([=]() {
+                if (isWrite)
+                    write_range(stripe.ctx, stripe.rail, stripeLocal,
+                                descriptor, stripeOffset, stripeBytes);
+                else
+                    read_range(stripe.ctx, stripe.rail, stripeLocal,
+                               descriptor, stripeOffset, stripeBytes);
+            });
+            nStarted++;
+        }
+        if (isWrite)
+            write_range(famCtx, NULL, local, descriptor, offset,
+                        ranges[0].second);
         else
-            chunkSize = firstBlockSize;
+            read_range(famCtx, NULL, local, descriptor, offset,
+                       ranges[0].second);
+    } catch (...) {
+        error = std::current_exception();
+    }
+    // Every stripe must be done with the buffer before returning
+    for (size_t i = 0; i < nStarted; i++) {
+        try {
+            stripeSet->stripes[i].worker->wait();
+        } catch (...) {
+            if (!error)
+                error = std::current_exception();
+        }
+    }
+    (void)pthread_mutex_unlock(&stripeSet->lock);
+    if (error)
+        std::rethrow_exception(error);
+    return true;
+}
 
-        // Issue an IO
-        fi_context *ctx = fabric_read(
-            keys[currentServerIndex], (void *)currentLocalPtr, chunkSize,
-            (uint64_t)(base_addr_list[currentServerIndex]) + currentFamPtr +
-                displacement,
-            (*fiAddr)[memServerIds[currentServerIndex]],
-            get_context(descriptor), true);
-        // store the fi_context pointer to ensure the completion latter.
-        fiCtxVector.push_back(ctx);
-        // go to next server for next block of data
-        currentServerIndex++;
-        // If last memory server is reached roll back to first server and
-        // incement the interleave block by one
-        if (currentServerIndex == usedMemsrvCnt) {
-            currentServerIndex = 0;
-            // Increment a block everytime cricles through used servers.
-            currentFamPtr += interleaveSize;
+int Fam_Ops_Libfabric::get_batch(Fam_Batch_Entry *entries, uint64_t nEntries) {
+    return batch_io(entries, nEntries, false);
+}
+
+int Fam_Ops_Libfabric::put_batch(Fam_Batch_Entry *entries, uint64_t nEntries) {
+    // As for put_blocking, invalidate before the IOs are issued and again
+    // once they have completed
+    for (uint64_t i = 0; i < nEntries && readCache != NULL; i++)
+        invalidate(entries[i].descriptor, entries[i].offset,
+                   entries[i].nbytes);
+    int ret = batch_io(entries, nEntries, true);
+    for (uint64_t i = 0; i < nEntries && readCache != NULL; i++)
+        invalidate(entries[i].descriptor, entries[i].offset,
+                   entries[i].nbytes);
+    return ret;
+}
+
+int Fam_Ops_Libfabric::batch_io(Fam_Batch_Entry *entries, uint64_t nEntries,
+                                bool isWrite) {
+    if (nEntries == 0)
+        return 0;
+    Fam_Context *famCtx = get_context(entries[0].descriptor);
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
+    // IOs of the batch grouped by memory server id
+    std::map<uint64_t, std::vector<std::pair<iovec, fi_rma_iov>>> ioMap;
+
+    for (uint64_t i = 0; i < nEntries; i++) {
+        Fam_Descriptor *descriptor = entries[i].descriptor;
+        uint64_t *memServerIds = descriptor->get_memserver_ids();
+        size_t interleaveSize = descriptor->get_interleave_size();
+        uint64_t *keys = descriptor->get_keys();
+        uint64_t *base_addr_list = descriptor->get_base_address_list();
+        uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
+        uint64_t currentOffset = entries[i].offset;
+        uint64_t currentLocalPtr = (uint64_t)entries[i].local;
+        uint64_t nbytes = entries[i].nbytes;
+        uint64_t nBytesIssued = 0;
+        // Split the entry at interleave block boundaries and at the fabric
+        // max message size
+        while (nBytesIssued < nbytes) {
+            uint64_t serverIndex = 0;
+            uint64_t currentFamPtr = currentOffset;
+            uint64_t chunkSize = nbytes - nBytesIssued;
+            if (usedMemsrvCnt > 1) {
+                uint64_t block = currentOffset / interleaveSize;
+                uint64_t displacement = currentOffset % interleaveSize;
+                serverIndex = block % usedMemsrvCnt;
+                currentFamPtr =
+                    (block / usedMemsrvCnt) * interleaveSize + displacement;
+                chunkSize = std::min<uint64_t>(chunkSize,
+                                               interleaveSize - displacement);
+            }
+            chunkSize = std::min<uint64_t>(chunkSize, fabric_max_msg_size);
+
+            struct iovec iov = {.iov_base = (void *)currentLocalPtr,
+                                .iov_len = chunkSize};
+            struct fi_rma_iov rma_iov = {
+                .addr = (uint64_t)(base_addr_list[serverIndex]) + currentFamPtr,
+                .len = chunkSize,
+                .key = keys[serverIndex]};
+            ioMap[memServerIds[serverIndex]].push_back(
+                std::make_pair(iov, rma_iov));
+
+            currentOffset += chunkSize;
+            currentLocalPtr += chunkSize;
+            nBytesIssued += chunkSize;
         }
-        // Increment the number of bytes read
-        nBytesRead += chunkSize;
-        // Increment the local buffer pointer by number of bytes read
-        currentLocalPtr += chunkSize;
-    }
-    // Loop until the requested number of bytes are issued through IO
-    while (nBytesRead < nbytes) {
-        // Calculate the chunk of size for each IO
-        //(For last IO the chunk size may not be same as inetrleave size)
-        if ((nbytes - nBytesRead) < interleaveSize)
-            chunkSize = nbytes - nBytesRead;
+    }
+
+    // A single fi_context tracks the completion of all the messages of the
+    // batch, so count them upfront.
+    uint64_t nMsgs = 0;
+    for (auto &io : ioMap)
+        nMsgs += (io.second.size() + fabric_iov_limit - 1) / fabric_iov_limit;
+    struct fi_context *ctx =
+        (struct fi_context *)famCtx->alloc_fi_context(nMsgs);
+
+    size_t pendingServers = ioMap.size();
+    for (auto &io : ioMap) {
+        pendingServers--;
+        fabric_read_write_batch(io.second, (*fiAddr)[io.first], famCtx,
+                                fabric_iov_limit, ctx, isWrite,
+                                (pendingServers > 0));
+    }
+
+    // wait for all the IOs of the batch to complete
+    wait_for_io(famCtx, ctx, isWrite);
+    return 0;
+}
+
+void Fam_Ops_Libfabric::wait_for_io(Fam_Context *famCtx,
+                                    struct fi_context *ctx, bool isWrite) {
+    famCtx->acquire_RDLock();
+    try {
+        fabric_completion_wait(famCtx, ctx, 0);
+    } catch (...) {
+        if (isWrite)
+            famCtx->inc_num_tx_fail_cnt(1l);
         else
-            chunkSize = interleaveSize;
-        // Issue an IO
-        fi_context *ctx = fabric_read(
-            keys[currentServerIndex], (void *)currentLocalPtr, chunkSize,
-            (uint64_t)(base_addr_list[currentServerIndex]) + currentFamPtr,
-            (*fiAddr)[memServerIds[currentServerIndex]],
-            get_context(descriptor), true);
-        // store the fi_context pointer to ensure the completion latter.
-        fiCtxVector.push_back(ctx);
-        // go to next server for next block of data
-        currentServerIndex++;
-        // If last memory server is reached roll back to first server and
-        // incement the interleave block by one
-        if (currentServerIndex == usedMemsrvCnt) {
-            currentServerIndex = 0;
-            currentFamPtr += interleaveSize;
+            famCtx->inc_num_rx_fail_cnt(1l);
+        // Release Fam_Context read lock
+        famCtx->release_lock();
+        throw;
+    }
+    famCtx->release_lock();
+    famCtx->free_fi_context(ctx);
+}
+
+void Fam_Ops_Libfabric::wait_for_io_window(
+    Fam_Context *famCtx, std::vector<struct fi_context *> &fiCtxVector,
+    size_t *completed, uint64_t maxOutstanding, bool isWrite) {
+    while (fiCtxVector.size() - *completed > maxOutstanding) {
+        wait_for_io(famCtx, fiCtxVector[*completed], isWrite);
+        (*completed)++;
+    }
+}
+
+bool Fam_Ops_Libfabric::test_request(Fam_Request *request) {
+    Fam_Context *famCtx = request->get_context();
+    std::vector<struct fi_context *> &fiCtxVector = request->get_ios();
+    size_t *completed = request->get_completed();
+
+    famCtx->acquire_RDLock();
+    try {
+        while (*completed < fiCtxVector.size()) {
+            if (!fabric_completion_test(famCtx, fiCtxVector[*completed], 0))
+                break;
+            famCtx->free_fi_context(fiCtxVector[*completed]);
+            (*completed)++;
         }
-        // Increment the number of bytes read
-        currentLocalPtr += chunkSize;
-        // Increment the local buffer pointer by number of bytes read
-        nBytesRead += chunkSize;
+    } catch (...) {
+        if (request->is_write())
+            famCtx->inc_num_tx_fail_cnt(1l);
+        else
+            famCtx->inc_num_rx_fail_cnt(1l);
+        // Release Fam_Context read lock
+        famCtx->release_lock();
+        throw;
     }
-    /*
-     * Iterate over the vector of fi_context to ensure the completion of all IOs
-     */
-    if (!fiCtxVector.empty()) {
-        famCtx->acquire_RDLock();
-        for (auto ctx : fiCtxVector) {
+    famCtx->release_lock();
+    if (!request->is_complete())
+        return false;
+    if (readCache != NULL && request->is_write())
+        readCache->apply_deferred();
+    return true;
+}
+
+void Fam_Ops_Libfabric::wait_request(Fam_Request *request) {
+    wait_for_io_window(request->get_context(), request->get_ios(),
+                       request->get_completed(), 0, request->is_write());
+    if (readCache != NULL && request->is_write())
+        readCache->apply_deferred();
+}
+
+uint64_t Fam_Ops_Libfabric::wait_any_request(Fam_Request **requests,
+                                             uint64_t count,
+                                             uint64_t *failed) {
+    struct fam_poll_state pollState = {};
+    for (;;) {
+        Fam_Context *famCtx = NULL;
+        for (uint64_t i = 0; i < count; i++) {
+            if (requests[i] == NULL)
+                continue;
+            bool done;
             try {
-                ret = fabric_completion_wait(famCtx, ctx, 0);
-                delete ctx;
+                done = test_request(requests[i]);
             } catch (...) {
-                famCtx->inc_num_rx_fail_cnt(1l);
-                // Release Fam_Context read lock
-                famCtx->release_lock();
+                *failed = i;
                 throw;
             }
+            if (done)
+                return i;
+            if (famCtx == NULL)
+                famCtx = requests[i]->get_context();
         }
-        famCtx->release_lock();
+        if (famCtx == NULL)
+            return count;
+        // Back off between passes as a single completion wait does, up to
+        // the same total timeout
+        fabric_completion_idle(famCtx, &pollState);
     }
-    return ret;
+}
+
+void Fam_Ops_Libfabric::drain_request(Fam_Request *request) {
+    if (request == NULL || request->get_context() == NULL)
+        return;
+    Fam_Context *famCtx = request->get_context();
+    std::vector<struct fi_context *> &fiCtxVector = request->get_ios();
+    size_t *completed = request->get_completed();
+
+    famCtx->acquire_RDLock();
+    for (; *completed < fiCtxVector.size(); (*completed)++) {
+        // A context the provider may still complete is leaked rather than
+        // handed out again
+        if (fabric_completion_drain(famCtx, fiCtxVector[*completed], 0))
+            famCtx->free_fi_context(fiCtxVector[*completed]);
+    }
+    famCtx->release_lock();
+    // Writes of the request may have reached FAM
+    if (readCache != NULL && request->is_write())
+        readCache->apply_deferred();
 }
 
 int Fam_Ops_Libfabric::scatter_blocking(void *local, Fam_Descriptor *descriptor,
                                         uint64_t nElements,
                                         uint64_t firstElement, uint64_t stride,
                                         uint64_t elementSize) {
+    Fam_Read_Cache_Write_Scope cacheScope(
+        readCache, descriptor, firstElement * elementSize,
+        nElements > 0 ? ((nElements - 1) * stride + 1) * elementSize : 0);
+    // Contiguous elements already coalesce into few IOs
+    if (stride > 1 &&
+        use_sg_offload(descriptor, nElements, elementSize, false)) {
+        sg_offload(local, descriptor, nElements, firstElement, stride, NULL,
+                   elementSize, true);
+        return 0;
+    }
     uint64_t *memServerIds = descriptor->get_memserver_ids();
     size_t interleaveSize = descriptor->get_interleave_size();
     uint64_t *keys = descriptor->get_keys();
@@ -707,7 +1350,7 @@ int Fam_Ops_Libfabric::scatter_blocking(void *local, Fam_Descriptor *descriptor,
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
     Fam_Context *famCtx = get_context(descriptor);
     int ret = 0;
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     // Check if the dataitem is spread across more than one memory server,
     // if spread across multiple servers calculate the index of first server,
     // first block and the displacement within the block, else issue a single IO
@@ -729,7 +1372,7 @@ int Fam_Ops_Libfabric::scatter_blocking(void *local, Fam_Descriptor *descriptor,
         famCtx->acquire_RDLock();
         try {
             ret = fabric_completion_wait(famCtx, ctx, 0);
-            delete ctx;
+            famCtx->free_fi_context(ctx);
         } catch (...) {
             famCtx->inc_num_tx_fail_cnt(1l);
             // Release Fam_Context read lock
@@ -831,7 +1474,7 @@ int Fam_Ops_Libfabric::scatter_blocking(void *local, Fam_Descriptor *descriptor,
         for (auto ctx : fiCtxVector) {
             try {
                 ret = fabric_completion_wait(famCtx, ctx, 0);
-                delete ctx;
+                famCtx->free_fi_context(ctx);
             } catch (...) {
                 famCtx->inc_num_tx_fail_cnt(1l);
                 // Release Fam_Context read lock
@@ -848,6 +1491,13 @@ int Fam_Ops_Libfabric::gather_blocking(void *local, Fam_Descriptor *descriptor,
                                        uint64_t nElements,
                                        uint64_t firstElement, uint64_t stride,
                                        uint64_t elementSize) {
+    // Contiguous elements already coalesce into few IOs
+    if (stride > 1 &&
+        use_sg_offload(descriptor, nElements, elementSize, false)) {
+        sg_offload(local, descriptor, nElements, firstElement, stride, NULL,
+                   elementSize, false);
+        return 0;
+    }
     uint64_t *memServerIds = descriptor->get_memserver_ids();
     size_t interleaveSize = descriptor->get_interleave_size();
     uint64_t *keys = descriptor->get_keys();
@@ -855,7 +1505,7 @@ int Fam_Ops_Libfabric::gather_blocking(void *local, Fam_Descriptor *descriptor,
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
     Fam_Context *famCtx = get_context(descriptor);
     int ret = 0;
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     // Check if the dataitem is spread across more than one memory server,
     // if spread across multiple servers calculate the index of first server,
     // first block and the displacement within the block, else issue a single IO
@@ -877,7 +1527,7 @@ int Fam_Ops_Libfabric::gather_blocking(void *local, Fam_Descriptor *descriptor,
         famCtx->acquire_RDLock();
         try {
             ret = fabric_completion_wait(famCtx, ctx, 0);
-            delete ctx;
+            famCtx->free_fi_context(ctx);
         } catch (...) {
             famCtx->inc_num_rx_fail_cnt(1l);
             // Release Fam_Context read lock
@@ -979,7 +1629,7 @@ int Fam_Ops_Libfabric::gather_blocking(void *local, Fam_Descriptor *descriptor,
         for (auto ctx : fiCtxVector) {
             try {
                 ret = fabric_completion_wait(famCtx, ctx, 0);
-                delete ctx;
+                famCtx->free_fi_context(ctx);
             } catch (...) {
                 famCtx->inc_num_rx_fail_cnt(1l);
                 // Release Fam_Context read lock
@@ -996,6 +1646,14 @@ int Fam_Ops_Libfabric::scatter_blocking(void *local, Fam_Descriptor *descriptor,
                                         uint64_t nElements,
                                         uint64_t *elementIndex,
                                         uint64_t elementSize) {
+    // Elements may be anywhere in the data item
+    Fam_Read_Cache_Write_Scope cacheScope(readCache, descriptor, 0,
+                                          UINT64_MAX);
+    if (use_sg_offload(descriptor, nElements, elementSize, true)) {
+        sg_offload(local, descriptor, nElements, 0, 0, elementIndex,
+                   elementSize, true);
+        return 0;
+    }
     uint64_t *memServerIds = descriptor->get_memserver_ids();
     size_t interleaveSize = descriptor->get_interleave_size();
     uint64_t *keys = descriptor->get_keys();
@@ -1003,7 +1661,7 @@ int Fam_Ops_Libfabric::scatter_blocking(void *local, Fam_Descriptor *descriptor,
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
     Fam_Context *famCtx = get_context(descriptor);
     int ret = 0;
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     // Check if the dataitem is spread across more than one memory server,
     // if spread across multiple servers calculate the index of first server,
     // first block and the displacement within the block, else issue a single IO
@@ -1025,7 +1683,7 @@ int Fam_Ops_Libfabric::scatter_blocking(void *local, Fam_Descriptor *descriptor,
         famCtx->acquire_RDLock();
         try {
             ret = fabric_completion_wait(famCtx, ctx, 0);
-            delete ctx;
+            famCtx->free_fi_context(ctx);
         } catch (...) {
             famCtx->inc_num_tx_fail_cnt(1l);
             // Release Fam_Context read lock
@@ -1127,7 +1785,7 @@ int Fam_Ops_Libfabric::scatter_blocking(void *local, Fam_Descriptor *descriptor,
         for (auto ctx : fiCtxVector) {
             try {
                 ret = fabric_completion_wait(famCtx, ctx, 0);
-                delete ctx;
+                famCtx->free_fi_context(ctx);
             } catch (...) {
                 famCtx->inc_num_tx_fail_cnt(1l);
                 // Release Fam_Context read lock
@@ -1144,6 +1802,11 @@ int Fam_Ops_Libfabric::gather_blocking(void *local, Fam_Descriptor *descriptor,
                                        uint64_t nElements,
                                        uint64_t *elementIndex,
                                        uint64_t elementSize) {
+    if (use_sg_offload(descriptor, nElements, elementSize, true)) {
+        sg_offload(local, descriptor, nElements, 0, 0, elementIndex,
+                   elementSize, false);
+        return 0;
+    }
     uint64_t *memServerIds = descriptor->get_memserver_ids();
     size_t interleaveSize = descriptor->get_interleave_size();
     uint64_t *keys = descriptor->get_keys();
@@ -1151,7 +1814,7 @@ int Fam_Ops_Libfabric::gather_blocking(void *local, Fam_Descriptor *descriptor,
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
     Fam_Context *famCtx = get_context(descriptor);
     int ret = 0;
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     // Check if the dataitem is spread across more than one memory server,
     // if spread across multiple servers calculate the index of first server,
     // first block and the displacement within the block, else issue a single IO
@@ -1173,7 +1836,7 @@ int Fam_Ops_Libfabric::gather_blocking(void *local, Fam_Descriptor *descriptor,
         famCtx->acquire_RDLock();
         try {
             ret = fabric_completion_wait(famCtx, ctx, 0);
-            delete ctx;
+            famCtx->free_fi_context(ctx);
         } catch (...) {
             famCtx->inc_num_rx_fail_cnt(1l);
             // Release Fam_Context read lock
@@ -1275,7 +1938,7 @@ int Fam_Ops_Libfabric::gather_blocking(void *local, Fam_Descriptor *descriptor,
         for (auto ctx : fiCtxVector) {
             try {
                 ret = fabric_completion_wait(famCtx, ctx, 0);
-                delete ctx;
+                famCtx->free_fi_context(ctx);
             } catch (...) {
                 famCtx->inc_num_rx_fail_cnt(1l);
                 // Release Fam_Context read lock
@@ -1289,14 +1952,33 @@ int Fam_Ops_Libfabric::gather_blocking(void *local, Fam_Descriptor *descriptor,
 }
 
 void Fam_Ops_Libfabric::put_nonblocking(void *local, Fam_Descriptor *descriptor,
-                                        uint64_t offset, uint64_t nbytes) {
-    uint64_t *memServerIds = descriptor->get_memserver_ids();
-    size_t interleaveSize = descriptor->get_interleave_size();
-    uint64_t *keys = descriptor->get_keys();
-    uint64_t *base_addr_list = descriptor->get_base_address_list();
-    uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
+                                        uint64_t offset, uint64_t nbytes,
+                                        Fam_Request *request) {
+    // Puts with a request are tracked individually and never combined
+    if (writeCombining && request == NULL &&
+        combine_put(local, descriptor, offset, nbytes))
+        return;
+    write_nonblocking(local, descriptor, offset, nbytes, request);
+}
+
+void Fam_Ops_Libfabric::write_nonblocking(void *local,
+                                          Fam_Descriptor *descriptor,
+                                          uint64_t offset, uint64_t nbytes,
+                                          Fam_Request *request) {
+    defer_invalidate(descriptor, offset, nbytes);
+    const Fam_Layout *layout = descriptor->get_layout();
+    const uint64_t *memServerIds = layout->memServerIds;
+    const uint64_t *keys = layout->keys;
+    const uint64_t *base_addr_list = layout->baseAddrs;
+    uint64_t usedMemsrvCnt = layout->usedMemsrvCnt;
     Fam_Context *famCtx = get_context(descriptor);
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    // IOs of a request are posted with a completion so that they can be
+    // tracked individually; plain nonblocking IOs only update the counters
+    bool block = (request != NULL);
+    struct fi_context *ctx = NULL;
+    if (request != NULL)
+        request->set_context(famCtx);
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     // Check if the dataitem is spread across more than one memory server,
     // if spread across multiple servers calculate the index of first server,
     // first block and the displacement within the block, else issue a single IO
@@ -1314,9 +1996,11 @@ void Fam_Ops_Libfabric::put_nonblocking(void *local, Fam_Descriptor *descriptor,
                 pending_nbytes = 0;
             }
             // Issue an IO
-            fabric_write(keys[0], (void *)currentLocal, currentNbytes,
-                         (uint64_t)(base_addr_list[0]) + currentOffset,
-                         (*fiAddr)[memServerIds[0]], famCtx, false);
+            ctx = fabric_write(keys[0], (void *)currentLocal, currentNbytes,
+                               (uint64_t)(base_addr_list[0]) + currentOffset,
+                               (*fiAddr)[memServerIds[0]], famCtx, block);
+            if (request != NULL)
+                request->add_io(ctx);
             currentNbytes = pending_nbytes;
             if (currentNbytes > 0) {
                 currentOffset = currentOffset + fabric_max_msg_size;
@@ -1327,90 +2011,35 @@ void Fam_Ops_Libfabric::put_nonblocking(void *local, Fam_Descriptor *descriptor,
         return;
     }
 
-    // Current memory server Id index
-    uint64_t currentServerIndex = ((offset / interleaveSize) % usedMemsrvCnt);
-    // Current remote location in FAM
-    uint64_t currentFamPtr =
-        (((offset / interleaveSize) - currentServerIndex) / usedMemsrvCnt) *
-        interleaveSize;
-    // Current Local pointer position
-    uint64_t currentLocalPtr = (uint64_t)local;
-    // Displacement from the starting position of the interleave block
-    uint64_t displacement = offset % interleaveSize;
-
-    uint64_t chunkSize;
-    uint64_t nBytesWritten = 0;
-    /*
-     * If the offset is displaced from a starting position of a block
-     * issue a seperate IO for that chunk of data
-     */
-    uint64_t firstBlockSize = interleaveSize - displacement;
-    if (firstBlockSize < interleaveSize) {
-        // Calculate the chunk of size for each IO
-        if (nbytes < firstBlockSize)
-            chunkSize = nbytes;
-        else
-            chunkSize = firstBlockSize;
-        // Issue an IO
-        fabric_write(keys[currentServerIndex], (void *)currentLocalPtr,
-                     chunkSize,
-                     (uint64_t)(base_addr_list[currentServerIndex]) +
-                         currentFamPtr + displacement,
-                     (*fiAddr)[memServerIds[currentServerIndex]],
-                     get_context(descriptor), false);
-        // go to next server for next block of data
-        currentServerIndex++;
-        // If last memory server is reached roll back to first server and
-        // incement the interleave block by one
-        if (currentServerIndex == usedMemsrvCnt) {
-            currentServerIndex = 0;
-            // Increment a block everytime cricles through used servers.
-            currentFamPtr += interleaveSize;
-        }
-        // Increment the number of bytes written
-        nBytesWritten += chunkSize;
-        // Increment the local buffer pointer by number of bytes written
-        currentLocalPtr += chunkSize;
-    }
-    // Loop until the requested number of bytes are issued through IO
-    while (nBytesWritten < nbytes) {
-        // Calculate the chunk of size for each IO
-        //(For last IO the chunk size may not be same as inetrleave size)
-        if ((nbytes - nBytesWritten) < interleaveSize)
-            chunkSize = nbytes - nBytesWritten;
-        else
-            chunkSize = interleaveSize;
-        // Issue an IO
-        fabric_write(
-            keys[currentServerIndex], (void *)currentLocalPtr, chunkSize,
-            (uint64_t)(base_addr_list[currentServerIndex]) + currentFamPtr,
-            (*fiAddr)[memServerIds[currentServerIndex]],
-            get_context(descriptor), false);
-        // go to next server for next block of data
-        currentServerIndex++;
-        // If last memory server is reached roll back to first server and
-        // incement the interleave block by one
-        if (currentServerIndex == usedMemsrvCnt) {
-            currentServerIndex = 0;
-            currentFamPtr += interleaveSize;
-        }
-        // Increment the number of bytes written
-        currentLocalPtr += chunkSize;
-        // Increment the local buffer pointer by number of bytes written
-        nBytesWritten += chunkSize;
-    }
-    return;
+    // Issue one IO per interleave block
+    layout->for_each_segment(offset, nbytes, [&](uint64_t serverIndex,
+                                                 uint64_t remoteOffset,
+                                                 uint64_t localOffset,
+                                                 uint64_t len) {
+        ctx = fabric_write(keys[serverIndex], (char *)local + localOffset, len,
+                 base_addr_list[serverIndex] + remoteOffset,
+                 (*fiAddr)[memServerIds[serverIndex]], famCtx, block);
+        if (request != NULL)
+            request->add_io(ctx);
+    });
 }
 
 void Fam_Ops_Libfabric::get_nonblocking(void *local, Fam_Descriptor *descriptor,
-                                        uint64_t offset, uint64_t nbytes) {
-    uint64_t *memServerIds = descriptor->get_memserver_ids();
-    size_t interleaveSize = descriptor->get_interleave_size();
-    uint64_t *keys = descriptor->get_keys();
-    uint64_t *base_addr_list = descriptor->get_base_address_list();
-    uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
+                                        uint64_t offset, uint64_t nbytes,
+                                        Fam_Request *request) {
+    const Fam_Layout *layout = descriptor->get_layout();
+    const uint64_t *memServerIds = layout->memServerIds;
+    const uint64_t *keys = layout->keys;
+    const uint64_t *base_addr_list = layout->baseAddrs;
+    uint64_t usedMemsrvCnt = layout->usedMemsrvCnt;
     Fam_Context *famCtx = get_context(descriptor);
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    // IOs of a request are posted with a completion so that they can be
+    // tracked individually; plain nonblocking IOs only update the counters
+    bool block = (request != NULL);
+    struct fi_context *ctx = NULL;
+    if (request != NULL)
+        request->set_context(famCtx);
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     // Check if the dataitem is spread across more than one memory server,
     // if spread across multiple servers calculate the index of first server,
     // first block and the displacement within the block using the given offset,
@@ -1429,9 +2058,11 @@ void Fam_Ops_Libfabric::get_nonblocking(void *local, Fam_Descriptor *descriptor,
             }
 
             // Issue an IO
-            fabric_read(keys[0], (void *)currentLocal, currentNbytes,
-                        (uint64_t)(base_addr_list[0]) + currentOffset,
-                        (*fiAddr)[memServerIds[0]], famCtx, false);
+            ctx = fabric_read(keys[0], (void *)currentLocal, currentNbytes,
+                              (uint64_t)(base_addr_list[0]) + currentOffset,
+                              (*fiAddr)[memServerIds[0]], famCtx, block);
+            if (request != NULL)
+                request->add_io(ctx);
             currentNbytes = pending_nbytes;
             if (currentNbytes > 0) {
                 currentOffset = currentOffset + fabric_max_msg_size;
@@ -1442,91 +2073,40 @@ void Fam_Ops_Libfabric::get_nonblocking(void *local, Fam_Descriptor *descriptor,
         return;
     }
 
-    // Current memory server Id index
-    uint64_t currentServerIndex = ((offset / interleaveSize) % usedMemsrvCnt);
-    // Current remote location in FAM
-    uint64_t currentFamPtr =
-        (((offset / interleaveSize) - currentServerIndex) / usedMemsrvCnt) *
-        interleaveSize;
-    // Current Local pointer position
-    uint64_t currentLocalPtr = (uint64_t)local;
-    // Displacement from the starting position of the interleave block
-    uint64_t displacement = offset % interleaveSize;
-    uint64_t chunkSize;
-    uint64_t nBytesRead = 0;
-    /*
-     * If the offset is displaced from a starting position of a block
-     * issue a seperate IO for that chunk of data
-     */
-    uint64_t firstBlockSize = interleaveSize - displacement;
-    if (firstBlockSize < interleaveSize) {
-        // Calculate the chunk of size for each IO
-        if (nbytes < firstBlockSize)
-            chunkSize = nbytes;
-        else
-            chunkSize = firstBlockSize;
-
-        // Issue an IO
-        fabric_read(keys[currentServerIndex], (void *)currentLocalPtr,
-                    chunkSize,
-                    (uint64_t)(base_addr_list[currentServerIndex]) +
-                        currentFamPtr + displacement,
-                    (*fiAddr)[memServerIds[currentServerIndex]],
-                    get_context(descriptor), false);
-        // go to next server for next block of data
-        currentServerIndex++;
-        // If last memory server is reached roll back to first server and
-        // incement the interleave block by one
-        if (currentServerIndex == usedMemsrvCnt) {
-            currentServerIndex = 0;
-            // Increment a block everytime cricles through used servers.
-            currentFamPtr += interleaveSize;
-        }
-        // Increment the number of bytes read
-        nBytesRead += chunkSize;
-        // Increment the local buffer pointer by number of bytes read
-        currentLocalPtr += chunkSize;
-    }
-    // Loop until the requested number of bytes are issued through IO
-    while (nBytesRead < nbytes) {
-        // Calculate the chunk of size for each IO
-        //(For last IO the chunk size may not be same as inetrleave size)
-        if ((nbytes - nBytesRead) < interleaveSize)
-            chunkSize = nbytes - nBytesRead;
-        else
-            chunkSize = interleaveSize;
-        // Issue an IO
-        fabric_read(
-            keys[currentServerIndex], (void *)currentLocalPtr, chunkSize,
-            (uint64_t)(base_addr_list[currentServerIndex]) + currentFamPtr,
-            (*fiAddr)[memServerIds[currentServerIndex]],
-            get_context(descriptor), false);
-        // go to next server for next block of data
-        currentServerIndex++;
-        // If last memory server is reached roll back to first server and
-        // incement the interleave block by one
-        if (currentServerIndex == usedMemsrvCnt) {
-            currentServerIndex = 0;
-            currentFamPtr += interleaveSize;
-        }
-        // Increment the number of bytes read
-        currentLocalPtr += chunkSize;
-        // Increment the local buffer pointer by number of bytes read
-        nBytesRead += chunkSize;
-    }
-    return;
+    // Issue one IO per interleave block
+    layout->for_each_segment(offset, nbytes, [&](uint64_t serverIndex,
+                                                 uint64_t remoteOffset,
+                                                 uint64_t localOffset,
+                                                 uint64_t len) {
+        ctx = fabric_read(keys[serverIndex], (char *)local + localOffset, len,
+                 base_addr_list[serverIndex] + remoteOffset,
+                 (*fiAddr)[memServerIds[serverIndex]], famCtx, block);
+        if (request != NULL)
+            request->add_io(ctx);
+    });
 }
 
 void Fam_Ops_Libfabric::scatter_nonblocking(
     void *local, Fam_Descriptor *descriptor, uint64_t nElements,
-    uint64_t firstElement, uint64_t stride, uint64_t elementSize) {
+    uint64_t firstElement, uint64_t stride, uint64_t elementSize,
+    Fam_Request *request) {
+    defer_invalidate(descriptor, firstElement * elementSize,
+                     nElements > 0 ? ((nElements - 1) * stride + 1) *
+                                         elementSize
+                                   : 0);
     uint64_t *memServerIds = descriptor->get_memserver_ids();
     size_t interleaveSize = descriptor->get_interleave_size();
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
     Fam_Context *famCtx = get_context(descriptor);
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    // IOs of a request are posted with a completion so that they can be
+    // tracked individually; plain nonblocking IOs only update the counters
+    bool block = (request != NULL);
+    struct fi_context *ctx = NULL;
+    if (request != NULL)
+        request->set_context(famCtx);
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     // Check if the dataitem is spread across more than one memory server,
     // if spread across multiple servers calculate the index of first server,
     // first block and the displacement within the block, else issue a single IO
@@ -1540,10 +2120,12 @@ void Fam_Ops_Libfabric::scatter_nonblocking(
                             message.str().c_str());
         }
         // Issue an IO
-        fabric_scatter_stride(keys[0], (void *)local, elementSize, firstElement,
-                              nElements, stride, (*fiAddr)[memServerIds[0]],
-                              famCtx, fabric_iov_limit,
-                              (uint64_t)(base_addr_list[0]), false);
+        ctx = fabric_scatter_stride(
+            keys[0], (void *)local, elementSize, firstElement, nElements,
+            stride, (*fiAddr)[memServerIds[0]], famCtx, fabric_iov_limit,
+            (uint64_t)(base_addr_list[0]), block);
+        if (request != NULL)
+            request->add_io(ctx);
         return;
     }
 
@@ -1574,12 +2156,14 @@ void Fam_Ops_Libfabric::scatter_nonblocking(
             else
                 chunkSize = firstBlockSize;
             // Issue an IO
-            fabric_write(keys[currentServerIndex], (void *)currentLocalPtr,
-                         chunkSize,
-                         (uint64_t)(base_addr_list[currentServerIndex]) +
-                             currentFamPtr + displacement,
-                         (*fiAddr)[memServerIds[currentServerIndex]],
-                         get_context(descriptor), false);
+            ctx = fabric_write(
+                keys[currentServerIndex], (void *)currentLocalPtr, chunkSize,
+                (uint64_t)(base_addr_list[currentServerIndex]) + currentFamPtr +
+                    displacement,
+                (*fiAddr)[memServerIds[currentServerIndex]],
+                get_context(descriptor), block);
+            if (request != NULL)
+                request->add_io(ctx);
             // go to next server for next block of data
             currentServerIndex++;
             // If last memory server is reached roll back to first server and
@@ -1603,11 +2187,13 @@ void Fam_Ops_Libfabric::scatter_nonblocking(
             else
                 chunkSize = interleaveSize;
             // Issue an IO
-            fabric_write(
+            ctx = fabric_write(
                 keys[currentServerIndex], (void *)currentLocalPtr, chunkSize,
                 (uint64_t)(base_addr_list[currentServerIndex]) + currentFamPtr,
                 (*fiAddr)[memServerIds[currentServerIndex]],
-                get_context(descriptor), false);
+                get_context(descriptor), block);
+            if (request != NULL)
+                request->add_io(ctx);
             // go to next server for next block of data
             currentServerIndex++;
             // If last memory server is reached roll back to first server and
@@ -1628,14 +2214,21 @@ void Fam_Ops_Libfabric::scatter_nonblocking(
 
 void Fam_Ops_Libfabric::gather_nonblocking(
     void *local, Fam_Descriptor *descriptor, uint64_t nElements,
-    uint64_t firstElement, uint64_t stride, uint64_t elementSize) {
+    uint64_t firstElement, uint64_t stride, uint64_t elementSize,
+    Fam_Request *request) {
     uint64_t *memServerIds = descriptor->get_memserver_ids();
     size_t interleaveSize = descriptor->get_interleave_size();
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
     Fam_Context *famCtx = get_context(descriptor);
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    // IOs of a request are posted with a completion so that they can be
+    // tracked individually; plain nonblocking IOs only update the counters
+    bool block = (request != NULL);
+    struct fi_context *ctx = NULL;
+    if (request != NULL)
+        request->set_context(famCtx);
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     // Check if the dataitem is spread across more than one memory server,
     // if spread across multiple servers calculate the index of first server,
     // first block and the displacement within the block, else issue a single IO
@@ -1649,10 +2242,12 @@ void Fam_Ops_Libfabric::gather_nonblocking(
                             message.str().c_str());
         }
         // Issue an IO
-        fabric_gather_stride(keys[0], (void *)local, elementSize, firstElement,
-                             nElements, stride, (*fiAddr)[memServerIds[0]],
-                             famCtx, fabric_iov_limit,
-                             (uint64_t)(base_addr_list[0]), false);
+        ctx = fabric_gather_stride(
+            keys[0], (void *)local, elementSize, firstElement, nElements,
+            stride, (*fiAddr)[memServerIds[0]], famCtx, fabric_iov_limit,
+            (uint64_t)(base_addr_list[0]), block);
+        if (request != NULL)
+            request->add_io(ctx);
         return;
     }
 
@@ -1683,12 +2278,14 @@ void Fam_Ops_Libfabric::gather_nonblocking(
             else
                 chunkSize = firstBlockSize;
             // Issue an IO
-            fabric_read(keys[currentServerIndex], (void *)currentLocalPtr,
-                        chunkSize,
-                        (uint64_t)(base_addr_list[currentServerIndex]) +
-                            currentFamPtr + displacement,
-                        (*fiAddr)[memServerIds[currentServerIndex]],
-                        get_context(descriptor), false);
+            ctx = fabric_read(keys[currentServerIndex], (void *)currentLocalPtr,
+                              chunkSize,
+                              (uint64_t)(base_addr_list[currentServerIndex]) +
+                                  currentFamPtr + displacement,
+                              (*fiAddr)[memServerIds[currentServerIndex]],
+                              get_context(descriptor), block);
+            if (request != NULL)
+                request->add_io(ctx);
             // go to next server for next block of data
             currentServerIndex++;
             // If last memory server is reached roll back to first server and
@@ -1712,11 +2309,13 @@ void Fam_Ops_Libfabric::gather_nonblocking(
             else
                 chunkSize = interleaveSize;
             // Issue an IO
-            fabric_read(
+            ctx = fabric_read(
                 keys[currentServerIndex], (void *)currentLocalPtr, chunkSize,
                 (uint64_t)(base_addr_list[currentServerIndex]) + currentFamPtr,
                 (*fiAddr)[memServerIds[currentServerIndex]],
-                get_context(descriptor), false);
+                get_context(descriptor), block);
+            if (request != NULL)
+                request->add_io(ctx);
             // go to next server for next block of data
             currentServerIndex++;
             // If last memory server is reached roll back to first server and
@@ -1739,14 +2338,22 @@ void Fam_Ops_Libfabric::scatter_nonblocking(void *local,
                                             Fam_Descriptor *descriptor,
                                             uint64_t nElements,
                                             uint64_t *elementIndex,
-                                            uint64_t elementSize) {
+                                            uint64_t elementSize,
+                                            Fam_Request *request) {
+    defer_invalidate(descriptor, 0, UINT64_MAX);
     uint64_t *memServerIds = descriptor->get_memserver_ids();
     size_t interleaveSize = descriptor->get_interleave_size();
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
     Fam_Context *famCtx = get_context(descriptor);
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    // IOs of a request are posted with a completion so that they can be
+    // tracked individually; plain nonblocking IOs only update the counters
+    bool block = (request != NULL);
+    struct fi_context *ctx = NULL;
+    if (request != NULL)
+        request->set_context(famCtx);
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     // Check if the dataitem is spread across more than one memory server,
     // if spread across multiple servers calculate the index of first server,
     // first block and the displacement within the block, else issue a single IO
@@ -1760,10 +2367,12 @@ void Fam_Ops_Libfabric::scatter_nonblocking(void *local,
                             message.str().c_str());
         }
         // Issue an IO
-        fabric_scatter_index(keys[0], (void *)local, elementSize, elementIndex,
-                             nElements, (*fiAddr)[memServerIds[0]], famCtx,
-                             fabric_iov_limit, (uint64_t)(base_addr_list[0]),
-                             false);
+        ctx = fabric_scatter_index(
+            keys[0], (void *)local, elementSize, elementIndex, nElements,
+            (*fiAddr)[memServerIds[0]], famCtx, fabric_iov_limit,
+            (uint64_t)(base_addr_list[0]), block);
+        if (request != NULL)
+            request->add_io(ctx);
         return;
     }
 
@@ -1795,12 +2404,14 @@ void Fam_Ops_Libfabric::scatter_nonblocking(void *local,
             else
                 chunkSize = firstBlockSize;
             // Issue an IO
-            fabric_write(keys[currentServerIndex], (void *)currentLocalPtr,
-                         chunkSize,
-                         (uint64_t)(base_addr_list[currentServerIndex]) +
-                             currentFamPtr + displacement,
-                         (*fiAddr)[memServerIds[currentServerIndex]],
-                         get_context(descriptor), false);
+            ctx = fabric_write(
+                keys[currentServerIndex], (void *)currentLocalPtr, chunkSize,
+                (uint64_t)(base_addr_list[currentServerIndex]) + currentFamPtr +
+                    displacement,
+                (*fiAddr)[memServerIds[currentServerIndex]],
+                get_context(descriptor), block);
+            if (request != NULL)
+                request->add_io(ctx);
             // go to next server for next block of data
             currentServerIndex++;
             // If last memory server is reached roll back to first server and
@@ -1824,11 +2435,13 @@ void Fam_Ops_Libfabric::scatter_nonblocking(void *local,
             else
                 chunkSize = interleaveSize;
             // Issue an IO
-            fabric_write(
+            ctx = fabric_write(
                 keys[currentServerIndex], (void *)currentLocalPtr, chunkSize,
                 (uint64_t)(base_addr_list[currentServerIndex]) + currentFamPtr,
                 (*fiAddr)[memServerIds[currentServerIndex]],
-                get_context(descriptor), false);
+                get_context(descriptor), block);
+            if (request != NULL)
+                request->add_io(ctx);
             // go to next server for next block of data
             currentServerIndex++;
             // If last memory server is reached roll back to first server and
@@ -1850,14 +2463,21 @@ void Fam_Ops_Libfabric::gather_nonblocking(void *local,
                                            Fam_Descriptor *descriptor,
                                            uint64_t nElements,
                                            uint64_t *elementIndex,
-                                           uint64_t elementSize) {
+                                           uint64_t elementSize,
+                                           Fam_Request *request) {
     uint64_t *memServerIds = descriptor->get_memserver_ids();
     size_t interleaveSize = descriptor->get_interleave_size();
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
     Fam_Context *famCtx = get_context(descriptor);
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    // IOs of a request are posted with a completion so that they can be
+    // tracked individually; plain nonblocking IOs only update the counters
+    bool block = (request != NULL);
+    struct fi_context *ctx = NULL;
+    if (request != NULL)
+        request->set_context(famCtx);
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     // Check if the dataitem is spread across more than one memory server,
     // if spread across multiple servers calculate the index of first server,
     // first block and the displacement within the block, else issue a single IO
@@ -1871,10 +2491,12 @@ void Fam_Ops_Libfabric::gather_nonblocking(void *local,
                             message.str().c_str());
         }
         // Issue an IO
-        fabric_gather_index(keys[0], (void *)local, elementSize, elementIndex,
-                            nElements, (*fiAddr)[memServerIds[0]], famCtx,
-                            fabric_iov_limit, (uint64_t)(base_addr_list[0]),
-                            false);
+        ctx = fabric_gather_index(
+            keys[0], (void *)local, elementSize, elementIndex, nElements,
+            (*fiAddr)[memServerIds[0]], famCtx, fabric_iov_limit,
+            (uint64_t)(base_addr_list[0]), block);
+        if (request != NULL)
+            request->add_io(ctx);
         return;
     }
 
@@ -1906,12 +2528,14 @@ void Fam_Ops_Libfabric::gather_nonblocking(void *local,
             else
                 chunkSize = firstBlockSize;
             // Issue IO
-            fabric_read(keys[currentServerIndex], (void *)currentLocalPtr,
-                        chunkSize,
-                        (uint64_t)(base_addr_list[currentServerIndex]) +
-                            currentFamPtr + displacement,
-                        (*fiAddr)[memServerIds[currentServerIndex]],
-                        get_context(descriptor), false);
+            ctx = fabric_read(keys[currentServerIndex], (void *)currentLocalPtr,
+                              chunkSize,
+                              (uint64_t)(base_addr_list[currentServerIndex]) +
+                                  currentFamPtr + displacement,
+                              (*fiAddr)[memServerIds[currentServerIndex]],
+                              get_context(descriptor), block);
+            if (request != NULL)
+                request->add_io(ctx);
             // go to next server for next block of data
             currentServerIndex++;
             // If last memory server is reached roll back to first server and
@@ -1935,11 +2559,13 @@ void Fam_Ops_Libfabric::gather_nonblocking(void *local,
             else
                 chunkSize = interleaveSize;
             // Issue an IO
-            fabric_read(
+            ctx = fabric_read(
                 keys[currentServerIndex], (void *)currentLocalPtr, chunkSize,
                 (uint64_t)(base_addr_list[currentServerIndex]) + currentFamPtr,
                 (*fiAddr)[memServerIds[currentServerIndex]],
-                get_context(descriptor), false);
+                get_context(descriptor), block);
+            if (request != NULL)
+                request->add_io(ctx);
             // go to next server for next block of data
             currentServerIndex++;
             // If last memory server is reached roll back to first server and
@@ -1984,29 +2610,143 @@ void Fam_Ops_Libfabric::quiet_context(Fam_Context *context = NULL) {
             THROW_ERRNO_MSG(Fam_Datapath_Exception, get_fam_error(err), errmsg);
         }
 
-    } else if (famContextModel == FAM_CONTEXT_DEFAULT && context != NULL) {
+    } else if ((famContextModel == FAM_CONTEXT_DEFAULT ||
+                famContextModel == FAM_CONTEXT_THREAD) &&
+               context != NULL) {
         fabric_quiet(context);
     }
     return;
 }
 
 void Fam_Ops_Libfabric::quiet(Fam_Region_Descriptor *descriptor) {
-    if (famContextModel == FAM_CONTEXT_DEFAULT) {
-        quiet_context(get_context());
+    // Unless each thread has its own context, the quiet also covers the
+    // atomics other threads combined on the shared one
+    flush_combined_atomics(!threadContexts);
+    if (writeCombining && !threadContexts) {
+        quiet_shared_write_combiners();
+    } else {
+        flush_combined_puts();
+        // In the FAM_CONTEXT_THREAD model only the context of the calling
+        // thread is drained
+        if (famContextModel == FAM_CONTEXT_DEFAULT ||
+            famContextModel == FAM_CONTEXT_THREAD) {
+            quiet_context(get_context());
+        }
+    }
+    if (readCache != NULL) {
+        complete_prefetches(get_context());
+        readCache->apply_deferred();
+    }
+    // The puts of the runs issued by this thread are complete
+    if (writeCombining && threadContexts) {
+        Fam_Write_Combiner *combiner =
+            (Fam_Write_Combiner *)pthread_getspecific(writeCombinerKey);
+        if (combiner != NULL) {
+            combiner->acquire_lock();
+            combiner->recycle();
+            combiner->release_lock();
+        }
+    }
+}
+
+void Fam_Ops_Libfabric::fence(Fam_Region_Descriptor *descriptor) {
+    // Combined atomics and puts issued before the fence must be ordered
+    // before it, those of all threads when they share the context
+    flush_combined_atomics(!threadContexts);
+    flush_combined_puts(!threadContexts, false);
+    if (famContextModel == FAM_CONTEXT_DEFAULT ||
+        famContextModel == FAM_CONTEXT_THREAD) {
+        // Servers never accessed have nothing to order
+        Fam_Context *famCtx = get_context(NULL);
+        fiAddrs->for_each_inserted(
+            [&](fi_addr_t fiAddr) { fabric_fence(fiAddr, famCtx); });
+    }
+    if (readCacheInvalidateOnFence)
+        invalidate(descriptor);
+}
+
+void Fam_Ops_Libfabric::invalidate(Fam_Descriptor *descriptor,
+                                   uint64_t offset, uint64_t nbytes) {
+    if (readCache != NULL)
+        readCache->invalidate(descriptor->get_global_descriptor(), offset,
+                              nbytes);
+}
+
+void Fam_Ops_Libfabric::prefetch(Fam_Descriptor *descriptor, uint64_t offset,
+                                 uint64_t nbytes) {
+    // Without the read cache there is nowhere to keep the data
+    if (readCache == NULL)
+        return;
+    uint64_t itemSize = descriptor->get_size();
+    if (itemSize == 0 || offset >= itemSize)
         return;
+    uint64_t end = offset + std::min(nbytes, itemSize - offset);
+    end = std::min(end, offset + readCache->get_max_prefetch());
+    Fam_Global_Descriptor gd = descriptor->get_global_descriptor();
+    uint64_t pageSize = readCache->get_page_size();
+    for (uint64_t page = offset / pageSize; page * pageSize < end; page++) {
+        uint64_t pageStart = page * pageSize;
+        uint64_t fillLen = std::min(pageSize, itemSize - pageStart);
+        Fam_Read_Cache_Key key = Fam_Read_Cache::make_key(gd, page);
+        Fam_Request *request = new Fam_Request(false);
+        char *frame = readCache->reserve_prefetch(key, fillLen, request);
+        if (frame == NULL) {
+            delete request;
+            continue;
+        }
+        try {
+            get_nonblocking(frame, descriptor, pageStart, fillLen, request);
+        } catch (...) {
+            drain_request(request);
+            readCache->cancel_prefetch(key);
+            delete request;
+            throw;
+        }
+        readCache->issue_prefetch(key, request->get_context());
+    }
+}
+
+void Fam_Ops_Libfabric::complete_prefetch(Fam_Read_Cache_Prefetch &prefetch) {
+    try {
+        wait_request(prefetch.request);
+    } catch (...) {
+        drain_request(prefetch.request);
+        readCache->abandon(prefetch.frameIdx);
+        delete prefetch.request;
+        throw;
+    }
+    delete prefetch.request;
+    readCache->publish(prefetch.key, prefetch.frameIdx, prefetch.fillGen,
+                       prefetch.len);
+}
+
+void Fam_Ops_Libfabric::complete_prefetches(Fam_Context *famCtx) {
+    std::vector<Fam_Read_Cache_Prefetch> prefetches;
+    readCache->take_prefetches(famCtx, prefetches);
+    size_t i = 0;
+    try {
+        for (; i < prefetches.size(); i++)
+            complete_prefetch(prefetches[i]);
+    } catch (...) {
+        // Wait for the remaining reads before their frames can be reused
+        for (i++; i < prefetches.size(); i++) {
+            try {
+                complete_prefetch(prefetches[i]);
+            } catch (...) {
+            }
+        }
+        throw;
     }
 }
 
-void Fam_Ops_Libfabric::fence(Fam_Region_Descriptor *descriptor) {
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
-
-    uint64_t nodeId = 0;
-    if (famContextModel == FAM_CONTEXT_DEFAULT) {
-        for (auto memServers : *memServerAddrs) {
-            nodeId = memServers.first;
-            fabric_fence((*fiAddr)[nodeId], get_context(NULL));
-        }
-    }
+void Fam_Ops_Libfabric::invalidate(Fam_Region_Descriptor *descriptor) {
+    if (readCache == NULL)
+        return;
+    if (descriptor == NULL)
+        readCache->invalidate_all();
+    else
+        readCache->invalidate_region(
+            descriptor->get_global_descriptor().regionId);
 }
 
 // Note : In case of copy operation across memoryserver this API is blocking
@@ -2015,7 +2755,7 @@ void *Fam_Ops_Libfabric::copy(Fam_Descriptor *src, uint64_t srcOffset,
                               Fam_Descriptor *dest, uint64_t destOffset,
                               uint64_t nbytes) {
     // Perform actual copy operation at the destination memory server
-
+    defer_invalidate(dest, destOffset, nbytes);
     return famAllocator->copy(src, srcOffset, dest, destOffset, nbytes);
 }
 
@@ -2030,7 +2770,7 @@ void *Fam_Ops_Libfabric::backup(Fam_Descriptor *descriptor,
 }
 
 void *Fam_Ops_Libfabric::restore(const char *BackupName, Fam_Descriptor *dest) {
-
+    defer_invalidate(dest, 0, UINT64_MAX);
     return famAllocator->restore(dest, BackupName);
 }
 
@@ -2050,7 +2790,8 @@ uint64_t Fam_Ops_Libfabric::progress_context() {
 uint64_t Fam_Ops_Libfabric::progress() { return progress_context(); }
 
 void Fam_Ops_Libfabric::check_progress(Fam_Region_Descriptor *descriptor) {
-    if (famContextModel == FAM_CONTEXT_DEFAULT) {
+    if (famContextModel == FAM_CONTEXT_DEFAULT ||
+        famContextModel == FAM_CONTEXT_THREAD) {
 
         for (auto context : *defContexts) {
             Fam_Context *famCtx = context.second;
@@ -2063,13 +2804,14 @@ void Fam_Ops_Libfabric::check_progress(Fam_Region_Descriptor *descriptor) {
 
 void Fam_Ops_Libfabric::atomic_set(Fam_Descriptor *descriptor, uint64_t offset,
                                    int32_t value) {
+    defer_invalidate(descriptor, offset, sizeof(value));
     std::ostringstream message;
     uint64_t *memServerIds = descriptor->get_memserver_ids();
     size_t interleaveSize = descriptor->get_interleave_size();
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     if (usedMemsrvCnt == 1) {
         offset += (uint64_t)base_addr_list[0];
         fabric_atomic(keys[0], (void *)&value, offset, FI_ATOMIC_WRITE,
@@ -2106,13 +2848,14 @@ void Fam_Ops_Libfabric::atomic_set(Fam_Descriptor *descriptor, uint64_t offset,
 
 void Fam_Ops_Libfabric::atomic_set(Fam_Descriptor *descriptor, uint64_t offset,
                                    int64_t value) {
+    defer_invalidate(descriptor, offset, sizeof(value));
     std::ostringstream message;
     uint64_t *memServerIds = descriptor->get_memserver_ids();
     size_t interleaveSize = descriptor->get_interleave_size();
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     if (usedMemsrvCnt == 1) {
         offset += (uint64_t)base_addr_list[0];
         fabric_atomic(keys[0], (void *)&value, offset, FI_ATOMIC_WRITE,
@@ -2149,13 +2892,14 @@ void Fam_Ops_Libfabric::atomic_set(Fam_Descriptor *descriptor, uint64_t offset,
 
 void Fam_Ops_Libfabric::atomic_set(Fam_Descriptor *descriptor, uint64_t offset,
                                    uint32_t value) {
+    defer_invalidate(descriptor, offset, sizeof(value));
     std::ostringstream message;
     uint64_t *memServerIds = descriptor->get_memserver_ids();
     size_t interleaveSize = descriptor->get_interleave_size();
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     if (usedMemsrvCnt == 1) {
         offset += (uint64_t)base_addr_list[0];
         fabric_atomic(keys[0], (void *)&value, offset, FI_ATOMIC_WRITE,
@@ -2192,13 +2936,14 @@ void Fam_Ops_Libfabric::atomic_set(Fam_Descriptor *descriptor, uint64_t offset,
 
 void Fam_Ops_Libfabric::atomic_set(Fam_Descriptor *descriptor, uint64_t offset,
                                    uint64_t value) {
+    defer_invalidate(descriptor, offset, sizeof(value));
     std::ostringstream message;
     uint64_t *memServerIds = descriptor->get_memserver_ids();
     size_t interleaveSize = descriptor->get_interleave_size();
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     if (usedMemsrvCnt == 1) {
         offset += (uint64_t)base_addr_list[0];
         fabric_atomic(keys[0], (void *)&value, offset, FI_ATOMIC_WRITE,
@@ -2235,13 +2980,14 @@ void Fam_Ops_Libfabric::atomic_set(Fam_Descriptor *descriptor, uint64_t offset,
 
 void Fam_Ops_Libfabric::atomic_set(Fam_Descriptor *descriptor, uint64_t offset,
                                    float value) {
+    defer_invalidate(descriptor, offset, sizeof(value));
     std::ostringstream message;
     uint64_t *memServerIds = descriptor->get_memserver_ids();
     size_t interleaveSize = descriptor->get_interleave_size();
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     if (usedMemsrvCnt == 1) {
         offset += (uint64_t)base_addr_list[0];
         fabric_atomic(keys[0], (void *)&value, offset, FI_ATOMIC_WRITE,
@@ -2278,13 +3024,14 @@ void Fam_Ops_Libfabric::atomic_set(Fam_Descriptor *descriptor, uint64_t offset,
 
 void Fam_Ops_Libfabric::atomic_set(Fam_Descriptor *descriptor, uint64_t offset,
                                    double value) {
+    defer_invalidate(descriptor, offset, sizeof(value));
     std::ostringstream message;
     uint64_t *memServerIds = descriptor->get_memserver_ids();
     size_t interleaveSize = descriptor->get_interleave_size();
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     if (usedMemsrvCnt == 1) {
         offset += (uint64_t)base_addr_list[0];
         fabric_atomic(keys[0], (void *)&value, offset, FI_ATOMIC_WRITE,
@@ -2321,13 +3068,17 @@ void Fam_Ops_Libfabric::atomic_set(Fam_Descriptor *descriptor, uint64_t offset,
 
 void Fam_Ops_Libfabric::atomic_add(Fam_Descriptor *descriptor, uint64_t offset,
                                    int32_t value) {
+    defer_invalidate(descriptor, offset, sizeof(value));
+    if (combine_atomic(descriptor, offset, FAM_ATOMIC_ADD, FAM_ATOMIC_INT32,
+                       value))
+        return;
     std::ostringstream message;
     uint64_t *memServerIds = descriptor->get_memserver_ids();
     size_t interleaveSize = descriptor->get_interleave_size();
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     if (usedMemsrvCnt == 1) {
         offset += (uint64_t)base_addr_list[0];
         fabric_atomic(keys[0], (void *)&value, offset, FI_SUM, FI_INT32,
@@ -2362,13 +3113,17 @@ void Fam_Ops_Libfabric::atomic_add(Fam_Descriptor *descriptor, uint64_t offset,
 
 void Fam_Ops_Libfabric::atomic_add(Fam_Descriptor *descriptor, uint64_t offset,
                                    int64_t value) {
+    defer_invalidate(descriptor, offset, sizeof(value));
+    if (combine_atomic(descriptor, offset, FAM_ATOMIC_ADD, FAM_ATOMIC_INT64,
+                       value))
+        return;
     std::ostringstream message;
     uint64_t *memServerIds = descriptor->get_memserver_ids();
     size_t interleaveSize = descriptor->get_interleave_size();
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     if (usedMemsrvCnt == 1) {
         offset += (uint64_t)base_addr_list[0];
         fabric_atomic(keys[0], (void *)&value, offset, FI_SUM, FI_INT64,
@@ -2403,13 +3158,17 @@ void Fam_Ops_Libfabric::atomic_add(Fam_Descriptor *descriptor, uint64_t offset,
 
 void Fam_Ops_Libfabric::atomic_add(Fam_Descriptor *descriptor, uint64_t offset,
                                    uint32_t value) {
+    defer_invalidate(descriptor, offset, sizeof(value));
+    if (combine_atomic(descriptor, offset, FAM_ATOMIC_ADD, FAM_ATOMIC_UINT32,
+                       value))
+        return;
     std::ostringstream message;
     uint64_t *memServerIds = descriptor->get_memserver_ids();
     size_t interleaveSize = descriptor->get_interleave_size();
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     if (usedMemsrvCnt == 1) {
         offset += (uint64_t)base_addr_list[0];
         fabric_atomic(keys[0], (void *)&value, offset, FI_SUM, FI_UINT32,
@@ -2445,13 +3204,17 @@ void Fam_Ops_Libfabric::atomic_add(Fam_Descriptor *descriptor, uint64_t offset,
 
 void Fam_Ops_Libfabric::atomic_add(Fam_Descriptor *descriptor, uint64_t offset,
                                    uint64_t value) {
+    defer_invalidate(descriptor, offset, sizeof(value));
+    if (combine_atomic(descriptor, offset, FAM_ATOMIC_ADD, FAM_ATOMIC_UINT64,
+                       value))
+        return;
     std::ostringstream message;
     uint64_t *memServerIds = descriptor->get_memserver_ids();
     size_t interleaveSize = descriptor->get_interleave_size();
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     if (usedMemsrvCnt == 1) {
         offset += (uint64_t)base_addr_list[0];
         fabric_atomic(keys[0], (void *)&value, offset, FI_SUM, FI_UINT64,
@@ -2487,13 +3250,17 @@ void Fam_Ops_Libfabric::atomic_add(Fam_Descriptor *descriptor, uint64_t offset,
 
 void Fam_Ops_Libfabric::atomic_add(Fam_Descriptor *descriptor, uint64_t offset,
                                    float value) {
+    defer_invalidate(descriptor, offset, sizeof(value));
+    if (combine_atomic(descriptor, offset, FAM_ATOMIC_ADD, FAM_ATOMIC_FLOAT,
+                       value))
+        return;
     std::ostringstream message;
     uint64_t *memServerIds = descriptor->get_memserver_ids();
     size_t interleaveSize = descriptor->get_interleave_size();
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     if (usedMemsrvCnt == 1) {
         offset += (uint64_t)base_addr_list[0];
         fabric_atomic(keys[0], (void *)&value, offset, FI_SUM, FI_FLOAT,
@@ -2528,13 +3295,17 @@ void Fam_Ops_Libfabric::atomic_add(Fam_Descriptor *descriptor, uint64_t offset,
 
 void Fam_Ops_Libfabric::atomic_add(Fam_Descriptor *descriptor, uint64_t offset,
                                    double value) {
+    defer_invalidate(descriptor, offset, sizeof(value));
+    if (combine_atomic(descriptor, offset, FAM_ATOMIC_ADD, FAM_ATOMIC_DOUBLE,
+                       value))
+        return;
     std::ostringstream message;
     uint64_t *memServerIds = descriptor->get_memserver_ids();
     size_t interleaveSize = descriptor->get_interleave_size();
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     if (usedMemsrvCnt == 1) {
         offset += (uint64_t)base_addr_list[0];
         fabric_atomic(keys[0], (void *)&value, offset, FI_SUM, FI_DOUBLE,
@@ -2606,13 +3377,17 @@ void Fam_Ops_Libfabric::atomic_subtract(Fam_Descriptor *descriptor,
 
 void Fam_Ops_Libfabric::atomic_min(Fam_Descriptor *descriptor, uint64_t offset,
                                    int32_t value) {
+    defer_invalidate(descriptor, offset, sizeof(value));
+    if (combine_atomic(descriptor, offset, FAM_ATOMIC_MIN, FAM_ATOMIC_INT32,
+                       value))
+        return;
     std::ostringstream message;
     uint64_t *memServerIds = descriptor->get_memserver_ids();
     size_t interleaveSize = descriptor->get_interleave_size();
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     if (usedMemsrvCnt == 1) {
         offset += (uint64_t)base_addr_list[0];
         fabric_atomic(keys[0], (void *)&value, offset, FI_MIN, FI_INT32,
@@ -2647,13 +3422,17 @@ void Fam_Ops_Libfabric::atomic_min(Fam_Descriptor *descriptor, uint64_t offset,
 
 void Fam_Ops_Libfabric::atomic_min(Fam_Descriptor *descriptor, uint64_t offset,
                                    int64_t value) {
+    defer_invalidate(descriptor, offset, sizeof(value));
+    if (combine_atomic(descriptor, offset, FAM_ATOMIC_MIN, FAM_ATOMIC_INT64,
+                       value))
+        return;
     std::ostringstream message;
     uint64_t *memServerIds = descriptor->get_memserver_ids();
     size_t interleaveSize = descriptor->get_interleave_size();
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     if (usedMemsrvCnt == 1) {
         offset += (uint64_t)base_addr_list[0];
         fabric_atomic(keys[0], (void *)&value, offset, FI_MIN, FI_INT64,
@@ -2688,13 +3467,17 @@ void Fam_Ops_Libfabric::atomic_min(Fam_Descriptor *descriptor, uint64_t offset,
 
 void Fam_Ops_Libfabric::atomic_min(Fam_Descriptor *descriptor, uint64_t offset,
                                    uint32_t value) {
+    defer_invalidate(descriptor, offset, sizeof(value));
+    if (combine_atomic(descriptor, offset, FAM_ATOMIC_MIN, FAM_ATOMIC_UINT32,
+                       value))
+        return;
     std::ostringstream message;
     uint64_t *memServerIds = descriptor->get_memserver_ids();
     size_t interleaveSize = descriptor->get_interleave_size();
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     if (usedMemsrvCnt == 1) {
         offset += (uint64_t)base_addr_list[0];
         fabric_atomic(keys[0], (void *)&value, offset, FI_MIN, FI_UINT32,
@@ -2730,13 +3513,17 @@ void Fam_Ops_Libfabric::atomic_min(Fam_Descriptor *descriptor, uint64_t offset,
 
 void Fam_Ops_Libfabric::atomic_min(Fam_Descriptor *descriptor, uint64_t offset,
                                    uint64_t value) {
+    defer_invalidate(descriptor, offset, sizeof(value));
+    if (combine_atomic(descriptor, offset, FAM_ATOMIC_MIN, FAM_ATOMIC_UINT64,
+                       value))
+        return;
     std::ostringstream message;
     uint64_t *memServerIds = descriptor->get_memserver_ids();
     size_t interleaveSize = descriptor->get_interleave_size();
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     if (usedMemsrvCnt == 1) {
         offset += (uint64_t)base_addr_list[0];
         fabric_atomic(keys[0], (void *)&value, offset, FI_MIN, FI_UINT64,
@@ -2772,13 +3559,17 @@ void Fam_Ops_Libfabric::atomic_min(Fam_Descriptor *descriptor, uint64_t offset,
 
 void Fam_Ops_Libfabric::atomic_min(Fam_Descriptor *descriptor, uint64_t offset,
                                    float value) {
+    defer_invalidate(descriptor, offset, sizeof(value));
+    if (combine_atomic(descriptor, offset, FAM_ATOMIC_MIN, FAM_ATOMIC_FLOAT,
+                       value))
+        return;
     std::ostringstream message;
     uint64_t *memServerIds = descriptor->get_memserver_ids();
     size_t interleaveSize = descriptor->get_interleave_size();
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     if (usedMemsrvCnt == 1) {
         offset += (uint64_t)base_addr_list[0];
         fabric_atomic(keys[0], (void *)&value, offset, FI_MIN, FI_FLOAT,
@@ -2813,13 +3604,17 @@ void Fam_Ops_Libfabric::atomic_min(Fam_Descriptor *descriptor, uint64_t offset,
 
 void Fam_Ops_Libfabric::atomic_min(Fam_Descriptor *descriptor, uint64_t offset,
                                    double value) {
+    defer_invalidate(descriptor, offset, sizeof(value));
+    if (combine_atomic(descriptor, offset, FAM_ATOMIC_MIN, FAM_ATOMIC_DOUBLE,
+                       value))
+        return;
     std::ostringstream message;
     uint64_t *memServerIds = descriptor->get_memserver_ids();
     size_t interleaveSize = descriptor->get_interleave_size();
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     if (usedMemsrvCnt == 1) {
         offset += (uint64_t)base_addr_list[0];
         fabric_atomic(keys[0], (void *)&value, offset, FI_MIN, FI_DOUBLE,
@@ -2855,13 +3650,17 @@ void Fam_Ops_Libfabric::atomic_min(Fam_Descriptor *descriptor, uint64_t offset,
 
 void Fam_Ops_Libfabric::atomic_max(Fam_Descriptor *descriptor, uint64_t offset,
                                    int32_t value) {
+    defer_invalidate(descriptor, offset, sizeof(value));
+    if (combine_atomic(descriptor, offset, FAM_ATOMIC_MAX, FAM_ATOMIC_INT32,
+                       value))
+        return;
     std::ostringstream message;
     uint64_t *memServerIds = descriptor->get_memserver_ids();
     size_t interleaveSize = descriptor->get_interleave_size();
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     if (usedMemsrvCnt == 1) {
         offset += (uint64_t)base_addr_list[0];
         fabric_atomic(keys[0], (void *)&value, offset, FI_MAX, FI_INT32,
@@ -2896,13 +3695,17 @@ void Fam_Ops_Libfabric::atomic_max(Fam_Descriptor *descriptor, uint64_t offset,
 
 void Fam_Ops_Libfabric::atomic_max(Fam_Descriptor *descriptor, uint64_t offset,
                                    int64_t value) {
+    defer_invalidate(descriptor, offset, sizeof(value));
+    if (combine_atomic(descriptor, offset, FAM_ATOMIC_MAX, FAM_ATOMIC_INT64,
+                       value))
+        return;
     std::ostringstream message;
     uint64_t *memServerIds = descriptor->get_memserver_ids();
     size_t interleaveSize = descriptor->get_interleave_size();
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     if (usedMemsrvCnt == 1) {
         offset += (uint64_t)base_addr_list[0];
         fabric_atomic(keys[0], (void *)&value, offset, FI_MAX, FI_INT64,
@@ -2937,13 +3740,17 @@ void Fam_Ops_Libfabric::atomic_max(Fam_Descriptor *descriptor, uint64_t offset,
 
 void Fam_Ops_Libfabric::atomic_max(Fam_Descriptor *descriptor, uint64_t offset,
                                    uint32_t value) {
+    defer_invalidate(descriptor, offset, sizeof(value));
+    if (combine_atomic(descriptor, offset, FAM_ATOMIC_MAX, FAM_ATOMIC_UINT32,
+                       value))
+        return;
     std::ostringstream message;
     uint64_t *memServerIds = descriptor->get_memserver_ids();
     size_t interleaveSize = descriptor->get_interleave_size();
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     if (usedMemsrvCnt == 1) {
         offset += (uint64_t)base_addr_list[0];
         fabric_atomic(keys[0], (void *)&value, offset, FI_MAX, FI_UINT32,
@@ -2979,13 +3786,17 @@ void Fam_Ops_Libfabric::atomic_max(Fam_Descriptor *descriptor, uint64_t offset,
 
 void Fam_Ops_Libfabric::atomic_max(Fam_Descriptor *descriptor, uint64_t offset,
                                    uint64_t value) {
+    defer_invalidate(descriptor, offset, sizeof(value));
+    if (combine_atomic(descriptor, offset, FAM_ATOMIC_MAX, FAM_ATOMIC_UINT64,
+                       value))
+        return;
     std::ostringstream message;
     uint64_t *memServerIds = descriptor->get_memserver_ids();
     size_t interleaveSize = descriptor->get_interleave_size();
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     if (usedMemsrvCnt == 1) {
         offset += (uint64_t)base_addr_list[0];
         fabric_atomic(keys[0], (void *)&value, offset, FI_MAX, FI_UINT64,
@@ -3021,13 +3832,17 @@ void Fam_Ops_Libfabric::atomic_max(Fam_Descriptor *descriptor, uint64_t offset,
 
 void Fam_Ops_Libfabric::atomic_max(Fam_Descriptor *descriptor, uint64_t offset,
                                    float value) {
+    defer_invalidate(descriptor, offset, sizeof(value));
+    if (combine_atomic(descriptor, offset, FAM_ATOMIC_MAX, FAM_ATOMIC_FLOAT,
+                       value))
+        return;
     std::ostringstream message;
     uint64_t *memServerIds = descriptor->get_memserver_ids();
     size_t interleaveSize = descriptor->get_interleave_size();
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     if (usedMemsrvCnt == 1) {
         offset += (uint64_t)base_addr_list[0];
         fabric_atomic(keys[0], (void *)&value, offset, FI_MAX, FI_FLOAT,
@@ -3062,13 +3877,17 @@ void Fam_Ops_Libfabric::atomic_max(Fam_Descriptor *descriptor, uint64_t offset,
 
 void Fam_Ops_Libfabric::atomic_max(Fam_Descriptor *descriptor, uint64_t offset,
                                    double value) {
+    defer_invalidate(descriptor, offset, sizeof(value));
+    if (combine_atomic(descriptor, offset, FAM_ATOMIC_MAX, FAM_ATOMIC_DOUBLE,
+                       value))
+        return;
     std::ostringstream message;
     uint64_t *memServerIds = descriptor->get_memserver_ids();
     size_t interleaveSize = descriptor->get_interleave_size();
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     if (usedMemsrvCnt == 1) {
         offset += (uint64_t)base_addr_list[0];
         fabric_atomic(keys[0], (void *)&value, offset, FI_MAX, FI_DOUBLE,
@@ -3104,13 +3923,17 @@ void Fam_Ops_Libfabric::atomic_max(Fam_Descriptor *descriptor, uint64_t offset,
 
 void Fam_Ops_Libfabric::atomic_and(Fam_Descriptor *descriptor, uint64_t offset,
                                    uint32_t value) {
+    defer_invalidate(descriptor, offset, sizeof(value));
+    if (combine_atomic(descriptor, offset, FAM_ATOMIC_AND, FAM_ATOMIC_UINT32,
+                       value))
+        return;
     std::ostringstream message;
     uint64_t *memServerIds = descriptor->get_memserver_ids();
     size_t interleaveSize = descriptor->get_interleave_size();
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     if (usedMemsrvCnt == 1) {
         offset += (uint64_t)base_addr_list[0];
         fabric_atomic(keys[0], (void *)&value, offset, FI_BAND, FI_UINT32,
@@ -3146,13 +3969,17 @@ void Fam_Ops_Libfabric::atomic_and(Fam_Descriptor *descriptor, uint64_t offset,
 
 void Fam_Ops_Libfabric::atomic_and(Fam_Descriptor *descriptor, uint64_t offset,
                                    uint64_t value) {
+    defer_invalidate(descriptor, offset, sizeof(value));
+    if (combine_atomic(descriptor, offset, FAM_ATOMIC_AND, FAM_ATOMIC_UINT64,
+                       value))
+        return;
     std::ostringstream message;
     uint64_t *memServerIds = descriptor->get_memserver_ids();
     size_t interleaveSize = descriptor->get_interleave_size();
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     if (usedMemsrvCnt == 1) {
         offset += (uint64_t)base_addr_list[0];
         fabric_atomic(keys[0], (void *)&value, offset, FI_BAND, FI_UINT64,
@@ -3188,13 +4015,17 @@ void Fam_Ops_Libfabric::atomic_and(Fam_Descriptor *descriptor, uint64_t offset,
 
 void Fam_Ops_Libfabric::atomic_or(Fam_Descriptor *descriptor, uint64_t offset,
                                   uint32_t value) {
+    defer_invalidate(descriptor, offset, sizeof(value));
+    if (combine_atomic(descriptor, offset, FAM_ATOMIC_OR, FAM_ATOMIC_UINT32,
+                       value))
+        return;
     std::ostringstream message;
     uint64_t *memServerIds = descriptor->get_memserver_ids();
     size_t interleaveSize = descriptor->get_interleave_size();
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     if (usedMemsrvCnt == 1) {
         offset += (uint64_t)base_addr_list[0];
         fabric_atomic(keys[0], (void *)&value, offset, FI_BOR, FI_UINT32,
@@ -3230,13 +4061,17 @@ void Fam_Ops_Libfabric::atomic_or(Fam_Descriptor *descriptor, uint64_t offset,
 
 void Fam_Ops_Libfabric::atomic_or(Fam_Descriptor *descriptor, uint64_t offset,
                                   uint64_t value) {
+    defer_invalidate(descriptor, offset, sizeof(value));
+    if (combine_atomic(descriptor, offset, FAM_ATOMIC_OR, FAM_ATOMIC_UINT64,
+                       value))
+        return;
     std::ostringstream message;
     uint64_t *memServerIds = descriptor->get_memserver_ids();
     size_t interleaveSize = descriptor->get_interleave_size();
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     if (usedMemsrvCnt == 1) {
         offset += (uint64_t)base_addr_list[0];
         fabric_atomic(keys[0], (void *)&value, offset, FI_BOR, FI_UINT64,
@@ -3272,13 +4107,17 @@ void Fam_Ops_Libfabric::atomic_or(Fam_Descriptor *descriptor, uint64_t offset,
 
 void Fam_Ops_Libfabric::atomic_xor(Fam_Descriptor *descriptor, uint64_t offset,
                                    uint32_t value) {
+    defer_invalidate(descriptor, offset, sizeof(value));
+    if (combine_atomic(descriptor, offset, FAM_ATOMIC_XOR, FAM_ATOMIC_UINT32,
+                       value))
+        return;
     std::ostringstream message;
     uint64_t *memServerIds = descriptor->get_memserver_ids();
     size_t interleaveSize = descriptor->get_interleave_size();
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     if (usedMemsrvCnt == 1) {
         offset += (uint64_t)base_addr_list[0];
         fabric_atomic(keys[0], (void *)&value, offset, FI_BXOR, FI_UINT32,
@@ -3314,13 +4153,17 @@ void Fam_Ops_Libfabric::atomic_xor(Fam_Descriptor *descriptor, uint64_t offset,
 
 void Fam_Ops_Libfabric::atomic_xor(Fam_Descriptor *descriptor, uint64_t offset,
                                    uint64_t value) {
+    defer_invalidate(descriptor, offset, sizeof(value));
+    if (combine_atomic(descriptor, offset, FAM_ATOMIC_XOR, FAM_ATOMIC_UINT64,
+                       value))
+        return;
     std::ostringstream message;
     uint64_t *memServerIds = descriptor->get_memserver_ids();
     size_t interleaveSize = descriptor->get_interleave_size();
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     if (usedMemsrvCnt == 1) {
         offset += (uint64_t)base_addr_list[0];
         fabric_atomic(keys[0], (void *)&value, offset, FI_BXOR, FI_UINT64,
@@ -3356,13 +4199,15 @@ void Fam_Ops_Libfabric::atomic_xor(Fam_Descriptor *descriptor, uint64_t offset,
 
 int32_t Fam_Ops_Libfabric::swap(Fam_Descriptor *descriptor, uint64_t offset,
                                 int32_t value) {
+    Fam_Read_Cache_Write_Scope cacheScope(readCache, descriptor, offset,
+                                          sizeof(value));
     std::ostringstream message;
     uint64_t *memServerIds = descriptor->get_memserver_ids();
     size_t interleaveSize = descriptor->get_interleave_size();
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     int32_t old;
     if (usedMemsrvCnt == 1) {
         offset += (uint64_t)base_addr_list[0];
@@ -3400,13 +4245,15 @@ int32_t Fam_Ops_Libfabric::swap(Fam_Descriptor *descriptor, uint64_t offset,
 
 int64_t Fam_Ops_Libfabric::swap(Fam_Descriptor *descriptor, uint64_t offset,
                                 int64_t value) {
+    Fam_Read_Cache_Write_Scope cacheScope(readCache, descriptor, offset,
+                                          sizeof(value));
     std::ostringstream message;
     uint64_t *memServerIds = descriptor->get_memserver_ids();
     size_t interleaveSize = descriptor->get_interleave_size();
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     int64_t old;
     if (usedMemsrvCnt == 1) {
         offset += (uint64_t)base_addr_list[0];
@@ -3444,13 +4291,15 @@ int64_t Fam_Ops_Libfabric::swap(Fam_Descriptor *descriptor, uint64_t offset,
 
 uint32_t Fam_Ops_Libfabric::swap(Fam_Descriptor *descriptor, uint64_t offset,
                                  uint32_t value) {
+    Fam_Read_Cache_Write_Scope cacheScope(readCache, descriptor, offset,
+                                          sizeof(value));
     std::ostringstream message;
     uint64_t *memServerIds = descriptor->get_memserver_ids();
     size_t interleaveSize = descriptor->get_interleave_size();
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     uint32_t old;
     if (usedMemsrvCnt == 1) {
         offset += (uint64_t)base_addr_list[0];
@@ -3488,13 +4337,15 @@ uint32_t Fam_Ops_Libfabric::swap(Fam_Descriptor *descriptor, uint64_t offset,
 
 uint64_t Fam_Ops_Libfabric::swap(Fam_Descriptor *descriptor, uint64_t offset,
                                  uint64_t value) {
+    Fam_Read_Cache_Write_Scope cacheScope(readCache, descriptor, offset,
+                                          sizeof(value));
     std::ostringstream message;
     uint64_t *memServerIds = descriptor->get_memserver_ids();
     size_t interleaveSize = descriptor->get_interleave_size();
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     uint64_t old;
     if (usedMemsrvCnt == 1) {
         offset += (uint64_t)base_addr_list[0];
@@ -3532,13 +4383,15 @@ uint64_t Fam_Ops_Libfabric::swap(Fam_Descriptor *descriptor, uint64_t offset,
 
 float Fam_Ops_Libfabric::swap(Fam_Descriptor *descriptor, uint64_t offset,
                               float value) {
+    Fam_Read_Cache_Write_Scope cacheScope(readCache, descriptor, offset,
+                                          sizeof(value));
     std::ostringstream message;
     uint64_t *memServerIds = descriptor->get_memserver_ids();
     size_t interleaveSize = descriptor->get_interleave_size();
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     float old;
     if (usedMemsrvCnt == 1) {
         offset += (uint64_t)base_addr_list[0];
@@ -3576,13 +4429,15 @@ float Fam_Ops_Libfabric::swap(Fam_Descriptor *descriptor, uint64_t offset,
 
 double Fam_Ops_Libfabric::swap(Fam_Descriptor *descriptor, uint64_t offset,
                                double value) {
+    Fam_Read_Cache_Write_Scope cacheScope(readCache, descriptor, offset,
+                                          sizeof(value));
     std::ostringstream message;
     uint64_t *memServerIds = descriptor->get_memserver_ids();
     size_t interleaveSize = descriptor->get_interleave_size();
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     double old;
     if (usedMemsrvCnt == 1) {
         offset += (uint64_t)base_addr_list[0];
@@ -3621,13 +4476,15 @@ double Fam_Ops_Libfabric::swap(Fam_Descriptor *descriptor, uint64_t offset,
 int32_t Fam_Ops_Libfabric::compare_swap(Fam_Descriptor *descriptor,
                                         uint64_t offset, int32_t oldValue,
                                         int32_t newValue) {
+    Fam_Read_Cache_Write_Scope cacheScope(readCache, descriptor, offset,
+                                          sizeof(oldValue));
     std::ostringstream message;
     uint64_t *memServerIds = descriptor->get_memserver_ids();
     size_t interleaveSize = descriptor->get_interleave_size();
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     int32_t old;
     if (usedMemsrvCnt == 1) {
         offset += (uint64_t)base_addr_list[0];
@@ -3667,13 +4524,15 @@ int32_t Fam_Ops_Libfabric::compare_swap(Fam_Descriptor *descriptor,
 int64_t Fam_Ops_Libfabric::compare_swap(Fam_Descriptor *descriptor,
                                         uint64_t offset, int64_t oldValue,
                                         int64_t newValue) {
+    Fam_Read_Cache_Write_Scope cacheScope(readCache, descriptor, offset,
+                                          sizeof(oldValue));
     std::ostringstream message;
     uint64_t *memServerIds = descriptor->get_memserver_ids();
     size_t interleaveSize = descriptor->get_interleave_size();
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     int64_t old;
     if (usedMemsrvCnt == 1) {
         offset += (uint64_t)base_addr_list[0];
@@ -3713,13 +4572,15 @@ int64_t Fam_Ops_Libfabric::compare_swap(Fam_Descriptor *descriptor,
 uint32_t Fam_Ops_Libfabric::compare_swap(Fam_Descriptor *descriptor,
                                          uint64_t offset, uint32_t oldValue,
                                          uint32_t newValue) {
+    Fam_Read_Cache_Write_Scope cacheScope(readCache, descriptor, offset,
+                                          sizeof(oldValue));
     std::ostringstream message;
     uint64_t *memServerIds = descriptor->get_memserver_ids();
     size_t interleaveSize = descriptor->get_interleave_size();
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     uint32_t old;
     if (usedMemsrvCnt == 1) {
         offset += (uint64_t)base_addr_list[0];
@@ -3759,13 +4620,15 @@ uint32_t Fam_Ops_Libfabric::compare_swap(Fam_Descriptor *descriptor,
 uint64_t Fam_Ops_Libfabric::compare_swap(Fam_Descriptor *descriptor,
                                          uint64_t offset, uint64_t oldValue,
                                          uint64_t newValue) {
+    Fam_Read_Cache_Write_Scope cacheScope(readCache, descriptor, offset,
+                                          sizeof(oldValue));
     std::ostringstream message;
     uint64_t *memServerIds = descriptor->get_memserver_ids();
     size_t interleaveSize = descriptor->get_interleave_size();
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     uint64_t old;
     if (usedMemsrvCnt == 1) {
         offset += (uint64_t)base_addr_list[0];
@@ -3805,6 +4668,8 @@ uint64_t Fam_Ops_Libfabric::compare_swap(Fam_Descriptor *descriptor,
 int128_t Fam_Ops_Libfabric::compare_swap(Fam_Descriptor *descriptor,
                                          uint64_t offset, int128_t oldValue,
                                          int128_t newValue) {
+    Fam_Read_Cache_Write_Scope cacheScope(readCache, descriptor, offset,
+                                          sizeof(oldValue));
 
     std::ostringstream message;
     uint64_t *memServerIds = descriptor->get_memserver_ids();
@@ -3812,9 +4677,19 @@ int128_t Fam_Ops_Libfabric::compare_swap(Fam_Descriptor *descriptor,
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     int128_t local;
 
+    if (nativeInt128Atomics) {
+        uint64_t key, famPtr;
+        fi_addr_t addr;
+        get_int128_location(descriptor, offset, &key, &famPtr, &addr);
+        fabric_atomic128(key, (void *)&newValue, (void *)&local,
+                         (void *)&oldValue, famPtr, FI_CSWAP, addr,
+                         get_context(descriptor));
+        return local;
+    }
+
     if (usedMemsrvCnt == 1) {
         offset += (uint64_t)base_addr_list[0];
         famAllocator->acquire_CAS_lock(descriptor, memServerIds[0]);
@@ -3895,7 +4770,7 @@ int32_t Fam_Ops_Libfabric::atomic_fetch_int32(Fam_Descriptor *descriptor,
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     int32_t result;
     if (usedMemsrvCnt == 1) {
         offset += (uint64_t)base_addr_list[0];
@@ -3939,7 +4814,7 @@ int64_t Fam_Ops_Libfabric::atomic_fetch_int64(Fam_Descriptor *descriptor,
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     int64_t result;
     if (usedMemsrvCnt == 1) {
         offset += (uint64_t)base_addr_list[0];
@@ -3983,7 +4858,7 @@ uint32_t Fam_Ops_Libfabric::atomic_fetch_uint32(Fam_Descriptor *descriptor,
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     uint32_t result;
     if (usedMemsrvCnt == 1) {
         offset += (uint64_t)base_addr_list[0];
@@ -4027,7 +4902,7 @@ uint64_t Fam_Ops_Libfabric::atomic_fetch_uint64(Fam_Descriptor *descriptor,
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     uint64_t result;
     if (usedMemsrvCnt == 1) {
         offset += (uint64_t)base_addr_list[0];
@@ -4071,7 +4946,7 @@ float Fam_Ops_Libfabric::atomic_fetch_float(Fam_Descriptor *descriptor,
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     float result;
     if (usedMemsrvCnt == 1) {
         offset += (uint64_t)base_addr_list[0];
@@ -4115,7 +4990,7 @@ double Fam_Ops_Libfabric::atomic_fetch_double(Fam_Descriptor *descriptor,
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     double result;
     if (usedMemsrvCnt == 1) {
         offset += (uint64_t)base_addr_list[0];
@@ -4153,13 +5028,15 @@ double Fam_Ops_Libfabric::atomic_fetch_double(Fam_Descriptor *descriptor,
 
 int32_t Fam_Ops_Libfabric::atomic_fetch_add(Fam_Descriptor *descriptor,
                                             uint64_t offset, int32_t value) {
+    Fam_Read_Cache_Write_Scope cacheScope(readCache, descriptor, offset,
+                                          sizeof(value));
     std::ostringstream message;
     uint64_t *memServerIds = descriptor->get_memserver_ids();
     size_t interleaveSize = descriptor->get_interleave_size();
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     int32_t old;
     if (usedMemsrvCnt == 1) {
         offset += (uint64_t)base_addr_list[0];
@@ -4197,13 +5074,15 @@ int32_t Fam_Ops_Libfabric::atomic_fetch_add(Fam_Descriptor *descriptor,
 
 int64_t Fam_Ops_Libfabric::atomic_fetch_add(Fam_Descriptor *descriptor,
                                             uint64_t offset, int64_t value) {
+    Fam_Read_Cache_Write_Scope cacheScope(readCache, descriptor, offset,
+                                          sizeof(value));
     std::ostringstream message;
     uint64_t *memServerIds = descriptor->get_memserver_ids();
     size_t interleaveSize = descriptor->get_interleave_size();
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     int64_t old;
     if (usedMemsrvCnt == 1) {
         offset += (uint64_t)base_addr_list[0];
@@ -4241,13 +5120,15 @@ int64_t Fam_Ops_Libfabric::atomic_fetch_add(Fam_Descriptor *descriptor,
 
 uint32_t Fam_Ops_Libfabric::atomic_fetch_add(Fam_Descriptor *descriptor,
                                              uint64_t offset, uint32_t value) {
+    Fam_Read_Cache_Write_Scope cacheScope(readCache, descriptor, offset,
+                                          sizeof(value));
     std::ostringstream message;
     uint64_t *memServerIds = descriptor->get_memserver_ids();
     size_t interleaveSize = descriptor->get_interleave_size();
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     uint32_t old;
     if (usedMemsrvCnt == 1) {
         offset += (uint64_t)base_addr_list[0];
@@ -4285,13 +5166,15 @@ uint32_t Fam_Ops_Libfabric::atomic_fetch_add(Fam_Descriptor *descriptor,
 
 uint64_t Fam_Ops_Libfabric::atomic_fetch_add(Fam_Descriptor *descriptor,
                                              uint64_t offset, uint64_t value) {
+    Fam_Read_Cache_Write_Scope cacheScope(readCache, descriptor, offset,
+                                          sizeof(value));
     std::ostringstream message;
     uint64_t *memServerIds = descriptor->get_memserver_ids();
     size_t interleaveSize = descriptor->get_interleave_size();
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     uint64_t old;
     if (usedMemsrvCnt == 1) {
         offset += (uint64_t)base_addr_list[0];
@@ -4329,13 +5212,15 @@ uint64_t Fam_Ops_Libfabric::atomic_fetch_add(Fam_Descriptor *descriptor,
 
 float Fam_Ops_Libfabric::atomic_fetch_add(Fam_Descriptor *descriptor,
                                           uint64_t offset, float value) {
+    Fam_Read_Cache_Write_Scope cacheScope(readCache, descriptor, offset,
+                                          sizeof(value));
     std::ostringstream message;
     uint64_t *memServerIds = descriptor->get_memserver_ids();
     size_t interleaveSize = descriptor->get_interleave_size();
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     float old;
     if (usedMemsrvCnt == 1) {
         offset += (uint64_t)base_addr_list[0];
@@ -4373,13 +5258,15 @@ float Fam_Ops_Libfabric::atomic_fetch_add(Fam_Descriptor *descriptor,
 
 double Fam_Ops_Libfabric::atomic_fetch_add(Fam_Descriptor *descriptor,
                                            uint64_t offset, double value) {
+    Fam_Read_Cache_Write_Scope cacheScope(readCache, descriptor, offset,
+                                          sizeof(value));
     std::ostringstream message;
     uint64_t *memServerIds = descriptor->get_memserver_ids();
     size_t interleaveSize = descriptor->get_interleave_size();
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     double old;
     if (usedMemsrvCnt == 1) {
         offset += (uint64_t)base_addr_list[0];
@@ -4451,13 +5338,15 @@ double Fam_Ops_Libfabric::atomic_fetch_subtract(Fam_Descriptor *descriptor,
 
 int32_t Fam_Ops_Libfabric::atomic_fetch_min(Fam_Descriptor *descriptor,
                                             uint64_t offset, int32_t value) {
+    Fam_Read_Cache_Write_Scope cacheScope(readCache, descriptor, offset,
+                                          sizeof(value));
     std::ostringstream message;
     uint64_t *memServerIds = descriptor->get_memserver_ids();
     size_t interleaveSize = descriptor->get_interleave_size();
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     int32_t old;
     if (usedMemsrvCnt == 1) {
         offset += (uint64_t)base_addr_list[0];
@@ -4495,13 +5384,15 @@ int32_t Fam_Ops_Libfabric::atomic_fetch_min(Fam_Descriptor *descriptor,
 
 int64_t Fam_Ops_Libfabric::atomic_fetch_min(Fam_Descriptor *descriptor,
                                             uint64_t offset, int64_t value) {
+    Fam_Read_Cache_Write_Scope cacheScope(readCache, descriptor, offset,
+                                          sizeof(value));
     std::ostringstream message;
     uint64_t *memServerIds = descriptor->get_memserver_ids();
     size_t interleaveSize = descriptor->get_interleave_size();
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     int64_t old;
     if (usedMemsrvCnt == 1) {
         offset += (uint64_t)base_addr_list[0];
@@ -4539,13 +5430,15 @@ int64_t Fam_Ops_Libfabric::atomic_fetch_min(Fam_Descriptor *descriptor,
 
 uint32_t Fam_Ops_Libfabric::atomic_fetch_min(Fam_Descriptor *descriptor,
                                              uint64_t offset, uint32_t value) {
+    Fam_Read_Cache_Write_Scope cacheScope(readCache, descriptor, offset,
+                                          sizeof(value));
     std::ostringstream message;
     uint64_t *memServerIds = descriptor->get_memserver_ids();
     size_t interleaveSize = descriptor->get_interleave_size();
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     uint32_t old;
     if (usedMemsrvCnt == 1) {
         offset += (uint64_t)base_addr_list[0];
@@ -4583,13 +5476,15 @@ uint32_t Fam_Ops_Libfabric::atomic_fetch_min(Fam_Descriptor *descriptor,
 
 uint64_t Fam_Ops_Libfabric::atomic_fetch_min(Fam_Descriptor *descriptor,
                                              uint64_t offset, uint64_t value) {
+    Fam_Read_Cache_Write_Scope cacheScope(readCache, descriptor, offset,
+                                          sizeof(value));
     std::ostringstream message;
     uint64_t *memServerIds = descriptor->get_memserver_ids();
     size_t interleaveSize = descriptor->get_interleave_size();
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     uint64_t old;
     if (usedMemsrvCnt == 1) {
         offset += (uint64_t)base_addr_list[0];
@@ -4627,13 +5522,15 @@ uint64_t Fam_Ops_Libfabric::atomic_fetch_min(Fam_Descriptor *descriptor,
 
 float Fam_Ops_Libfabric::atomic_fetch_min(Fam_Descriptor *descriptor,
                                           uint64_t offset, float value) {
+    Fam_Read_Cache_Write_Scope cacheScope(readCache, descriptor, offset,
+                                          sizeof(value));
     std::ostringstream message;
     uint64_t *memServerIds = descriptor->get_memserver_ids();
     size_t interleaveSize = descriptor->get_interleave_size();
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     float old;
     if (usedMemsrvCnt == 1) {
         offset += (uint64_t)base_addr_list[0];
@@ -4671,13 +5568,15 @@ float Fam_Ops_Libfabric::atomic_fetch_min(Fam_Descriptor *descriptor,
 
 double Fam_Ops_Libfabric::atomic_fetch_min(Fam_Descriptor *descriptor,
                                            uint64_t offset, double value) {
+    Fam_Read_Cache_Write_Scope cacheScope(readCache, descriptor, offset,
+                                          sizeof(value));
     std::ostringstream message;
     uint64_t *memServerIds = descriptor->get_memserver_ids();
     size_t interleaveSize = descriptor->get_interleave_size();
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     double old;
     if (usedMemsrvCnt == 1) {
         offset += (uint64_t)base_addr_list[0];
@@ -4715,13 +5614,15 @@ double Fam_Ops_Libfabric::atomic_fetch_min(Fam_Descriptor *descriptor,
 
 int32_t Fam_Ops_Libfabric::atomic_fetch_max(Fam_Descriptor *descriptor,
                                             uint64_t offset, int32_t value) {
+    Fam_Read_Cache_Write_Scope cacheScope(readCache, descriptor, offset,
+                                          sizeof(value));
     std::ostringstream message;
     uint64_t *memServerIds = descriptor->get_memserver_ids();
     size_t interleaveSize = descriptor->get_interleave_size();
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     int32_t old;
     if (usedMemsrvCnt == 1) {
         offset += (uint64_t)base_addr_list[0];
@@ -4759,13 +5660,15 @@ int32_t Fam_Ops_Libfabric::atomic_fetch_max(Fam_Descriptor *descriptor,
 
 int64_t Fam_Ops_Libfabric::atomic_fetch_max(Fam_Descriptor *descriptor,
                                             uint64_t offset, int64_t value) {
+    Fam_Read_Cache_Write_Scope cacheScope(readCache, descriptor, offset,
+                                          sizeof(value));
     std::ostringstream message;
     uint64_t *memServerIds = descriptor->get_memserver_ids();
     size_t interleaveSize = descriptor->get_interleave_size();
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     int64_t old;
     if (usedMemsrvCnt == 1) {
         offset += (uint64_t)base_addr_list[0];
@@ -4803,13 +5706,15 @@ int64_t Fam_Ops_Libfabric::atomic_fetch_max(Fam_Descriptor *descriptor,
 
 uint32_t Fam_Ops_Libfabric::atomic_fetch_max(Fam_Descriptor *descriptor,
                                              uint64_t offset, uint32_t value) {
+    Fam_Read_Cache_Write_Scope cacheScope(readCache, descriptor, offset,
+                                          sizeof(value));
     std::ostringstream message;
     uint64_t *memServerIds = descriptor->get_memserver_ids();
     size_t interleaveSize = descriptor->get_interleave_size();
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     uint32_t old;
     if (usedMemsrvCnt == 1) {
         offset += (uint64_t)base_addr_list[0];
@@ -4847,13 +5752,15 @@ uint32_t Fam_Ops_Libfabric::atomic_fetch_max(Fam_Descriptor *descriptor,
 
 uint64_t Fam_Ops_Libfabric::atomic_fetch_max(Fam_Descriptor *descriptor,
                                              uint64_t offset, uint64_t value) {
+    Fam_Read_Cache_Write_Scope cacheScope(readCache, descriptor, offset,
+                                          sizeof(value));
     std::ostringstream message;
     uint64_t *memServerIds = descriptor->get_memserver_ids();
     size_t interleaveSize = descriptor->get_interleave_size();
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     uint64_t old;
     if (usedMemsrvCnt == 1) {
         offset += (uint64_t)base_addr_list[0];
@@ -4891,13 +5798,15 @@ uint64_t Fam_Ops_Libfabric::atomic_fetch_max(Fam_Descriptor *descriptor,
 
 float Fam_Ops_Libfabric::atomic_fetch_max(Fam_Descriptor *descriptor,
                                           uint64_t offset, float value) {
+    Fam_Read_Cache_Write_Scope cacheScope(readCache, descriptor, offset,
+                                          sizeof(value));
     std::ostringstream message;
     uint64_t *memServerIds = descriptor->get_memserver_ids();
     size_t interleaveSize = descriptor->get_interleave_size();
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     float old;
     if (usedMemsrvCnt == 1) {
         offset += (uint64_t)base_addr_list[0];
@@ -4935,13 +5844,15 @@ float Fam_Ops_Libfabric::atomic_fetch_max(Fam_Descriptor *descriptor,
 
 double Fam_Ops_Libfabric::atomic_fetch_max(Fam_Descriptor *descriptor,
                                            uint64_t offset, double value) {
+    Fam_Read_Cache_Write_Scope cacheScope(readCache, descriptor, offset,
+                                          sizeof(value));
     std::ostringstream message;
     uint64_t *memServerIds = descriptor->get_memserver_ids();
     size_t interleaveSize = descriptor->get_interleave_size();
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     double old;
     if (usedMemsrvCnt == 1) {
         offset += (uint64_t)base_addr_list[0];
@@ -4979,13 +5890,15 @@ double Fam_Ops_Libfabric::atomic_fetch_max(Fam_Descriptor *descriptor,
 
 uint32_t Fam_Ops_Libfabric::atomic_fetch_and(Fam_Descriptor *descriptor,
                                              uint64_t offset, uint32_t value) {
+    Fam_Read_Cache_Write_Scope cacheScope(readCache, descriptor, offset,
+                                          sizeof(value));
     std::ostringstream message;
     uint64_t *memServerIds = descriptor->get_memserver_ids();
     size_t interleaveSize = descriptor->get_interleave_size();
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     uint32_t old;
     if (usedMemsrvCnt == 1) {
         offset += (uint64_t)base_addr_list[0];
@@ -5023,13 +5936,15 @@ uint32_t Fam_Ops_Libfabric::atomic_fetch_and(Fam_Descriptor *descriptor,
 
 uint64_t Fam_Ops_Libfabric::atomic_fetch_and(Fam_Descriptor *descriptor,
                                              uint64_t offset, uint64_t value) {
+    Fam_Read_Cache_Write_Scope cacheScope(readCache, descriptor, offset,
+                                          sizeof(value));
     std::ostringstream message;
     uint64_t *memServerIds = descriptor->get_memserver_ids();
     size_t interleaveSize = descriptor->get_interleave_size();
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     uint64_t old;
     if (usedMemsrvCnt == 1) {
         offset += (uint64_t)base_addr_list[0];
@@ -5067,13 +5982,15 @@ uint64_t Fam_Ops_Libfabric::atomic_fetch_and(Fam_Descriptor *descriptor,
 
 uint32_t Fam_Ops_Libfabric::atomic_fetch_or(Fam_Descriptor *descriptor,
                                             uint64_t offset, uint32_t value) {
+    Fam_Read_Cache_Write_Scope cacheScope(readCache, descriptor, offset,
+                                          sizeof(value));
     std::ostringstream message;
     uint64_t *memServerIds = descriptor->get_memserver_ids();
     size_t interleaveSize = descriptor->get_interleave_size();
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     uint32_t old;
     if (usedMemsrvCnt == 1) {
         offset += (uint64_t)base_addr_list[0];
@@ -5111,13 +6028,15 @@ uint32_t Fam_Ops_Libfabric::atomic_fetch_or(Fam_Descriptor *descriptor,
 
 uint64_t Fam_Ops_Libfabric::atomic_fetch_or(Fam_Descriptor *descriptor,
                                             uint64_t offset, uint64_t value) {
+    Fam_Read_Cache_Write_Scope cacheScope(readCache, descriptor, offset,
+                                          sizeof(value));
     std::ostringstream message;
     uint64_t *memServerIds = descriptor->get_memserver_ids();
     size_t interleaveSize = descriptor->get_interleave_size();
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     uint64_t old;
     if (usedMemsrvCnt == 1) {
         offset += (uint64_t)base_addr_list[0];
@@ -5155,13 +6074,15 @@ uint64_t Fam_Ops_Libfabric::atomic_fetch_or(Fam_Descriptor *descriptor,
 
 uint32_t Fam_Ops_Libfabric::atomic_fetch_xor(Fam_Descriptor *descriptor,
                                              uint64_t offset, uint32_t value) {
+    Fam_Read_Cache_Write_Scope cacheScope(readCache, descriptor, offset,
+                                          sizeof(value));
     std::ostringstream message;
     uint64_t *memServerIds = descriptor->get_memserver_ids();
     size_t interleaveSize = descriptor->get_interleave_size();
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     uint32_t old;
     if (usedMemsrvCnt == 1) {
         offset += (uint64_t)base_addr_list[0];
@@ -5199,13 +6120,15 @@ uint32_t Fam_Ops_Libfabric::atomic_fetch_xor(Fam_Descriptor *descriptor,
 
 uint64_t Fam_Ops_Libfabric::atomic_fetch_xor(Fam_Descriptor *descriptor,
                                              uint64_t offset, uint64_t value) {
+    Fam_Read_Cache_Write_Scope cacheScope(readCache, descriptor, offset,
+                                          sizeof(value));
     std::ostringstream message;
     uint64_t *memServerIds = descriptor->get_memserver_ids();
     size_t interleaveSize = descriptor->get_interleave_size();
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
     uint64_t old;
     if (usedMemsrvCnt == 1) {
         offset += (uint64_t)base_addr_list[0];
@@ -5241,17 +6164,441 @@ uint64_t Fam_Ops_Libfabric::atomic_fetch_xor(Fam_Descriptor *descriptor,
     return old;
 }
 
+void Fam_Ops_Libfabric::atomic_batch(Fam_Atomic_Batch_Entry *entries,
+                                     uint64_t nEntries,
+                                     Fam_Atomic_Value *results) {
+    std::ostringstream message;
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
+    // Operands are copied, as subtract is issued as an add of the negated
+    // value. The vector is sized upfront so that pointers into it stay valid.
+    std::vector<Fam_Atomic_Value> operands(nEntries);
+    // Atomics of the batch grouped by the context they are issued on
+    std::map<Fam_Context *, std::vector<struct fam_atomic_io>> ioMap;
+
+    for (uint64_t i = 0; i < nEntries; i++) {
+        Fam_Descriptor *descriptor = entries[i].descriptor;
+        uint64_t *memServerIds = descriptor->get_memserver_ids();
+        size_t interleaveSize = descriptor->get_interleave_size();
+        uint64_t *keys = descriptor->get_keys();
+        uint64_t *base_addr_list = descriptor->get_base_address_list();
+        uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
+        uint64_t offset = entries[i].offset;
+        struct fam_atomic_io io;
+        size_t valueSize;
+
+        operands[i] = entries[i].value;
+        switch (entries[i].type) {
+        case FAM_ATOMIC_INT32:
+            io.datatype = FI_INT32;
+            valueSize = sizeof(int32_t);
+            if (entries[i].op == FAM_ATOMIC_SUBTRACT)
+                operands[i].int32Value = -operands[i].int32Value;
+            break;
+        case FAM_ATOMIC_INT64:
+            io.datatype = FI_INT64;
+            valueSize = sizeof(int64_t);
+            if (entries[i].op == FAM_ATOMIC_SUBTRACT)
+                operands[i].int64Value = -operands[i].int64Value;
+            break;
+        case FAM_ATOMIC_UINT32:
+            io.datatype = FI_UINT32;
+            valueSize = sizeof(uint32_t);
+            if (entries[i].op == FAM_ATOMIC_SUBTRACT)
+                operands[i].uint32Value = -operands[i].uint32Value;
+            break;
+        case FAM_ATOMIC_UINT64:
+            io.datatype = FI_UINT64;
+            valueSize = sizeof(uint64_t);
+            if (entries[i].op == FAM_ATOMIC_SUBTRACT)
+                operands[i].uint64Value = -operands[i].uint64Value;
+            break;
+        case FAM_ATOMIC_FLOAT:
+            io.datatype = FI_FLOAT;
+            valueSize = sizeof(float);
+            if (entries[i].op == FAM_ATOMIC_SUBTRACT)
+                operands[i].floatValue = -operands[i].floatValue;
+            break;
+        case FAM_ATOMIC_DOUBLE:
+            io.datatype = FI_DOUBLE;
+            valueSize = sizeof(double);
+            if (entries[i].op == FAM_ATOMIC_SUBTRACT)
+                operands[i].doubleValue = -operands[i].doubleValue;
+            break;
+        default:
+            THROW_ERR_MSG(Fam_InvalidOption_Exception, "Invalid atomic type");
+        }
+
+        switch (entries[i].op) {
+        case FAM_ATOMIC_SET:
+            io.op = FI_ATOMIC_WRITE;
+            break;
+        case FAM_ATOMIC_ADD:
+        case FAM_ATOMIC_SUBTRACT:
+            io.op = FI_SUM;
+            break;
+        case FAM_ATOMIC_MIN:
+            io.op = FI_MIN;
+            break;
+        case FAM_ATOMIC_MAX:
+            io.op = FI_MAX;
+            break;
+        case FAM_ATOMIC_AND:
+            io.op = FI_BAND;
+            break;
+        case FAM_ATOMIC_OR:
+            io.op = FI_BOR;
+            break;
+        case FAM_ATOMIC_XOR:
+            io.op = FI_BXOR;
+            break;
+        default:
+            THROW_ERR_MSG(Fam_InvalidOption_Exception, "Invalid atomic op");
+        }
+        if (results == NULL)
+            defer_invalidate(descriptor, offset, valueSize);
+        else
+            invalidate(descriptor, offset, valueSize);
+
+        uint64_t currentServerIndex = 0;
+        uint64_t currentFamPtr = offset;
+        if (usedMemsrvCnt > 1) {
+            // Current memory server Id index
+            currentServerIndex = ((offset / interleaveSize) % usedMemsrvCnt);
+            // Current remote location in FAM
+            currentFamPtr = (((offset / interleaveSize) - currentServerIndex) /
+                             usedMemsrvCnt) *
+                            interleaveSize;
+            // Displacement from the starting position of the interleave block
+            uint64_t displacement = offset % interleaveSize;
+            if (displacement + valueSize > interleaveSize) {
+                message << "Atmoic operation can not be performed, size of the "
+                           "value goes beyond interleave block";
+                THROW_ERR_MSG(Fam_Datapath_Exception, message.str().c_str());
+            }
+            currentFamPtr += displacement;
+        }
+
+        io.key = keys[currentServerIndex];
+        io.offset = (uint64_t)base_addr_list[currentServerIndex] + currentFamPtr;
+        io.value = (void *)&operands[i];
+        io.result = (results ? (void *)&results[i] : NULL);
+        io.fiAddr = (*fiAddr)[memServerIds[currentServerIndex]];
+        ioMap[get_context(descriptor)].push_back(io);
+    }
+
+    for (auto &ctxIo : ioMap)
+        fabric_atomic_batch(ctxIo.second, ctxIo.first, (results != NULL));
+    return;
+}
+
+void Fam_Ops_Libfabric::enable_atomic_combining(uint64_t maxEntries,
+                                                uint64_t flushUsec) {
+    atomicCombineMaxEntries = maxEntries;
+    atomicCombineFlushUsec = flushUsec;
+    if (atomicCombining)
+        return;
+    int ret = pthread_key_create(&combinerKey, NULL);
+    if (ret != 0) {
+        THROW_ERRNO_MSG(Fam_Datapath_Exception, get_fam_error(ret),
+                        "Failed to create atomic combining key");
+    }
+    (void)pthread_mutex_init(&combinerLock, NULL);
+    combiners = new std::vector<Fam_Atomic_Combiner *>();
+    atomicCombining = true;
+}
+
+Fam_Atomic_Combiner *Fam_Ops_Libfabric::get_combiner() {
+    Fam_Atomic_Combiner *combiner =
+        (Fam_Atomic_Combiner *)pthread_getspecific(combinerKey);
+    if (combiner == NULL) {
+        combiner = new Fam_Atomic_Combiner(atomicCombineMaxEntries,
+                                           atomicCombineFlushUsec);
+        // The table outlives its thread, so that updates left in it are
+        // issued by flush_combined_atomics(true) during finalize.
+        (void)pthread_mutex_lock(&combinerLock);
+        combiners->push_back(combiner);
+        (void)pthread_mutex_unlock(&combinerLock);
+        (void)pthread_setspecific(combinerKey, combiner);
+    }
+    return combiner;
+}
+
+// Must be called with the lock of the combiner held
+void Fam_Ops_Libfabric::flush_combiner(Fam_Atomic_Combiner *combiner) {
+    std::vector<Fam_Atomic_Batch_Entry> entries;
+    combiner->drain(entries);
+    if (!entries.empty())
+        atomic_batch(entries.data(), entries.size(), NULL);
+}
+
+void Fam_Ops_Libfabric::combine_atomic_value(Fam_Descriptor *descriptor,
+                                             uint64_t offset,
+                                             Fam_Atomic_Op op,
+                                             Fam_Atomic_Type type,
+                                             Fam_Atomic_Value value) {
+    Fam_Atomic_Combiner *combiner = get_combiner();
+    combiner->acquire_lock();
+    try {
+        if (!combiner->combine(descriptor, offset, op, type, value)) {
+            // A different atomic is pending at this location, issue it
+            // first so that the two are not reordered.
+            flush_combiner(combiner);
+            combiner->combine(descriptor, offset, op, type, value);
+        }
+        if (combiner->needs_flush())
+            flush_combiner(combiner);
+    } catch (...) {
+        combiner->release_lock();
+        throw;
+    }
+    combiner->release_lock();
+}
+
+void Fam_Ops_Libfabric::flush_combined_atomics(bool allThreads) {
+    if (!atomicCombining)
+        return;
+    if (!allThreads) {
+        Fam_Atomic_Combiner *combiner =
+            (Fam_Atomic_Combiner *)pthread_getspecific(combinerKey);
+        if (combiner == NULL)
+            return;
+        combiner->acquire_lock();
+        try {
+            flush_combiner(combiner);
+        } catch (...) {
+            combiner->release_lock();
+            throw;
+        }
+        combiner->release_lock();
+        return;
+    }
+
+    (void)pthread_mutex_lock(&combinerLock);
+    try {
+        for (auto combiner : *combiners) {
+            combiner->acquire_lock();
+            try {
+                flush_combiner(combiner);
+            } catch (...) {
+                combiner->release_lock();
+                throw;
+            }
+            combiner->release_lock();
+        }
+    } catch (...) {
+        (void)pthread_mutex_unlock(&combinerLock);
+        throw;
+    }
+    (void)pthread_mutex_unlock(&combinerLock);
+}
+
+void Fam_Ops_Libfabric::flush_combined_item(Fam_Descriptor *descriptor) {
+    if (writeCombining) {
+        // Blocking puts, so that the runs are written before the item goes
+        // away
+        std::vector<Fam_Write_Run> closed;
+        (void)pthread_mutex_lock(&writeCombinerLock);
+        try {
+            for (auto combiner : *writeCombiners) {
+                combiner->acquire_lock();
+                try {
+                    closed.clear();
+                    combiner->close_runs(descriptor, closed);
+                    issue_write_runs(closed, true);
+                } catch (...) {
+                    combiner->release_lock();
+                    throw;
+                }
+                combiner->release_lock();
+            }
+        } catch (...) {
+            (void)pthread_mutex_unlock(&writeCombinerLock);
+            throw;
+        }
+        (void)pthread_mutex_unlock(&writeCombinerLock);
+    }
+    if (!atomicCombining)
+        return;
+    std::vector<Fam_Atomic_Batch_Entry> entries;
+    (void)pthread_mutex_lock(&combinerLock);
+    for (auto combiner : *combiners) {
+        combiner->acquire_lock();
+        combiner->drain(descriptor, entries);
+        combiner->release_lock();
+    }
+    (void)pthread_mutex_unlock(&combinerLock);
+    if (entries.empty())
+        return;
+    // The atomics of other threads are issued on the context of this one
+    atomic_batch(entries.data(), entries.size(), NULL);
+    quiet_context(get_context());
+}
+
+void Fam_Ops_Libfabric::enable_write_combining(uint64_t bufSize,
+                                               uint64_t maxPut,
+                                               uint64_t maxBuffers) {
+    writeCombineBufSize = bufSize;
+    writeCombineMaxPut = (maxPut < bufSize) ? maxPut : bufSize;
+    writeCombineMaxBuffers = maxBuffers;
+    if (writeCombining)
+        return;
+    int ret = pthread_key_create(&writeCombinerKey, NULL);
+    if (ret != 0) {
+        THROW_ERRNO_MSG(Fam_Datapath_Exception, get_fam_error(ret),
+                        "Failed to create write combining key");
+    }
+    (void)pthread_mutex_init(&writeCombinerLock, NULL);
+    writeCombiners = new std::vector<Fam_Write_Combiner *>();
+    writeCombining = true;
+}
+
+Fam_Write_Combiner *Fam_Ops_Libfabric::get_write_combiner() {
+    Fam_Write_Combiner *combiner =
+        (Fam_Write_Combiner *)pthread_getspecific(writeCombinerKey);
+    if (combiner == NULL) {
+        combiner = new Fam_Write_Combiner(writeCombineBufSize,
+                                          writeCombineMaxBuffers);
+        // Like the atomic tables, the buffers outlive their thread so that
+        // runs left open are written by flush_combined_puts(true).
+        (void)pthread_mutex_lock(&writeCombinerLock);
+        writeCombiners->push_back(combiner);
+        (void)pthread_mutex_unlock(&writeCombinerLock);
+        (void)pthread_setspecific(writeCombinerKey, combiner);
+    }
+    return combiner;
+}
+
+// Must be called with the lock of the combiner that owns the runs held
+void Fam_Ops_Libfabric::issue_write_runs(std::vector<Fam_Write_Run> &runs,
+                                         bool wait) {
+    for (auto &run : runs) {
+        if (wait)
+            put_blocking(run.buf, run.descriptor, run.offset, run.nbytes);
+        else
+            write_nonblocking(run.buf, run.descriptor, run.offset, run.nbytes,
+                              NULL);
+    }
+}
+
+bool Fam_Ops_Libfabric::combine_put(void *local, Fam_Descriptor *descriptor,
+                                    uint64_t offset, uint64_t nbytes) {
+    Fam_Write_Combiner *combiner = get_write_combiner();
+    std::vector<Fam_Write_Run> closed;
+    bool combined = true;
+    combiner->acquire_lock();
+    try {
+        if (nbytes > writeCombineMaxPut ||
+            !combiner->extend_run(descriptor, offset, local, nbytes)) {
+            // The put is not adjacent to the open run of the item, which is
+            // issued first so that the two are not reordered.
+            combiner->close_runs(descriptor, closed);
+            if (nbytes > writeCombineMaxPut ||
+                !combiner->open_run(descriptor, offset, local, nbytes))
+                combined = false;
+        }
+        if (combined && combiner->is_full(descriptor))
+            combiner->close_runs(descriptor, closed);
+        issue_write_runs(closed, false);
+    } catch (...) {
+        combiner->release_lock();
+        throw;
+    }
+    combiner->release_lock();
+    return combined;
+}
+
+void Fam_Ops_Libfabric::flush_combined_puts(bool allThreads, bool wait) {
+    if (!writeCombining)
+        return;
+    std::vector<Fam_Write_Run> closed;
+    if (!allThreads) {
+        Fam_Write_Combiner *combiner =
+            (Fam_Write_Combiner *)pthread_getspecific(writeCombinerKey);
+        if (combiner == NULL)
+            return;
+        combiner->acquire_lock();
+        try {
+            combiner->close_runs(NULL, closed);
+            issue_write_runs(closed, false);
+        } catch (...) {
+            combiner->release_lock();
+            throw;
+        }
+        combiner->release_lock();
+        return;
+    }
+
+    // The runs of other threads are not covered by a quiet of the calling
+    // thread, so they are written with blocking puts unless the caller only
+    // orders them.
+    (void)pthread_mutex_lock(&writeCombinerLock);
+    try {
+        for (auto combiner : *writeCombiners) {
+            combiner->acquire_lock();
+            try {
+                closed.clear();
+                combiner->close_runs(NULL, closed);
+                issue_write_runs(closed, wait);
+            } catch (...) {
+                combiner->release_lock();
+                throw;
+            }
+            combiner->release_lock();
+        }
+    } catch (...) {
+        (void)pthread_mutex_unlock(&writeCombinerLock);
+        throw;
+    }
+    (void)pthread_mutex_unlock(&writeCombinerLock);
+}
+
+void Fam_Ops_Libfabric::quiet_shared_write_combiners() {
+    std::vector<Fam_Write_Run> closed;
+    std::vector<Fam_Write_Combiner *> &all = *writeCombiners;
+    size_t numLocked = 0;
+    (void)pthread_mutex_lock(&writeCombinerLock);
+    try {
+        for (auto combiner : all) {
+            combiner->acquire_lock();
+            numLocked++;
+            closed.clear();
+            combiner->close_runs(NULL, closed);
+            issue_write_runs(closed, false);
+        }
+        quiet_context(get_context());
+    } catch (...) {
+        for (size_t i = 0; i < numLocked; i++)
+            all[i]->release_lock();
+        (void)pthread_mutex_unlock(&writeCombinerLock);
+        throw;
+    }
+    for (auto combiner : all) {
+        combiner->recycle();
+        combiner->release_lock();
+    }
+    (void)pthread_mutex_unlock(&writeCombinerLock);
+}
+
 void Fam_Ops_Libfabric::abort(int status) FAM_OPS_UNIMPLEMENTED(void__);
 
 void Fam_Ops_Libfabric::atomic_set(Fam_Descriptor *descriptor, uint64_t offset,
                                    int128_t value) {
+    defer_invalidate(descriptor, offset, sizeof(value));
     std::ostringstream message;
     uint64_t *memServerIds = descriptor->get_memserver_ids();
     size_t interleaveSize = descriptor->get_interleave_size();
     uint64_t *keys = descriptor->get_keys();
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
+    if (nativeInt128Atomics) {
+        uint64_t key, famPtr;
+        fi_addr_t addr;
+        get_int128_location(descriptor, offset, &key, &famPtr, &addr);
+        fabric_atomic128(key, (void *)&value, NULL, NULL, famPtr,
+                         FI_ATOMIC_WRITE, addr, get_context(descriptor));
+        return;
+    }
     if (usedMemsrvCnt == 1) {
         offset += (uint64_t)base_addr_list[0];
         famAllocator->acquire_CAS_lock(descriptor, memServerIds[0]);
@@ -5310,7 +6657,16 @@ int128_t Fam_Ops_Libfabric::atomic_fetch_int128(Fam_Descriptor *descriptor,
     uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
 
     int128_t local;
-    std::vector<fi_addr_t> *fiAddr = get_fiAddrs();
+    Fam_Addr_Table *fiAddr = get_fiAddrs();
+    if (nativeInt128Atomics) {
+        uint64_t key, famPtr;
+        fi_addr_t addr;
+        int128_t operand = 0;
+        get_int128_location(descriptor, offset, &key, &famPtr, &addr);
+        fabric_atomic128(key, (void *)&operand, (void *)&local, NULL, famPtr,
+                         FI_ATOMIC_READ, addr, get_context(descriptor));
+        return local;
+    }
     if (usedMemsrvCnt == 1) {
         offset += (uint64_t)base_addr_list[0];
         famAllocator->acquire_CAS_lock(descriptor, memServerIds[0]);
@@ -5359,16 +6715,167 @@ int128_t Fam_Ops_Libfabric::atomic_fetch_int128(Fam_Descriptor *descriptor,
     return local;
 }
 
-void Fam_Ops_Libfabric::context_open(uint64_t contextId, Fam_Ops *famOpsObj) {
-    // Create a new fam_context
+void Fam_Ops_Libfabric::get_int128_location(Fam_Descriptor *descriptor,
+                                            uint64_t offset, uint64_t *key,
+                                            uint64_t *famPtr,
+                                            fi_addr_t *fiAddr) {
+    std::ostringstream message;
+    uint64_t *memServerIds = descriptor->get_memserver_ids();
+    size_t interleaveSize = descriptor->get_interleave_size();
+    uint64_t *keys = descriptor->get_keys();
+    uint64_t *base_addr_list = descriptor->get_base_address_list();
+    uint64_t usedMemsrvCnt = descriptor->get_used_memsrv_cnt();
+    Fam_Addr_Table *fiAddrList = get_fiAddrs();
+
+    if (usedMemsrvCnt == 1) {
+        *key = keys[0];
+        *famPtr = offset + (uint64_t)base_addr_list[0];
+        *fiAddr = (*fiAddrList)[memServerIds[0]];
+        return;
+    }
+    // Current memory server Id index
+    uint64_t currentServerIndex = ((offset / interleaveSize) % usedMemsrvCnt);
+    // Displacement from the starting position of the interleave block
+    uint64_t displacement = offset % interleaveSize;
+
+    if (displacement + sizeof(int128_t) > interleaveSize) {
+        message << "Atmoic operation can not be performed, size of the value "
+                   "goes beyond interleave block";
+        THROW_ERR_MSG(Fam_Datapath_Exception, message.str().c_str());
+    }
+
+    *key = keys[currentServerIndex];
+    *famPtr =
+        (((offset / interleaveSize) - currentServerIndex) / usedMemsrvCnt) *
+            interleaveSize +
+        (uint64_t)base_addr_list[currentServerIndex] + displacement;
+    *fiAddr = (*fiAddrList)[memServerIds[currentServerIndex]];
+}
+
+bool Fam_Ops_Libfabric::use_sg_offload(Fam_Descriptor *descriptor,
+                                       uint64_t nElements,
+                                       uint64_t elementSize, bool indexed) {
+    if (!sgOffload || descriptor->get_used_memsrv_cnt() != 1)
+        return false;
+    if (nElements < sgOffloadMinElements || elementSize == 0 ||
+        elementSize > sgOffloadMaxElementSize)
+        return false;
+    // The element index travels in the RPC request
+    if (indexed &&
+        nElements > FAM_SG_OFFLOAD_MAX_INDEX_SIZE / sizeof(uint64_t))
+        return false;
+    // The packed elements move as a single message
+    return nElements <= fabric_max_msg_size / elementSize;
+}
+
+void Fam_Ops_Libfabric::sg_offload(void *local, Fam_Descriptor *descriptor,
+                                   uint64_t nElements, uint64_t firstElement,
+                                   uint64_t stride, uint64_t *elementIndex,
+                                   uint64_t elementSize, bool isScatter) {
+    std::ostringstream message;
+    struct fid_ep *ep = get_context(descriptor)->get_ep();
+    size_t nbytes = nElements * elementSize;
+
+    size_t addrSize = 0;
+    int ret = fabric_getname_len(ep, &addrSize);
+    if (ret < 0) {
+        message << "Fam libfabric fabric_getname_len failed: "
+                << fabric_strerror(ret);
+        THROW_ERR_MSG(Fam_Datapath_Exception, message.str().c_str());
+    }
+    std::vector<char> nodeAddr(addrSize);
+    ret = fabric_getname(ep, nodeAddr.data(), &addrSize);
+    if (ret < 0) {
+        message << "Fam libfabric fabric_getname failed: "
+                << fabric_strerror(ret);
+        THROW_ERR_MSG(Fam_Datapath_Exception, message.str().c_str());
+    }
+
+    // The memory server writes a gather into the buffer and reads a scatter
+    // from it
+    fid_mr *mr = NULL;
+    uint64_t key = fabric_alloc_mr_key();
+    ret = fabric_register_mr(local, nbytes, &key, domain, ep, provider,
+                             !isScatter, mr);
+    if (ret < 0) {
+        message << "Fam libfabric fabric_register_mr failed: "
+                << fabric_strerror(ret);
+        THROW_ERR_MSG(Fam_Datapath_Exception, message.str().c_str());
+    }
+
+    // RMA addresses are virtual addresses or offsets into the region
+    uint64_t clientBaseAddr = 0;
+    if (fi->domain_attr->mr_mode & FI_MR_VIRT_ADDR)
+        clientBaseAddr = (uint64_t)local;
+
+    try {
+        if (isScatter)
+            famAllocator->scatter_packed(
+                descriptor, nElements, firstElement, stride, elementIndex,
+                elementSize, key, clientBaseAddr, nodeAddr.data(),
+                (uint32_t)addrSize);
+        else
+            famAllocator->gather_packed(
+                descriptor, nElements, firstElement, stride, elementIndex,
+                elementSize, key, clientBaseAddr, nodeAddr.data(),
+                (uint32_t)addrSize);
+    } catch (...) {
+        fabric_deregister_mr(mr);
+        throw;
+    }
+    fabric_deregister_mr(mr);
+}
+
+void Fam_Ops_Libfabric::configure_context(Fam_Context *ctx) {
+    ctx->set_poll_mode(pollMode, pollSpinCount, pollMaxSleepUsec);
+    if (bounceCount > 0)
+        ctx->init_bounce_pool(domain,
+                              std::max(fi->tx_attr->rma_iov_limit, (size_t)1),
+                              bounceMaxSize, (uint32_t)bounceCount);
+}
+
+void Fam_Ops_Libfabric::open_shared_contexts() {
+    // Providers without shared contexts keep a transmit and a receive
+    // context per endpoint, as when the option is off
+    struct fi_tx_attr txAttr = *fi->tx_attr;
+    // Same completion semantics as the endpoints of Fam_Context
+    txAttr.op_flags = FI_DELIVERY_COMPLETE;
+    txAttr.mode = 0;
+    if (fi->domain_attr->max_ep_stx_ctx > 0 &&
+        fi_stx_context(domain, &txAttr, &stx, NULL) < 0)
+        stx = NULL;
+    if (fi->domain_attr->max_ep_srx_ctx > 0 &&
+        fi_srx_context(domain, fi->rx_attr, &srx, NULL) < 0)
+        srx = NULL;
+}
+
+Fam_Context *Fam_Ops_Libfabric::create_context() {
     std::ostringstream message;
-    Fam_Context *ctx = new Fam_Context(fi, domain, famThreadModel);
+    Fam_Context *ctx = new Fam_Context(fi, domain, famThreadModel, stx, srx);
+    configure_context(ctx);
     int ret = fabric_enable_bind_ep(fi, av, eq, ctx->get_ep());
     if (ret < 0) {
+        delete ctx;
         message << "Fam libfabric fabric_enable_bind_ep failed: "
                 << fabric_strerror(ret);
         THROW_ERR_MSG(Fam_Datapath_Exception, message.str().c_str());
     }
+    return ctx;
+}
+
+void Fam_Ops_Libfabric::context_open(uint64_t contextId, Fam_Ops *famOpsObj) {
+    Fam_Context *ctx = NULL;
+    // ctx mutex lock
+    (void)pthread_mutex_lock(&ctxLock);
+    if (ctxPool != NULL && !ctxPool->empty()) {
+        ctx = ctxPool->back();
+        ctxPool->pop_back();
+    }
+    // ctx mutex unlock
+    (void)pthread_mutex_unlock(&ctxLock);
+    // Create a new fam_context if none is pooled
+    if (ctx == NULL)
+        ctx = create_context();
 
     // ctx mutex lock
     (void)pthread_mutex_lock(&ctxLock);
@@ -5389,17 +6896,121 @@ void Fam_Ops_Libfabric::context_close(uint64_t contextId) {
         // ctx mutex unlock
         (void)pthread_mutex_unlock(&ctxLock);
         THROW_ERR_MSG(Fam_Datapath_Exception, "Context not found");
-    } else {
-        // Delete context : Need to validate this task.
-        delete obj->second;
-        // Remove item from map
-        defContexts->erase(obj);
+    }
+    Fam_Context *ctx = obj->second;
+    // Remove item from map
+    defContexts->erase(obj);
+    // ctx mutex unlock
+    (void)pthread_mutex_unlock(&ctxLock);
+
+    // Complete the IOs still outstanding on the context, then recycle it if
+    // the pool has room for it, otherwise delete it
+    bool recycle = false;
+    try {
+        fabric_quiet(ctx);
+        recycle = (ctxPool != NULL);
+    } catch (...) {
+        // The failed IOs belong to the closed context, do not hand its
+        // errors to the next owner
+    }
+    if (recycle) {
+        ctx->unregister_heap();
+        // ctx mutex lock
+        (void)pthread_mutex_lock(&ctxLock);
+        if (ctxPool->size() < ctxPoolSize) {
+            ctxPool->push_back(ctx);
+            ctx = NULL;
+        }
         // ctx mutex unlock
         (void)pthread_mutex_unlock(&ctxLock);
     }
+    delete ctx;
     return;
 }
+Fam_Context *Fam_Ops_Libfabric::open_thread_context() {
+    std::ostringstream message;
+    Fam_Thread_Context *threadCtx = NULL;
+
+    // ctx mutex lock
+    (void)pthread_mutex_lock(&ctxLock);
+    if (!freeThreadCtxList->empty()) {
+        threadCtx = freeThreadCtxList->back();
+        freeThreadCtxList->pop_back();
+    }
+    // ctx mutex unlock
+    (void)pthread_mutex_unlock(&ctxLock);
+
+    if (threadCtx == NULL) {
+        // Only the owning thread issues IOs on the context, so its datapath
+        // takes no lock
+        Fam_Context *ctx =
+            new Fam_Context(fi, domain, FAM_THREAD_SERIALIZE, stx, srx);
+        configure_context(ctx);
+        int ret = fabric_enable_bind_ep(fi, av, eq, ctx->get_ep());
+        if (ret < 0) {
+            delete ctx;
+            message << "Fam libfabric fabric_enable_bind_ep failed: "
+                    << fabric_strerror(ret);
+            THROW_ERR_MSG(Fam_Datapath_Exception, message.str().c_str());
+        }
+        threadCtx = new Fam_Thread_Context();
+        threadCtx->famOps = this;
+        threadCtx->famCtx = ctx;
+
+        // ctx mutex lock
+        (void)pthread_mutex_lock(&ctxLock);
+        try {
+            if (heapBase != NULL)
+                ctx->register_heap(heapBase, heapLen, domain,
+                                   fabric_iov_limit);
+        } catch (...) {
+            // ctx mutex unlock
+            (void)pthread_mutex_unlock(&ctxLock);
+            delete threadCtx;
+            delete ctx;
+            throw;
+        }
+        defContexts->insert({get_next_ctxId(1), ctx});
+        threadCtxList->push_back(threadCtx);
+        // ctx mutex unlock
+        (void)pthread_mutex_unlock(&ctxLock);
+    }
+
+    (void)pthread_setspecific(threadCtxKey, threadCtx);
+    return threadCtx->famCtx;
+}
+
+void Fam_Ops_Libfabric::release_thread_context(Fam_Thread_Context *threadCtx) {
+    try {
+        fabric_quiet(threadCtx->famCtx);
+    } catch (...) {
+        // The thread has exited, failures of its IOs can not be reported
+    }
+    // ctx mutex lock
+    (void)pthread_mutex_lock(&ctxLock);
+    freeThreadCtxList->push_back(threadCtx);
+    // ctx mutex unlock
+    (void)pthread_mutex_unlock(&ctxLock);
+}
+
 void Fam_Ops_Libfabric::register_heap(void *base, size_t len) {
+    if (threadContexts) {
+        // Register on the contexts already opened, and remember the heap for
+        // the contexts opened later
+        (void)pthread_mutex_lock(&ctxLock);
+        heapBase = base;
+        heapLen = len;
+        try {
+            for (auto threadCtx : *threadCtxList)
+                threadCtx->famCtx->register_heap(base, len, domain,
+                                                 fabric_iov_limit);
+        } catch (...) {
+            (void)pthread_mutex_unlock(&ctxLock);
+            throw;
+        }
+        (void)pthread_mutex_unlock(&ctxLock);
+        return;
+    }
     get_context()->register_heap(base, len, domain, fabric_iov_limit);
 }
 } // namespace openfam
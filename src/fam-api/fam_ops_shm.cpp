@@ -186,6 +186,22 @@ int Fam_Ops_SHM::get_blocking(void *local, Fam_Descriptor *descriptor,
     return FAM_SUCCESS;
 }
 
+int Fam_Ops_SHM::get_batch(Fam_Batch_Entry *entries, uint64_t nEntries) {
+    for (uint64_t i = 0; i < nEntries; i++) {
+        get_blocking(entries[i].local, entries[i].descriptor, entries[i].offset,
+                     entries[i].nbytes);
+    }
+    return FAM_SUCCESS;
+}
+
+int Fam_Ops_SHM::put_batch(Fam_Batch_Entry *entries, uint64_t nEntries) {
+    for (uint64_t i = 0; i < nEntries; i++) {
+        put_blocking(entries[i].local, entries[i].descriptor, entries[i].offset,
+                     entries[i].nbytes);
+    }
+    return FAM_SUCCESS;
+}
+
 int Fam_Ops_SHM::gather_blocking(void *local, Fam_Descriptor *descriptor,
                                  uint64_t nElements, uint64_t firstElement,
                                  uint64_t stride, uint64_t elementSize) {
@@ -361,7 +377,14 @@ int Fam_Ops_SHM::scatter_blocking(void *local, Fam_Descriptor *descriptor,
 }
 
 void Fam_Ops_SHM::put_nonblocking(void *local, Fam_Descriptor *descriptor,
-                                  uint64_t offset, uint64_t nbytes) {
+                                  uint64_t offset, uint64_t nbytes,
+                                  Fam_Request *request) {
+    // Copies to shared memory are done in place, so a request is completed
+    // before returning and there is nothing left to test or wait for
+    if (request != NULL) {
+        put_blocking(local, descriptor, offset, nbytes);
+        return;
+    }
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t itemSize = descriptor->get_size();
     uint64_t *keys = descriptor->get_keys();
@@ -385,7 +408,12 @@ void Fam_Ops_SHM::put_nonblocking(void *local, Fam_Descriptor *descriptor,
 }
 
 void Fam_Ops_SHM::get_nonblocking(void *local, Fam_Descriptor *descriptor,
-                                  uint64_t offset, uint64_t nbytes) {
+                                  uint64_t offset, uint64_t nbytes,
+                                  Fam_Request *request) {
+    if (request != NULL) {
+        get_blocking(local, descriptor, offset, nbytes);
+        return;
+    }
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t itemSize = descriptor->get_size();
     uint64_t *keys = descriptor->get_keys();
@@ -411,7 +439,13 @@ void Fam_Ops_SHM::get_nonblocking(void *local, Fam_Descriptor *descriptor,
 
 void Fam_Ops_SHM::gather_nonblocking(void *local, Fam_Descriptor *descriptor,
                                      uint64_t nElements, uint64_t firstElement,
-                                     uint64_t stride, uint64_t elementSize) {
+                                     uint64_t stride, uint64_t elementSize,
+                                     Fam_Request *request) {
+    if (request != NULL) {
+        gather_blocking(local, descriptor, nElements, firstElement, stride,
+                        elementSize);
+        return;
+    }
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t itemSize = descriptor->get_size();
     uint64_t *keys = descriptor->get_keys();
@@ -446,7 +480,13 @@ void Fam_Ops_SHM::gather_nonblocking(void *local, Fam_Descriptor *descriptor,
 
 void Fam_Ops_SHM::gather_nonblocking(void *local, Fam_Descriptor *descriptor,
                                      uint64_t nElements, uint64_t *elementIndex,
-                                     uint64_t elementSize) {
+                                     uint64_t elementSize,
+                                     Fam_Request *request) {
+    if (request != NULL) {
+        gather_blocking(local, descriptor, nElements, elementIndex,
+                        elementSize);
+        return;
+    }
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t itemSize = descriptor->get_size();
     uint64_t *keys = descriptor->get_keys();
@@ -480,7 +520,13 @@ void Fam_Ops_SHM::gather_nonblocking(void *local, Fam_Descriptor *descriptor,
 
 void Fam_Ops_SHM::scatter_nonblocking(void *local, Fam_Descriptor *descriptor,
                                       uint64_t nElements, uint64_t firstElement,
-                                      uint64_t stride, uint64_t elementSize) {
+                                      uint64_t stride, uint64_t elementSize,
+                                      Fam_Request *request) {
+    if (request != NULL) {
+        scatter_blocking(local, descriptor, nElements, firstElement, stride,
+                         elementSize);
+        return;
+    }
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t itemSize = descriptor->get_size();
     uint64_t *keys = descriptor->get_keys();
@@ -515,7 +561,13 @@ void Fam_Ops_SHM::scatter_nonblocking(void *local, Fam_Descriptor *descriptor,
 void Fam_Ops_SHM::scatter_nonblocking(void *local, Fam_Descriptor *descriptor,
                                       uint64_t nElements,
                                       uint64_t *elementIndex,
-                                      uint64_t elementSize) {
+                                      uint64_t elementSize,
+                                      Fam_Request *request) {
+    if (request != NULL) {
+        scatter_blocking(local, descriptor, nElements, elementIndex,
+                         elementSize);
+        return;
+    }
     uint64_t *base_addr_list = descriptor->get_base_address_list();
     uint64_t itemSize = descriptor->get_size();
     uint64_t *keys = descriptor->get_keys();
@@ -546,6 +598,21 @@ void Fam_Ops_SHM::scatter_nonblocking(void *local, Fam_Descriptor *descriptor,
     return;
 }
 
+bool Fam_Ops_SHM::test_request(Fam_Request *request) { return true; }
+
+void Fam_Ops_SHM::wait_request(Fam_Request *request) { return; }
+
+uint64_t Fam_Ops_SHM::wait_any_request(Fam_Request **requests, uint64_t count,
+                                       uint64_t *failed) {
+    for (uint64_t i = 0; i < count; i++) {
+        if (requests[i] != NULL)
+            return i;
+    }
+    return count;
+}
+
+void Fam_Ops_SHM::drain_request(Fam_Request *request) { return; }
+
 void Fam_Ops_SHM::check_progress(Fam_Region_Descriptor *descriptor) {
 
        return;
@@ -2280,6 +2347,124 @@ uint64_t Fam_Ops_SHM::atomic_fetch_xor(Fam_Descriptor *descriptor,
     return result;
 }
 
+// Issue one arithmetic atomic of a batch with the per-type atomic routine
+template <typename T>
+static T shm_batch_arith_atomic(Fam_Ops_SHM *famOps,
+                                Fam_Atomic_Batch_Entry *entry, T value,
+                                bool fetch) {
+    Fam_Descriptor *descriptor = entry->descriptor;
+    uint64_t offset = entry->offset;
+    T old = 0;
+    switch (entry->op) {
+    case FAM_ATOMIC_SET:
+        if (fetch)
+            old = famOps->swap(descriptor, offset, value);
+        else
+            famOps->atomic_set(descriptor, offset, value);
+        break;
+    case FAM_ATOMIC_ADD:
+        if (fetch)
+            old = famOps->atomic_fetch_add(descriptor, offset, value);
+        else
+            famOps->atomic_add(descriptor, offset, value);
+        break;
+    case FAM_ATOMIC_SUBTRACT:
+        if (fetch)
+            old = famOps->atomic_fetch_subtract(descriptor, offset, value);
+        else
+            famOps->atomic_subtract(descriptor, offset, value);
+        break;
+    case FAM_ATOMIC_MIN:
+        if (fetch)
+            old = famOps->atomic_fetch_min(descriptor, offset, value);
+        else
+            famOps->atomic_min(descriptor, offset, value);
+        break;
+    case FAM_ATOMIC_MAX:
+        if (fetch)
+            old = famOps->atomic_fetch_max(descriptor, offset, value);
+        else
+            famOps->atomic_max(descriptor, offset, value);
+        break;
+    default:
+        THROW_ERR_MSG(Fam_InvalidOption_Exception, "Invalid atomic op");
+    }
+    return old;
+}
+
+// Issue one atomic of a batch on an unsigned type, which also supports the
+// logical operations
+template <typename T>
+static T shm_batch_unsigned_atomic(Fam_Ops_SHM *famOps,
+                                   Fam_Atomic_Batch_Entry *entry, T value,
+                                   bool fetch) {
+    Fam_Descriptor *descriptor = entry->descriptor;
+    uint64_t offset = entry->offset;
+    T old = 0;
+    switch (entry->op) {
+    case FAM_ATOMIC_AND:
+        if (fetch)
+            old = famOps->atomic_fetch_and(descriptor, offset, value);
+        else
+            famOps->atomic_and(descriptor, offset, value);
+        break;
+    case FAM_ATOMIC_OR:
+        if (fetch)
+            old = famOps->atomic_fetch_or(descriptor, offset, value);
+        else
+            famOps->atomic_or(descriptor, offset, value);
+        break;
+    case FAM_ATOMIC_XOR:
+        if (fetch)
+            old = famOps->atomic_fetch_xor(descriptor, offset, value);
+        else
+            famOps->atomic_xor(descriptor, offset, value);
+        break;
+    default:
+        old = shm_batch_arith_atomic<T>(famOps, entry, value, fetch);
+    }
+    return old;
+}
+
+void Fam_Ops_SHM::atomic_batch(Fam_Atomic_Batch_Entry *entries,
+                               uint64_t nEntries, Fam_Atomic_Value *results) {
+    bool fetch = (results != NULL);
+    for (uint64_t i = 0; i < nEntries; i++) {
+        Fam_Atomic_Value *value = &entries[i].value;
+        Fam_Atomic_Value old;
+        switch (entries[i].type) {
+        case FAM_ATOMIC_INT32:
+            old.int32Value = shm_batch_arith_atomic<int32_t>(
+                this, &entries[i], value->int32Value, fetch);
+            break;
+        case FAM_ATOMIC_INT64:
+            old.int64Value = shm_batch_arith_atomic<int64_t>(
+                this, &entries[i], value->int64Value, fetch);
+            break;
+        case FAM_ATOMIC_UINT32:
+            old.uint32Value = shm_batch_unsigned_atomic<uint32_t>(
+                this, &entries[i], value->uint32Value, fetch);
+            break;
+        case FAM_ATOMIC_UINT64:
+            old.uint64Value = shm_batch_unsigned_atomic<uint64_t>(
+                this, &entries[i], value->uint64Value, fetch);
+            break;
+        case FAM_ATOMIC_FLOAT:
+            old.floatValue = shm_batch_arith_atomic<float>(
+                this, &entries[i], value->floatValue, fetch);
+            break;
+        case FAM_ATOMIC_DOUBLE:
+            old.doubleValue = shm_batch_arith_atomic<double>(
+                this, &entries[i], value->doubleValue, fetch);
+            break;
+        default:
+            THROW_ERR_MSG(Fam_InvalidOption_Exception, "Invalid atomic type");
+        }
+        if (fetch)
+            results[i] = old;
+    }
+}
+
 void Fam_Ops_SHM::context_open(uint64_t contextId, Fam_Ops *famOpsObj) {
     return;
 }
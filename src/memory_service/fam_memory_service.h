@@ -148,6 +148,24 @@ class Fam_Memory_Service {
         const void *elementIndex, uint64_t elementSize, uint64_t key,
         uint64_t srcBaseAddr, const char *nodeAddr, uint32_t nodeAddrSize) = 0;
 
+    // Packed gather/scatter: elements are packed into (or unpacked from) a
+    // contiguous buffer on the memory server, which is moved to (or from)
+    // the client buffer with a single RDMA. If elementIndex is NULL, the
+    // elements are described by firstElement and stride.
+    virtual void gather_packed(uint64_t regionId, uint64_t offset,
+                               uint64_t nElements, uint64_t firstElement,
+                               uint64_t stride, const uint64_t *elementIndex,
+                               uint64_t elementSize, uint64_t key,
+                               uint64_t clientBaseAddr, const char *nodeAddr,
+                               uint32_t nodeAddrSize) = 0;
+
+    virtual void scatter_packed(uint64_t regionId, uint64_t offset,
+                                uint64_t nElements, uint64_t firstElement,
+                                uint64_t stride, const uint64_t *elementIndex,
+                                uint64_t elementSize, uint64_t key,
+                                uint64_t clientBaseAddr, const char *nodeAddr,
+                                uint32_t nodeAddrSize) = 0;
+
     virtual void update_memserver_addrlist(void *memServerInfoBuffer,
                                            size_t memServerInfoSize,
                                            uint64_t memoryServerCount) = 0;
@@ -732,6 +732,64 @@ void Fam_Memory_Service_Client::gather_indexed_atomic(
     MEMORY_SERVICE_CLIENT_PROFILE_END_OPS(mem_client_gather_indexed_atomic);
 }
 
+void Fam_Memory_Service_Client::gather_packed(
+    uint64_t regionId, uint64_t offset, uint64_t nElements,
+    uint64_t firstElement, uint64_t stride, const uint64_t *elementIndex,
+    uint64_t elementSize, uint64_t key, uint64_t clientBaseAddr,
+    const char *nodeAddr, uint32_t nodeAddrSize) {
+    Fam_Memory_SG_Packed_Request req;
+    Fam_Memory_Service_Response res;
+    ::grpc::ClientContext ctx;
+
+    MEMORY_SERVICE_CLIENT_PROFILE_START_OPS()
+    req.set_regionid(regionId & REGIONID_MASK);
+    req.set_offset(offset);
+    req.set_nelements(nElements);
+    req.set_firstelement(firstElement);
+    req.set_stride(stride);
+    if (elementIndex)
+        req.set_elementindex(elementIndex, nElements * sizeof(uint64_t));
+    req.set_elementsize(elementSize);
+    req.set_key(key);
+    req.set_client_base_addr(clientBaseAddr);
+    req.set_nodeaddr(nodeAddr, nodeAddrSize);
+    req.set_nodeaddrsize(nodeAddrSize);
+
+    ::grpc::Status status = stub->gather_packed(&ctx, req, &res);
+
+    STATUS_CHECK(Memory_Service_Exception)
+    MEMORY_SERVICE_CLIENT_PROFILE_END_OPS(mem_client_gather_packed);
+}
+
+void Fam_Memory_Service_Client::scatter_packed(
+    uint64_t regionId, uint64_t offset, uint64_t nElements,
+    uint64_t firstElement, uint64_t stride, const uint64_t *elementIndex,
+    uint64_t elementSize, uint64_t key, uint64_t clientBaseAddr,
+    const char *nodeAddr, uint32_t nodeAddrSize) {
+    Fam_Memory_SG_Packed_Request req;
+    Fam_Memory_Service_Response res;
+    ::grpc::ClientContext ctx;
+
+    MEMORY_SERVICE_CLIENT_PROFILE_START_OPS()
+    req.set_regionid(regionId & REGIONID_MASK);
+    req.set_offset(offset);
+    req.set_nelements(nElements);
+    req.set_firstelement(firstElement);
+    req.set_stride(stride);
+    if (elementIndex)
+        req.set_elementindex(elementIndex, nElements * sizeof(uint64_t));
+    req.set_elementsize(elementSize);
+    req.set_key(key);
+    req.set_client_base_addr(clientBaseAddr);
+    req.set_nodeaddr(nodeAddr, nodeAddrSize);
+    req.set_nodeaddrsize(nodeAddrSize);
+
+    ::grpc::Status status = stub->scatter_packed(&ctx, req, &res);
+
+    STATUS_CHECK(Memory_Service_Exception)
+    MEMORY_SERVICE_CLIENT_PROFILE_END_OPS(mem_client_scatter_packed);
+}
+
 void Fam_Memory_Service_Client::update_memserver_addrlist(
     void *memServerInfoBuffer, size_t memServerInfoSize,
     uint64_t memoryServerCount) {
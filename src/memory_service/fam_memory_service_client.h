@@ -145,6 +145,18 @@ class Fam_Memory_Service_Client : public Fam_Memory_Service {
                                uint64_t srcBaseAddr, const char *nodeAddr,
                                uint32_t nodeAddrSize);
 
+    void gather_packed(uint64_t regionId, uint64_t offset, uint64_t nElements,
+                       uint64_t firstElement, uint64_t stride,
+                       const uint64_t *elementIndex, uint64_t elementSize,
+                       uint64_t key, uint64_t clientBaseAddr,
+                       const char *nodeAddr, uint32_t nodeAddrSize);
+
+    void scatter_packed(uint64_t regionId, uint64_t offset, uint64_t nElements,
+                        uint64_t firstElement, uint64_t stride,
+                        const uint64_t *elementIndex, uint64_t elementSize,
+                        uint64_t key, uint64_t clientBaseAddr,
+                        const char *nodeAddr, uint32_t nodeAddrSize);
+
     void update_memserver_addrlist(void *memServerInfoBuffer,
                                    size_t memServerInfoSize,
                                    uint64_t memoryServerCount);
@@ -129,6 +129,9 @@ Fam_Memory_Service_Direct::Fam_Memory_Service_Direct(uint64_t memserver_id,
     rpc_interface = (char *)strdup(config_options["Memservers:rpc_interface"].c_str());
     std::string addr = rpc_interface.substr(0, rpc_interface.find(':'));
     if_device = (char *)strdup(config_options["Memservers:if_device"].c_str());
+    rails = config_options["Memservers:rails"];
+    railAddrName = NULL;
+    railAddrNameLen = 0;
     libfabricProvider = (char *)strdup(config_options["provider"].c_str());
 
     int num_delayed_free_Threads =
@@ -161,6 +164,8 @@ Fam_Memory_Service_Direct::Fam_Memory_Service_Direct(uint64_t memserver_id,
                           libfabricProvider.c_str(), if_device.c_str());
         famResourceManager = new Fam_Server_Resource_Manager(
             allocator, enableResourceRelease, false, famOps);
+        for (auto railOp : railOps)
+            famResourceManager->add_rail(railOp);
     }
 
     for (int i = 0; i < CAS_LOCK_CNT; i++) {
@@ -224,6 +229,55 @@ void Fam_Memory_Service_Direct::fabric_initialize(const char *name,
     else
         isBaseRequire = false;
     famOpsLibfabricQ = famOps;
+
+    if (!rails.empty())
+        open_rails();
+}
+
+void Fam_Memory_Service_Direct::open_rails() {
+    ostringstream message;
+    std::vector<std::pair<void *, size_t>> railAddrs;
+    std::istringstream railList(rails);
+    std::string rail;
+    while (std::getline(railList, rail, ',')) {
+        size_t sep = rail.rfind(':');
+        if (sep == std::string::npos) {
+            message << "Invalid rail in the config file, expected "
+                       "address:port: "
+                    << rail;
+            throw Memory_Service_Exception(OPS_INIT_FAILED,
+                                           message.str().c_str());
+        }
+        std::string railAddr = rail.substr(0, sep);
+        std::string railPort = rail.substr(sep + 1);
+        Fam_Ops_Libfabric *railOp = new Fam_Ops_Libfabric(
+            true, libfabricProvider.c_str(), "", FAM_THREAD_MULTIPLE, NULL,
+            FAM_CONTEXT_DEFAULT, railAddr.c_str(), railPort.c_str());
+        railOp->set_rail_address(railAddr.c_str());
+        railOps.push_back(railOp);
+        if (railOp->initialize() < 0) {
+            message << "famOps initialization failed for rail " << rail;
+            throw Memory_Service_Exception(OPS_INIT_FAILED,
+                                           message.str().c_str());
+        }
+        // Memory is registered on every rail with the key of the primary
+        // interface, which clients find in the descriptors
+        if (railOp->get_fi()->domain_attr->mr_mode & FI_MR_PROV_KEY) {
+            message << "Memory server rails need a provider accepting "
+                       "requested memory keys";
+            throw Memory_Service_Exception(OPS_INIT_FAILED,
+                                           message.str().c_str());
+        }
+        railAddrs.push_back(
+            std::make_pair(railOp->get_addr(), railOp->get_addr_size()));
+    }
+    railAddrName = fabric_pack_rail_addrs(famOps->get_addr(),
+                                          famOps->get_addr_size(), railAddrs,
+                                          &railAddrNameLen);
+    if (railAddrName == NULL) {
+        message << "Memory server rails have addresses of different lengths";
+        throw Memory_Service_Exception(OPS_INIT_FAILED, message.str().c_str());
+    }
 }
 
 void Fam_Memory_Service_Direct::fabric_finalize() {
@@ -232,6 +286,14 @@ void Fam_Memory_Service_Direct::fabric_finalize() {
         progressThread.join();
     }
 
+    for (auto railOp : railOps) {
+        railOp->finalize();
+        delete railOp;
+    }
+    railOps.clear();
+    free(railAddrName);
+    railAddrName = NULL;
+
     famOps->finalize();
     delete famOps;
 }
@@ -239,9 +301,11 @@ void Fam_Memory_Service_Direct::fabric_finalize() {
 void Fam_Memory_Service_Direct::progress_thread() {
     if (libfabricProgressMode == FI_PROGRESS_MANUAL) {
         while (1) {
-            if (!haltProgress)
+            if (!haltProgress) {
                 famOps->check_progress();
-            else
+                for (auto railOp : railOps)
+                    railOp->check_progress();
+            } else
                 break;
         }
     }
@@ -431,7 +495,7 @@ void Fam_Memory_Service_Direct::copy(
         return;
     Fam_Context *famCtx = famOps->get_defaultCtx(uint64_t(0));
 
-    std::vector<fi_addr_t> *fiAddr = famOps->get_fiAddrs();
+    Fam_Addr_Table *fiAddr = famOps->get_fiAddrs();
     uint64_t destDisplacement = destOffset % destInterleaveSize;
     // Get the local pointer to destination FAM offset
     void *local = allocator->get_local_pointer(destRegionId, destOffset);
@@ -597,6 +661,7 @@ void Fam_Memory_Service_Direct::copy(
         for (auto ctx : fiCtxVector) {
             try {
                 fabric_completion_wait(famCtx, ctx, 0);
+                famCtx->free_fi_context(ctx);
             } catch (Fam_Exception &e) {
                 famCtx->inc_num_rx_fail_cnt(1l);
                 // Release Fam_Context read lock
@@ -709,7 +774,9 @@ size_t Fam_Memory_Service_Direct::get_addr_size() {
     // This function is used only in memory server model
     if (isSharedMemory)
         return 0;
-    addrSize = famOps->get_addr_size();
+    // With rails, the published address carries the rail addresses
+    addrSize = (railAddrName != NULL) ? railAddrNameLen
+                                      : famOps->get_addr_size();
     MEMORY_SERVICE_DIRECT_PROFILE_END_OPS(mem_direct_get_addr_size);
     return addrSize;
 }
@@ -720,7 +787,7 @@ void *Fam_Memory_Service_Direct::get_addr() {
     // This function is used only in memory server model
     if (isSharedMemory)
         return NULL;
-    addr = famOps->get_addr();
+    addr = (railAddrName != NULL) ? railAddrName : famOps->get_addr();
     MEMORY_SERVICE_DIRECT_PROFILE_END_OPS(mem_direct_get_addr);
     return addr;
 }
@@ -985,6 +1052,14 @@ Fam_Memory_Service_Direct::get_config_info(std::string filename) {
             // If parameter is not present, then set the default.
             options["Memservers:if_device"] = (char *)strdup("");
         }
+        try {
+            options["Memservers:rails"] = (char *)strdup(
+                (info->get_map_value("Memservers", memory_server_id, "rails"))
+                    .c_str());
+        } catch (Fam_InvalidOption_Exception &e) {
+            // If parameter is not present, then set the default.
+            options["Memservers:rails"] = (char *)strdup("");
+        }
         try {
             options["rpc_framework_type"] = (char *)strdup(
                 (info->get_key_value("rpc_framework_type")).c_str());
@@ -1290,6 +1365,117 @@ void Fam_Memory_Service_Direct::gather_indexed_atomic(
     MEMORY_SERVICE_DIRECT_PROFILE_END_OPS(mem_direct_gather_indexed_atomic)
 }
 
+uint64_t Fam_Memory_Service_Direct::insert_client_addr(const char *nodeAddr,
+                                                       uint32_t nodeAddrSize) {
+    ostringstream message;
+    std::string name(nodeAddr, nodeAddrSize);
+    std::vector<fi_addr_t> fiAddrV;
+    if (fabric_insert_av(name.data(), famOps->get_av(), &fiAddrV) < 0) {
+        message << "Failed to insert client address into address vector";
+        throw Memory_Service_Exception(LIBFABRIC_ERROR, message.str().c_str());
+    }
+    return fiAddrV[0];
+}
+
+void Fam_Memory_Service_Direct::remove_client_addr(uint64_t fiAddr) {
+    if (fiAddr != FI_ADDR_UNSPEC)
+        (void)fabric_remove_av(fiAddr, famOps->get_av());
+}
+
+// Byte offset of element i of a packed gather/scatter within the data item
+static inline uint64_t packed_element_offset(uint64_t i, uint64_t firstElement,
+                                             uint64_t stride,
+                                             const uint64_t *elementIndex,
+                                             uint64_t elementSize) {
+    if (elementIndex)
+        return elementIndex[i] * elementSize;
+    return (firstElement + i * stride) * elementSize;
+}
+
+void Fam_Memory_Service_Direct::gather_packed(
+    uint64_t regionId, uint64_t offset, uint64_t nElements,
+    uint64_t firstElement, uint64_t stride, const uint64_t *elementIndex,
+    uint64_t elementSize, uint64_t key, uint64_t clientBaseAddr,
+    const char *nodeAddr, uint32_t nodeAddrSize) {
+    MEMORY_SERVICE_DIRECT_PROFILE_START_OPS()
+    ostringstream message;
+    if (isSharedMemory) {
+        message << "Packed gather is not supported in shared memory model";
+        throw Memory_Service_Exception(UNIMPLEMENTED, message.str().c_str());
+    }
+    char *local = (char *)allocator->get_local_pointer(regionId, offset);
+    uint64_t bufferSize = nElements * elementSize;
+    char *buffer = (char *)malloc(bufferSize);
+    if (buffer == NULL) {
+        message << "Failed to allocate buffer for packed gather";
+        throw Memory_Service_Exception(NULL_POINTER_ACCESS,
+                                       message.str().c_str());
+    }
+
+    // Pack the elements and push them to the client with one RDMA write
+    for (uint64_t i = 0; i < nElements; i++) {
+        memcpy(buffer + i * elementSize,
+               local + packed_element_offset(i, firstElement, stride,
+                                             elementIndex, elementSize),
+               elementSize);
+    }
+    fi_addr_t fiAddr = FI_ADDR_UNSPEC;
+    try {
+        fiAddr = insert_client_addr(nodeAddr, nodeAddrSize);
+        fabric_write(key, buffer, bufferSize, clientBaseAddr, fiAddr,
+                     famOps->get_defaultCtx(uint64_t(0)));
+    } catch (...) {
+        remove_client_addr(fiAddr);
+        free(buffer);
+        throw;
+    }
+    remove_client_addr(fiAddr);
+    free(buffer);
+    MEMORY_SERVICE_DIRECT_PROFILE_END_OPS(mem_direct_gather_packed)
+}
+
+void Fam_Memory_Service_Direct::scatter_packed(
+    uint64_t regionId, uint64_t offset, uint64_t nElements,
+    uint64_t firstElement, uint64_t stride, const uint64_t *elementIndex,
+    uint64_t elementSize, uint64_t key, uint64_t clientBaseAddr,
+    const char *nodeAddr, uint32_t nodeAddrSize) {
+    MEMORY_SERVICE_DIRECT_PROFILE_START_OPS()
+    ostringstream message;
+    if (isSharedMemory) {
+        message << "Packed scatter is not supported in shared memory model";
+        throw Memory_Service_Exception(UNIMPLEMENTED, message.str().c_str());
+    }
+    char *local = (char *)allocator->get_local_pointer(regionId, offset);
+    uint64_t bufferSize = nElements * elementSize;
+    char *buffer = (char *)malloc(bufferSize);
+    if (buffer == NULL) {
+        message << "Failed to allocate buffer for packed scatter";
+        throw Memory_Service_Exception(NULL_POINTER_ACCESS,
+                                       message.str().c_str());
+    }
+
+    // Pull the packed elements from the client with one RDMA read and
+    // unpack them into the data item
+    fi_addr_t fiAddr = FI_ADDR_UNSPEC;
+    try {
+        fiAddr = insert_client_addr(nodeAddr, nodeAddrSize);
+        fabric_read(key, buffer, bufferSize, clientBaseAddr, fiAddr,
+                    famOps->get_defaultCtx(uint64_t(0)));
+    } catch (...) {
+        remove_client_addr(fiAddr);
+        free(buffer);
+        throw;
+    }
+    remove_client_addr(fiAddr);
+    for (uint64_t i = 0; i < nElements; i++) {
+        memcpy(local + packed_element_offset(i, firstElement, stride,
+                                             elementIndex, elementSize),
+               buffer + i * elementSize, elementSize);
+    }
+    free(buffer);
+    MEMORY_SERVICE_DIRECT_PROFILE_END_OPS(mem_direct_scatter_packed)
+}
+
 // get and set controlpath address functions
 string Fam_Memory_Service_Direct::get_controlpath_addr() {
     return controlpath_addr;
@@ -31,6 +31,9 @@
 #ifndef FAM_MEMORY_SERVICE_DIRECT_H_
 #define FAM_MEMORY_SERVICE_DIRECT_H_
 
+#include <map>
+#include <pthread.h>
+#include <string>
 #include <sys/types.h>
 
 #include "allocator/memserver_allocator.h"
@@ -146,6 +149,18 @@ class Fam_Memory_Service_Direct : public Fam_Memory_Service {
                                uint64_t srcBaseAddr, const char *nodeAddr,
                                uint32_t nodeAddrSize);
 
+    void gather_packed(uint64_t regionId, uint64_t offset, uint64_t nElements,
+                       uint64_t firstElement, uint64_t stride,
+                       const uint64_t *elementIndex, uint64_t elementSize,
+                       uint64_t key, uint64_t clientBaseAddr,
+                       const char *nodeAddr, uint32_t nodeAddrSize);
+
+    void scatter_packed(uint64_t regionId, uint64_t offset, uint64_t nElements,
+                        uint64_t firstElement, uint64_t stride,
+                        const uint64_t *elementIndex, uint64_t elementSize,
+                        uint64_t key, uint64_t clientBaseAddr,
+                        const char *nodeAddr, uint32_t nodeAddrSize);
+
     void update_memserver_addrlist(void *memServerInfoBuffer,
                                    size_t memServerInfoSize,
                                    uint64_t memoryServerCount);
@@ -183,11 +198,22 @@ class Fam_Memory_Service_Direct : public Fam_Memory_Service {
     string controlpath_addr, rpc_framework_type, rpc_protocol_type;
 
     Fam_Ops_Libfabric *famOps;
+    // The client of a packed gather/scatter is in the address vector only
+    // for the duration of the transfer
+    uint64_t insert_client_addr(const char *nodeAddr, uint32_t nodeAddrSize);
+    void remove_client_addr(uint64_t fiAddr);
     int libfabricProgressMode;
     std::thread progressThread;
     boost::atomic<bool> haltProgress;
+    // Additional rails as a list of address:port, their libfabric objects,
+    // and the published address with the rail addresses appended
+    std::string rails;
+    std::vector<Fam_Ops_Libfabric *> railOps;
+    void *railAddrName;
+    size_t railAddrNameLen;
     void fabric_initialize(const char *name, const char *service,
                            const char *provider, const char *if_device);
+    void open_rails();
     void fabric_finalize();
     void progress_thread();
 };
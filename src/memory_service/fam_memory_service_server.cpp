@@ -731,6 +731,62 @@ Fam_Memory_Service_Server::copy(::grpc::ServerContext *context,
     return ::grpc::Status::OK;
 }
 
+::grpc::Status Fam_Memory_Service_Server::gather_packed(
+    ::grpc::ServerContext *context,
+    const ::Fam_Memory_SG_Packed_Request *request,
+    ::Fam_Memory_Service_Response *response) {
+    MEMORY_SERVICE_SERVER_PROFILE_START_OPS()
+    const uint64_t *elementIndex = NULL;
+    if (!request->elementindex().empty())
+        elementIndex = (const uint64_t *)request->elementindex().data();
+    try {
+        if (!packed_index_matches(request->elementindex(),
+                                  request->nelements()))
+            THROW_ERRNO_MSG(Memory_Service_Exception, FAM_ERR_INVALID,
+                            "Element index does not match nElements");
+        memoryService->gather_packed(
+            request->regionid(), request->offset(), request->nelements(),
+            request->firstelement(), request->stride(), elementIndex,
+            request->elementsize(), request->key(),
+            request->client_base_addr(), request->nodeaddr().c_str(),
+            request->nodeaddrsize());
+    } catch (Fam_Exception &e) {
+        response->set_errorcode(e.fam_error());
+        response->set_errormsg(e.fam_error_msg());
+        return ::grpc::Status::OK;
+    }
+    MEMORY_SERVICE_SERVER_PROFILE_END_OPS(mem_server_gather_packed);
+    return ::grpc::Status::OK;
+}
+
+::grpc::Status Fam_Memory_Service_Server::scatter_packed(
+    ::grpc::ServerContext *context,
+    const ::Fam_Memory_SG_Packed_Request *request,
+    ::Fam_Memory_Service_Response *response) {
+    MEMORY_SERVICE_SERVER_PROFILE_START_OPS()
+    const uint64_t *elementIndex = NULL;
+    if (!request->elementindex().empty())
+        elementIndex = (const uint64_t *)request->elementindex().data();
+    try {
+        if (!packed_index_matches(request->elementindex(),
+                                  request->nelements()))
+            THROW_ERRNO_MSG(Memory_Service_Exception, FAM_ERR_INVALID,
+                            "Element index does not match nElements");
+        memoryService->scatter_packed(
+            request->regionid(), request->offset(), request->nelements(),
+            request->firstelement(), request->stride(), elementIndex,
+            request->elementsize(), request->key(),
+            request->client_base_addr(), request->nodeaddr().c_str(),
+            request->nodeaddrsize());
+    } catch (Fam_Exception &e) {
+        response->set_errorcode(e.fam_error());
+        response->set_errormsg(e.fam_error_msg());
+        return ::grpc::Status::OK;
+    }
+    MEMORY_SERVICE_SERVER_PROFILE_END_OPS(mem_server_scatter_packed);
+    return ::grpc::Status::OK;
+}
+
 ::grpc::Status Fam_Memory_Service_Server::update_memserver_addrlist(
     ::grpc::ServerContext *context,
     const ::Fam_Memory_Service_Addr_Info *request,
@@ -210,6 +210,16 @@ class Fam_Memory_Service_Server : public Fam_Memory_Service_Rpc::Service {
                           const ::Fam_Memory_Atomic_SG_Indexed_Request *request,
                           ::Fam_Memory_Atomic_Response *response) override;
 
+    ::grpc::Status
+    gather_packed(::grpc::ServerContext *context,
+                  const ::Fam_Memory_SG_Packed_Request *request,
+                  ::Fam_Memory_Service_Response *response) override;
+
+    ::grpc::Status
+    scatter_packed(::grpc::ServerContext *context,
+                   const ::Fam_Memory_SG_Packed_Request *request,
+                   ::Fam_Memory_Service_Response *response) override;
+
     ::grpc::Status update_memserver_addrlist(
         ::grpc::ServerContext *context,
         const ::Fam_Memory_Service_Addr_Info *request,
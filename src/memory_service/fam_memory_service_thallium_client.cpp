@@ -218,6 +218,8 @@ void Fam_Memory_Service_Thallium_Client::connect(const char *name,
     rp_gather_strided_atomic = myEngine.define("gather_strided_atomic");
     rp_scatter_indexed_atomic = myEngine.define("scatter_indexed_atomic");
     rp_gather_indexed_atomic = myEngine.define("gather_indexed_atomic");
+    rp_gather_packed = myEngine.define("gather_packed");
+    rp_scatter_packed = myEngine.define("scatter_packed");
     rp_update_memserver_addrlist = myEngine.define("update_memserver_addrlist");
     rp_open_region_with_registration =
         myEngine.define("open_region_with_registration");
@@ -781,6 +783,64 @@ void Fam_Memory_Service_Thallium_Client::gather_indexed_atomic(
         thallium_mem_client_gather_indexed_atomic);
 }
 
+void Fam_Memory_Service_Thallium_Client::gather_packed(
+    uint64_t regionId, uint64_t offset, uint64_t nElements,
+    uint64_t firstElement, uint64_t stride, const uint64_t *elementIndex,
+    uint64_t elementSize, uint64_t key, uint64_t clientBaseAddr,
+    const char *nodeAddr, uint32_t nodeAddrSize) {
+    MEMORY_SERVICE_THALLIUM_CLIENT_PROFILE_START_OPS()
+
+    Fam_Memory_Service_Thallium_Request memRequest;
+    memRequest.set_region_id(regionId & REGIONID_MASK);
+    memRequest.set_offset(offset);
+    memRequest.set_nelements(nElements);
+    memRequest.set_firstelement(firstElement);
+    memRequest.set_stride(stride);
+    if (elementIndex)
+        memRequest.set_elementindex((const char *)elementIndex,
+                                    (int)(nElements * sizeof(uint64_t)));
+    memRequest.set_elementsize(elementSize);
+    memRequest.set_key(key);
+    memRequest.set_src_base_addr(clientBaseAddr);
+    memRequest.set_nodeaddr(nodeAddr, (int)nodeAddrSize);
+    memRequest.set_nodeaddrsize(nodeAddrSize);
+    Fam_Memory_Service_Thallium_Response memResponse =
+        rp_gather_packed.on(ph)(memRequest);
+    RPC_STATUS_CHECK(Memory_Service_Exception, memResponse)
+
+    MEMORY_SERVICE_THALLIUM_CLIENT_PROFILE_END_OPS(
+        thallium_mem_client_gather_packed);
+}
+
+void Fam_Memory_Service_Thallium_Client::scatter_packed(
+    uint64_t regionId, uint64_t offset, uint64_t nElements,
+    uint64_t firstElement, uint64_t stride, const uint64_t *elementIndex,
+    uint64_t elementSize, uint64_t key, uint64_t clientBaseAddr,
+    const char *nodeAddr, uint32_t nodeAddrSize) {
+    MEMORY_SERVICE_THALLIUM_CLIENT_PROFILE_START_OPS()
+
+    Fam_Memory_Service_Thallium_Request memRequest;
+    memRequest.set_region_id(regionId & REGIONID_MASK);
+    memRequest.set_offset(offset);
+    memRequest.set_nelements(nElements);
+    memRequest.set_firstelement(firstElement);
+    memRequest.set_stride(stride);
+    if (elementIndex)
+        memRequest.set_elementindex((const char *)elementIndex,
+                                    (int)(nElements * sizeof(uint64_t)));
+    memRequest.set_elementsize(elementSize);
+    memRequest.set_key(key);
+    memRequest.set_src_base_addr(clientBaseAddr);
+    memRequest.set_nodeaddr(nodeAddr, (int)nodeAddrSize);
+    memRequest.set_nodeaddrsize(nodeAddrSize);
+    Fam_Memory_Service_Thallium_Response memResponse =
+        rp_scatter_packed.on(ph)(memRequest);
+    RPC_STATUS_CHECK(Memory_Service_Exception, memResponse)
+
+    MEMORY_SERVICE_THALLIUM_CLIENT_PROFILE_END_OPS(
+        thallium_mem_client_scatter_packed);
+}
+
 void Fam_Memory_Service_Thallium_Client::update_memserver_addrlist(
     void *memServerInfoBuffer, size_t memServerInfoSize,
     uint64_t memoryServerCount) {
@@ -150,6 +150,18 @@ class Fam_Memory_Service_Thallium_Client : public Fam_Memory_Service {
                                uint64_t srcBaseAddr, const char *nodeAddr,
                                uint32_t nodeAddrSize);
 
+    void gather_packed(uint64_t regionId, uint64_t offset, uint64_t nElements,
+                       uint64_t firstElement, uint64_t stride,
+                       const uint64_t *elementIndex, uint64_t elementSize,
+                       uint64_t key, uint64_t clientBaseAddr,
+                       const char *nodeAddr, uint32_t nodeAddrSize);
+
+    void scatter_packed(uint64_t regionId, uint64_t offset, uint64_t nElements,
+                        uint64_t firstElement, uint64_t stride,
+                        const uint64_t *elementIndex, uint64_t elementSize,
+                        uint64_t key, uint64_t clientBaseAddr,
+                        const char *nodeAddr, uint32_t nodeAddrSize);
+
     void update_memserver_addrlist(void *memServerInfoBuffer,
                                    size_t memServerInfoSize,
                                    uint64_t memoryServerCount);
@@ -184,7 +196,8 @@ class Fam_Memory_Service_Thallium_Client : public Fam_Memory_Service {
         rp_get_region_memory, rp_get_dataitem_memory, rp_acquire_CAS_lock,
         rp_release_CAS_lock, rp_get_atomic, rp_put_atomic,
         rp_scatter_strided_atomic, rp_gather_strided_atomic,
-        rp_scatter_indexed_atomic, rp_gather_indexed_atomic,
+        rp_scatter_indexed_atomic, rp_gather_indexed_atomic, rp_gather_packed,
+        rp_scatter_packed,
         rp_update_memserver_addrlist, rp_open_region_with_registration,
         rp_open_region_without_registration, rp_close_region,
         rp_create_region_failure_cleanup;
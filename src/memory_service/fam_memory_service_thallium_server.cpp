@@ -162,6 +162,10 @@ void Fam_Memory_Service_Thallium_Server::run() {
            *myPool);
     define("gather_indexed_atomic",
            &Fam_Memory_Service_Thallium_Server::gather_indexed_atomic, *myPool);
+    define("gather_packed", &Fam_Memory_Service_Thallium_Server::gather_packed,
+           *myPool);
+    define("scatter_packed",
+           &Fam_Memory_Service_Thallium_Server::scatter_packed, *myPool);
     define("update_memserver_addrlist",
            &Fam_Memory_Service_Thallium_Server::update_memserver_addrlist,
            *myPool);
@@ -744,6 +748,62 @@ void Fam_Memory_Service_Thallium_Server::gather_indexed_atomic(
     HANDLE_ERROR(req.respond(memResponse));
 }
 
+void Fam_Memory_Service_Thallium_Server::gather_packed(
+    const tl::request &req, Fam_Memory_Service_Thallium_Request memRequest) {
+    Fam_Memory_Service_Thallium_Response memResponse;
+    MEMORY_SERVICE_THALLIUM_SERVER_PROFILE_START_OPS()
+    std::string elementIndex = memRequest.get_elementindex();
+    try {
+        if (!packed_index_matches(elementIndex, memRequest.get_nelements()))
+            THROW_ERRNO_MSG(Memory_Service_Exception, FAM_ERR_INVALID,
+                            "Element index does not match nElements");
+        direct_memoryService->gather_packed(
+            memRequest.get_region_id(), memRequest.get_offset(),
+            memRequest.get_nelements(), memRequest.get_firstelement(),
+            memRequest.get_stride(),
+            elementIndex.empty() ? NULL
+                                 : (const uint64_t *)elementIndex.data(),
+            memRequest.get_elementsize(), memRequest.get_key(),
+            memRequest.get_src_base_addr(), memRequest.get_nodeaddr().c_str(),
+            memRequest.get_nodeaddrsize());
+        memResponse.set_status(ok);
+    } catch (Fam_Exception &e) {
+        memResponse.set_errorcode(e.fam_error());
+        memResponse.set_errormsg(e.fam_error_msg());
+    }
+    MEMORY_SERVICE_THALLIUM_SERVER_PROFILE_END_OPS(
+        thallium_mem_server_gather_packed);
+    HANDLE_ERROR(req.respond(memResponse));
+}
+
+void Fam_Memory_Service_Thallium_Server::scatter_packed(
+    const tl::request &req, Fam_Memory_Service_Thallium_Request memRequest) {
+    Fam_Memory_Service_Thallium_Response memResponse;
+    MEMORY_SERVICE_THALLIUM_SERVER_PROFILE_START_OPS()
+    std::string elementIndex = memRequest.get_elementindex();
+    try {
+        if (!packed_index_matches(elementIndex, memRequest.get_nelements()))
+            THROW_ERRNO_MSG(Memory_Service_Exception, FAM_ERR_INVALID,
+                            "Element index does not match nElements");
+        direct_memoryService->scatter_packed(
+            memRequest.get_region_id(), memRequest.get_offset(),
+            memRequest.get_nelements(), memRequest.get_firstelement(),
+            memRequest.get_stride(),
+            elementIndex.empty() ? NULL
+                                 : (const uint64_t *)elementIndex.data(),
+            memRequest.get_elementsize(), memRequest.get_key(),
+            memRequest.get_src_base_addr(), memRequest.get_nodeaddr().c_str(),
+            memRequest.get_nodeaddrsize());
+        memResponse.set_status(ok);
+    } catch (Fam_Exception &e) {
+        memResponse.set_errorcode(e.fam_error());
+        memResponse.set_errormsg(e.fam_error_msg());
+    }
+    MEMORY_SERVICE_THALLIUM_SERVER_PROFILE_END_OPS(
+        thallium_mem_server_scatter_packed);
+    HANDLE_ERROR(req.respond(memResponse));
+}
+
 void Fam_Memory_Service_Thallium_Server::update_memserver_addrlist(
     const tl::request &req, Fam_Memory_Service_Thallium_Request memRequest) {
     Fam_Memory_Service_Thallium_Response memResponse;
@@ -147,6 +147,12 @@ class Fam_Memory_Service_Thallium_Server
     void gather_indexed_atomic(const tl::request &req,
                                Fam_Memory_Service_Thallium_Request memRequest);
 
+    void gather_packed(const tl::request &req,
+                       Fam_Memory_Service_Thallium_Request memRequest);
+
+    void scatter_packed(const tl::request &req,
+                        Fam_Memory_Service_Thallium_Request memRequest);
+
     void
     update_memserver_addrlist(const tl::request &req,
                               Fam_Memory_Service_Thallium_Request memRequest);
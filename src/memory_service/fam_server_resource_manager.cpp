@@ -555,6 +555,19 @@ uint64_t Fam_Server_Resource_Manager::register_memory(
     famRegistration->deallocated = false;
 #endif
     famRegistration->mr = mr;
+    ret = register_rail_memory(localPointer, size, mrkey, rwFlag,
+                               famRegistration);
+    if (ret < 0) {
+        (void)unregister_rail_memory(famRegistration);
+        (void)fabric_deregister_mr(mr);
+        if (strncmp(famOps->get_provider(), "cxi", 3) == 0)
+            bitmap_reset(keyMap, mrkey);
+        delete famRegistration;
+        pthread_rwlock_unlock(&famResource->famRegionLock);
+        message << "failed to register with fabric on a rail";
+        throw Memory_Service_Exception(REGISTRATION_FAILED,
+                                       message.str().c_str());
+    }
     famResource->famRegistrationTable->insert({key, famRegistration});
 
     pthread_rwlock_unlock(&famResource->famRegionLock);
@@ -562,6 +575,41 @@ uint64_t Fam_Server_Resource_Manager::register_memory(
     return mrkey;
 }
 
+/*
+ * Register the memory of a registration on every rail with the key it got on
+ * the primary interface, so that clients reach it on any of them
+ */
+int Fam_Server_Resource_Manager::register_rail_memory(
+    void *base, uint64_t size, uint64_t mrkey, bool rwFlag,
+    Fam_Memory_Registration *famRegistration) {
+    for (auto railOps : rails) {
+        fid_mr *railMr = 0;
+        uint64_t railKey = mrkey;
+        int ret = fabric_register_mr(
+            base, size, &railKey, railOps->get_domain(),
+            (railOps->get_defaultCtx((uint64_t)0))->get_ep(),
+            railOps->get_provider(), rwFlag, railMr);
+        if (ret < 0)
+            return ret;
+        famRegistration->railMrs.push_back(railMr);
+        if (railKey != mrkey)
+            return -FI_EKEYREJECTED;
+    }
+    return 0;
+}
+
+int Fam_Server_Resource_Manager::unregister_rail_memory(
+    Fam_Memory_Registration *famRegistration) {
+    int ret = 0;
+    for (auto railMr : famRegistration->railMrs) {
+        int railRet = fabric_deregister_mr(railMr);
+        if (railRet < 0)
+            ret = railRet;
+    }
+    famRegistration->railMrs.clear();
+    return ret;
+}
+
 void Fam_Server_Resource_Manager::unregister_fence_memory() {
     ostringstream message;
     message << "Error while deregistering fence memory : ";
@@ -597,7 +645,9 @@ void Fam_Server_Resource_Manager::unregister_memory(
         Fam_Memory_Registration *famRegistration = rMr->second;
         if (strncmp(famOps->get_provider(), "cxi", 3) == 0)
             mrkey = fi_mr_key(famRegistration->mr);
-        ret = fabric_deregister_mr(famRegistration->mr);
+        ret = unregister_rail_memory(famRegistration);
+        if (ret == 0)
+            ret = fabric_deregister_mr(famRegistration->mr);
         if (ret < 0) {
             pthread_rwlock_unlock(&famResource->famRegionLock);
             message << "failed to deregister with fabric";
@@ -626,7 +676,9 @@ void Fam_Server_Resource_Manager::unregister_memory(
         Fam_Memory_Registration *famRegistration = rwMr->second;
         if (strncmp(famOps->get_provider(), "cxi", 3) == 0)
             mrkey = fi_mr_key(famRegistration->mr);
-        ret = fabric_deregister_mr(famRegistration->mr);
+        ret = unregister_rail_memory(famRegistration);
+        if (ret == 0)
+            ret = fabric_deregister_mr(famRegistration->mr);
         if (ret < 0) {
             pthread_rwlock_unlock(&famResource->famRegionLock);
             message << "failed to deregister with fabric";
@@ -666,7 +718,9 @@ void Fam_Server_Resource_Manager::unregister_region_memory(
         uint64_t mrkey = 0;
         if (strncmp(famOps->get_provider(), "cxi", 3) == 0)
             mrkey = fi_mr_key(mr);
-        ret = fabric_deregister_mr(mr);
+        ret = unregister_rail_memory(famRegistration);
+        if (ret == 0)
+            ret = fabric_deregister_mr(mr);
         if (ret < 0) {
             message << "Failed to unregister memory";
             throw Memory_Service_Exception(UNREGISTRATION_FAILED,
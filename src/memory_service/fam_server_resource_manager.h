@@ -60,6 +60,8 @@ typedef struct {
     std::atomic<bool> deallocated;
 #endif
     fid_mr *mr;
+    // Registrations of the same memory on the rails, with the same key
+    std::vector<fid_mr *> railMrs;
 } Fam_Memory_Registration;
 
 // Structure to manage resource on server side
@@ -81,6 +83,8 @@ class Fam_Server_Resource_Manager {
                                 bool isSharedMemory = true,
                                 Fam_Ops_Libfabric *famOps = NULL);
     ~Fam_Server_Resource_Manager();
+    // Mirror the registrations made from now on to an additional rail
+    void add_rail(Fam_Ops_Libfabric *railOps) { rails.push_back(railOps); }
     void reset_profile();
     void dump_profile();
     Fam_Server_Resource *find_resource(uint64_t regionId);
@@ -126,7 +130,14 @@ class Fam_Server_Resource_Manager {
 
     uint64_t get_key_from_bitmap();
 
+    int register_rail_memory(void *base, uint64_t size, uint64_t mrkey,
+                             bool rwFlag,
+                             Fam_Memory_Registration *famRegistration);
+
+    int unregister_rail_memory(Fam_Memory_Registration *famRegistration);
+
     Fam_Ops_Libfabric *famOps;
+    std::vector<Fam_Ops_Libfabric *> rails;
     Memserver_Allocator *allocator;
     pthread_rwlock_t famResourceTableLock;
     std::map<uint64_t, Fam_Server_Resource *> *famResourceTable;
@@ -44,6 +44,8 @@ class Fam_Runtime {
     virtual int num_pes(void) = 0;
     virtual int runtime_abort(int exitCode, const char msg[]) = 0;
     virtual int runtime_barrier_all() = 0;
+    // Identifier of the job, shared by all its PEs; empty if unknown
+    virtual const char *job_id() = 0;
     virtual ~Fam_Runtime() {}
 };
 #endif
@@ -42,6 +42,7 @@ class Pmi2_Runtime : public Fam_Runtime {
     int mInitrc;
     int mRank = -1;
     int mNumPEs = 0;
+    char mJobId[PMI2_MAX_VALLEN] = "";
 
   public:
     /*
@@ -63,6 +64,8 @@ class Pmi2_Runtime : public Fam_Runtime {
             return rc;
         }
         mInitrc = rc;
+        if (PMI2_SUCCESS != PMI2_Job_GetId(mJobId, (int)sizeof(mJobId)))
+            mJobId[0] = '\0';
         return mInitrc;
     }
     /*
@@ -121,6 +124,11 @@ class Pmi2_Runtime : public Fam_Runtime {
         return rc;
     }
 
+    /*
+     * Gives the identifier of this job, shared by all its PEs.
+     **/
+    const char *job_id() { return mJobId; }
+
     /*
      * Adding a dummy destructor
      */
@@ -139,6 +139,16 @@ class Pmix_Runtime : public Fam_Runtime {
         return 0;
     }
 
+    /*
+     * Gives the namespace of this job, shared by all its PEs.
+     **/
+    const char *job_id() {
+        if (PMIX_SUCCESS == mInitrc)
+            return mProc.nspace;
+        else
+            return "";
+    }
+
     /*
      * Adding a dummy destructor
      */
@@ -27,6 +27,7 @@
  * See https://spdx.org/licenses/BSD-3-Clause
  *
  */
+#include <chrono>
 #include <fam/fam_exception.h>
 #include <gtest/gtest.h>
 #include <iostream>
@@ -42,6 +43,7 @@
 #define ALL_PERM 0777
 
 using namespace std;
+using namespace std::chrono;
 using namespace openfam;
 
 fam *my_fam;
@@ -62,6 +64,17 @@ union int128store {
 
 int128store operand1Value, operand2Value, operand3Value;
 
+// Print the average latency of NUM_ITERATIONS operations started at start.
+// Run with native_int128_atomics enabled and disabled in fam_pe_config.yaml
+// to compare the provider atomic with the memory server CAS lock.
+void report_latency(const char *name, steady_clock::time_point start) {
+    double totalNs =
+        (double)duration_cast<nanoseconds>(steady_clock::now() - start)
+            .count();
+    cout << name << ": " << totalNs / NUM_ITERATIONS << " ns/op over "
+         << NUM_ITERATIONS << " iterations" << endl;
+}
+
 // Test case - Compare and Swap 128 bit success case
 TEST(FamCompareSwap128microbench, CompareSwapInt128Success) {
     int i;
@@ -76,10 +89,12 @@ TEST(FamCompareSwap128microbench, CompareSwapInt128Success) {
                                     operand1Value.i64[1]));
     EXPECT_NO_THROW(my_fam->fam_quiet());
 
+    steady_clock::time_point start = steady_clock::now();
     for (i = 0; i < NUM_ITERATIONS; i++) {
         EXPECT_NO_THROW(my_fam->fam_compare_swap(
             item, testOffset, operand1Value.i128, operand2Value.i128));
     }
+    report_latency("fam_compare_swap(int128_t) success", start);
 }
 
 // Test case - Compare and Swap 128 bit compare failure case
@@ -98,10 +113,44 @@ TEST(FamCompareSwap128microbench, CompareSwapInt128Fail) {
                                     operand1Value.i64[1]));
     EXPECT_NO_THROW(my_fam->fam_quiet());
 
+    steady_clock::time_point start = steady_clock::now();
     for (i = 0; i < NUM_ITERATIONS; i++) {
         EXPECT_NO_THROW(my_fam->fam_compare_swap(
             item, testOffset, operand2Value.i128, operand3Value.i128));
     }
+    report_latency("fam_compare_swap(int128_t) failure", start);
+}
+
+// Test case - Compare and Swap 128 bit where every iteration swaps the value
+TEST(FamCompareSwap128microbench, CompareSwapInt128Alternate) {
+    int i;
+    uint64_t testOffset = 0;
+    int128_t result = 0;
+    operand1Value.i64[0] = 0x1fffffffffffffff;
+    operand1Value.i64[1] = 0x1fffffffffffffff;
+    operand2Value.i64[0] = 0x2fffffffffffffff;
+    operand2Value.i64[1] = 0x2fffffffffffffff;
+
+    EXPECT_NO_THROW(my_fam->fam_set(item, testOffset, operand1Value.i64[0]));
+    EXPECT_NO_THROW(my_fam->fam_set(item, testOffset + sizeof(int64_t),
+                                    operand1Value.i64[1]));
+    EXPECT_NO_THROW(my_fam->fam_quiet());
+
+    steady_clock::time_point start = steady_clock::now();
+    for (i = 0; i < NUM_ITERATIONS; i++) {
+        if (i % 2 == 0) {
+            EXPECT_NO_THROW(result = my_fam->fam_compare_swap(
+                                item, testOffset, operand1Value.i128,
+                                operand2Value.i128));
+            EXPECT_TRUE(result == operand1Value.i128);
+        } else {
+            EXPECT_NO_THROW(result = my_fam->fam_compare_swap(
+                                item, testOffset, operand2Value.i128,
+                                operand1Value.i128));
+            EXPECT_TRUE(result == operand2Value.i128);
+        }
+    }
+    report_latency("fam_compare_swap(int128_t) alternate", start);
 }
 
 int main(int argc, char **argv) {
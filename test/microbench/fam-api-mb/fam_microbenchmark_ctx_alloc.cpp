@@ -0,0 +1,167 @@
+/*
+ * fam_microbenchmark_ctx_alloc.cpp
+ * Copyright (c) 2024 Hewlett Packard Enterprise Development, LP. All rights
+ * reserved. Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See https://spdx.org/licenses/BSD-3-Clause
+ *
+ */
+#include <fam/fam_exception.h>
+#include <gtest/gtest.h>
+#include <iostream>
+#include <new>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <fam/fam.h>
+
+#include "common/fam_test_config.h"
+#define NUM_ITERATIONS 10000
+#define BIG_REGION_SIZE 1073741824
+#define ITEM_SIZE 16777216
+#define SMALL_IO_SIZE 256
+#define LARGE_IO_SIZE 4194304
+#define ALL_PERM 0777
+
+using namespace std;
+using namespace openfam;
+
+fam *my_fam;
+Fam_Options fam_opts;
+Fam_Descriptor *item;
+Fam_Region_Descriptor *desc;
+
+// Number of heap allocations done through operator new by this process,
+// including the ones done inside the OpenFAM library.
+static uint64_t numHeapAllocs = 0;
+
+void *operator new(size_t size) {
+    __sync_fetch_and_add(&numHeapAllocs, (uint64_t)1);
+    void *ptr = malloc(size ? size : 1);
+    if (ptr == NULL)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+void operator delete(void *ptr) noexcept { free(ptr); }
+
+void operator delete(void *ptr, size_t) noexcept { free(ptr); }
+
+#define REPORT_ALLOCS(name, startCnt)                                          \
+    cout << name << ": "                                                       \
+         << (double)(numHeapAllocs - startCnt) / NUM_ITERATIONS                \
+         << " heap allocations per op" << endl;
+
+// Test case - heap allocations of a small blocking put
+TEST(FamCtxAllocMicrobench, BlockingPutSmall) {
+    char *local = (char *)malloc(SMALL_IO_SIZE);
+    memset(local, 1, SMALL_IO_SIZE);
+    // Warm up
+    EXPECT_NO_THROW(my_fam->fam_put_blocking(local, item, 0, SMALL_IO_SIZE));
+
+    uint64_t startCnt = numHeapAllocs;
+    for (int i = 0; i < NUM_ITERATIONS; i++) {
+        my_fam->fam_put_blocking(local, item, 0, SMALL_IO_SIZE);
+    }
+    REPORT_ALLOCS("fam_put_blocking(256B)", startCnt);
+    free(local);
+}
+
+// Test case - heap allocations of a small blocking get
+TEST(FamCtxAllocMicrobench, BlockingGetSmall) {
+    char *local = (char *)malloc(SMALL_IO_SIZE);
+    // Warm up
+    EXPECT_NO_THROW(my_fam->fam_get_blocking(local, item, 0, SMALL_IO_SIZE));
+
+    uint64_t startCnt = numHeapAllocs;
+    for (int i = 0; i < NUM_ITERATIONS; i++) {
+        my_fam->fam_get_blocking(local, item, 0, SMALL_IO_SIZE);
+    }
+    REPORT_ALLOCS("fam_get_blocking(256B)", startCnt);
+    free(local);
+}
+
+// Test case - heap allocations of a blocking fetch atomic
+TEST(FamCtxAllocMicrobench, FetchAdd) {
+    uint64_t offset = 0;
+    EXPECT_NO_THROW(my_fam->fam_set(item, offset, (uint64_t)0));
+    EXPECT_NO_THROW(my_fam->fam_quiet());
+
+    uint64_t startCnt = numHeapAllocs;
+    for (int i = 0; i < NUM_ITERATIONS; i++) {
+        my_fam->fam_fetch_add(item, offset, (uint64_t)1);
+    }
+    REPORT_ALLOCS("fam_fetch_add(uint64_t)", startCnt);
+}
+
+// Test case - heap allocations of a large blocking get, which is split into
+// multiple IOs (chunks or interleave blocks)
+TEST(FamCtxAllocMicrobench, BlockingGetLarge) {
+    char *local = (char *)malloc(LARGE_IO_SIZE);
+    // Warm up
+    EXPECT_NO_THROW(my_fam->fam_get_blocking(local, item, 0, LARGE_IO_SIZE));
+
+    uint64_t startCnt = numHeapAllocs;
+    for (int i = 0; i < NUM_ITERATIONS / 100; i++) {
+        my_fam->fam_get_blocking(local, item, 0, LARGE_IO_SIZE);
+    }
+    cout << "fam_get_blocking(4MB): "
+         << (double)(numHeapAllocs - startCnt) / (NUM_ITERATIONS / 100)
+         << " heap allocations per op" << endl;
+    free(local);
+}
+
+int main(int argc, char **argv) {
+    int ret;
+    ::testing::InitGoogleTest(&argc, argv);
+
+    my_fam = new fam();
+
+    init_fam_options(&fam_opts);
+
+    EXPECT_NO_THROW(my_fam->fam_initialize("default", &fam_opts));
+
+    const char *dataItem = get_uniq_str("firstGlobal", my_fam);
+    const char *testRegion = get_uniq_str("testGlobal", my_fam);
+
+    EXPECT_NO_THROW(desc = my_fam->fam_create_region(
+                        testRegion, BIG_REGION_SIZE, ALL_PERM, NULL));
+    // Allocating data items in the created region
+    EXPECT_NO_THROW(
+        item = my_fam->fam_allocate(dataItem, ITEM_SIZE, ALL_PERM, desc));
+    EXPECT_NE((void *)NULL, item);
+    ret = RUN_ALL_TESTS();
+
+    EXPECT_NO_THROW(my_fam->fam_deallocate(item));
+    EXPECT_NO_THROW(my_fam->fam_destroy_region(desc));
+    delete item;
+    delete desc;
+    free((void *)dataItem);
+    free((void *)testRegion);
+
+    EXPECT_NO_THROW(my_fam->fam_finalize("default"));
+    delete my_fam;
+    return ret;
+}
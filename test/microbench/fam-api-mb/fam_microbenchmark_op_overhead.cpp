@@ -0,0 +1,175 @@
+/*
+ * fam_microbenchmark_op_overhead.cpp
+ * Copyright (c) 2024 Hewlett Packard Enterprise Development, LP. All rights
+ * reserved. Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See https://spdx.org/licenses/BSD-3-Clause
+ *
+ */
+#include <chrono>
+#include <fam/fam_exception.h>
+#include <gtest/gtest.h>
+#include <iostream>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <fam/fam.h>
+
+#include "common/fam_test_config.h"
+#define NUM_ITERATIONS 100000
+#define BIG_REGION_SIZE 1073741824
+#define ITEM_SIZE 1048576
+#define TINY_IO_SIZE 8
+#define ALL_PERM 0777
+
+using namespace std;
+using namespace std::chrono;
+using namespace openfam;
+
+fam *my_fam;
+Fam_Options fam_opts;
+Fam_Descriptor *item;
+Fam_Region_Descriptor *desc;
+
+/*
+ * Per-op software overhead of the data path: context and fabric address
+ * resolution, descriptor decoding and request bookkeeping. Ops are tiny so
+ * that the transfer itself is negligible; run with the memory server on the
+ * same node (or the shared memory model) to keep the wire out of the numbers.
+ * Nonblocking ops are timed on issue only, their completion is timed apart.
+ */
+#define REPORT_NS(name, start, cnt)                                            \
+    cout << name << ": "                                                       \
+         << (double)duration_cast<nanoseconds>(steady_clock::now() - start)    \
+                    .count() /                                                 \
+                (cnt)                                                          \
+         << " ns per op" << endl;
+
+// Test case - issue cost of a tiny nonblocking put
+TEST(FamOpOverheadMicrobench, NonBlockingPutIssue) {
+    uint64_t local = 1;
+    EXPECT_NO_THROW(
+        my_fam->fam_put_nonblocking(&local, item, 0, TINY_IO_SIZE));
+    EXPECT_NO_THROW(my_fam->fam_quiet());
+
+    auto start = steady_clock::now();
+    for (int i = 0; i < NUM_ITERATIONS; i++) {
+        my_fam->fam_put_nonblocking(&local, item,
+                                    (i * TINY_IO_SIZE) % ITEM_SIZE,
+                                    TINY_IO_SIZE);
+    }
+    REPORT_NS("fam_put_nonblocking(8B) issue", start, NUM_ITERATIONS);
+
+    start = steady_clock::now();
+    EXPECT_NO_THROW(my_fam->fam_quiet());
+    REPORT_NS("fam_quiet after puts", start, NUM_ITERATIONS);
+}
+
+// Test case - issue cost of a tiny nonblocking get
+TEST(FamOpOverheadMicrobench, NonBlockingGetIssue) {
+    uint64_t local;
+    EXPECT_NO_THROW(
+        my_fam->fam_get_nonblocking(&local, item, 0, TINY_IO_SIZE));
+    EXPECT_NO_THROW(my_fam->fam_quiet());
+
+    auto start = steady_clock::now();
+    for (int i = 0; i < NUM_ITERATIONS; i++) {
+        my_fam->fam_get_nonblocking(&local, item,
+                                    (i * TINY_IO_SIZE) % ITEM_SIZE,
+                                    TINY_IO_SIZE);
+    }
+    REPORT_NS("fam_get_nonblocking(8B) issue", start, NUM_ITERATIONS);
+    EXPECT_NO_THROW(my_fam->fam_quiet());
+}
+
+// Test case - issue cost of a non-fetching atomic
+TEST(FamOpOverheadMicrobench, NonFetchAddIssue) {
+    EXPECT_NO_THROW(my_fam->fam_set(item, 0, (uint64_t)0));
+    EXPECT_NO_THROW(my_fam->fam_quiet());
+
+    auto start = steady_clock::now();
+    for (int i = 0; i < NUM_ITERATIONS; i++) {
+        my_fam->fam_add(item, 0, (uint64_t)1);
+    }
+    REPORT_NS("fam_add(uint64_t) issue", start, NUM_ITERATIONS);
+    EXPECT_NO_THROW(my_fam->fam_quiet());
+}
+
+// Test case - round trip of a tiny blocking get, for reference
+TEST(FamOpOverheadMicrobench, BlockingGetRoundTrip) {
+    uint64_t local;
+    EXPECT_NO_THROW(my_fam->fam_get_blocking(&local, item, 0, TINY_IO_SIZE));
+
+    auto start = steady_clock::now();
+    for (int i = 0; i < NUM_ITERATIONS; i++) {
+        my_fam->fam_get_blocking(&local, item, 0, TINY_IO_SIZE);
+    }
+    REPORT_NS("fam_get_blocking(8B)", start, NUM_ITERATIONS);
+}
+
+// Test case - fam_quiet with nothing outstanding, the floor of the per-call
+// context bookkeeping
+TEST(FamOpOverheadMicrobench, IdleQuiet) {
+    EXPECT_NO_THROW(my_fam->fam_quiet());
+
+    auto start = steady_clock::now();
+    for (int i = 0; i < NUM_ITERATIONS; i++) {
+        my_fam->fam_quiet();
+    }
+    REPORT_NS("fam_quiet(idle)", start, NUM_ITERATIONS);
+}
+
+int main(int argc, char **argv) {
+    int ret;
+    ::testing::InitGoogleTest(&argc, argv);
+
+    my_fam = new fam();
+
+    init_fam_options(&fam_opts);
+
+    EXPECT_NO_THROW(my_fam->fam_initialize("default", &fam_opts));
+
+    const char *dataItem = get_uniq_str("firstGlobal", my_fam);
+    const char *testRegion = get_uniq_str("testGlobal", my_fam);
+
+    EXPECT_NO_THROW(desc = my_fam->fam_create_region(
+                        testRegion, BIG_REGION_SIZE, ALL_PERM, NULL));
+    // Allocating data items in the created region
+    EXPECT_NO_THROW(
+        item = my_fam->fam_allocate(dataItem, ITEM_SIZE, ALL_PERM, desc));
+    EXPECT_NE((void *)NULL, item);
+    ret = RUN_ALL_TESTS();
+
+    EXPECT_NO_THROW(my_fam->fam_deallocate(item));
+    EXPECT_NO_THROW(my_fam->fam_destroy_region(desc));
+    delete item;
+    delete desc;
+    free((void *)dataItem);
+    free((void *)testRegion);
+
+    EXPECT_NO_THROW(my_fam->fam_finalize("default"));
+    delete my_fam;
+    return ret;
+}
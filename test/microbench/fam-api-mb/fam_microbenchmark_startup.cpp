@@ -0,0 +1,93 @@
+/*
+ * fam_microbenchmark_startup.cpp
+ * Copyright (c) 2024 Hewlett Packard Enterprise Development, LP. All rights
+ * reserved. Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See https://spdx.org/licenses/BSD-3-Clause
+ *
+ */
+#include <chrono>
+#include <fam/fam_exception.h>
+#include <gtest/gtest.h>
+#include <iostream>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <fam/fam.h>
+
+#include "common/fam_test_config.h"
+
+using namespace std;
+using namespace std::chrono;
+using namespace openfam;
+
+fam *my_fam;
+Fam_Options fam_opts;
+double initMsec;
+
+/*
+ * Startup time of a PE: fam_initialize, including the runtime setup, the
+ * fabric setup and the fetch of the memory server information, and the first
+ * barrier, which completes once every PE is up. Run across PE counts with
+ * scripts/test_series_startup.sh, with node_bootstrap enabled and disabled in
+ * fam_pe_config.yaml.
+ */
+// Test case - time taken by this PE in fam_initialize and to the first barrier
+TEST(FamStartupMicrobench, Initialize) {
+    auto start = steady_clock::now();
+    EXPECT_NO_THROW(my_fam->fam_barrier_all());
+    double barrierMsec =
+        (double)duration_cast<microseconds>(steady_clock::now() - start)
+            .count() /
+        1000;
+    int *peId = (int *)my_fam->fam_get_option(strdup("PE_ID"));
+    int *peCnt = (int *)my_fam->fam_get_option(strdup("PE_COUNT"));
+    cout << "PE " << *peId << " of " << *peCnt
+         << ": fam_initialize: " << initMsec
+         << " ms, all PEs up: " << initMsec + barrierMsec << " ms" << endl;
+    free(peId);
+    free(peCnt);
+}
+
+int main(int argc, char **argv) {
+    int ret;
+    ::testing::InitGoogleTest(&argc, argv);
+
+    my_fam = new fam();
+
+    init_fam_options(&fam_opts);
+
+    auto start = steady_clock::now();
+    EXPECT_NO_THROW(my_fam->fam_initialize("default", &fam_opts));
+    initMsec = (double)duration_cast<microseconds>(steady_clock::now() - start)
+                   .count() /
+               1000;
+
+    ret = RUN_ALL_TESTS();
+
+    EXPECT_NO_THROW(my_fam->fam_finalize("default"));
+    delete my_fam;
+    return ret;
+}
@@ -0,0 +1,211 @@
+/*
+ * fam_atomic_batch_reg_test.cpp
+ * Copyright (c) 2024 Hewlett Packard Enterprise Development, LP. All rights
+ * reserved. Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See https://spdx.org/licenses/BSD-3-Clause
+ *
+ */
+#include <fam/fam_exception.h>
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <iostream>
+#include <stdio.h>
+#include <string.h>
+
+#include <fam/fam.h>
+
+#include "common/fam_test_config.h"
+
+using namespace std;
+using namespace openfam;
+
+fam *my_fam;
+Fam_Options fam_opts;
+
+#define NUM_ENTRIES 256
+#define ITEM_SIZE (1024 * 1024)
+
+// Test case 1 - non-fetching batch spread over the whole data item.
+TEST(FamAtomicBatch, AtomicBatchSuccess) {
+    Fam_Region_Descriptor *desc;
+    Fam_Descriptor *item;
+    const char *testRegion = get_uniq_str("test", my_fam);
+    const char *firstItem = get_uniq_str("first", my_fam);
+    uint64_t stride = ITEM_SIZE / NUM_ENTRIES;
+
+    EXPECT_NO_THROW(desc = my_fam->fam_create_region(testRegion, 2 * ITEM_SIZE,
+                                                      0777, NULL));
+    EXPECT_NE((void *)NULL, desc);
+
+    EXPECT_NO_THROW(item = my_fam->fam_allocate(firstItem, ITEM_SIZE, 0777,
+                                                desc));
+    EXPECT_NE((void *)NULL, item);
+
+    Fam_Atomic_Batch_Entry entries[NUM_ENTRIES];
+    for (int i = 0; i < NUM_ENTRIES; i++) {
+        entries[i].descriptor = item;
+        entries[i].offset = i * stride;
+        entries[i].op = FAM_ATOMIC_SET;
+        entries[i].type = FAM_ATOMIC_UINT64;
+        entries[i].value.uint64Value = 0xf0;
+    }
+    EXPECT_NO_THROW(my_fam->fam_atomic_batch(entries, NUM_ENTRIES));
+    EXPECT_NO_THROW(my_fam->fam_quiet());
+
+    for (int i = 0; i < NUM_ENTRIES; i++) {
+        entries[i].op = (i % 2) ? FAM_ATOMIC_ADD : FAM_ATOMIC_XOR;
+        entries[i].value.uint64Value = i;
+    }
+    EXPECT_NO_THROW(my_fam->fam_atomic_batch(entries, NUM_ENTRIES));
+    EXPECT_NO_THROW(my_fam->fam_quiet());
+
+    for (int i = 0; i < NUM_ENTRIES; i++) {
+        uint64_t expected = (i % 2) ? (0xf0 + i) : (0xf0 ^ i);
+        uint64_t value = 0;
+        EXPECT_NO_THROW(value = my_fam->fam_fetch_uint64(item, i * stride));
+        EXPECT_EQ(expected, value);
+    }
+
+    EXPECT_NO_THROW(my_fam->fam_deallocate(item));
+    EXPECT_NO_THROW(my_fam->fam_destroy_region(desc));
+
+    delete item;
+    delete desc;
+
+    free((void *)testRegion);
+    free((void *)firstItem);
+}
+
+// Test case 2 - fetching batch returns the old values.
+TEST(FamAtomicBatch, AtomicFetchBatchSuccess) {
+    Fam_Region_Descriptor *desc;
+    Fam_Descriptor *item;
+    const char *testRegion = get_uniq_str("test", my_fam);
+    const char *firstItem = get_uniq_str("first", my_fam);
+    uint64_t stride = ITEM_SIZE / NUM_ENTRIES;
+
+    EXPECT_NO_THROW(desc = my_fam->fam_create_region(testRegion, 2 * ITEM_SIZE,
+                                                      0777, NULL));
+    EXPECT_NE((void *)NULL, desc);
+
+    EXPECT_NO_THROW(item = my_fam->fam_allocate(firstItem, ITEM_SIZE, 0777,
+                                                desc));
+    EXPECT_NE((void *)NULL, item);
+
+    Fam_Atomic_Batch_Entry entries[NUM_ENTRIES];
+    Fam_Atomic_Value results[NUM_ENTRIES];
+    for (int i = 0; i < NUM_ENTRIES; i++) {
+        entries[i].descriptor = item;
+        entries[i].offset = i * stride;
+        entries[i].op = FAM_ATOMIC_SET;
+        entries[i].type = FAM_ATOMIC_INT64;
+        entries[i].value.int64Value = 100;
+    }
+    EXPECT_NO_THROW(my_fam->fam_atomic_fetch_batch(entries, NUM_ENTRIES,
+                                                   results));
+
+    for (int i = 0; i < NUM_ENTRIES; i++) {
+        entries[i].op = (i % 2) ? FAM_ATOMIC_SUBTRACT : FAM_ATOMIC_MAX;
+        entries[i].value.int64Value = i;
+    }
+    EXPECT_NO_THROW(my_fam->fam_atomic_fetch_batch(entries, NUM_ENTRIES,
+                                                   results));
+    for (int i = 0; i < NUM_ENTRIES; i++) {
+        EXPECT_EQ(100, results[i].int64Value);
+        int64_t expected = (i % 2) ? (100 - i) : std::max<int64_t>(100, i);
+        int64_t value = 0;
+        EXPECT_NO_THROW(value = my_fam->fam_fetch_int64(item, i * stride));
+        EXPECT_EQ(expected, value);
+    }
+
+    EXPECT_NO_THROW(my_fam->fam_deallocate(item));
+    EXPECT_NO_THROW(my_fam->fam_destroy_region(desc));
+
+    delete item;
+    delete desc;
+
+    free((void *)testRegion);
+    free((void *)firstItem);
+}
+
+// Test case 3 - invalid batch arguments are rejected.
+TEST(FamAtomicBatch, AtomicBatchInvalidOptions) {
+    Fam_Region_Descriptor *desc;
+    Fam_Descriptor *item;
+    const char *testRegion = get_uniq_str("test", my_fam);
+    const char *firstItem = get_uniq_str("first", my_fam);
+    Fam_Atomic_Value results[1];
+
+    EXPECT_NO_THROW(
+        desc = my_fam->fam_create_region(testRegion, 8192, 0777, NULL));
+    EXPECT_NE((void *)NULL, desc);
+
+    EXPECT_NO_THROW(item = my_fam->fam_allocate(firstItem, 1024, 0777, desc));
+    EXPECT_NE((void *)NULL, item);
+
+    Fam_Atomic_Batch_Entry entry;
+    entry.descriptor = item;
+    entry.offset = 0;
+    entry.op = FAM_ATOMIC_AND;
+    entry.type = FAM_ATOMIC_INT32;
+    entry.value.int32Value = 1;
+
+    // Logical operations are not defined on signed types
+    EXPECT_THROW(my_fam->fam_atomic_batch(&entry, 1), Fam_Exception);
+    EXPECT_THROW(my_fam->fam_atomic_batch(NULL, 1), Fam_Exception);
+    entry.op = FAM_ATOMIC_ADD;
+    EXPECT_THROW(my_fam->fam_atomic_batch(&entry, 0), Fam_Exception);
+    EXPECT_THROW(my_fam->fam_atomic_fetch_batch(&entry, 1, NULL),
+                 Fam_Exception);
+    entry.descriptor = NULL;
+    EXPECT_THROW(my_fam->fam_atomic_fetch_batch(&entry, 1, results),
+                 Fam_Exception);
+
+    EXPECT_NO_THROW(my_fam->fam_deallocate(item));
+    EXPECT_NO_THROW(my_fam->fam_destroy_region(desc));
+
+    delete item;
+    delete desc;
+
+    free((void *)testRegion);
+    free((void *)firstItem);
+}
+
+int main(int argc, char **argv) {
+    int ret;
+    ::testing::InitGoogleTest(&argc, argv);
+
+    my_fam = new fam();
+
+    init_fam_options(&fam_opts);
+
+    EXPECT_NO_THROW(my_fam->fam_initialize("default", &fam_opts));
+
+    ret = RUN_ALL_TESTS();
+
+    EXPECT_NO_THROW(my_fam->fam_finalize("default"));
+
+    return ret;
+}
@@ -0,0 +1,156 @@
+/*
+ * fam_atomic_combining_reg_test.cpp
+ * Copyright (c) 2024 Hewlett Packard Enterprise Development, LP. All rights
+ * reserved. Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See https://spdx.org/licenses/BSD-3-Clause
+ *
+ */
+#include <fam/fam_exception.h>
+#include <gtest/gtest.h>
+#include <iostream>
+#include <stdio.h>
+#include <string.h>
+
+#include <fam/fam.h>
+
+#include "common/fam_test_config.h"
+
+using namespace std;
+using namespace openfam;
+
+fam *my_fam;
+Fam_Options fam_opts;
+
+#define NUM_COUNTERS 8
+#define NUM_UPDATES 10000
+
+// Test case 1 - many updates to a few hot locations. The results must be the
+// same whether or not atomic_combining is enabled in the PE config.
+TEST(FamAtomicCombining, HotCounters) {
+    Fam_Region_Descriptor *desc;
+    Fam_Descriptor *item;
+    const char *testRegion = get_uniq_str("test", my_fam);
+    const char *firstItem = get_uniq_str("first", my_fam);
+
+    EXPECT_NO_THROW(
+        desc = my_fam->fam_create_region(testRegion, 8192, 0777, NULL));
+    EXPECT_NE((void *)NULL, desc);
+
+    EXPECT_NO_THROW(item = my_fam->fam_allocate(firstItem, 4096, 0777, desc));
+    EXPECT_NE((void *)NULL, item);
+
+    // counters, minimums, maximums and bitmasks
+    for (int i = 0; i < NUM_COUNTERS; i++) {
+        EXPECT_NO_THROW(my_fam->fam_set(item, i * 8, (int64_t)0));
+        EXPECT_NO_THROW(my_fam->fam_set(item, 512 + i * 8, (int64_t)0));
+        EXPECT_NO_THROW(my_fam->fam_set(item, 1024 + i * 8, (int64_t)0));
+        EXPECT_NO_THROW(my_fam->fam_set(item, 1536 + i * 8, (uint64_t)0));
+    }
+    EXPECT_NO_THROW(my_fam->fam_quiet());
+
+    for (int j = 0; j < NUM_UPDATES; j++) {
+        int i = j % NUM_COUNTERS;
+        EXPECT_NO_THROW(my_fam->fam_add(item, i * 8, (int64_t)1));
+        EXPECT_NO_THROW(my_fam->fam_min(item, 512 + i * 8, (int64_t)-j));
+        EXPECT_NO_THROW(my_fam->fam_max(item, 1024 + i * 8, (int64_t)j));
+        EXPECT_NO_THROW(
+            my_fam->fam_or(item, 1536 + i * 8, (uint64_t)1 << (j % 64)));
+    }
+    EXPECT_NO_THROW(my_fam->fam_quiet());
+
+    for (int i = 0; i < NUM_COUNTERS; i++) {
+        int64_t lastJ = NUM_UPDATES - NUM_COUNTERS + i;
+        EXPECT_EQ(NUM_UPDATES / NUM_COUNTERS,
+                  my_fam->fam_fetch_int64(item, i * 8));
+        EXPECT_EQ(-lastJ, my_fam->fam_fetch_int64(item, 512 + i * 8));
+        EXPECT_EQ(lastJ, my_fam->fam_fetch_int64(item, 1024 + i * 8));
+        EXPECT_NE((uint64_t)0, my_fam->fam_fetch_uint64(item, 1536 + i * 8));
+    }
+
+    EXPECT_NO_THROW(my_fam->fam_deallocate(item));
+    EXPECT_NO_THROW(my_fam->fam_destroy_region(desc));
+
+    delete item;
+    delete desc;
+
+    free((void *)testRegion);
+    free((void *)firstItem);
+}
+
+// Test case 2 - different operations on the same location keep their order.
+TEST(FamAtomicCombining, MixedOperations) {
+    Fam_Region_Descriptor *desc;
+    Fam_Descriptor *item;
+    const char *testRegion = get_uniq_str("test", my_fam);
+    const char *firstItem = get_uniq_str("first", my_fam);
+
+    EXPECT_NO_THROW(
+        desc = my_fam->fam_create_region(testRegion, 8192, 0777, NULL));
+    EXPECT_NE((void *)NULL, desc);
+
+    EXPECT_NO_THROW(item = my_fam->fam_allocate(firstItem, 1024, 0777, desc));
+    EXPECT_NE((void *)NULL, item);
+
+    EXPECT_NO_THROW(my_fam->fam_set(item, 0, (int64_t)0));
+    EXPECT_NO_THROW(my_fam->fam_quiet());
+
+    // ((0 + 5 + 5) max 20) + 1 - 3
+    EXPECT_NO_THROW(my_fam->fam_add(item, 0, (int64_t)5));
+    EXPECT_NO_THROW(my_fam->fam_add(item, 0, (int64_t)5));
+    EXPECT_NO_THROW(my_fam->fam_fence());
+    EXPECT_NO_THROW(my_fam->fam_max(item, 0, (int64_t)20));
+    EXPECT_NO_THROW(my_fam->fam_fence());
+    EXPECT_NO_THROW(my_fam->fam_add(item, 0, (int64_t)1));
+    EXPECT_NO_THROW(my_fam->fam_subtract(item, 0, (int64_t)3));
+    EXPECT_NO_THROW(my_fam->fam_quiet());
+
+    EXPECT_EQ(18, my_fam->fam_fetch_int64(item, 0));
+
+    EXPECT_NO_THROW(my_fam->fam_deallocate(item));
+    EXPECT_NO_THROW(my_fam->fam_destroy_region(desc));
+
+    delete item;
+    delete desc;
+
+    free((void *)testRegion);
+    free((void *)firstItem);
+}
+
+int main(int argc, char **argv) {
+    int ret;
+    ::testing::InitGoogleTest(&argc, argv);
+
+    my_fam = new fam();
+
+    init_fam_options(&fam_opts);
+
+    EXPECT_NO_THROW(my_fam->fam_initialize("default", &fam_opts));
+
+    ret = RUN_ALL_TESTS();
+
+    EXPECT_NO_THROW(my_fam->fam_finalize("default"));
+
+    return ret;
+}
@@ -630,9 +630,110 @@ TEST(FamContextModel, FamContextAllAtomicsIOTest) {
     free((void *)dataItem);
     EXPECT_NO_THROW(my_fam->fam_context_close(ctx));
 }
+
+// Test case 8- FamContextCloseWithPendingIOTest
+// Close contexts with nonblocking puts still outstanding; with the context
+// pool enabled in main() the next open reuses the closed context
+TEST(FamContextModel, FamContextCloseWithPendingIOTest) {
+    Fam_Region_Descriptor *rd = NULL;
+    Fam_Descriptor *descriptor = NULL;
+    fam_context *ctx = NULL;
+    const char *myRegion = get_uniq_str("myRegion", my_fam);
+    const char *myItem = get_uniq_str("myItem", my_fam);
+    uint64_t values[NUM_ITERATIONS];
+    uint64_t result[NUM_ITERATIONS];
+
+    EXPECT_NO_THROW(rd = my_fam->fam_create_region(myRegion, (uint64_t)8192,
+                                                   0777, NULL));
+    EXPECT_NE((void *)NULL, rd);
+    EXPECT_NO_THROW(descriptor = my_fam->fam_allocate(
+                        myItem, (uint64_t)sizeof(values), 0600, rd));
+
+    for (int iter = 0; iter < NUM_IO_ITERATIONS; iter++) {
+        EXPECT_NO_THROW(ctx = my_fam->fam_context_open());
+        for (int i = 0; i < NUM_ITERATIONS; i++) {
+            values[i] = (uint64_t)(iter * NUM_ITERATIONS + i);
+            EXPECT_NO_THROW(ctx->fam_put_nonblocking(
+                &values[i], descriptor, i * sizeof(uint64_t),
+                sizeof(uint64_t)));
+        }
+        EXPECT_NO_THROW(my_fam->fam_context_close(ctx));
+
+        EXPECT_NO_THROW(ctx = my_fam->fam_context_open());
+        memset(result, 0, sizeof(result));
+        EXPECT_NO_THROW(
+            ctx->fam_get_blocking(result, descriptor, 0, sizeof(result)));
+        for (int i = 0; i < NUM_ITERATIONS; i++)
+            EXPECT_EQ(values[i], result[i]);
+        EXPECT_NO_THROW(my_fam->fam_context_close(ctx));
+    }
+
+    EXPECT_NO_THROW(my_fam->fam_deallocate(descriptor));
+    EXPECT_NO_THROW(my_fam->fam_destroy_region(rd));
+    delete descriptor;
+    delete rd;
+    free((void *)myRegion);
+    free((void *)myItem);
+}
+
+// Test case 9- FamContextIndependentQuietTest
+// Many open contexts with puts outstanding on each; a quiet on one context
+// completes its own puts, also when the contexts share the transmit and
+// receive contexts as enabled in main()
+TEST(FamContextModel, FamContextIndependentQuietTest) {
+    Fam_Region_Descriptor *rd = NULL;
+    Fam_Descriptor *descriptor = NULL;
+    fam_context *ctx[NUM_CONTEXTS];
+    const char *myRegion = get_uniq_str("myRegion", my_fam);
+    const char *myItem = get_uniq_str("myItem", my_fam);
+    uint64_t values[NUM_CONTEXTS][NUM_IO_ITERATIONS];
+    uint64_t result[NUM_IO_ITERATIONS];
+
+    EXPECT_NO_THROW(rd = my_fam->fam_create_region(myRegion, (uint64_t)8192,
+                                                   0777, NULL));
+    EXPECT_NE((void *)NULL, rd);
+    EXPECT_NO_THROW(descriptor = my_fam->fam_allocate(
+                        myItem, (uint64_t)sizeof(values), 0600, rd));
+
+    for (int c = 0; c < NUM_CONTEXTS; c++) {
+        EXPECT_NO_THROW(ctx[c] = my_fam->fam_context_open());
+        for (int i = 0; i < NUM_IO_ITERATIONS; i++) {
+            values[c][i] = (uint64_t)(c * NUM_IO_ITERATIONS + i);
+            EXPECT_NO_THROW(ctx[c]->fam_put_nonblocking(
+                &values[c][i], descriptor,
+                (c * NUM_IO_ITERATIONS + i) * sizeof(uint64_t),
+                sizeof(uint64_t)));
+        }
+    }
+
+    for (int c = NUM_CONTEXTS - 1; c >= 0; c--) {
+        EXPECT_NO_THROW(ctx[c]->fam_quiet());
+        memset(result, 0, sizeof(result));
+        EXPECT_NO_THROW(my_fam->fam_get_blocking(
+            result, descriptor, c * NUM_IO_ITERATIONS * sizeof(uint64_t),
+            sizeof(result)));
+        for (int i = 0; i < NUM_IO_ITERATIONS; i++)
+            EXPECT_EQ(values[c][i], result[i]);
+    }
+
+    for (int c = 0; c < NUM_CONTEXTS; c++)
+        EXPECT_NO_THROW(my_fam->fam_context_close(ctx[c]));
+
+    EXPECT_NO_THROW(my_fam->fam_deallocate(descriptor));
+    EXPECT_NO_THROW(my_fam->fam_destroy_region(rd));
+    delete descriptor;
+    delete rd;
+    free((void *)myRegion);
+    free((void *)myItem);
+}
+
 int main(int argc, char **argv) {
     int ret = 0;
     ::testing::InitGoogleTest(&argc, argv);
+    // Recycle closed contexts through a pool, and have all contexts share
+    // the fabric transmit and receive contexts
+    char *configDir = override_pe_config(
+        {"context_pool_size: 4", "shared_contexts: enable"});
     my_fam = new fam();
 
     init_fam_options(&fam_opts);
@@ -642,6 +743,7 @@ int main(int argc, char **argv) {
     ret = RUN_ALL_TESTS();
 
     EXPECT_NO_THROW(my_fam->fam_finalize("default"));
+    remove_pe_config_override(configDir);
 
     return ret;
 }
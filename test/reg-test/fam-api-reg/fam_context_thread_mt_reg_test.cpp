@@ -0,0 +1,176 @@
+/*
+ * fam_context_thread_mt_reg_test.cpp
+ * Copyright (c) 2024 Hewlett Packard Enterprise Development, LP. All rights
+ * reserved. Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See https://spdx.org/licenses/BSD-3-Clause
+ *
+ */
+/* Test Case Description: Tests the FAM_CONTEXT_THREAD context model, where
+ * every thread issues its IOs on its own endpoint.
+ */
+
+#include <fam/fam.h>
+#include <fam/fam_exception.h>
+#include <gtest/gtest.h>
+#include <iostream>
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "common/fam_test_config.h"
+
+using namespace std;
+using namespace openfam;
+fam *my_fam;
+Fam_Options fam_opts;
+
+Fam_Region_Descriptor *testRegionDesc;
+const char *testRegionStr;
+#define NUM_THREADS 8
+#define NUM_ROUNDS 4
+#define BLOCK_SIZE 4096
+#define REGION_SIZE (BLOCK_SIZE * NUM_THREADS * 4)
+#define REGION_PERM 0777
+
+typedef struct {
+    Fam_Descriptor *item;
+    uint64_t offset;
+    int32_t tid;
+} ThreadInfo;
+
+// Each thread writes its own block with non-blocking puts, quiets its own
+// context and reads the block back
+void *thrd_put_get(void *arg) {
+    ThreadInfo *info = (ThreadInfo *)arg;
+    char *local = (char *)malloc(BLOCK_SIZE);
+    char *result = (char *)malloc(BLOCK_SIZE);
+    memset(local, 'a' + info->tid, BLOCK_SIZE);
+    memset(result, 0, BLOCK_SIZE);
+
+    for (uint64_t off = 0; off < BLOCK_SIZE; off += BLOCK_SIZE / 8) {
+        EXPECT_NO_THROW(my_fam->fam_put_nonblocking(
+            local + off, info->item, info->offset + off, BLOCK_SIZE / 8));
+    }
+    EXPECT_NO_THROW(my_fam->fam_quiet());
+    EXPECT_NO_THROW(
+        my_fam->fam_get_blocking(result, info->item, info->offset, BLOCK_SIZE));
+    EXPECT_EQ(0, memcmp(local, result, BLOCK_SIZE));
+
+    free(local);
+    free(result);
+    pthread_exit(NULL);
+}
+
+// Each thread adds to a shared counter and exits, so that the contexts of
+// exited threads are reused by the next round
+void *thrd_add(void *arg) {
+    ThreadInfo *info = (ThreadInfo *)arg;
+    EXPECT_NO_THROW(my_fam->fam_add(info->item, 0, (uint64_t)1));
+    EXPECT_NO_THROW(my_fam->fam_quiet());
+    pthread_exit(NULL);
+}
+
+TEST(FamContextThreadModel, PerThreadPutGet) {
+    Fam_Descriptor *item = NULL;
+    const char *dataItem = get_uniq_str("first", my_fam);
+    pthread_t thr[NUM_THREADS];
+    ThreadInfo info[NUM_THREADS];
+
+    EXPECT_NO_THROW(item = my_fam->fam_allocate(
+                        dataItem, BLOCK_SIZE * NUM_THREADS, 0777,
+                        testRegionDesc));
+    EXPECT_NE((void *)NULL, item);
+
+    for (int i = 0; i < NUM_THREADS; i++) {
+        info[i].item = item;
+        info[i].offset = (uint64_t)i * BLOCK_SIZE;
+        info[i].tid = i;
+        EXPECT_EQ(0, pthread_create(&thr[i], NULL, thrd_put_get, &info[i]));
+    }
+    for (int i = 0; i < NUM_THREADS; i++)
+        pthread_join(thr[i], NULL);
+
+    EXPECT_NO_THROW(my_fam->fam_deallocate(item));
+    delete item;
+    free((void *)dataItem);
+}
+
+TEST(FamContextThreadModel, ContextReuseAfterThreadExit) {
+    Fam_Descriptor *item = NULL;
+    const char *dataItem = get_uniq_str("second", my_fam);
+    pthread_t thr[NUM_THREADS];
+    ThreadInfo info[NUM_THREADS];
+    uint64_t counter = 0;
+
+    EXPECT_NO_THROW(item = my_fam->fam_allocate(dataItem, BLOCK_SIZE, 0777,
+                                                testRegionDesc));
+    EXPECT_NE((void *)NULL, item);
+    EXPECT_NO_THROW(my_fam->fam_set(item, 0, (uint64_t)0));
+    EXPECT_NO_THROW(my_fam->fam_quiet());
+
+    for (int round = 0; round < NUM_ROUNDS; round++) {
+        for (int i = 0; i < NUM_THREADS; i++) {
+            info[i].item = item;
+            info[i].offset = 0;
+            info[i].tid = i;
+            EXPECT_EQ(0, pthread_create(&thr[i], NULL, thrd_add, &info[i]));
+        }
+        for (int i = 0; i < NUM_THREADS; i++)
+            pthread_join(thr[i], NULL);
+    }
+
+    EXPECT_NO_THROW(counter = my_fam->fam_fetch_uint64(item, 0));
+    EXPECT_EQ((uint64_t)(NUM_ROUNDS * NUM_THREADS), counter);
+
+    EXPECT_NO_THROW(my_fam->fam_deallocate(item));
+    delete item;
+    free((void *)dataItem);
+}
+
+int main(int argc, char **argv) {
+    int ret = 0;
+    ::testing::InitGoogleTest(&argc, argv);
+
+    my_fam = new fam();
+    init_fam_options(&fam_opts);
+    fam_opts.famThreadModel = strdup("FAM_THREAD_MULTIPLE");
+    fam_opts.famContextModel = strdup("FAM_CONTEXT_THREAD");
+    EXPECT_NO_THROW(my_fam->fam_initialize("default", &fam_opts));
+    testRegionStr = get_uniq_str("test", my_fam);
+    EXPECT_NO_THROW(testRegionDesc = my_fam->fam_create_region(
+                        testRegionStr, REGION_SIZE, REGION_PERM, NULL));
+    EXPECT_NE((void *)NULL, testRegionDesc);
+
+    ret = RUN_ALL_TESTS();
+
+    EXPECT_NO_THROW(my_fam->fam_destroy_region(testRegionDesc));
+    delete testRegionDesc;
+    free((void *)testRegionStr);
+
+    EXPECT_NO_THROW(my_fam->fam_finalize("default"));
+    delete my_fam;
+
+    return ret;
+}
@@ -0,0 +1,212 @@
+/*
+ * fam_multi_rail_reg_test.cpp
+ * Copyright (c) 2024 Hewlett Packard Enterprise Development, LP. All rights
+ * reserved. Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See https://spdx.org/licenses/BSD-3-Clause
+ *
+ */
+#include <fam/fam_exception.h>
+#include <gtest/gtest.h>
+#include <iostream>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fam/fam.h>
+
+#include "common/fam_test_config.h"
+
+using namespace std;
+using namespace openfam;
+
+fam *my_fam;
+Fam_Options fam_opts;
+
+// Run by fam_multi_rail_reg_test.sh against a memory server with rails on
+// 127.0.0.2 and 127.0.0.3, so that the transfers below are striped over the
+// primary interface and both rails. Without rails they are plain blocking
+// transfers and the test still passes.
+
+static void fill(char *buf, size_t size, unsigned seed) {
+    for (size_t i = 0; i < size; i++)
+        buf[i] = (char)((i + seed) % 251);
+}
+
+// Test case 1 - large put and get over all rails
+TEST(FamMultiRail, PutGetStripedSuccess) {
+    Fam_Region_Descriptor *desc;
+    Fam_Descriptor *item;
+    const char *testRegion = get_uniq_str("test", my_fam);
+    const char *firstItem = get_uniq_str("first", my_fam);
+    const size_t size = 32 * 1048576;
+
+    EXPECT_NO_THROW(
+        desc = my_fam->fam_create_region(testRegion, 2 * size, 0777, NULL));
+    EXPECT_NE((void *)NULL, desc);
+    EXPECT_NO_THROW(item = my_fam->fam_allocate(firstItem, size, 0777, desc));
+    EXPECT_NE((void *)NULL, item);
+
+    char *local = (char *)malloc(size);
+    char *local2 = (char *)malloc(size);
+    fill(local, size, 1);
+    EXPECT_NO_THROW(my_fam->fam_put_blocking(local, item, 0, size));
+    memset(local2, 0, size);
+    EXPECT_NO_THROW(my_fam->fam_get_blocking(local2, item, 0, size));
+    EXPECT_EQ(0, memcmp(local, local2, size));
+
+    // Each stripe lands where an unstriped transfer puts it
+    const size_t chunk = 65536;
+    for (size_t off = 0; off < size; off += size / 16) {
+        memset(local2, 0, chunk);
+        EXPECT_NO_THROW(my_fam->fam_get_blocking(local2, item, off, chunk));
+        EXPECT_EQ(0, memcmp(local + off, local2, chunk));
+    }
+
+    EXPECT_NO_THROW(my_fam->fam_deallocate(item));
+    EXPECT_NO_THROW(my_fam->fam_destroy_region(desc));
+
+    delete item;
+    delete desc;
+
+    free(local);
+    free(local2);
+    free((void *)testRegion);
+    free((void *)firstItem);
+}
+
+// Test case 2 - striped transfers at offsets and sizes that are not block
+// aligned
+TEST(FamMultiRail, PutGetStripedUnalignedSuccess) {
+    Fam_Region_Descriptor *desc;
+    Fam_Descriptor *item;
+    const char *testRegion = get_uniq_str("test", my_fam);
+    const char *firstItem = get_uniq_str("first", my_fam);
+    const size_t size = 16 * 1048576;
+    const size_t offset = 4093;
+    const size_t nbytes = size - 2 * offset - 7;
+
+    EXPECT_NO_THROW(
+        desc = my_fam->fam_create_region(testRegion, 2 * size, 0777, NULL));
+    EXPECT_NE((void *)NULL, desc);
+    EXPECT_NO_THROW(item = my_fam->fam_allocate(firstItem, size, 0777, desc));
+    EXPECT_NE((void *)NULL, item);
+
+    char *local = (char *)malloc(size);
+    char *local2 = (char *)malloc(size);
+    fill(local, size, 2);
+    EXPECT_NO_THROW(my_fam->fam_put_blocking(local, item, 0, size));
+
+    fill(local + offset, nbytes, 3);
+    EXPECT_NO_THROW(
+        my_fam->fam_put_blocking(local + offset, item, offset, nbytes));
+    memset(local2, 0, size);
+    EXPECT_NO_THROW(
+        my_fam->fam_get_blocking(local2 + offset, item, offset, nbytes));
+    EXPECT_EQ(0, memcmp(local + offset, local2 + offset, nbytes));
+    EXPECT_NO_THROW(my_fam->fam_get_blocking(local2, item, 0, size));
+    EXPECT_EQ(0, memcmp(local, local2, size));
+
+    EXPECT_NO_THROW(my_fam->fam_deallocate(item));
+    EXPECT_NO_THROW(my_fam->fam_destroy_region(desc));
+
+    delete item;
+    delete desc;
+
+    free(local);
+    free(local2);
+    free((void *)testRegion);
+    free((void *)firstItem);
+}
+
+// Test case 3 - concurrent large transfers; those finding the stripe set
+// busy run unstriped
+TEST(FamMultiRail, PutGetStripedConcurrentSuccess) {
+    Fam_Region_Descriptor *desc;
+    const char *testRegion = get_uniq_str("test", my_fam);
+    const int nThreads = 4;
+    const size_t size = 8 * 1048576;
+    Fam_Descriptor *items[nThreads];
+    char *locals[nThreads];
+    char *locals2[nThreads];
+
+    EXPECT_NO_THROW(desc = my_fam->fam_create_region(
+                        testRegion, 2 * nThreads * size, 0777, NULL));
+    EXPECT_NE((void *)NULL, desc);
+    for (int i = 0; i < nThreads; i++) {
+        std::string name = std::string(testRegion) + "_" + std::to_string(i);
+        EXPECT_NO_THROW(
+            items[i] = my_fam->fam_allocate(name.c_str(), size, 0777, desc));
+        EXPECT_NE((void *)NULL, items[i]);
+        locals[i] = (char *)malloc(size);
+        locals2[i] = (char *)malloc(size);
+        fill(locals[i], size, (unsigned)i + 4);
+        memset(locals2[i], 0, size);
+    }
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < nThreads; i++) {
+        threads.push_back(std::thread([&, i]() {
+            EXPECT_NO_THROW(
+                my_fam->fam_put_blocking(locals[i], items[i], 0, size));
+            EXPECT_NO_THROW(
+                my_fam->fam_get_blocking(locals2[i], items[i], 0, size));
+        }));
+    }
+    for (auto &t : threads)
+        t.join();
+
+    for (int i = 0; i < nThreads; i++) {
+        EXPECT_EQ(0, memcmp(locals[i], locals2[i], size));
+        EXPECT_NO_THROW(my_fam->fam_deallocate(items[i]));
+        delete items[i];
+        free(locals[i]);
+        free(locals2[i]);
+    }
+    EXPECT_NO_THROW(my_fam->fam_destroy_region(desc));
+
+    delete desc;
+
+    free((void *)testRegion);
+}
+
+int main(int argc, char **argv) {
+    int ret;
+    ::testing::InitGoogleTest(&argc, argv);
+
+    my_fam = new fam();
+
+    init_fam_options(&fam_opts);
+    fam_opts.famThreadModel = strdup("FAM_THREAD_MULTIPLE");
+
+    EXPECT_NO_THROW(my_fam->fam_initialize("default", &fam_opts));
+
+    ret = RUN_ALL_TESTS();
+
+    EXPECT_NO_THROW(my_fam->fam_finalize("default"));
+
+    return ret;
+}
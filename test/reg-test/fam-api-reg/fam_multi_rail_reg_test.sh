@@ -0,0 +1,85 @@
+#!/bin/bash
+#
+# fam_multi_rail_reg_test.sh
+# Copyright (c) 2024 Hewlett Packard Enterprise Development, LP. All rights
+# reserved. Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+# 1. Redistributions of source code must retain the above copyright notice,
+# this list of conditions and the following disclaimer.
+# 2. Redistributions in binary form must reproduce the above copyright notice,
+# this list of conditions and the following disclaimer in the documentation
+# and/or other materials provided with the distribution.
+# 3. Neither the name of the copyright holder nor the names of its contributors
+# may be used to endorse or promote products derived from this software without
+# specific prior written permission.
+#
+#    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+# IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+# ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+# LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+# CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+# SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+#    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+# CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+#
+# See https://spdx.org/licenses/BSD-3-Clause
+#
+# Runs fam_multi_rail_reg_test against a memory server with two rails on the
+# loopback addresses 127.0.0.2 and 127.0.0.3, using the sockets provider (or
+# the one given as second argument, e.g. tcp). The client opens the same two
+# rails and stripes transfers of 64 KiB and more over two endpoints per rail.
+#
+# Usage: fam_multi_rail_reg_test.sh <build directory> [provider]
+#
+
+build_dir=$(cd ${1:-build} && pwd)
+provider=${2:-sockets}
+config_dir=$(mktemp -d /tmp/openfam_multi_rail.XXXXXX)
+test_status=0
+
+export OPENFAM_ROOT=$config_dir
+
+$build_dir/bin/openfam_adm --install_path $build_dir \
+    --model memory_server --cisinterface rpc --memserverinterface rpc \
+    --metaserverinterface direct --provider $provider \
+    --metapath /dev/shm/fam_multi_rail_metadata \
+    --cisserver={rpc_interface:127.0.0.1,rpc_port:8980} \
+    --memservers=0:{memory_type:volatile,fam_path:/dev/shm/fam_multi_rail,rpc_interface:127.0.0.1,rpc_port:8990,libfabric_port:7620,if_device:lo} \
+    --metaservers=0:{rpc_interface:127.0.0.1,rpc_port:8981} \
+    --test_args={num_pes:1} \
+    --create_config_files --config_file_path $config_dir || exit 1
+
+# Add the rails, which --memservers cannot express
+python3 - $config_dir/config <<'PYEOF' || exit 1
+import sys
+import ruamel.yaml
+
+path = sys.argv[1]
+with open(path + "/fam_memoryserver_config.yaml") as f:
+    doc = ruamel.yaml.load(f, ruamel.yaml.RoundTripLoader)
+doc["Memservers"][0]["rails"] = "127.0.0.2:7620,127.0.0.3:7620"
+with open(path + "/fam_memoryserver_config.yaml", "w") as f:
+    ruamel.yaml.dump(doc, f, Dumper=ruamel.yaml.RoundTripDumper)
+
+with open(path + "/fam_pe_config.yaml") as f:
+    doc = ruamel.yaml.load(f, ruamel.yaml.RoundTripLoader)
+doc["rail_addresses"] = ["127.0.0.2", "127.0.0.3"]
+doc["io_stripe_count"] = 2
+doc["io_stripe_min_size"] = 65536
+with open(path + "/fam_pe_config.yaml", "w") as f:
+    ruamel.yaml.dump(doc, f, Dumper=ruamel.yaml.RoundTripDumper)
+PYEOF
+
+$build_dir/bin/openfam_adm --start_service --config_file_path $config_dir || exit 1
+
+$build_dir/../third-party/build/bin/mpirun --allow-run-as-root -n 1 \
+    -x OPENFAM_ROOT=$config_dir \
+    $build_dir/test/reg-test/fam-api-reg/fam_multi_rail_reg_test || test_status=1
+
+$build_dir/bin/openfam_adm --stop_service --clean --config_file_path $config_dir
+rm -rf $config_dir
+
+exit $test_status
@@ -0,0 +1,152 @@
+/*
+ * fam_put_get_batch_reg_test.cpp
+ * Copyright (c) 2024 Hewlett Packard Enterprise Development, LP. All rights
+ * reserved. Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See https://spdx.org/licenses/BSD-3-Clause
+ *
+ */
+#include <fam/fam_exception.h>
+#include <gtest/gtest.h>
+#include <iostream>
+#include <stdio.h>
+#include <string.h>
+
+#include <fam/fam.h>
+
+#include "common/fam_test_config.h"
+
+using namespace std;
+using namespace openfam;
+
+fam *my_fam;
+Fam_Options fam_opts;
+
+#define NUM_ENTRIES 64
+#define ENTRY_SIZE 4096
+#define ITEM_SIZE (8 * 1024 * 1024)
+
+// Test case 1 - batched put followed by batched get over scattered offsets.
+TEST(FamPutGetBatch, PutGetBatchSuccess) {
+    Fam_Region_Descriptor *desc;
+    Fam_Descriptor *item;
+    const char *testRegion = get_uniq_str("test", my_fam);
+    const char *firstItem = get_uniq_str("first", my_fam);
+
+    EXPECT_NO_THROW(desc = my_fam->fam_create_region(testRegion, 2 * ITEM_SIZE,
+                                                      0777, NULL));
+    EXPECT_NE((void *)NULL, desc);
+
+    EXPECT_NO_THROW(item = my_fam->fam_allocate(firstItem, ITEM_SIZE, 0777,
+                                                desc));
+    EXPECT_NE((void *)NULL, item);
+
+    char *local = (char *)malloc(NUM_ENTRIES * ENTRY_SIZE);
+    char *local2 = (char *)calloc(NUM_ENTRIES, ENTRY_SIZE);
+    Fam_Batch_Entry entries[NUM_ENTRIES];
+    for (int i = 0; i < NUM_ENTRIES; i++) {
+        memset(local + i * ENTRY_SIZE, 'a' + (i % 26), ENTRY_SIZE);
+        // Spread the entries so that they straddle interleave blocks
+        entries[i].descriptor = item;
+        entries[i].offset =
+            ((uint64_t)i * (ITEM_SIZE / NUM_ENTRIES)) + (i * 61) % ENTRY_SIZE;
+        entries[i].local = local + i * ENTRY_SIZE;
+        entries[i].nbytes = ENTRY_SIZE;
+    }
+
+    EXPECT_NO_THROW(my_fam->fam_put_batch(entries, NUM_ENTRIES));
+
+    for (int i = 0; i < NUM_ENTRIES; i++)
+        entries[i].local = local2 + i * ENTRY_SIZE;
+
+    EXPECT_NO_THROW(my_fam->fam_get_batch(entries, NUM_ENTRIES));
+
+    EXPECT_EQ(0, memcmp(local, local2, NUM_ENTRIES * ENTRY_SIZE));
+
+    // Entries read individually must match the batched write
+    memset(local2, 0, ENTRY_SIZE);
+    EXPECT_NO_THROW(my_fam->fam_get_blocking(local2, item, entries[5].offset,
+                                             ENTRY_SIZE));
+    EXPECT_EQ(0, memcmp(local + 5 * ENTRY_SIZE, local2, ENTRY_SIZE));
+
+    EXPECT_NO_THROW(my_fam->fam_deallocate(item));
+    EXPECT_NO_THROW(my_fam->fam_destroy_region(desc));
+
+    delete item;
+    delete desc;
+
+    free(local);
+    free(local2);
+    free((void *)testRegion);
+    free((void *)firstItem);
+}
+
+// Test case 2 - invalid batch arguments are rejected.
+TEST(FamPutGetBatch, PutGetBatchInvalidOptions) {
+    Fam_Region_Descriptor *desc;
+    Fam_Descriptor *item;
+    const char *testRegion = get_uniq_str("test", my_fam);
+    const char *firstItem = get_uniq_str("first", my_fam);
+    char local[64];
+
+    EXPECT_NO_THROW(
+        desc = my_fam->fam_create_region(testRegion, 8192, 0777, NULL));
+    EXPECT_NE((void *)NULL, desc);
+
+    EXPECT_NO_THROW(item = my_fam->fam_allocate(firstItem, 1024, 0777, desc));
+    EXPECT_NE((void *)NULL, item);
+
+    Fam_Batch_Entry entries[2] = {{item, 0, local, 64}, {item, 64, NULL, 64}};
+
+    EXPECT_THROW(my_fam->fam_put_batch(NULL, 2), Fam_Exception);
+    EXPECT_THROW(my_fam->fam_get_batch(entries, 0), Fam_Exception);
+    EXPECT_THROW(my_fam->fam_put_batch(entries, 2), Fam_Exception);
+    EXPECT_THROW(my_fam->fam_get_batch(entries, 2), Fam_Exception);
+
+    EXPECT_NO_THROW(my_fam->fam_deallocate(item));
+    EXPECT_NO_THROW(my_fam->fam_destroy_region(desc));
+
+    delete item;
+    delete desc;
+
+    free((void *)testRegion);
+    free((void *)firstItem);
+}
+
+int main(int argc, char **argv) {
+    int ret;
+    ::testing::InitGoogleTest(&argc, argv);
+
+    my_fam = new fam();
+
+    init_fam_options(&fam_opts);
+
+    EXPECT_NO_THROW(my_fam->fam_initialize("default", &fam_opts));
+
+    ret = RUN_ALL_TESTS();
+
+    EXPECT_NO_THROW(my_fam->fam_finalize("default"));
+
+    return ret;
+}
@@ -100,6 +100,62 @@ TEST(FamPutGetNonblock, PutGetNonblockSuccess) {
     free((void *)firstItem);
 }
 
+// Test case 2 - small sequential, overlapping and non-adjacent puts, which
+// are merged when write combining is enabled.
+TEST(FamPutGetNonblock, PutSequentialNonblockSuccess) {
+    Fam_Region_Descriptor *desc;
+    Fam_Descriptor *item;
+    const char *testRegion = get_uniq_str("test", my_fam);
+    const char *firstItem = get_uniq_str("first", my_fam);
+    const uint64_t itemSize = 65536;
+
+    EXPECT_NO_THROW(
+        desc = my_fam->fam_create_region(testRegion, 1048576, 0777, NULL));
+    EXPECT_NE((void *)NULL, desc);
+    EXPECT_NO_THROW(item =
+                        my_fam->fam_allocate(firstItem, itemSize, 0777, desc));
+    EXPECT_NE((void *)NULL, item);
+
+    uint64_t *local = (uint64_t *)malloc(itemSize);
+    uint64_t *local2 = (uint64_t *)malloc(itemSize);
+    uint64_t count = itemSize / sizeof(uint64_t);
+
+    uint64_t first = count;
+    for (uint64_t i = 0; i < count; i++) {
+        local[i] = i * 3;
+        local2[i] = i;
+    }
+
+    // Write the item one element at a time, rewriting each element once
+    for (uint64_t i = 0; i < count; i++) {
+        EXPECT_NO_THROW(my_fam->fam_put_nonblocking(
+            &local2[i], item, i * sizeof(uint64_t), sizeof(uint64_t)));
+        EXPECT_NO_THROW(my_fam->fam_put_nonblocking(
+            &local[i], item, i * sizeof(uint64_t), sizeof(uint64_t)));
+    }
+    // Jump back to the start of the item
+    EXPECT_NO_THROW(
+        my_fam->fam_put_nonblocking(&first, item, 0, sizeof(uint64_t)));
+
+    EXPECT_NO_THROW(my_fam->fam_quiet());
+
+    memset(local2, 0, itemSize);
+    EXPECT_NO_THROW(my_fam->fam_get_blocking(local2, item, 0, itemSize));
+    local[0] = first;
+    EXPECT_EQ(0, memcmp(local, local2, itemSize));
+
+    EXPECT_NO_THROW(my_fam->fam_deallocate(item));
+    EXPECT_NO_THROW(my_fam->fam_destroy_region(desc));
+
+    delete item;
+    delete desc;
+    free(local);
+    free(local2);
+
+    free((void *)testRegion);
+    free((void *)firstItem);
+}
+
 int main(int argc, char **argv) {
     int ret;
     ::testing::InitGoogleTest(&argc, argv);
@@ -32,6 +32,7 @@
 #include <iostream>
 #include <stdio.h>
 #include <string.h>
+#include <sys/mman.h>
 
 #include <fam/fam.h>
 
@@ -78,10 +79,292 @@ TEST(FamPutGet, PutGetSuccess) {
     free((void *)firstItem);
 }
 
+// Small transfers from stack buffers, around the size classes of the
+// bounce buffers
+TEST(FamPutGet, PutGetSmallSizesSuccess) {
+    Fam_Region_Descriptor *desc;
+    Fam_Descriptor *item;
+    const char *testRegion = get_uniq_str("test", my_fam);
+    const char *firstItem = get_uniq_str("first", my_fam);
+    size_t sizes[] = {1, 63, 64, 65, 255, 256, 1000, 4096, 4097, 8192};
+
+    EXPECT_NO_THROW(
+        desc = my_fam->fam_create_region(testRegion, 65536, 0777, NULL));
+    EXPECT_NE((void *)NULL, desc);
+
+    // Allocating data items in the created region
+    EXPECT_NO_THROW(item = my_fam->fam_allocate(firstItem, 16384, 0777, desc));
+    EXPECT_NE((void *)NULL, item);
+
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        char local[8192], local2[8192];
+        memset(local, (int)('A' + i), sizes[i]);
+        memset(local2, 0, sizes[i]);
+        EXPECT_NO_THROW(my_fam->fam_put_blocking(local, item, i, sizes[i]));
+        EXPECT_NO_THROW(my_fam->fam_get_blocking(local2, item, i, sizes[i]));
+        EXPECT_EQ(0, memcmp(local, local2, sizes[i]));
+    }
+
+    EXPECT_NO_THROW(my_fam->fam_deallocate(item));
+    EXPECT_NO_THROW(my_fam->fam_destroy_region(desc));
+
+    delete item;
+    delete desc;
+
+    free((void *)testRegion);
+    free((void *)firstItem);
+}
+
+// Large buffers reused across calls, and a buffer unmapped and mapped again
+// at the same address, must move the current contents when mr_cache is on
+TEST(FamPutGet, PutGetLargeBufferReuseSuccess) {
+    Fam_Region_Descriptor *desc;
+    Fam_Descriptor *item;
+    const char *testRegion = get_uniq_str("test", my_fam);
+    const char *firstItem = get_uniq_str("first", my_fam);
+    const size_t size = 1048576;
+
+    EXPECT_NO_THROW(
+        desc = my_fam->fam_create_region(testRegion, 4 * size, 0777, NULL));
+    EXPECT_NE((void *)NULL, desc);
+
+    // Allocating data items in the created region
+    EXPECT_NO_THROW(item = my_fam->fam_allocate(firstItem, size, 0777, desc));
+    EXPECT_NE((void *)NULL, item);
+
+    char *local = (char *)mmap(NULL, size, PROT_READ | PROT_WRITE,
+                               MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    ASSERT_NE(MAP_FAILED, (void *)local);
+    char *local2 = (char *)malloc(size);
+
+    for (int iter = 0; iter < 4; iter++) {
+        memset(local, 'a' + iter, size);
+        EXPECT_NO_THROW(my_fam->fam_put_blocking(local, item, 0, size));
+        memset(local2, 0, size);
+        EXPECT_NO_THROW(my_fam->fam_get_blocking(local2, item, 0, size));
+        EXPECT_EQ(0, memcmp(local, local2, size));
+    }
+
+    EXPECT_EQ(0, munmap(local, size));
+    char *remapped = (char *)mmap(local, size, PROT_READ | PROT_WRITE,
+                                  MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    ASSERT_NE(MAP_FAILED, (void *)remapped);
+    memset(remapped, 'z', size);
+    EXPECT_NO_THROW(my_fam->fam_put_blocking(remapped, item, 0, size));
+    memset(local2, 0, size);
+    EXPECT_NO_THROW(my_fam->fam_get_blocking(local2, item, 0, size));
+    EXPECT_EQ(0, memcmp(remapped, local2, size));
+
+    EXPECT_NO_THROW(my_fam->fam_deallocate(item));
+    EXPECT_NO_THROW(my_fam->fam_destroy_region(desc));
+
+    delete item;
+    delete desc;
+
+    munmap(remapped, size);
+    free(local2);
+    free((void *)testRegion);
+    free((void *)firstItem);
+}
+
+// Transfers large enough to be striped over the endpoints enabled in main(),
+// at offsets and sizes that are not block aligned
+TEST(FamPutGet, PutGetLargeUnalignedSuccess) {
+    Fam_Region_Descriptor *desc;
+    Fam_Descriptor *item;
+    const char *testRegion = get_uniq_str("test", my_fam);
+    const char *firstItem = get_uniq_str("first", my_fam);
+    const size_t size = 16 * 1048576;
+    const size_t offset = 4093;
+    const size_t nbytes = size - 2 * offset - 7;
+
+    EXPECT_NO_THROW(
+        desc = my_fam->fam_create_region(testRegion, 2 * size, 0777, NULL));
+    EXPECT_NE((void *)NULL, desc);
+    EXPECT_NO_THROW(item = my_fam->fam_allocate(firstItem, size, 0777, desc));
+    EXPECT_NE((void *)NULL, item);
+
+    char *local = (char *)malloc(size);
+    char *local2 = (char *)malloc(size);
+    for (size_t i = 0; i < size; i++)
+        local[i] = (char)(i % 253);
+    EXPECT_NO_THROW(my_fam->fam_put_blocking(local, item, 0, size));
+    memset(local2, 0, size);
+    EXPECT_NO_THROW(my_fam->fam_get_blocking(local2, item, 0, size));
+    EXPECT_EQ(0, memcmp(local, local2, size));
+
+    memset(local + offset, 'S', nbytes);
+    EXPECT_NO_THROW(
+        my_fam->fam_put_blocking(local + offset, item, offset, nbytes));
+    memset(local2, 0, size);
+    EXPECT_NO_THROW(
+        my_fam->fam_get_blocking(local2 + offset, item, offset, nbytes));
+    EXPECT_EQ(0, memcmp(local + offset, local2 + offset, nbytes));
+    EXPECT_NO_THROW(my_fam->fam_get_blocking(local2, item, 0, size));
+    EXPECT_EQ(0, memcmp(local, local2, size));
+
+    EXPECT_NO_THROW(my_fam->fam_deallocate(item));
+    EXPECT_NO_THROW(my_fam->fam_destroy_region(desc));
+
+    delete item;
+    delete desc;
+
+    free(local);
+    free(local2);
+    free((void *)testRegion);
+    free((void *)firstItem);
+}
+
+// Reads after writes of the same PE return the new data, from the read cache
+// enabled in main()
+TEST(FamPutGet, GetAfterWriteCoherentSuccess) {
+    Fam_Region_Descriptor *desc;
+    Fam_Descriptor *item;
+    const char *testRegion = get_uniq_str("test", my_fam);
+    const char *firstItem = get_uniq_str("first", my_fam);
+    char local[256], local2[256];
+
+    EXPECT_NO_THROW(
+        desc = my_fam->fam_create_region(testRegion, 65536, 0777, NULL));
+    EXPECT_NE((void *)NULL, desc);
+
+    EXPECT_NO_THROW(item = my_fam->fam_allocate(firstItem, 16384, 0777, desc));
+    EXPECT_NE((void *)NULL, item);
+
+    memset(local, 'A', sizeof(local));
+    EXPECT_NO_THROW(my_fam->fam_put_blocking(local, item, 4000, sizeof(local)));
+    EXPECT_NO_THROW(
+        my_fam->fam_get_blocking(local2, item, 4000, sizeof(local2)));
+    EXPECT_EQ(0, memcmp(local, local2, sizeof(local)));
+
+    // Blocking put over part of the range read above
+    memset(local, 'B', 100);
+    EXPECT_NO_THROW(my_fam->fam_put_blocking(local, item, 4000, 100));
+    EXPECT_NO_THROW(
+        my_fam->fam_get_blocking(local2, item, 4000, sizeof(local2)));
+    EXPECT_EQ(0, memcmp(local, local2, sizeof(local)));
+
+    // Nonblocking put, visible after fam_quiet
+    memset(local + 100, 'C', 100);
+    EXPECT_NO_THROW(
+        my_fam->fam_put_nonblocking(local + 100, item, 4100, 100));
+    EXPECT_NO_THROW(my_fam->fam_quiet());
+    EXPECT_NO_THROW(
+        my_fam->fam_get_blocking(local2, item, 4000, sizeof(local2)));
+    EXPECT_EQ(0, memcmp(local, local2, sizeof(local)));
+
+    // Atomic
+    uint64_t value = 0x4444444444444444ULL;
+    EXPECT_NO_THROW(my_fam->fam_set(item, 4096, value));
+    EXPECT_NO_THROW(my_fam->fam_quiet());
+    memcpy(local + 96, &value, sizeof(value));
+    EXPECT_NO_THROW(
+        my_fam->fam_get_blocking(local2, item, 4000, sizeof(local2)));
+    EXPECT_EQ(0, memcmp(local, local2, sizeof(local)));
+
+    EXPECT_NO_THROW(my_fam->fam_invalidate(item, 0, 16384));
+    EXPECT_NO_THROW(
+        my_fam->fam_get_blocking(local2, item, 4000, sizeof(local2)));
+    EXPECT_EQ(0, memcmp(local, local2, sizeof(local)));
+
+    EXPECT_NO_THROW(my_fam->fam_deallocate(item));
+    EXPECT_NO_THROW(my_fam->fam_destroy_region(desc));
+
+    delete item;
+    delete desc;
+
+    free((void *)testRegion);
+    free((void *)firstItem);
+}
+
+// Prefetched ranges and streams return the data written before them. The
+// read cache enabled in main() holds fewer pages than the item, so that
+// fam_prefetch of the whole item is cut short
+TEST(FamPutGet, PrefetchStreamSuccess) {
+    Fam_Region_Descriptor *desc;
+    Fam_Descriptor *item;
+    const char *testRegion = get_uniq_str("test", my_fam);
+    const char *firstItem = get_uniq_str("first", my_fam);
+    const uint64_t itemSize = 65536;
+
+    EXPECT_NO_THROW(
+        desc = my_fam->fam_create_region(testRegion, 1048576, 0777, NULL));
+    EXPECT_NE((void *)NULL, desc);
+    EXPECT_NO_THROW(item =
+                        my_fam->fam_allocate(firstItem, itemSize, 0777, desc));
+    EXPECT_NE((void *)NULL, item);
+
+    char *local = (char *)malloc(itemSize);
+    char *local2 = (char *)malloc(itemSize);
+    for (uint64_t i = 0; i < itemSize; i++)
+        local[i] = (char)(i % 251);
+    EXPECT_NO_THROW(my_fam->fam_put_blocking(local, item, 0, itemSize));
+
+    EXPECT_NO_THROW(my_fam->fam_prefetch(item, 0, itemSize));
+    EXPECT_NO_THROW(my_fam->fam_get_blocking(local2, item, 100, 5000));
+    EXPECT_EQ(0, memcmp(local + 100, local2, 5000));
+    // Pages past the prefetched part are read from FAM
+    EXPECT_NO_THROW(my_fam->fam_get_blocking(local2, item, 0, itemSize));
+    EXPECT_EQ(0, memcmp(local, local2, itemSize));
+
+    // Write over a prefetched range before reading it
+    EXPECT_NO_THROW(my_fam->fam_prefetch(item, 8192, 8192));
+    memset(local + 9000, 'P', 1000);
+    EXPECT_NO_THROW(my_fam->fam_put_blocking(local + 9000, item, 9000, 1000));
+    EXPECT_NO_THROW(my_fam->fam_get_blocking(local2, item, 8192, 8192));
+    EXPECT_EQ(0, memcmp(local + 8192, local2, 8192));
+
+    // Chunks that do not divide the range, with a short last chunk
+    Fam_Stream *stream = NULL;
+    EXPECT_NO_THROW(stream = my_fam->fam_stream_open(item, 100, itemSize - 200,
+                                                     4000, 4));
+    EXPECT_NE((void *)NULL, stream);
+    uint64_t total = 0, nbytes = 0;
+    const void *chunk;
+    do {
+        EXPECT_NO_THROW(chunk = my_fam->fam_stream_next(stream, &nbytes));
+        if (chunk != NULL) {
+            EXPECT_LE(total + nbytes, itemSize - 200);
+            memcpy(local2 + total, chunk, nbytes);
+            total += nbytes;
+        }
+    } while (chunk != NULL);
+    EXPECT_EQ(itemSize - 200, total);
+    EXPECT_EQ(0, memcmp(local + 100, local2, itemSize - 200));
+    EXPECT_NO_THROW(my_fam->fam_stream_close(stream));
+
+    // Close a stream with chunks still being read
+    EXPECT_NO_THROW(stream = my_fam->fam_stream_open(item, 0, itemSize, 1024,
+                                                     8));
+    EXPECT_NO_THROW(chunk = my_fam->fam_stream_next(stream, &nbytes));
+    EXPECT_EQ(1024, nbytes);
+    EXPECT_EQ(0, memcmp(local, chunk, nbytes));
+    EXPECT_NO_THROW(my_fam->fam_stream_close(stream));
+
+    EXPECT_NO_THROW(my_fam->fam_deallocate(item));
+    EXPECT_NO_THROW(my_fam->fam_destroy_region(desc));
+
+    delete item;
+    delete desc;
+    free(local);
+    free(local2);
+
+    free((void *)testRegion);
+    free((void *)firstItem);
+}
+
 int main(int argc, char **argv) {
     int ret;
     ::testing::InitGoogleTest(&argc, argv);
 
+    // Stripe the large transfers over four endpoints, keep the
+    // registrations of large buffers (the test links libopenfam_mrhook) and
+    // serve small reads and prefetches from a read cache of eight pages
+    char *configDir = override_pe_config(
+        {"io_stripe_count: 4", "io_stripe_min_size: 1048576",
+         "mr_cache: enable", "read_cache: enable", "read_cache_size: 32768",
+         "read_cache_page_size: 4096"});
+
     my_fam = new fam();
 
     init_fam_options(&fam_opts);
@@ -92,5 +375,6 @@ int main(int argc, char **argv) {
 
     EXPECT_NO_THROW(my_fam->fam_finalize("default"));
 
+    remove_pe_config_override(configDir);
     return ret;
 }
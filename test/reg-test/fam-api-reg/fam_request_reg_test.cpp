@@ -0,0 +1,233 @@
+/*
+ * fam_request_reg_test.cpp
+ * Copyright (c) 2024 Hewlett Packard Enterprise Development, LP. All rights
+ * reserved. Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See https://spdx.org/licenses/BSD-3-Clause
+ *
+ */
+#include <fam/fam_exception.h>
+#include <gtest/gtest.h>
+#include <iostream>
+#include <stdio.h>
+#include <string.h>
+
+#include <fam/fam.h>
+
+#include "common/fam_test_config.h"
+
+using namespace std;
+using namespace openfam;
+
+fam *my_fam;
+Fam_Options fam_opts;
+
+#define NUM_REQUESTS 32
+#define ENTRY_SIZE 4096
+#define ITEM_SIZE (NUM_REQUESTS * ENTRY_SIZE)
+
+// Test case 1 - put and get each waited on through their own request.
+TEST(FamRequest, PutGetTestWait) {
+    Fam_Region_Descriptor *desc;
+    Fam_Descriptor *item;
+    Fam_Request *request = NULL;
+    const char *testRegion = get_uniq_str("test", my_fam);
+    const char *firstItem = get_uniq_str("first", my_fam);
+
+    EXPECT_NO_THROW(desc = my_fam->fam_create_region(testRegion, 2 * ITEM_SIZE,
+                                                      0777, NULL));
+    EXPECT_NE((void *)NULL, desc);
+
+    EXPECT_NO_THROW(item = my_fam->fam_allocate(firstItem, ITEM_SIZE, 0777,
+                                                desc));
+    EXPECT_NE((void *)NULL, item);
+
+    char *local = (char *)malloc(ITEM_SIZE);
+    char *local2 = (char *)calloc(1, ITEM_SIZE);
+    memset(local, 'r', ITEM_SIZE);
+
+    EXPECT_NO_THROW(
+        my_fam->fam_put_nonblocking(local, item, 0, ITEM_SIZE, &request));
+    EXPECT_NE((void *)NULL, request);
+    EXPECT_NO_THROW(my_fam->fam_wait(request));
+
+    request = NULL;
+    EXPECT_NO_THROW(
+        my_fam->fam_get_nonblocking(local2, item, 0, ITEM_SIZE, &request));
+    EXPECT_NE((void *)NULL, request);
+    bool done = false;
+    while (!done)
+        EXPECT_NO_THROW(done = my_fam->fam_test(request));
+
+    EXPECT_EQ(0, memcmp(local, local2, ITEM_SIZE));
+
+    EXPECT_NO_THROW(my_fam->fam_deallocate(item));
+    EXPECT_NO_THROW(my_fam->fam_destroy_region(desc));
+
+    delete item;
+    delete desc;
+
+    free(local);
+    free(local2);
+    free((void *)testRegion);
+    free((void *)firstItem);
+}
+
+// Test case 2 - many requests completed with fam_wait_all and fam_wait_any.
+TEST(FamRequest, WaitAllWaitAny) {
+    Fam_Region_Descriptor *desc;
+    Fam_Descriptor *item;
+    Fam_Request *requests[NUM_REQUESTS];
+    const char *testRegion = get_uniq_str("test", my_fam);
+    const char *firstItem = get_uniq_str("first", my_fam);
+
+    EXPECT_NO_THROW(desc = my_fam->fam_create_region(testRegion, 2 * ITEM_SIZE,
+                                                      0777, NULL));
+    EXPECT_NE((void *)NULL, desc);
+
+    EXPECT_NO_THROW(item = my_fam->fam_allocate(firstItem, ITEM_SIZE, 0777,
+                                                desc));
+    EXPECT_NE((void *)NULL, item);
+
+    char *local = (char *)malloc(ITEM_SIZE);
+    char *local2 = (char *)calloc(1, ITEM_SIZE);
+    for (int i = 0; i < NUM_REQUESTS; i++) {
+        memset(local + i * ENTRY_SIZE, 'a' + (i % 26), ENTRY_SIZE);
+        EXPECT_NO_THROW(my_fam->fam_put_nonblocking(
+            local + i * ENTRY_SIZE, item, i * ENTRY_SIZE, ENTRY_SIZE,
+            &requests[i]));
+    }
+    EXPECT_NO_THROW(my_fam->fam_wait_all(requests, NUM_REQUESTS));
+    for (int i = 0; i < NUM_REQUESTS; i++)
+        EXPECT_EQ((void *)NULL, requests[i]);
+
+    for (int i = 0; i < NUM_REQUESTS; i++) {
+        EXPECT_NO_THROW(my_fam->fam_get_nonblocking(
+            local2 + i * ENTRY_SIZE, item, i * ENTRY_SIZE, ENTRY_SIZE,
+            &requests[i]));
+    }
+    // Every request is returned exactly once, then count is returned
+    uint64_t completed = 0;
+    uint64_t idx = 0;
+    while (idx != NUM_REQUESTS) {
+        EXPECT_NO_THROW(idx = my_fam->fam_wait_any(requests, NUM_REQUESTS));
+        if (idx < NUM_REQUESTS) {
+            EXPECT_EQ((void *)NULL, requests[idx]);
+            EXPECT_EQ(0, memcmp(local + idx * ENTRY_SIZE,
+                                local2 + idx * ENTRY_SIZE, ENTRY_SIZE));
+            completed++;
+        }
+    }
+    EXPECT_EQ((uint64_t)NUM_REQUESTS, completed);
+
+    EXPECT_NO_THROW(my_fam->fam_deallocate(item));
+    EXPECT_NO_THROW(my_fam->fam_destroy_region(desc));
+
+    delete item;
+    delete desc;
+
+    free(local);
+    free(local2);
+    free((void *)testRegion);
+    free((void *)firstItem);
+}
+
+// Test case 3 - strided and indexed scatter/gather with requests.
+TEST(FamRequest, ScatterGatherWait) {
+    Fam_Region_Descriptor *desc;
+    Fam_Descriptor *item;
+    Fam_Request *requests[2];
+    const char *testRegion = get_uniq_str("test", my_fam);
+    const char *firstItem = get_uniq_str("first", my_fam);
+
+    EXPECT_NO_THROW(desc = my_fam->fam_create_region(testRegion, 2 * ITEM_SIZE,
+                                                      0777, NULL));
+    EXPECT_NE((void *)NULL, desc);
+
+    EXPECT_NO_THROW(item = my_fam->fam_allocate(firstItem, ITEM_SIZE, 0777,
+                                                desc));
+    EXPECT_NE((void *)NULL, item);
+
+    int64_t local[5] = {1, 2, 3, 4, 5};
+    int64_t local2[5];
+    uint64_t indexes[] = {1, 7, 19, 33, 60};
+
+    EXPECT_NO_THROW(my_fam->fam_scatter_nonblocking(
+        local, item, 5, 2, 3, sizeof(int64_t), &requests[0]));
+    EXPECT_NO_THROW(my_fam->fam_scatter_nonblocking(
+        local, item, 5, indexes, sizeof(int64_t), &requests[1]));
+    EXPECT_NO_THROW(my_fam->fam_wait_all(requests, 2));
+
+    memset(local2, 0, sizeof(local2));
+    EXPECT_NO_THROW(my_fam->fam_gather_nonblocking(
+        local2, item, 5, 2, 3, sizeof(int64_t), &requests[0]));
+    EXPECT_NO_THROW(my_fam->fam_wait(requests[0]));
+    EXPECT_EQ(0, memcmp(local, local2, sizeof(local)));
+
+    memset(local2, 0, sizeof(local2));
+    EXPECT_NO_THROW(my_fam->fam_gather_nonblocking(
+        local2, item, 5, indexes, sizeof(int64_t), &requests[1]));
+    EXPECT_NO_THROW(my_fam->fam_wait(requests[1]));
+    EXPECT_EQ(0, memcmp(local, local2, sizeof(local)));
+
+    EXPECT_NO_THROW(my_fam->fam_deallocate(item));
+    EXPECT_NO_THROW(my_fam->fam_destroy_region(desc));
+
+    delete item;
+    delete desc;
+
+    free((void *)testRegion);
+    free((void *)firstItem);
+}
+
+// Test case 4 - invalid request arguments.
+TEST(FamRequest, InvalidOptions) {
+    Fam_Request *requests[4] = {NULL, NULL, NULL, NULL};
+
+    EXPECT_THROW(my_fam->fam_test(NULL), Fam_Exception);
+    EXPECT_THROW(my_fam->fam_wait(NULL), Fam_Exception);
+    EXPECT_THROW(my_fam->fam_wait_any(NULL, 4), Fam_Exception);
+    EXPECT_THROW(my_fam->fam_wait_all(NULL, 4), Fam_Exception);
+
+    // An array with no pending request completes at once
+    EXPECT_EQ((uint64_t)4, my_fam->fam_wait_any(requests, 4));
+    EXPECT_NO_THROW(my_fam->fam_wait_all(requests, 4));
+}
+
+int main(int argc, char **argv) {
+    int ret;
+    ::testing::InitGoogleTest(&argc, argv);
+
+    my_fam = new fam();
+
+    init_fam_options(&fam_opts);
+
+    EXPECT_NO_THROW(my_fam->fam_initialize("default", &fam_opts));
+
+    ret = RUN_ALL_TESTS();
+
+    EXPECT_NO_THROW(my_fam->fam_finalize("default"));
+
+    return ret;
+}
@@ -168,6 +168,61 @@ TEST(FamScatterGatherIndexBlock, ScatterGetIndexBlockSuccess) {
     free((void *)firstItem);
 }
 
+// Test case 4 - runs of consecutive indexes mixed with isolated ones, with
+// more elements than fit in a single short list
+TEST(FamScatterGatherIndexBlock, ScatterGatherIndexRunsSuccess) {
+    Fam_Region_Descriptor *desc;
+    Fam_Descriptor *item;
+    const char *testRegion = get_uniq_str("test", my_fam);
+    const char *firstItem = get_uniq_str("first", my_fam);
+    const uint64_t count = 1000;
+
+    EXPECT_NO_THROW(
+        desc = my_fam->fam_create_region(testRegion, 8388608, 0777, NULL));
+    EXPECT_NE((void *)NULL, desc);
+
+    // Allocating data items in the created region
+    EXPECT_NO_THROW(item =
+                        my_fam->fam_allocate(firstItem, 4194304, 0777, desc));
+    EXPECT_NE((void *)NULL, item);
+
+    // Blocks of eight consecutive indexes, each followed by a gap, then a
+    // descending tail that must not be merged
+    uint64_t *indexes = (uint64_t *)malloc(count * sizeof(uint64_t));
+    uint64_t *newLocal = (uint64_t *)malloc(count * sizeof(uint64_t));
+    for (uint64_t i = 0; i < count; i++) {
+        if (i < count / 2)
+            indexes[i] = (i / 8) * 10 + (i % 8);
+        else
+            indexes[i] = 3 * count - i;
+        newLocal[i] = i + 100;
+    }
+
+    EXPECT_NO_THROW(my_fam->fam_scatter_blocking(newLocal, item, count,
+                                                 indexes, sizeof(uint64_t)));
+
+    uint64_t *local2 = (uint64_t *)malloc(count * sizeof(uint64_t));
+
+    EXPECT_NO_THROW(my_fam->fam_gather_blocking(local2, item, count, indexes,
+                                                sizeof(uint64_t)));
+
+    for (uint64_t i = 0; i < count; i++) {
+        EXPECT_EQ(local2[i], newLocal[i]);
+    }
+
+    EXPECT_NO_THROW(my_fam->fam_deallocate(item));
+    EXPECT_NO_THROW(my_fam->fam_destroy_region(desc));
+
+    delete item;
+    delete desc;
+
+    free(indexes);
+    free(newLocal);
+    free(local2);
+    free((void *)testRegion);
+    free((void *)firstItem);
+}
+
 int main(int argc, char **argv) {
     int ret;
     ::testing::InitGoogleTest(&argc, argv);
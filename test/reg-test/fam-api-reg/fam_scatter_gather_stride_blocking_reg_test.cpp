@@ -35,6 +35,7 @@
 
 #include <fam/fam.h>
 
+#include "common/fam_internal.h"
 #include "common/fam_test_config.h"
 
 using namespace std;
@@ -84,10 +85,141 @@ TEST(FamScatterGatherStrideBlock, ScatterGatherStrideBlockSuccess) {
     free((void *)firstItem);
 }
 
+// Test case 2 - many small elements, packed by the memory server when
+// sg_offload is enabled
+TEST(FamScatterGatherStrideBlock, ScatterGatherStrideManySuccess) {
+    Fam_Region_Descriptor *desc;
+    Fam_Descriptor *item;
+    const char *testRegion = get_uniq_str("test", my_fam);
+    const char *firstItem = get_uniq_str("first", my_fam);
+    const uint64_t count = 4096;
+    const uint64_t first = 5, stride = 3;
+
+    EXPECT_NO_THROW(
+        desc = my_fam->fam_create_region(testRegion, 1048576, 0777, NULL));
+    EXPECT_NE((void *)NULL, desc);
+
+    // Allocating data items in the created region
+    EXPECT_NO_THROW(item = my_fam->fam_allocate(firstItem, 65536, 0777, desc));
+    EXPECT_NE((void *)NULL, item);
+
+    int *newLocal = (int *)malloc(count * sizeof(int));
+    for (uint64_t i = 0; i < count; i++)
+        newLocal[i] = (int)(i * 7 + 1);
+
+    EXPECT_NO_THROW(my_fam->fam_scatter_blocking(newLocal, item, count, first,
+                                                 stride, sizeof(int)));
+
+    // Every element must be where an unpacked scatter puts it
+    uint64_t span = first + (count - 1) * stride + 1;
+    int *whole = (int *)malloc(span * sizeof(int));
+    EXPECT_NO_THROW(
+        my_fam->fam_get_blocking(whole, item, 0, span * sizeof(int)));
+    for (uint64_t i = 0; i < count; i++) {
+        EXPECT_EQ(whole[first + i * stride], newLocal[i]);
+    }
+
+    int *local2 = (int *)malloc(count * sizeof(int));
+
+    EXPECT_NO_THROW(my_fam->fam_gather_blocking(local2, item, count, first,
+                                                stride, sizeof(int)));
+
+    for (uint64_t i = 0; i < count; i++) {
+        EXPECT_EQ(local2[i], newLocal[i]);
+    }
+
+    EXPECT_NO_THROW(my_fam->fam_deallocate(item));
+    EXPECT_NO_THROW(my_fam->fam_destroy_region(desc));
+
+    delete item;
+    delete desc;
+
+    free(newLocal);
+    free(whole);
+    free(local2);
+    free((void *)testRegion);
+    free((void *)firstItem);
+}
+
+// Test case 3 - many small elements given by an index, packed by the memory
+// server when sg_offload is enabled
+TEST(FamScatterGatherStrideBlock, ScatterGatherIndexManySuccess) {
+    Fam_Region_Descriptor *desc;
+    Fam_Descriptor *item;
+    const char *testRegion = get_uniq_str("test", my_fam);
+    const char *firstItem = get_uniq_str("first", my_fam);
+    const uint64_t count = 4096;
+
+    EXPECT_NO_THROW(
+        desc = my_fam->fam_create_region(testRegion, 1048576, 0777, NULL));
+    EXPECT_NE((void *)NULL, desc);
+
+    // Allocating data items in the created region
+    EXPECT_NO_THROW(item = my_fam->fam_allocate(firstItem, 65536, 0777, desc));
+    EXPECT_NE((void *)NULL, item);
+
+    // Elements in reverse order, two apart
+    uint64_t *indexes = (uint64_t *)malloc(count * sizeof(uint64_t));
+    int *newLocal = (int *)malloc(count * sizeof(int));
+    for (uint64_t i = 0; i < count; i++) {
+        indexes[i] = 2 * (count - 1 - i);
+        newLocal[i] = (int)(i * 5 + 3);
+    }
+
+    EXPECT_NO_THROW(my_fam->fam_scatter_blocking(newLocal, item, count,
+                                                 indexes, sizeof(int)));
+
+    // Every element must be where an unpacked scatter puts it
+    int *whole = (int *)malloc(2 * count * sizeof(int));
+    EXPECT_NO_THROW(
+        my_fam->fam_get_blocking(whole, item, 0, 2 * count * sizeof(int)));
+    for (uint64_t i = 0; i < count; i++) {
+        EXPECT_EQ(whole[indexes[i]], newLocal[i]);
+    }
+
+    int *local2 = (int *)malloc(count * sizeof(int));
+
+    EXPECT_NO_THROW(my_fam->fam_gather_blocking(local2, item, count, indexes,
+                                                sizeof(int)));
+
+    for (uint64_t i = 0; i < count; i++) {
+        EXPECT_EQ(local2[i], newLocal[i]);
+    }
+
+    EXPECT_NO_THROW(my_fam->fam_deallocate(item));
+    EXPECT_NO_THROW(my_fam->fam_destroy_region(desc));
+
+    delete item;
+    delete desc;
+
+    free(indexes);
+    free(newLocal);
+    free(whole);
+    free(local2);
+    free((void *)testRegion);
+    free((void *)firstItem);
+}
+
+// Test case 4 - the servers only accept a packed request whose index holds
+// one entry per element
+TEST(FamScatterGatherStrideBlock, PackedShortIndexRejected) {
+    uint64_t indexes[4] = {0, 3, 6, 9};
+    std::string full((const char *)indexes, sizeof(indexes));
+
+    EXPECT_TRUE(packed_index_matches(full, 4));
+    EXPECT_TRUE(packed_index_matches(std::string(), 4));
+    EXPECT_FALSE(packed_index_matches(full.substr(0, 3 * sizeof(uint64_t)), 4));
+    EXPECT_FALSE(packed_index_matches(full.substr(0, sizeof(indexes) - 1), 4));
+    EXPECT_FALSE(packed_index_matches(full, 5));
+}
+
 int main(int argc, char **argv) {
     int ret;
     ::testing::InitGoogleTest(&argc, argv);
 
+    // Offload is off by default
+    char *configDir = override_pe_config({"sg_offload: enable"});
+
     my_fam = new fam();
 
     init_fam_options(&fam_opts);
@@ -98,5 +230,7 @@ int main(int argc, char **argv) {
 
     EXPECT_NO_THROW(my_fam->fam_finalize("default"));
 
+    remove_pe_config_override(configDir);
+
     return ret;
 }